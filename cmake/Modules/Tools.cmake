@@ -37,6 +37,23 @@ if(BUILD_TOOLS)
   add_subdirectory(${LAMMPS_TOOLS_DIR}/phonon ${CMAKE_BINARY_DIR}/phana_build)
 endif()
 
+if(BUILD_MICROBENCH)
+  add_executable(lammps-microbench ${LAMMPS_TOOLS_DIR}/microbench/microbench.cpp)
+  target_link_libraries(lammps-microbench PRIVATE lammps)
+  if(PKG_KSPACE)
+    # FFT data types must match the settings used for compiling the LAMMPS library
+    target_include_directories(lammps-microbench PRIVATE ${LAMMPS_SOURCE_DIR}/KSPACE)
+    target_compile_definitions(lammps-microbench PRIVATE -DLMP_MICROBENCH_KSPACE
+                               $<TARGET_PROPERTY:lammps,COMPILE_DEFINITIONS>)
+    if(FFT STREQUAL "FFTW3")
+      target_link_libraries(lammps-microbench PRIVATE ${FFTW}::${FFTW})
+    elseif(FFT STREQUAL "MKL")
+      target_link_libraries(lammps-microbench PRIVATE MKL::MKL)
+    endif()
+  endif()
+  install(TARGETS lammps-microbench DESTINATION ${CMAKE_INSTALL_BINDIR})
+endif()
+
 find_package(PkgConfig QUIET)
 if(BUILD_LAMMPS_SHELL)
   if(NOT PkgConfig_FOUND)
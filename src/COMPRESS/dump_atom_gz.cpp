@@ -145,15 +145,12 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpAtomGZ::write()
+void DumpAtomGZ::write_footer()
 {
-  DumpAtom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
@@ -188,15 +188,12 @@ void DumpCFGGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGGZ::write()
+void DumpCFGGZ::write_footer()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
@@ -23,6 +23,7 @@
 #include "domain.h"
 #include "error.h"
 #include "file_writer.h"
+#include "memory.h"
 #include "update.h"
 
 #include <cstring>
@@ -33,6 +34,8 @@ static constexpr double UNWRAPEXPAND = 10.0;
 DumpCFGZstd::DumpCFGZstd(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump cfg/zstd only writes compressed files");
+
+  frame_flag = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -127,7 +130,8 @@ void DumpCFGZstd::write_header(bigint n)
 void DumpCFGZstd::write_data(int n, double *mybuf)
 {
   if (buffer_flag) {
-    writer.write(mybuf, n);
+    if (frame_flag) writer.writeFrame(mybuf, n);
+    else writer.write(mybuf, n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -196,16 +200,38 @@ void DumpCFGZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCFGZstd::write()
+void DumpCFGZstd::write_footer()
 {
-  DumpCFG::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   with compression_frames enabled, each proc compresses its formatted
+   text into an independent zstd frame before it is sent to the filewriter
+------------------------------------------------------------------------- */
+
+int DumpCFGZstd::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpCFG::convert_string(n, mybuf);
+  if (!frame_flag || (nchars <= 0)) return nchars;
+
+  try {
+    const auto &frame = writer.compressFrame(sbuf, nchars);
+    if (frame.size() > (size_t) MAXSMALLINT) return -1;
+    if ((int) frame.size() > maxsbuf) {
+      maxsbuf = frame.size();
+      memory->grow(sbuf, maxsbuf, "dump:sbuf");
     }
+    memcpy(sbuf, frame.data(), frame.size());
+    nchars = frame.size();
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
   }
+  return nchars;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -223,6 +249,14 @@ int DumpCFGZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
+      } else if (strcmp(arg[0], "compression_frames") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        frame_flag = utils::logical(FLERR, arg[1], false, lmp);
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, e.what());
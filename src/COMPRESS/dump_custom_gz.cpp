@@ -145,15 +145,12 @@ void DumpCustomGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpCustomGZ::write()
+void DumpCustomGZ::write_footer()
 {
-  DumpCustom::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
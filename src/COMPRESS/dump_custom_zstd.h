@@ -37,11 +37,13 @@ class DumpCustomZstd : public DumpCustom {
 
  protected:
   ZstdFileWriter writer;
+  int frame_flag;    // 1 if each proc compresses its data into a separate frame
 
   void openfile() override;
   void write_header(bigint) override;
   void write_data(int, double *) override;
-  void write() override;
+  void write_footer() override;
+  int convert_string(int, double *) override;
 
   int modify_param(int, char **) override;
 };
@@ -145,15 +145,12 @@ void DumpLocalGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpLocalGZ::write()
+void DumpLocalGZ::write_footer()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
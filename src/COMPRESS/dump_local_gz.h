@@ -35,7 +35,7 @@ class DumpLocalGZ : public DumpLocal {
   void openfile() override;
   void write_header(bigint) override;
   void write_data(int, double *) override;
-  void write() override;
+  void write_footer() override;
 
   int modify_param(int, char **) override;
 };
@@ -22,6 +22,7 @@
 #include "domain.h"
 #include "error.h"
 #include "file_writer.h"
+#include "memory.h"
 #include "update.h"
 
 #include <cstring>
@@ -31,6 +32,8 @@ using namespace LAMMPS_NS;
 DumpLocalZstd::DumpLocalZstd(LAMMPS *lmp, int narg, char **arg) : DumpLocal(lmp, narg, arg)
 {
   if (!compressed) error->all(FLERR, "Dump local/zstd only writes compressed files");
+
+  frame_flag = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -121,7 +124,8 @@ void DumpLocalZstd::write_header(bigint ndump)
 void DumpLocalZstd::write_data(int n, double *mybuf)
 {
   if (buffer_flag == 1) {
-    writer.write(mybuf, sizeof(char) * n);
+    if (frame_flag) writer.writeFrame(mybuf, sizeof(char) * n);
+    else writer.write(mybuf, sizeof(char) * n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -153,16 +157,38 @@ void DumpLocalZstd::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpLocalZstd::write()
+void DumpLocalZstd::write_footer()
 {
-  DumpLocal::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   with compression_frames enabled, each proc compresses its formatted
+   text into an independent zstd frame before it is sent to the filewriter
+------------------------------------------------------------------------- */
+
+int DumpLocalZstd::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpLocal::convert_string(n, mybuf);
+  if (!frame_flag || (nchars <= 0)) return nchars;
+
+  try {
+    const auto &frame = writer.compressFrame(sbuf, nchars);
+    if (frame.size() > (size_t) MAXSMALLINT) return -1;
+    if ((int) frame.size() > maxsbuf) {
+      maxsbuf = frame.size();
+      memory->grow(sbuf, maxsbuf, "dump:sbuf");
     }
+    memcpy(sbuf, frame.data(), frame.size());
+    nchars = frame.size();
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
   }
+  return nchars;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -180,6 +206,14 @@ int DumpLocalZstd::modify_param(int narg, char **arg)
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setCompressionLevel(utils::inumeric(FLERR, arg[1], false, lmp));
         return 2;
+      } else if (strcmp(arg[0], "compression_threads") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        writer.setThreads(utils::inumeric(FLERR, arg[1], false, lmp));
+        return 2;
+      } else if (strcmp(arg[0], "compression_frames") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        frame_flag = utils::logical(FLERR, arg[1], false, lmp);
+        return 2;
       }
     } catch (FileWriterException &e) {
       error->one(FLERR, "Illegal dump_modify command: {}", e.what());
@@ -114,15 +114,12 @@ void DumpXYZGZ::write_data(int n, double *mybuf)
 
 /* ---------------------------------------------------------------------- */
 
-void DumpXYZGZ::write()
+void DumpXYZGZ::write_footer()
 {
-  DumpXYZ::write();
-  if (filewriter) {
-    if (multifile) {
-      writer.close();
-    } else {
-      if (flush_flag && writer.isopen()) { writer.flush(); }
-    }
+  if (multifile) {
+    writer.close();
+  } else {
+    if (flush_flag && writer.isopen()) { writer.flush(); }
   }
 }
 
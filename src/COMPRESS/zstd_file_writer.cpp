@@ -24,7 +24,8 @@
 using namespace LAMMPS_NS;
 
 ZstdFileWriter::ZstdFileWriter() :
-    compression_level(0), checksum_flag(1), cctx(nullptr), fp(nullptr)
+    compression_level(0), checksum_flag(1), nb_workers(0), stream_pending(false), cctx(nullptr),
+    frame_cctx(nullptr), fp(nullptr)
 {
   out_buffer_size = ZSTD_CStreamOutSize();
   out_buffer = new char[out_buffer_size];
@@ -36,6 +37,9 @@ ZstdFileWriter::~ZstdFileWriter()
 {
   ZstdFileWriter::close();
 
+  ZSTD_freeCCtx(frame_cctx);
+  frame_cctx = nullptr;
+
   delete[] out_buffer;
   out_buffer = nullptr;
   out_buffer_size = 0;
@@ -65,6 +69,8 @@ void ZstdFileWriter::open(const std::string &path, bool append)
 
   ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, compression_level);
   ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, checksum_flag);
+  if (nb_workers > 0) ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, nb_workers);
+  stream_pending = true;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -75,6 +81,7 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
 
   ZSTD_inBuffer input = {buffer, length, 0};
   ZSTD_EndDirective mode = ZSTD_e_continue;
+  stream_pending = true;
 
   do {
     ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
@@ -91,15 +98,17 @@ void ZstdFileWriter::flush()
 {
   if (!isopen()) return;
 
-  size_t remaining;
-  ZSTD_inBuffer input = {nullptr, 0, 0};
-  ZSTD_EndDirective mode = ZSTD_e_flush;
+  if (stream_pending) {
+    size_t remaining;
+    ZSTD_inBuffer input = {nullptr, 0, 0};
+    ZSTD_EndDirective mode = ZSTD_e_flush;
 
-  do {
-    ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
-    remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
-    fwrite(out_buffer, sizeof(char), output.pos, fp);
-  } while (remaining);
+    do {
+      ZSTD_outBuffer output = {out_buffer, out_buffer_size, 0};
+      remaining = ZSTD_compressStream2(cctx, &output, &input, mode);
+      fwrite(out_buffer, sizeof(char), output.pos, fp);
+    } while (remaining);
+  }
 
   fflush(fp);
 }
@@ -110,6 +119,21 @@ void ZstdFileWriter::close()
 {
   if (!ZstdFileWriter::isopen()) return;
 
+  if (stream_pending) end_stream();
+
+  ZSTD_freeCCtx(cctx);
+  cctx = nullptr;
+  fclose(fp);
+  fp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   complete the frame of the streaming context, so that independent
+   frames can be appended. the next write() starts a new frame
+------------------------------------------------------------------------- */
+
+void ZstdFileWriter::end_stream()
+{
   size_t remaining;
   ZSTD_inBuffer input = {nullptr, 0, 0};
   ZSTD_EndDirective mode = ZSTD_e_end;
@@ -120,10 +144,48 @@ void ZstdFileWriter::close()
     fwrite(out_buffer, sizeof(char), output.pos, fp);
   } while (remaining);
 
-  ZSTD_freeCCtx(cctx);
-  cctx = nullptr;
-  fclose(fp);
-  fp = nullptr;
+  stream_pending = false;
+}
+
+/* ----------------------------------------------------------------------
+   compress buffer into a complete, independent zstd frame
+   does not require an open file, so any process can prepare frames
+   the returned data is valid until the next call
+------------------------------------------------------------------------- */
+
+const std::vector<char> &ZstdFileWriter::compressFrame(const void *buffer, size_t length)
+{
+  if (!frame_cctx) {
+    frame_cctx = ZSTD_createCCtx();
+    if (!frame_cctx) throw FileWriterException("Could not create Zstd context");
+  }
+
+  ZSTD_CCtx_reset(frame_cctx, ZSTD_reset_session_and_parameters);
+  ZSTD_CCtx_setParameter(frame_cctx, ZSTD_c_compressionLevel, compression_level);
+  ZSTD_CCtx_setParameter(frame_cctx, ZSTD_c_checksumFlag, checksum_flag);
+  if (nb_workers > 0) ZSTD_CCtx_setParameter(frame_cctx, ZSTD_c_nbWorkers, nb_workers);
+
+  frame_buffer.resize(ZSTD_compressBound(length));
+  size_t nbytes =
+      ZSTD_compress2(frame_cctx, frame_buffer.data(), frame_buffer.size(), buffer, length);
+  if (ZSTD_isError(nbytes))
+    throw FileWriterException(fmt::format("Zstd compression failed: {}", ZSTD_getErrorName(nbytes)));
+  frame_buffer.resize(nbytes);
+
+  return frame_buffer;
+}
+
+/* ----------------------------------------------------------------------
+   append data created by compressFrame() to the file
+   concatenated zstd frames are a valid zstd stream
+------------------------------------------------------------------------- */
+
+size_t ZstdFileWriter::writeFrame(const void *buffer, size_t length)
+{
+  if (!isopen()) return 0;
+
+  if (stream_pending) end_stream();
+  return fwrite(buffer, sizeof(char), length, fp);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -158,4 +220,27 @@ void ZstdFileWriter::setChecksum(bool enabled)
   checksum_flag = enabled ? 1 : 0;
 }
 
+/* ----------------------------------------------------------------------
+   number of zstd worker threads, 0 compresses in the calling thread
+------------------------------------------------------------------------- */
+
+void ZstdFileWriter::setThreads(int nthreads)
+{
+  if (isopen())
+    throw FileWriterException("Number of compression threads can not be changed while file is open");
+
+  if (nthreads < 0) throw FileWriterException("Number of compression threads must be >= 0");
+
+  if (nthreads > 0) {
+    ZSTD_bounds bounds = ZSTD_cParam_getBounds(ZSTD_c_nbWorkers);
+    if (ZSTD_isError(bounds.error) || (bounds.upperBound == 0))
+      throw FileWriterException("Zstd library was compiled without multi-threading support");
+    if (nthreads > bounds.upperBound)
+      throw FileWriterException(
+          fmt::format("Number of compression threads must be <= {}", bounds.upperBound));
+  }
+
+  nb_workers = nthreads;
+}
+
 #endif
@@ -23,6 +23,7 @@
 #include "file_writer.h"
 
 #include <string>
+#include <vector>
 #include <zstd.h>
 
 #if ZSTD_VERSION_NUMBER < 10400
@@ -34,11 +35,17 @@ namespace LAMMPS_NS {
 class ZstdFileWriter : public FileWriter {
   int compression_level;
   int checksum_flag;
+  int nb_workers;
+  bool stream_pending;
 
   ZSTD_CCtx *cctx;
+  ZSTD_CCtx *frame_cctx;
   FILE *fp;
   char *out_buffer;
   size_t out_buffer_size;
+  std::vector<char> frame_buffer;
+
+  void end_stream();
 
  public:
   ZstdFileWriter();
@@ -51,6 +58,10 @@ class ZstdFileWriter : public FileWriter {
 
   void setCompressionLevel(int level);
   void setChecksum(bool enabled);
+  void setThreads(int nthreads);
+
+  const std::vector<char> &compressFrame(const void *buffer, size_t length);
+  size_t writeFrame(const void *buffer, size_t length);
 };
 }    // namespace LAMMPS_NS
 
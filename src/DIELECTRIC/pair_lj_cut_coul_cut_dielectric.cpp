@@ -41,6 +41,7 @@ PairLJCutCoulCutDielectric::PairLJCutCoulCutDielectric(LAMMPS *_lmp) : PairLJCut
   epot = nullptr;
   nmax = 0;
   no_virial_fdotr_compute = 1;
+  overlap_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
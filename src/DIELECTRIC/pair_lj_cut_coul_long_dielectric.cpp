@@ -46,6 +46,7 @@ PairLJCutCoulLongDielectric::PairLJCutCoulLongDielectric(LAMMPS *_lmp) : PairLJC
   epot = nullptr;
   nmax = 0;
   no_virial_fdotr_compute = 1;
+  overlap_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
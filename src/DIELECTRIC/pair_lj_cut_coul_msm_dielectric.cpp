@@ -42,6 +42,7 @@ PairLJCutCoulMSMDielectric::PairLJCutCoulMSMDielectric(LAMMPS *_lmp) : PairLJCut
   ewaldflag = pppmflag = 0;
   msmflag = 1;
   respa_enable = 0;
+  overlap_enable = 0;
   cut_respa = nullptr;
 
   nmax = 0;
@@ -113,6 +113,7 @@ void PPPMElectrode::init()
   triclinic = domain->triclinic;
   if (triclinic) error->all(FLERR, "Cannot (yet) use PPPM/electrode with triclinic box ");
   if (domain->dimension == 2) error->all(FLERR, "Cannot use PPPM/electrode with 2d simulation");
+  if (r2c_flag) error->all(FLERR, "Cannot use PPPM/electrode with 'kspace_modify r2c yes'");
 
   if (!atom->q_flag) error->all(FLERR, "KSpace style requires atom attribute q");
 
@@ -1596,6 +1597,12 @@ void PPPMElectrode::set_grid_local()
   nfft = (nxhi_fft - nxlo_fft + 1) * (nyhi_fft - nylo_fft + 1) * (nzhi_fft - nzlo_fft + 1);
   int nfft_brick = (nxhi_in - nxlo_in + 1) * (nyhi_in - nylo_in + 1) * (nzhi_in - nzlo_in + 1);
   nfft_both = MAX(nfft, nfft_brick);
+
+  // K-space data always uses complex-to-complex FFTs
+
+  nxhi_kspace = nxhi_fft;
+  nfft_kspace = nfft;
+  ncomplex = nfft_both;
 }
 
 /* ----------------------------------------------------------------------
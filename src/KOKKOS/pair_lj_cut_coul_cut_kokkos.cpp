@@ -35,6 +35,7 @@ template<class DeviceType>
 PairLJCutCoulCutKokkos<DeviceType>::PairLJCutCoulCutKokkos(LAMMPS *lmp):PairLJCutCoulCut(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
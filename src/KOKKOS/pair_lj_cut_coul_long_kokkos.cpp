@@ -41,6 +41,7 @@ template<class DeviceType>
 PairLJCutCoulLongKokkos<DeviceType>::PairLJCutCoulLongKokkos(LAMMPS *lmp):PairLJCutCoulLong(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
 
   kokkosable = 1;
   atomKK = (AtomKokkos *) atom;
@@ -24,7 +24,9 @@
 
 #include "remap.h"
 
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 
 #if defined(_OPENMP)
@@ -58,6 +60,86 @@
      with a fast-varying, mid-varying, and slow-varying index
 ------------------------------------------------------------------------- */
 
+/* ----------------------------------------------------------------------
+   Perform 1d FFTs along fast, mid, or slow axis of data in place
+   # and length of the 1d FFTs are set by the plan
+------------------------------------------------------------------------- */
+
+static void fft_1d_fast(FFT_DATA *data, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  if (flag == 1)
+    DftiComputeForward(plan->handle_fast,data);
+  else
+    DftiComputeBackward(plan->handle_fast,data);
+#elif defined(FFT_FFTW3)
+  if (flag == 1)
+    FFTW_API(execute_dft)(plan->plan_fast_forward,data,data);
+  else
+    FFTW_API(execute_dft)(plan->plan_fast_backward,data,data);
+#else
+  int total = plan->total1;
+  int length = plan->length1;
+
+  if (flag == 1)
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
+  else
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
+#endif
+}
+
+static void fft_1d_mid(FFT_DATA *data, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  if (flag == 1)
+    DftiComputeForward(plan->handle_mid,data);
+  else
+    DftiComputeBackward(plan->handle_mid,data);
+#elif defined(FFT_FFTW3)
+  if (flag == 1)
+    FFTW_API(execute_dft)(plan->plan_mid_forward,data,data);
+  else
+    FFTW_API(execute_dft)(plan->plan_mid_backward,data,data);
+#else
+  int total = plan->total2;
+  int length = plan->length2;
+
+  if (flag == 1)
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
+  else
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
+#endif
+}
+
+static void fft_1d_slow(FFT_DATA *data, int flag, struct fft_plan_3d *plan)
+{
+#if defined(FFT_MKL)
+  if (flag == 1)
+    DftiComputeForward(plan->handle_slow,data);
+  else
+    DftiComputeBackward(plan->handle_slow,data);
+#elif defined(FFT_FFTW3)
+  if (flag == 1)
+    FFTW_API(execute_dft)(plan->plan_slow_forward,data,data);
+  else
+    FFTW_API(execute_dft)(plan->plan_slow_backward,data,data);
+#else
+  int total = plan->total3;
+  int length = plan->length3;
+
+  if (flag == 1)
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
+  else
+    for (int offset = 0; offset < total; offset += length)
+      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
+#endif
+}
+
 /* ----------------------------------------------------------------------
    Perform 3d FFT
 
@@ -77,14 +159,6 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 #endif
   FFT_DATA *data,*copy;
 
-  // system specific constants
-
-#if defined(FFT_FFTW3)
-  FFTW_API(plan) theplan;
-#else
-  // nothing to do for other FFTs
-#endif
-
   // pre-remap to prepare for 1st FFTs if needed
   // copy = loc for remap result
 
@@ -100,28 +174,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along fast axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_fast,data);
-  else
-    DftiComputeBackward(plan->handle_fast,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_fast_forward;
-  else
-    theplan=plan->plan_fast_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  int total = plan->total1;
-  int length = plan->length1;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_fast_backward,&data[offset],&data[offset]);
-#endif
+  fft_1d_fast(data,flag,plan);
 
   // 1st mid-remap to prepare for 2nd FFTs
   // copy = loc for remap result
@@ -134,28 +187,7 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along mid axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_mid,data);
-  else
-    DftiComputeBackward(plan->handle_mid,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_mid_forward;
-  else
-    theplan=plan->plan_mid_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
-#else
-  total = plan->total2;
-  length = plan->length2;
-
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_mid_backward,&data[offset],&data[offset]);
-#endif
+  fft_1d_mid(data,flag,plan);
 
   // 2nd mid-remap to prepare for 3rd FFTs
   // copy = loc for remap result
@@ -168,57 +200,585 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 
   // 1d FFTs along slow axis
 
-#if defined(FFT_MKL)
-  if (flag == 1)
-    DftiComputeForward(plan->handle_slow,data);
+  fft_1d_slow(data,flag,plan);
+
+  // post-remap to put data in output format if needed
+  // destination is always out
+
+  if (plan->post_plan)
+    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+             (FFT_SCALAR *) plan->scratch, plan->post_plan);
+
+  // scaling if required
+
+  if (flag == -1 && plan->scaled) {
+    norm = plan->norm;
+    const int num = plan->normnum;
+#if defined(FFT_FFTW3)
+    out_ptr = (FFT_SCALAR *)out;
+#endif
+    for (int i = 0; i < num; i++) {
+#if defined(FFT_FFTW3)
+      *(out_ptr++) *= norm;
+      *(out_ptr++) *= norm;
+#elif defined(FFT_MKL)
+      out[i].real *= norm;
+      out[i].imag *= norm;
+#else  /* FFT_KISS */
+      out[i].re *= norm;
+      out[i].im *= norm;
+#endif
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   1d FFTs of one data set of fft_3d_batch(), called by remap_3d_batch()
+     once the remap of the data set is complete
+------------------------------------------------------------------------- */
+
+struct fft_batch_stage {
+  struct fft_plan_3d *plan;
+  int flag;
+  void (*fft1d)(FFT_DATA *, int, struct fft_plan_3d *);
+};
+
+static void fft_batch_ready(FFT_SCALAR *data, void *ptr)
+{
+  auto stage = (struct fft_batch_stage *) ptr;
+  stage->fft1d((FFT_DATA *) data,stage->flag,stage->plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform nbatch 3d FFTs in place
+
+   Arguments:
+   data         starting address of 1st data set on this proc,
+                  data set i starts at data + i*plan->batch_stride
+   nbatch       # of data sets
+   flag         1 for forward FFT, -1 for backward FFT
+   plan         plan returned by previous call to fft_3d_create_plan
+
+   with non-blocking remaps, the remaps of all data sets are done
+     together and the 1d FFTs of each data set start as soon as
+     its remap is complete, while the others are still in flight
+------------------------------------------------------------------------- */
+
+void fft_3d_batch(FFT_DATA *data, int nbatch, int flag, struct fft_plan_3d *plan)
+{
+  int i;
+  const int stride = plan->batch_stride;
+  auto scratch = (FFT_SCALAR *) plan->scratch;
+  struct fft_batch_stage stage;
+
+  stage.plan = plan;
+  stage.flag = flag;
+
+  // pre-remap if needed and 1d FFTs along fast axis
+
+  stage.fft1d = fft_1d_fast;
+  if (plan->pre_plan)
+    remap_3d_batch((FFT_SCALAR *) data,nbatch,2*stride,scratch,plan->pre_plan,
+                   fft_batch_ready,&stage);
   else
-    DftiComputeBackward(plan->handle_slow,data);
-#elif defined(FFT_FFTW3)
-  if (flag == 1)
-    theplan=plan->plan_slow_forward;
+    for (i = 0; i < nbatch; i++) fft_1d_fast(&data[(size_t) i*stride],flag,plan);
+
+  // 1st mid-remap and 1d FFTs along mid axis
+
+  stage.fft1d = fft_1d_mid;
+  remap_3d_batch((FFT_SCALAR *) data,nbatch,2*stride,scratch,plan->mid1_plan,
+                 fft_batch_ready,&stage);
+
+  // 2nd mid-remap and 1d FFTs along slow axis
+
+  stage.fft1d = fft_1d_slow;
+  remap_3d_batch((FFT_SCALAR *) data,nbatch,2*stride,scratch,plan->mid2_plan,
+                 fft_batch_ready,&stage);
+
+  // post-remap to put data in output format if needed
+
+  if (plan->post_plan)
+    remap_3d_batch((FFT_SCALAR *) data,nbatch,2*stride,scratch,plan->post_plan,
+                   nullptr,nullptr);
+
+  // scaling if required
+
+  if (flag == -1 && plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = 2*plan->normnum;
+    for (i = 0; i < nbatch; i++) {
+      auto one = (FFT_SCALAR *) &data[(size_t) i*stride];
+      for (int j = 0; j < num; j++) one[j] *= norm;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Perform real-to-complex 1d FFTs along fast axis
+   pairs of real data sets are packed as real and imaginary part into
+     one complex data set, after the FFT their spectra are separated
+     using the Hermitian symmetry of the FFT of real data
+   only the half 0 to nfast/2 of each spectrum is stored in half
+   half can be the same memory as real
+------------------------------------------------------------------------- */
+
+static void fft_1d_r2c(FFT_SCALAR *real, FFT_DATA *half, struct fft_plan_3d *plan)
+{
+  const int n = plan->length1;
+  const int nhalf = n/2 + 1;
+  const int npencil = plan->npencil;
+  auto pair = (FFT_SCALAR *) plan->pairbuf;
+  auto out = (FFT_SCALAR *) half;
+  int i,k,m,ip;
+
+  for (ip = 0; ip < npencil; ip += 2) {
+    const FFT_SCALAR *a = real + ip*n;
+    FFT_SCALAR *z = pair + ip*n;
+    if (ip+1 < npencil) {
+      const FFT_SCALAR *b = a + n;
+      for (i = 0; i < n; i++) {
+        z[2*i] = a[i];
+        z[2*i+1] = b[i];
+      }
+    } else {
+      for (i = 0; i < n; i++) {
+        z[2*i] = a[i];
+        z[2*i+1] = 0.0;
+      }
+    }
+  }
+
+  fft_1d_fast(plan->pairbuf,1,plan);
+
+  for (ip = 0; ip < npencil; ip += 2) {
+    const FFT_SCALAR *z = pair + ip*n;
+    FFT_SCALAR *ha = out + 2*ip*nhalf;
+    FFT_SCALAR *hb = ha + 2*nhalf;
+    const int both = (ip+1 < npencil);
+    for (k = 0; k < nhalf; k++) {
+      m = (k == 0) ? 0 : n-k;
+      ha[2*k] = 0.5*(z[2*k] + z[2*m]);
+      ha[2*k+1] = 0.5*(z[2*k+1] - z[2*m+1]);
+      if (both) {
+        hb[2*k] = 0.5*(z[2*k+1] + z[2*m+1]);
+        hb[2*k+1] = 0.5*(z[2*m] - z[2*k]);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Perform complex-to-real 1d FFTs along fast axis
+   inverse of fft_1d_r2c(), the full spectrum of two real data sets
+     is rebuilt from their halves and transformed as one complex set
+   imaginary parts at 0 and nfast/2 are ignored, so the result is
+     the real part of the FFT of any non-Hermitian input
+   real can be the same memory as half
+------------------------------------------------------------------------- */
+
+static void fft_1d_c2r(FFT_DATA *half, FFT_SCALAR *real, struct fft_plan_3d *plan)
+{
+  const int n = plan->length1;
+  const int nhalf = n/2 + 1;
+  const int npencil = plan->npencil;
+  auto pair = (FFT_SCALAR *) plan->pairbuf;
+  auto in = (FFT_SCALAR *) half;
+  FFT_SCALAR ar,ai,br,bi;
+  int i,k,m,ip;
+
+  for (ip = 0; ip < npencil; ip += 2) {
+    const FFT_SCALAR *ha = in + 2*ip*nhalf;
+    const FFT_SCALAR *hb = ha + 2*nhalf;
+    const int both = (ip+1 < npencil);
+    FFT_SCALAR *z = pair + ip*n;
+    for (k = 0; k < nhalf; k++) {
+      ar = ha[2*k];
+      br = both ? hb[2*k] : 0.0;
+      if (k == 0 || 2*k == n) {
+        ai = bi = 0.0;
+      } else {
+        ai = ha[2*k+1];
+        bi = both ? hb[2*k+1] : 0.0;
+        m = n-k;
+        z[2*m] = ar + bi;
+        z[2*m+1] = br - ai;
+      }
+      z[2*k] = ar - bi;
+      z[2*k+1] = ai + br;
+    }
+  }
+
+  fft_1d_fast(plan->pairbuf,-1,plan);
+
+  for (ip = 0; ip < npencil; ip += 2) {
+    const FFT_SCALAR *z = pair + ip*n;
+    FFT_SCALAR *a = real + ip*n;
+    if (ip+1 < npencil) {
+      FFT_SCALAR *b = a + n;
+      for (i = 0; i < n; i++) {
+        a[i] = z[2*i];
+        b[i] = z[2*i+1];
+      }
+    } else {
+      for (i = 0; i < n; i++) a[i] = z[2*i];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d real-to-complex FFT, always forward
+
+   Arguments:
+   in           starting address of real input data on this proc
+   out          starting address of where complex output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_real
+                  with flag = 1
+------------------------------------------------------------------------- */
+
+void fft_3d_r2c(FFT_SCALAR *in, FFT_DATA *out, struct fft_plan_3d *plan)
+{
+  FFT_SCALAR *real;
+  FFT_DATA *data,*copy;
+
+  // pre-remap of real data to prepare for 1st FFTs if needed
+
+  if (plan->pre_plan) {
+    remap_3d(in, plan->realbuf, (FFT_SCALAR *) plan->scratch, plan->pre_plan);
+    real = plan->realbuf;
+  }
   else
-    theplan=plan->plan_slow_backward;
-  FFTW_API(execute_dft)(theplan,data,data);
+    real = in;
+
+  // real-to-complex 1d FFTs along fast axis
+  // copy = loc for result
+
+  if (plan->pre_target == 0) copy = out;
+  else copy = plan->copy;
+  fft_1d_r2c(real,copy,plan);
+  data = copy;
+
+  // remaining FFTs and remaps are the same as for a complex 3d FFT
+
+  if (plan->mid1_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  fft_1d_mid(data,1,plan);
+
+  if (plan->mid2_target == 0) copy = out;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  fft_1d_slow(data,1,plan);
+
+  if (plan->post_plan)
+    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
+             (FFT_SCALAR *) plan->scratch, plan->post_plan);
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d complex-to-real FFT, always backward
+   FFTs are done along slow, mid, and finally fast axis
+
+   Arguments:
+   in           starting address of complex input data on this proc,
+                  is overwritten
+   out          starting address of where real output data for this proc
+                  will be placed (can be same as in)
+   plan         plan returned by previous call to fft_3d_create_plan_real
+                  with flag = -1
+------------------------------------------------------------------------- */
+
+void fft_3d_c2r(FFT_DATA *in, FFT_SCALAR *out, struct fft_plan_3d *plan)
+{
+  FFT_DATA *data,*copy;
+  FFT_SCALAR *real;
+
+  // remap to prepare for 1d FFTs along slow axis
+  // copy = loc for remap result, input memory is re-used if big enough
+
+  if (plan->pre_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) in, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->pre_plan);
+  data = copy;
+
+  fft_1d_slow(data,-1,plan);
+
+  if (plan->mid2_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid2_plan);
+  data = copy;
+
+  fft_1d_mid(data,-1,plan);
+
+  if (plan->mid1_target == 0) copy = in;
+  else copy = plan->copy;
+  remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) copy,
+           (FFT_SCALAR *) plan->scratch, plan->mid1_plan);
+  data = copy;
+
+  // complex-to-real 1d FFTs along fast axis
+  // post-remap of real data to put it in output format if needed
+
+  if (plan->post_plan) real = plan->realbuf;
+  else real = out;
+  fft_1d_c2r(data,real,plan);
+
+  if (plan->post_plan)
+    remap_3d(real, out, (FFT_SCALAR *) plan->scratch, plan->post_plan);
+
+  // scaling if required
+
+  if (plan->scaled) {
+    const FFT_SCALAR norm = plan->norm;
+    const int num = plan->normnum;
+    for (int i = 0; i < num; i++) out[i] *= norm;
+  }
+}
+
+#if defined(FFT_FFTW3)
+
+/* ----------------------------------------------------------------------
+   optional FFTW wisdom file set by the LAMMPS_FFTW_WISDOM environment
+     variable of proc 0, read once and updated when new plans were measured
+   without a wisdom file, plans are created with FFTW_ESTIMATE
+------------------------------------------------------------------------- */
+
+static int wisdom_read = 0;    // 1 if wisdom file was checked for
+static int wisdom_flag = 0;    // 1 if plans are measured and stored as wisdom
+static int wisdom_new = 0;     // 1 if plans were measured since the last save
+
+static void fftw_wisdom_load(MPI_Comm comm)
+{
+  int me,flag;
+  MPI_Comm_rank(comm,&me);
+  MPI_Allreduce(&wisdom_read,&flag,1,MPI_INT,MPI_MIN,comm);
+  if (flag) return;
+  wisdom_read = 1;
+
+  // proc 0 reads the file and broadcasts its content
+
+  const char *file = getenv("LAMMPS_FFTW_WISDOM");
+  long n = 0;
+  char *buf = nullptr;
+  if (me == 0 && file && file[0]) {
+    wisdom_flag = 1;
+    FILE *fp = fopen(file,"r");
+    if (fp) {
+      fseek(fp,0,SEEK_END);
+      n = ftell(fp);
+      if (n < 0) n = 0;
+      rewind(fp);
+      buf = (char *) malloc(n+1);
+      n = fread(buf,1,n,fp);
+      buf[n] = '\0';
+      fclose(fp);
+    }
+  }
+  MPI_Bcast(&wisdom_flag,1,MPI_INT,0,comm);
+  MPI_Bcast(&n,1,MPI_LONG,0,comm);
+  if (n > 0) {
+    if (me) buf = (char *) malloc(n+1);
+    MPI_Bcast(buf,n+1,MPI_CHAR,0,comm);
+    FFTW_API(import_wisdom_from_string)(buf);
+  }
+  free(buf);
+}
+
+/* ----------------------------------------------------------------------
+   if any proc measured new plans, merge the wisdom of all procs
+     on proc 0 and write it to the wisdom file
+------------------------------------------------------------------------- */
+
+static void fftw_wisdom_save(MPI_Comm comm)
+{
+  int me,nprocs,flag;
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+  MPI_Allreduce(&wisdom_new,&flag,1,MPI_INT,MPI_MAX,comm);
+  if (!flag) return;
+  wisdom_new = 0;
+
+  char *mine = FFTW_API(export_wisdom_to_string)();
+  int len = strlen(mine) + 1;
+  int *recvcounts = nullptr;
+  int *displs = nullptr;
+  char *all = nullptr;
+  if (me == 0) {
+    recvcounts = (int *) malloc(nprocs*sizeof(int));
+    displs = (int *) malloc(nprocs*sizeof(int));
+  }
+  MPI_Gather(&len,1,MPI_INT,recvcounts,1,MPI_INT,0,comm);
+  if (me == 0) {
+    int total = 0;
+    for (int i = 0; i < nprocs; i++) {
+      displs[i] = total;
+      total += recvcounts[i];
+    }
+    all = (char *) malloc(total);
+  }
+  MPI_Gatherv(mine,len,MPI_CHAR,all,recvcounts,displs,MPI_CHAR,0,comm);
+  FFTW_API(free)(mine);
+
+  if (me == 0) {
+    for (int i = 1; i < nprocs; i++)
+      FFTW_API(import_wisdom_from_string)(&all[displs[i]]);
+    const char *file = getenv("LAMMPS_FFTW_WISDOM");
+    if (file) FFTW_API(export_wisdom_to_filename)(file);
+    free(all);
+    free(displs);
+    free(recvcounts);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   create plan for howmany in-place 1d FFTs of length n
+   work is only used for measuring and may be a null pointer otherwise
+------------------------------------------------------------------------- */
+
+static FFTW_API(plan) fft_1d_plan(int n, int howmany, FFT_DATA *work, int direction)
+{
+  if (wisdom_flag) {
+    FFTW_API(plan) p = FFTW_API(plan_many_dft)(1,&n,howmany,work,&n,1,n,work,&n,1,n,
+                                               direction,FFTW_MEASURE|FFTW_WISDOM_ONLY);
+    if (p) return p;
+    wisdom_new = 1;
+    return FFTW_API(plan_many_dft)(1,&n,howmany,work,&n,1,n,work,&n,1,n,
+                                   direction,FFTW_MEASURE);
+  }
+  return FFTW_API(plan_many_dft)(1,&n,howmany,nullptr,&n,1,n,nullptr,&n,1,n,
+                                 direction,FFTW_ESTIMATE);
+}
+
+#endif
+
+/* ----------------------------------------------------------------------
+   system specific pre-computation of 1d FFT coeffs
+   # and length of the 1d FFTs along each axis are taken from the plan
+   collective over comm when FFTW wisdom is used
+------------------------------------------------------------------------- */
+
+static void fft_1d_create(struct fft_plan_3d *plan, MPI_Comm comm)
+{
+  int nfast = plan->length1;
+  int nmid = plan->length2;
+  int nslow = plan->length3;
+
+  int nthreads;
+
+#if defined(_OPENMP)
+  // query OpenMP info.
+  // should have been initialized systemwide in Comm class constructor
+  nthreads = omp_get_max_threads();
 #else
-  total = plan->total3;
-  length = plan->length3;
+  nthreads = 1;
+#endif
+
+#if defined(FFT_MKL)
+  DftiCreateDescriptor( &(plan->handle_fast), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total1/nfast);
+  DftiSetValue(plan->handle_fast, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_fast, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
+  DftiSetValue(plan->handle_fast, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_fast);
+
+  DftiCreateDescriptor( &(plan->handle_mid), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total2/nmid);
+  DftiSetValue(plan->handle_mid, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_mid, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
+  DftiSetValue(plan->handle_mid, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_mid);
+
+  DftiCreateDescriptor( &(plan->handle_slow), FFT_MKL_PREC, DFTI_COMPLEX, 1,
+                        (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_TRANSFORMS,
+               (MKL_LONG)plan->total3/nslow);
+  DftiSetValue(plan->handle_slow, DFTI_PLACEMENT,DFTI_INPLACE);
+  DftiSetValue(plan->handle_slow, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
+  DftiSetValue(plan->handle_slow, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
+#if defined(FFT_MKL_THREADS)
+  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_USER_THREADS, nthreads);
+#endif
+  DftiCommitDescriptor(plan->handle_slow);
+
+#elif defined(FFT_FFTW3)
+#if defined(FFT_FFTW_THREADS)
+  if (nthreads > 1) {
+    FFTW_API(init_threads)();
+    FFTW_API(plan_with_nthreads)(nthreads);
+  }
+#endif
+
+  // with a wisdom file, plans are measured once and then taken from the wisdom
+
+  fftw_wisdom_load(comm);
+  FFT_DATA *work = nullptr;
+  if (wisdom_flag) {
+    int nwork = MAX(plan->total1,MAX(plan->total2,plan->total3));
+    work = (FFT_DATA *) FFTW_API(malloc)(MAX(nwork,1)*sizeof(FFT_DATA));
+  }
+
+  plan->plan_fast_forward =
+    fft_1d_plan(nfast,plan->total1/plan->length1,work,FFTW_FORWARD);
+  plan->plan_fast_backward =
+    fft_1d_plan(nfast,plan->total1/plan->length1,work,FFTW_BACKWARD);
+  plan->plan_mid_forward =
+    fft_1d_plan(nmid,plan->total2/plan->length2,work,FFTW_FORWARD);
+  plan->plan_mid_backward =
+    fft_1d_plan(nmid,plan->total2/plan->length2,work,FFTW_BACKWARD);
+  plan->plan_slow_forward =
+    fft_1d_plan(nslow,plan->total3/plan->length3,work,FFTW_FORWARD);
+  plan->plan_slow_backward =
+    fft_1d_plan(nslow,plan->total3/plan->length3,work,FFTW_BACKWARD);
 
-  if (flag == 1)
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_forward,&data[offset],&data[offset]);
-  else
-    for (int offset = 0; offset < total; offset += length)
-      kiss_fft(plan->cfg_slow_backward,&data[offset],&data[offset]);
-#endif
+  if (work) FFTW_API(free)(work);
+  fftw_wisdom_save(comm);
 
-  // post-remap to put data in output format if needed
-  // destination is always out
+#else /* FFT_KISS */
 
-  if (plan->post_plan)
-    remap_3d((FFT_SCALAR *) data, (FFT_SCALAR *) out,
-             (FFT_SCALAR *) plan->scratch, plan->post_plan);
+  plan->cfg_fast_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
+  plan->cfg_fast_backward = kiss_fft_alloc(nfast,1,nullptr,nullptr);
 
-  // scaling if required
+  if (nmid == nfast) {
+    plan->cfg_mid_forward = plan->cfg_fast_forward;
+    plan->cfg_mid_backward = plan->cfg_fast_backward;
+  }
+  else {
+    plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
+    plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
+  }
 
-  if (flag == -1 && plan->scaled) {
-    norm = plan->norm;
-    const int num = plan->normnum;
-#if defined(FFT_FFTW3)
-    out_ptr = (FFT_SCALAR *)out;
-#endif
-    for (int i = 0; i < num; i++) {
-#if defined(FFT_FFTW3)
-      *(out_ptr++) *= norm;
-      *(out_ptr++) *= norm;
-#elif defined(FFT_MKL)
-      out[i].real *= norm;
-      out[i].imag *= norm;
-#else  /* FFT_KISS */
-      out[i].re *= norm;
-      out[i].im *= norm;
-#endif
-    }
+  if (nslow == nfast) {
+    plan->cfg_slow_forward = plan->cfg_fast_forward;
+    plan->cfg_slow_backward = plan->cfg_fast_backward;
   }
+  else if (nslow == nmid) {
+    plan->cfg_slow_forward = plan->cfg_mid_forward;
+    plan->cfg_slow_backward = plan->cfg_mid_backward;
+  }
+  else {
+    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
+    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
+  }
+
+#endif
 }
 
 /* ----------------------------------------------------------------------
@@ -251,12 +811,12 @@ struct fft_plan_3d *fft_3d_create_plan(
        int scaled, int permute, int *nbuf, int usecollective)
 {
   struct fft_plan_3d *plan;
-  int me,nprocs,nthreads;
+  int me,nprocs;
   int flag,remapflag;
   int first_ilo,first_ihi,first_jlo,first_jhi,first_klo,first_khi;
   int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
   int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
-  int out_size,first_size,second_size,third_size,copy_size,scratch_size;
+  int in_size,out_size,first_size,second_size,third_size,copy_size,scratch_size;
   int np1,np2,ip1,ip2;
 
   // query MPI info
@@ -264,14 +824,6 @@ struct fft_plan_3d *fft_3d_create_plan(
   MPI_Comm_rank(comm,&me);
   MPI_Comm_size(comm,&nprocs);
 
-#if defined(_OPENMP)
-  // query OpenMP info.
-  // should have been initialized systemwide in Comm class constructor
-  nthreads = omp_get_max_threads();
-#else
-  nthreads = 1;
-#endif
-
   // compute division of procs in 2 dimensions not on-processor
 
   bifactor(nprocs,&np1,&np2);
@@ -282,6 +834,9 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
   if (plan == nullptr) return nullptr;
+  plan->npencil = 0;
+  plan->realbuf = nullptr;
+  plan->pairbuf = nullptr;
 
   // remap from initial distribution to layout needed for 1st set of 1d FFTs
   // not needed if all procs own entire fast axis initially
@@ -475,121 +1030,307 @@ struct fft_plan_3d *fft_3d_create_plan(
   }
   else plan->scratch = nullptr;
 
+  // batch_stride = room for one data set in all stages of fft_3d_batch()
+  // padded to a multiple of 8 to keep alignment of all data sets the same
+
+  in_size = (in_ihi-in_ilo+1) * (in_jhi-in_jlo+1) * (in_khi-in_klo+1);
+  plan->batch_stride = MAX(MAX(in_size,out_size),
+                           MAX(first_size,MAX(second_size,third_size)));
+  plan->batch_stride = (plan->batch_stride+7)/8 * 8;
+
   // system specific pre-computation of 1d FFT coeffs
   // and scaling normalization
 
-#if defined(FFT_MKL)
-  DftiCreateDescriptor( &(plan->handle_fast), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nfast);
-  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total1/nfast);
-  DftiSetValue(plan->handle_fast, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_fast, DFTI_INPUT_DISTANCE, (MKL_LONG)nfast);
-  DftiSetValue(plan->handle_fast, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nfast);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_fast, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_fast);
+  fft_1d_create(plan,comm);
 
-  DftiCreateDescriptor( &(plan->handle_mid), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nmid);
-  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total2/nmid);
-  DftiSetValue(plan->handle_mid, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_mid, DFTI_INPUT_DISTANCE, (MKL_LONG)nmid);
-  DftiSetValue(plan->handle_mid, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nmid);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_mid, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_mid);
+  if (scaled == 0)
+    plan->scaled = 0;
+  else {
+    plan->scaled = 1;
+    plan->norm = 1.0/(nfast*nmid*nslow);
+    plan->normnum = (out_ihi-out_ilo+1) * (out_jhi-out_jlo+1) *
+      (out_khi-out_klo+1);
+  }
 
-  DftiCreateDescriptor( &(plan->handle_slow), FFT_MKL_PREC, DFTI_COMPLEX, 1,
-                        (MKL_LONG)nslow);
-  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_TRANSFORMS,
-               (MKL_LONG)plan->total3/nslow);
-  DftiSetValue(plan->handle_slow, DFTI_PLACEMENT,DFTI_INPLACE);
-  DftiSetValue(plan->handle_slow, DFTI_INPUT_DISTANCE, (MKL_LONG)nslow);
-  DftiSetValue(plan->handle_slow, DFTI_OUTPUT_DISTANCE, (MKL_LONG)nslow);
-#if defined(FFT_MKL_THREADS)
-  DftiSetValue(plan->handle_slow, DFTI_NUMBER_OF_USER_THREADS, nthreads);
-#endif
-  DftiCommitDescriptor(plan->handle_slow);
+  return plan;
+}
 
-#elif defined(FFT_FFTW3)
-#if defined(FFT_FFTW_THREADS)
-  if (nthreads > 1) {
-    FFTW_API(init_threads)();
-    FFTW_API(plan_with_nthreads)(nthreads);
+/* ----------------------------------------------------------------------
+   Create plan for performing a 3d real-to-complex or complex-to-real FFT
+
+   Arguments:
+   comm                 MPI communicator for the P procs which own the data
+   nfast,nmid,nslow     size of global 3d matrix of real data
+   in_ilo,in_ihi        input bounds of data I own in fast index
+   in_jlo,in_jhi        input bounds of data I own in mid index
+   in_klo,in_khi        input bounds of data I own in slow index
+   out_ilo,out_ihi      output bounds of data I own in fast index
+   out_jlo,out_jhi      output bounds of data I own in mid index
+   out_klo,out_khi      output bounds of data I own in slow index
+   scaled               0 = no scaling of result, 1 = scaling
+   flag                 1 = forward real-to-complex FFT
+                          input is real, output is complex
+                       -1 = backward complex-to-real FFT
+                          input is complex, output is real
+   nbuf                 returns size of internal storage buffers used by FFT
+   usecollective        use collective MPI operations for remapping data
+
+   the complex data only covers the fast index 0 to nfast/2,
+     the other half follows from Hermitian symmetry
+   there is no permutation of indices on output
+------------------------------------------------------------------------- */
+
+struct fft_plan_3d *fft_3d_create_plan_real(
+       MPI_Comm comm, int nfast, int nmid, int nslow,
+       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+       int in_klo, int in_khi,
+       int out_ilo, int out_ihi, int out_jlo, int out_jhi,
+       int out_klo, int out_khi,
+       int scaled, int flag, int *nbuf, int usecollective)
+{
+  struct fft_plan_3d *plan;
+  int me,nprocs;
+  int remap,remapflag;
+  int real_ilo,real_ihi,real_jlo,real_jhi,real_klo,real_khi;
+  int cplx_ilo,cplx_ihi,cplx_jlo,cplx_jhi,cplx_klo,cplx_khi;
+  int first_jlo,first_jhi,first_klo,first_khi;
+  int second_ilo,second_ihi,second_jlo,second_jhi,second_klo,second_khi;
+  int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
+  int real_size,cplx_size,first_size,second_size,third_size;
+  int copy_size,scratch_size,pair_size,realbuf_size;
+  int np1,np2,ip1,ip2;
+
+  // query MPI info
+
+  MPI_Comm_rank(comm,&me);
+  MPI_Comm_size(comm,&nprocs);
+
+  // compute division of procs in 2 dimensions not on-processor
+
+  bifactor(nprocs,&np1,&np2);
+  ip1 = me % np1;
+  ip2 = me/np1;
+
+  // only half of the complex data along the fast axis is stored
+
+  const int nhalf = nfast/2 + 1;
+
+  // bounds of real and complex data I own
+
+  if (flag == 1) {
+    real_ilo = in_ilo; real_ihi = in_ihi;
+    real_jlo = in_jlo; real_jhi = in_jhi;
+    real_klo = in_klo; real_khi = in_khi;
+    cplx_ilo = out_ilo; cplx_ihi = out_ihi;
+    cplx_jlo = out_jlo; cplx_jhi = out_jhi;
+    cplx_klo = out_klo; cplx_khi = out_khi;
+  } else {
+    real_ilo = out_ilo; real_ihi = out_ihi;
+    real_jlo = out_jlo; real_jhi = out_jhi;
+    real_klo = out_klo; real_khi = out_khi;
+    cplx_ilo = in_ilo; cplx_ihi = in_ihi;
+    cplx_jlo = in_jlo; cplx_jhi = in_jhi;
+    cplx_klo = in_klo; cplx_khi = in_khi;
   }
-#endif
 
-  plan->plan_fast_forward =
-    FFTW_API(plan_many_dft)(1, &nfast,plan->total1/plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_fast_backward =
-    FFTW_API(plan_many_dft)(1, &nfast,plan->total1/plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            nullptr,&nfast,1,plan->length1,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
-  plan->plan_mid_forward =
-    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_mid_backward =
-    FFTW_API(plan_many_dft)(1, &nmid,plan->total2/plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            nullptr,&nmid,1,plan->length2,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
-  plan->plan_slow_forward =
-    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            FFTW_FORWARD,FFTW_ESTIMATE);
-  plan->plan_slow_backward =
-    FFTW_API(plan_many_dft)(1, &nslow,plan->total3/plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            nullptr,&nslow,1,plan->length3,
-                            FFTW_BACKWARD,FFTW_ESTIMATE);
+  // allocate memory for plan data struct
 
-#else /* FFT_KISS */
+  plan = (struct fft_plan_3d *) malloc(sizeof(struct fft_plan_3d));
+  if (plan == nullptr) return nullptr;
+  plan->pre_plan = plan->mid1_plan = plan->mid2_plan = plan->post_plan = nullptr;
+  plan->realbuf = nullptr;
+  plan->pairbuf = nullptr;
+  plan->batch_stride = 0;
 
-  plan->cfg_fast_forward = kiss_fft_alloc(nfast,0,nullptr,nullptr);
-  plan->cfg_fast_backward = kiss_fft_alloc(nfast,1,nullptr,nullptr);
+  // remap of real data between its distribution and full pencils along fast axis
+  // not needed if all procs own entire fast axis
+  // first indices = distribution of 1d FFTs along fast axis
 
-  if (nmid == nfast) {
-    plan->cfg_mid_forward = plan->cfg_fast_forward;
-    plan->cfg_mid_backward = plan->cfg_fast_backward;
+  if (real_ilo == 0 && real_ihi == nfast-1)
+    remap = 0;
+  else
+    remap = 1;
+
+  MPI_Allreduce(&remap,&remapflag,1,MPI_INT,MPI_MAX,comm);
+
+  struct remap_plan_3d *real_plan = nullptr;
+  if (remapflag == 0) {
+    first_jlo = real_jlo;
+    first_jhi = real_jhi;
+    first_klo = real_klo;
+    first_khi = real_khi;
+  } else {
+    first_jlo = ip1*nmid/np1;
+    first_jhi = (ip1+1)*nmid/np1 - 1;
+    first_klo = ip2*nslow/np2;
+    first_khi = (ip2+1)*nslow/np2 - 1;
+    if (flag == 1)
+      real_plan = remap_3d_create_plan(comm,real_ilo,real_ihi,real_jlo,real_jhi,
+                                       real_klo,real_khi,0,nfast-1,first_jlo,first_jhi,
+                                       first_klo,first_khi,1,0,0,FFT_PRECISION,0);
+    else
+      real_plan = remap_3d_create_plan(comm,0,nfast-1,first_jlo,first_jhi,
+                                       first_klo,first_khi,real_ilo,real_ihi,
+                                       real_jlo,real_jhi,real_klo,real_khi,
+                                       1,0,0,FFT_PRECISION,0);
+    if (real_plan == nullptr) return nullptr;
   }
-  else {
-    plan->cfg_mid_forward = kiss_fft_alloc(nmid,0,nullptr,nullptr);
-    plan->cfg_mid_backward = kiss_fft_alloc(nmid,1,nullptr,nullptr);
+
+  // second indices = distribution of 1d FFTs along mid axis
+  // third indices = distribution of 1d FFTs along slow axis
+
+  second_ilo = ip1*nhalf/np1;
+  second_ihi = (ip1+1)*nhalf/np1 - 1;
+  second_jlo = 0;
+  second_jhi = nmid - 1;
+  second_klo = ip2*nslow/np2;
+  second_khi = (ip2+1)*nslow/np2 - 1;
+
+  third_ilo = ip1*nhalf/np1;
+  third_ihi = (ip1+1)*nhalf/np1 - 1;
+  third_jlo = ip2*nmid/np2;
+  third_jhi = (ip2+1)*nmid/np2 - 1;
+  third_klo = 0;
+  third_khi = nslow - 1;
+
+  // forward: real pre-remap, then like a complex 3d FFT without permutation
+  // backward: same layouts in reverse order with inverse permutations
+
+  if (flag == 1) {
+    plan->pre_plan = real_plan;
+    plan->mid1_plan =
+      remap_3d_create_plan(comm,0,nhalf-1,first_jlo,first_jhi,first_klo,first_khi,
+                           second_ilo,second_ihi,second_jlo,second_jhi,
+                           second_klo,second_khi,2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid1_plan == nullptr) return nullptr;
+    plan->mid2_plan =
+      remap_3d_create_plan(comm,second_jlo,second_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,third_jlo,third_jhi,
+                           third_klo,third_khi,third_ilo,third_ihi,
+                           2,1,0,FFT_PRECISION,usecollective);
+    if (plan->mid2_plan == nullptr) return nullptr;
+    plan->post_plan =
+      remap_3d_create_plan(comm,third_klo,third_khi,third_ilo,third_ihi,
+                           third_jlo,third_jhi,cplx_klo,cplx_khi,cplx_ilo,cplx_ihi,
+                           cplx_jlo,cplx_jhi,2,1,0,FFT_PRECISION,0);
+    if (plan->post_plan == nullptr) return nullptr;
+  } else {
+    plan->pre_plan =
+      remap_3d_create_plan(comm,cplx_ilo,cplx_ihi,cplx_jlo,cplx_jhi,cplx_klo,cplx_khi,
+                           third_ilo,third_ihi,third_jlo,third_jhi,
+                           third_klo,third_khi,2,2,0,FFT_PRECISION,0);
+    if (plan->pre_plan == nullptr) return nullptr;
+    plan->mid2_plan =
+      remap_3d_create_plan(comm,third_klo,third_khi,third_ilo,third_ihi,
+                           third_jlo,third_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,second_jlo,second_jhi,
+                           2,2,0,FFT_PRECISION,usecollective);
+    if (plan->mid2_plan == nullptr) return nullptr;
+    plan->mid1_plan =
+      remap_3d_create_plan(comm,second_jlo,second_jhi,second_klo,second_khi,
+                           second_ilo,second_ihi,first_jlo,first_jhi,
+                           first_klo,first_khi,0,nhalf-1,
+                           2,2,0,FFT_PRECISION,usecollective);
+    if (plan->mid1_plan == nullptr) return nullptr;
+    plan->post_plan = real_plan;
   }
 
-  if (nslow == nfast) {
-    plan->cfg_slow_forward = plan->cfg_fast_forward;
-    plan->cfg_slow_backward = plan->cfg_fast_backward;
+  // 1d FFTs along fast axis are done on pairs of real data sets
+
+  plan->npencil = (first_jhi-first_jlo+1) * (first_khi-first_klo+1);
+  plan->length1 = nfast;
+  plan->total1 = nfast * ((plan->npencil+1)/2);
+
+  // 1d FFTs along mid and slow axis
+
+  plan->length2 = nmid;
+  plan->total2 = (second_ihi-second_ilo+1) * nmid * (second_khi-second_klo+1);
+  plan->length3 = nslow;
+  plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
+
+  // configure plan memory pointers and allocate work space
+  // cplx_size = amount of complex memory given to FFT by user
+  // real_size = amount of real memory given to FFT by user
+  // first/second/third_size = amount of complex memory needed
+  //   for 1d FFTs along fast/mid/slow axis
+  // copy_size = amount needed internally for extra copy of complex data
+  // scratch_size = amount needed internally for remap scratch space
+  // realbuf_size = amount needed for real data in full pencils, if remapped
+  // pair_size = amount needed for pairs of real data sets
+  // for each complex stage:
+  //   user complex space used for result if big enough, else require copy buffer
+
+  cplx_size = (cplx_ihi-cplx_ilo+1) * (cplx_jhi-cplx_jlo+1) * (cplx_khi-cplx_klo+1);
+  real_size = (real_ihi-real_ilo+1) * (real_jhi-real_jlo+1) * (real_khi-real_klo+1);
+  first_size = nhalf * plan->npencil;
+  second_size = (second_ihi-second_ilo+1) * (second_jhi-second_jlo+1) *
+    (second_khi-second_klo+1);
+  third_size = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) *
+    (third_khi-third_klo+1);
+
+  copy_size = 0;
+  scratch_size = MAX(second_size,third_size);
+
+  if (flag == 1) {
+    plan->pre_target = (first_size <= cplx_size) ? 0 : 1;
+    plan->mid1_target = (second_size <= cplx_size) ? 0 : 1;
+    plan->mid2_target = (third_size <= cplx_size) ? 0 : 1;
+    if (plan->pre_target) copy_size = MAX(copy_size,first_size);
+    if (plan->mid1_target) copy_size = MAX(copy_size,second_size);
+    if (plan->mid2_target) copy_size = MAX(copy_size,third_size);
+    scratch_size = MAX(scratch_size,cplx_size);
+  } else {
+    plan->pre_target = (third_size <= cplx_size) ? 0 : 1;
+    plan->mid2_target = (second_size <= cplx_size) ? 0 : 1;
+    plan->mid1_target = (first_size <= cplx_size) ? 0 : 1;
+    if (plan->pre_target) copy_size = MAX(copy_size,third_size);
+    if (plan->mid2_target) copy_size = MAX(copy_size,second_size);
+    if (plan->mid1_target) copy_size = MAX(copy_size,first_size);
+    scratch_size = MAX(scratch_size,first_size);
   }
-  else if (nslow == nmid) {
-    plan->cfg_slow_forward = plan->cfg_mid_forward;
-    plan->cfg_slow_backward = plan->cfg_mid_backward;
+
+  realbuf_size = 0;
+  if (real_plan) {
+    realbuf_size = nfast * plan->npencil;
+    scratch_size = MAX(scratch_size,(MAX(realbuf_size,real_size)+1)/2);
   }
-  else {
-    plan->cfg_slow_forward = kiss_fft_alloc(nslow,0,nullptr,nullptr);
-    plan->cfg_slow_backward = kiss_fft_alloc(nslow,1,nullptr,nullptr);
+  pair_size = plan->total1;
+
+  *nbuf = copy_size + scratch_size + pair_size + (realbuf_size+1)/2;
+
+  if (copy_size) {
+    plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_DATA));
+    if (plan->copy == nullptr) return nullptr;
+  }
+  else plan->copy = nullptr;
+
+  if (scratch_size) {
+    plan->scratch = (FFT_DATA *) malloc(scratch_size*sizeof(FFT_DATA));
+    if (plan->scratch == nullptr) return nullptr;
   }
+  else plan->scratch = nullptr;
 
-#endif
+  if (realbuf_size) {
+    plan->realbuf = (FFT_SCALAR *) malloc(realbuf_size*sizeof(FFT_SCALAR));
+    if (plan->realbuf == nullptr) return nullptr;
+  }
+
+  if (pair_size) {
+    plan->pairbuf = (FFT_DATA *) malloc(pair_size*sizeof(FFT_DATA));
+    if (plan->pairbuf == nullptr) return nullptr;
+  }
+
+  // system specific pre-computation of 1d FFT coeffs
+  // and scaling normalization of real output
+
+  fft_1d_create(plan,comm);
 
   if (scaled == 0)
     plan->scaled = 0;
   else {
-    plan->scaled = 1;
+    plan->scaled = (flag == -1) ? 1 : 0;
     plan->norm = 1.0/(nfast*nmid*nslow);
-    plan->normnum = (out_ihi-out_ilo+1) * (out_jhi-out_jlo+1) *
-      (out_khi-out_klo+1);
+    plan->normnum = real_size;
   }
 
   return plan;
@@ -608,6 +1349,8 @@ void fft_3d_destroy_plan(struct fft_plan_3d *plan)
 
   if (plan->copy) free(plan->copy);
   if (plan->scratch) free(plan->scratch);
+  if (plan->realbuf) free(plan->realbuf);
+  if (plan->pairbuf) free(plan->pairbuf);
 
 #if defined(FFT_MKL)
   DftiFreeDescriptor(&(plan->handle_fast));
@@ -103,6 +103,18 @@ struct fft_plan_3d {
   int normnum;    // # of values to rescale
   double norm;    // normalization factor for rescaling
 
+  int batch_stride;    // distance of data sets in fft_3d_batch(), 0 if not supported
+
+  // real-to-complex and complex-to-real FFTs only
+  // real data is transformed along the fast axis, two sets at a time,
+  //   as real and imaginary part of a complex 1d FFT of full length
+  // the complex data covers only the half 0 to nfast/2 of the fast axis
+  // complex-to-real FFTs remap in reverse order: pre, mid2, mid1, post
+
+  int npencil;            // # of real 1d data sets along fast axis
+  FFT_SCALAR *realbuf;    // memory for real data after/before remap
+  FFT_DATA *pairbuf;      // memory for pairs of real data sets
+
   // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
@@ -132,6 +144,11 @@ void fft_3d(FFT_DATA *, FFT_DATA *, int, struct fft_plan_3d *);
 struct fft_plan_3d *fft_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int, int,
                                        int, int, int, int, int, int, int, int *, int);
 void fft_3d_destroy_plan(struct fft_plan_3d *);
+void fft_3d_batch(FFT_DATA *, int, int, struct fft_plan_3d *);
+void fft_3d_r2c(FFT_SCALAR *, FFT_DATA *, struct fft_plan_3d *);
+void fft_3d_c2r(FFT_DATA *, FFT_SCALAR *, struct fft_plan_3d *);
+struct fft_plan_3d *fft_3d_create_plan_real(MPI_Comm, int, int, int, int, int, int, int, int, int,
+                                            int, int, int, int, int, int, int, int, int *, int);
 void factor(int, int *, int *);
 void bifactor(int, int *, int *);
 void fft_1d_only(FFT_DATA *, int, int, struct fft_plan_3d *);
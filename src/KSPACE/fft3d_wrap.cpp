@@ -14,28 +14,65 @@
 
 #include "fft3d_wrap.h"
 
+#include "comm.h"
 #include "error.h"
+#include "plan_cache.h"
 
 using namespace LAMMPS_NS;
 
-/* ---------------------------------------------------------------------- */
+#ifndef FFT_HEFFTE
+static void destroy_plan(void *ptr)
+{
+  fft_3d_destroy_plan((struct fft_plan_3d *) ptr);
+}
+#endif
+
+/* ----------------------------------------------------------------------
+   real = FORWARD creates a real-to-complex FFT,
+     real = BACKWARD a complex-to-real FFT,
+     the complex data then covers only nfast/2+1 values along the fast axis
+------------------------------------------------------------------------- */
 
 FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
              int in_ilo, int in_ihi, int in_jlo, int in_jhi,
              int in_klo, int in_khi,
              int out_ilo, int out_ihi, int out_jlo, int out_jhi,
              int out_klo, int out_khi,
-             int scaled, int permute, int *nbuf, int usecollective) : Pointers(lmp)
+             int scaled, int permute, int *nbuf, int usecollective,
+             int real) : Pointers(lmp), realflag(real)
 {
   #ifndef FFT_HEFFTE
-  plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
-                            in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
-                            out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
-                            scaled,permute,nbuf,usecollective);
+  if (realflag && permute)
+    error->all(FLERR,"Real-to-complex 3d FFT does not support permuted output");
+
+  // reuse a cached plan if one was created before with the same settings
+  // the key has a different length than those of Remap plans
+
+  std::vector<int> key = {nfast,nmid,nslow,
+                          in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                          out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                          scaled,permute,usecollective,realflag,
+                          lmp->comm->nthreads,(int) sizeof(FFT_SCALAR)};
+  plan = (struct fft_plan_3d *) PlanCache::acquire(comm,key,nbuf);
+  if (plan) return;
+
+  if (realflag) {
+    plan = fft_3d_create_plan_real(comm,nfast,nmid,nslow,
+                                   in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                                   out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                                   scaled,realflag,nbuf,usecollective);
+  } else {
+    plan = fft_3d_create_plan(comm,nfast,nmid,nslow,
+                              in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                              out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                              scaled,permute,nbuf,usecollective);
+  }
   if (plan == nullptr) error->one(FLERR,"Could not create 3d FFT plan");
+  PlanCache::insert(comm,key,plan,*nbuf,destroy_plan);
   #else
+  if (realflag) error->all(FLERR,"Real-to-complex 3d FFTs are not supported with heFFTe");
   heffte::plan_options options = heffte::default_options<heffte_backend>();
-  options.algorithm = (usecollective == 0) ?
+  options.algorithm = (usecollective != 1) ?
                           heffte::reshape_algorithm::p2p_plined
                         : heffte::reshape_algorithm::alltoallv;
   options.use_reorder = (permute != 0);
@@ -57,7 +94,7 @@ FFT3d::FFT3d(LAMMPS *lmp, MPI_Comm comm, int nfast, int nmid, int nslow,
 FFT3d::~FFT3d()
 {
   #ifndef FFT_HEFFTE
-  fft_3d_destroy_plan(plan);
+  PlanCache::release(plan);
   #endif
 }
 
@@ -66,7 +103,11 @@ FFT3d::~FFT3d()
 void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
 {
   #ifndef FFT_HEFFTE
-  fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
+  if (realflag) {
+    if (flag != realflag) error->one(FLERR,"Real-to-complex 3d FFT used in wrong direction");
+    if (flag == FORWARD) fft_3d_r2c(in,(FFT_DATA *) out,plan);
+    else fft_3d_c2r((FFT_DATA *) in,out,plan);
+  } else fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
   #else
   if (flag == 1)
       heffte_plan->forward(reinterpret_cast<std::complex<FFT_SCALAR>*>(in),
@@ -82,6 +123,35 @@ void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
   #endif
 }
 
+/* ----------------------------------------------------------------------
+   perform nbatch complex 3d FFTs in place
+   data set i starts at data + 2*i*batch_stride()
+------------------------------------------------------------------------- */
+
+void FFT3d::compute_batch(FFT_SCALAR *data, int nbatch, int flag)
+{
+  #ifndef FFT_HEFFTE
+  if (realflag) error->one(FLERR,"Real-to-complex 3d FFTs cannot be batched");
+  fft_3d_batch((FFT_DATA *) data,nbatch,flag,plan);
+  #else
+  error->one(FLERR,"Batched 3d FFTs are not supported with heFFTe");
+  #endif
+}
+
+/* ----------------------------------------------------------------------
+   # of complex values between data sets of compute_batch()
+   return 0 if batched FFTs are not supported
+------------------------------------------------------------------------- */
+
+int FFT3d::batch_stride()
+{
+  #ifndef FFT_HEFFTE
+  return plan->batch_stride;
+  #else
+  return 0;
+  #endif
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FFT3d::timing1d(FFT_SCALAR *in, int nsize, int flag)
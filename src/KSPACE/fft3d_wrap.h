@@ -37,12 +37,16 @@ class FFT3d : protected Pointers {
   enum { FORWARD = 1, BACKWARD = -1 };
 
   FFT3d(class LAMMPS *, MPI_Comm, int, int, int, int, int, int, int, int, int, int, int, int, int,
-        int, int, int, int, int *, int);
+        int, int, int, int, int *, int, int real = 0);
   ~FFT3d() override;
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
+  void compute_batch(FFT_SCALAR *, int, int);
+  int batch_stride();
   void timing1d(FFT_SCALAR *, int, int);
 
  private:
+  int realflag;    // 0 = complex FFT, FORWARD = real-to-complex, BACKWARD = complex-to-real
+
   #ifdef FFT_HEFFTE
   // the heFFTe plan supersedes the internal fft_plan_3d
   std::unique_ptr<heffte::fft3d<heffte_backend>> heffte_plan;
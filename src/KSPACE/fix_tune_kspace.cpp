@@ -18,8 +18,10 @@
 
 #include "fix_tune_kspace.h"
 
+#include "atom.h"
 #include "comm.h"
 #include "compute.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
 #include "info.h"
@@ -27,9 +29,11 @@
 #include "modify.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "text_file_reader.h"
 #include "timer.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <limits>
@@ -37,6 +41,10 @@
 
 #define SIGN(a,b) ((b) >= 0.0 ? fabs(a) : -fabs(a))
 static constexpr double GOLD = 1.618034;
+static constexpr int MAXORDER = 7;    // largest PPPM order
+static constexpr int NCUTOFF = 5;     // # of Coulomb cutoffs tested by PPPM search
+
+enum { STYLE, PPPM };
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -46,7 +54,7 @@ using namespace FixConst;
 FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg)
 {
-  if (narg < 3) error->all(FLERR,"Illegal fix tune/kspace command");
+  if (narg < 4) utils::missing_cmd_args(FLERR,"fix tune/kspace",error);
 
   global_freq = 1;
   firststep = 0;
@@ -64,6 +72,49 @@ FixTuneKspace::FixTuneKspace(LAMMPS *lmp, int narg, char **arg) :
   nevery = utils::inumeric(FLERR,arg[3],false,lmp);
   if (nevery <= 0) error->all(FLERR,"Illegal fix tune/kspace command");
 
+  search = STYLE;
+  order_min = 3;
+  order_max = MAXORDER;
+  cut_lo = 0.7;
+  cut_hi = 1.3;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"search") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace search",error);
+      if (strcmp(arg[iarg+1],"style") == 0) search = STYLE;
+      else if (strcmp(arg[iarg+1],"pppm") == 0) search = PPPM;
+      else error->all(FLERR,"Unknown fix tune/kspace search setting: {}",arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"order") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace order",error);
+      order_min = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
+      order_max = utils::inumeric(FLERR,arg[iarg+2],false,lmp);
+      if (order_min < 2 || order_max > MAXORDER || order_min > order_max)
+        error->all(FLERR,"Illegal fix tune/kspace order range {} {}",order_min,order_max);
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"cutoff") == 0) {
+      if (iarg+3 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace cutoff",error);
+      cut_lo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      cut_hi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      if (cut_lo <= 0.0 || cut_lo > cut_hi)
+        error->all(FLERR,"Illegal fix tune/kspace cutoff range {} {}",cut_lo,cut_hi);
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"cache") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/kspace cache",error);
+      cachefile = arg[iarg+1];
+      iarg += 2;
+    } else error->all(FLERR,"Unknown fix tune/kspace keyword: {}",arg[iarg]);
+  }
+
+  if (search != PPPM && (!cachefile.empty()))
+    error->all(FLERR,"Fix tune/kspace cache keyword requires search pppm");
+
+  tune_phase = 0;
+  need_baseline = 0;
+  trial_step = 0;
+  trial_start = base_cutoff = 0.0;
+
   // set up reneighboring
 
   force_reneighbor = 1;
@@ -96,6 +147,12 @@ void FixTuneKspace::init()
     error->all(FLERR,"Cannot use fix tune/kspace with TIP4P water");
   if (force->kspace->dipoleflag)
     error->all(FLERR,"Cannot use fix tune/kspace with dipole long-range solver");
+  if ((search == PPPM) && !utils::strmatch(force->kspace_style,"^pppm"))
+    error->all(FLERR,"Fix tune/kspace search pppm requires a PPPM kspace style");
+
+  // timers are reset at the start of each run, restart timing of the current trial
+
+  if (tune_phase > 0) need_baseline = 1;
 
   store_old_kspace_settings();
   double old_acc = force->kspace->accuracy/force->kspace->two_charge_force;
@@ -118,6 +175,11 @@ void FixTuneKspace::pre_exchange()
   if (next_reneighbor != update->ntimestep) return;
   next_reneighbor = update->ntimestep + nevery;
 
+  if (search == PPPM) {
+    tune_pppm();
+    return;
+  }
+
   auto info = new Info(lmp);
   bool has_msm = info->has_style("pair", base_pair_style + "/msm");
   delete info;
@@ -273,6 +335,15 @@ void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
   force->kspace->slabflag = old_slabflag;
   force->kspace->slab_volfactor = old_slab_volfactor;
 
+  reinit_styles();
+}
+
+/* ----------------------------------------------------------------------
+   re-initialize styles after the kspace or pair settings changed
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::reinit_styles()
+{
   // initialize new kspace style, pair style, molecular styles
 
   force->init();
@@ -288,6 +359,11 @@ void FixTuneKspace::update_kspace_style(const std::string &new_kspace_style,
 
   neighbor->init();
 
+  // ghost cutoff and bins must follow a changed Coulomb cutoff
+
+  comm->setup();
+  if (neighbor->style) neighbor->setup_bins();
+
   // Re-init computes to update pointers to virials, etc.
 
   for (int i = 0; i < modify->ncompute; i++) modify->compute[i]->init();
@@ -387,6 +463,257 @@ void FixTuneKspace::adjust_rcut(double time)
   update_kspace_style(kspace_style,acc_str);
 }
 
+/* ----------------------------------------------------------------------
+   joint search for the fastest PPPM order, differentiation, and Coulomb
+     cutoff at the requested accuracy, the mesh follows from these settings
+   each trial is timed over nevery steps, the search has 3 phases:
+     1 = all orders with ik and ad at the initial cutoff
+     2 = range of cutoffs with the best order and differentiation
+     3 = neighboring orders and the other differentiation at the best cutoff
+   the fastest trial is used for the rest of the run
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::tune_pppm()
+{
+  if (converged) return;
+
+  if (tune_phase == 0) {
+    base_cutoff = pair_cut_coul;
+    need_baseline = 0;
+
+    // reuse result of a previous tuning run for the same system
+
+    PPPMTrial cached;
+    if (read_cache(cached)) {
+      apply_pppm_trial(cached);
+      if (comm->me == 0)
+        utils::logmesg(lmp,"PPPM settings from fix tune/kspace cache file {}: order {} diff {} "
+                       "cutoff {:.8g} mesh {} {} {}\n", cachefile, cached.order,
+                       cached.diff ? "ad" : "ik", cached.cutoff, force->kspace->nx_pppm,
+                       force->kspace->ny_pppm, force->kspace->nz_pppm);
+      converged = true;
+      next_reneighbor = -1;
+      return;
+    }
+
+    tune_phase = 1;
+    next_pppm_phase();
+
+  } else if (need_baseline) {
+    trial_step = update->ntimestep;
+    trial_start = get_pppm_time();
+    need_baseline = 0;
+    return;
+
+  } else {
+    bigint nsteps = update->ntimestep - trial_step;
+    current.time = (get_pppm_time() - trial_start) / MAX(nsteps,1);
+    trials.push_back(current);
+    if (comm->me == 0)
+      utils::logmesg(lmp,"PPPM trial: order {} diff {} cutoff {:.8g} mesh {} {} {} "
+                     "time/step {:.8g}\n", current.order, current.diff ? "ad" : "ik",
+                     current.cutoff, current.nx, current.ny, current.nz, current.time);
+  }
+
+  while (pending.empty() && (tune_phase <= 3)) next_pppm_phase();
+
+  // search is done, switch to fastest settings
+
+  if (pending.empty()) {
+    PPPMTrial best = trials.front();
+    for (const auto &trial : trials)
+      if (trial.time < best.time) best = trial;
+    apply_pppm_trial(best);
+    if (comm->me == 0) {
+      utils::logmesg(lmp,"Fastest PPPM settings: order {} diff {} cutoff {:.8g} mesh {} {} {} "
+                     "time/step {:.8g}\n", best.order, best.diff ? "ad" : "ik", best.cutoff,
+                     best.nx, best.ny, best.nz, best.time);
+      write_cache(best);
+    }
+    converged = true;
+    next_reneighbor = -1;
+    return;
+  }
+
+  current = pending.front();
+  pending.erase(pending.begin());
+  apply_pppm_trial(current);
+  current.nx = force->kspace->nx_pppm;
+  current.ny = force->kspace->ny_pppm;
+  current.nz = force->kspace->nz_pppm;
+  trial_step = update->ntimestep;
+  trial_start = get_pppm_time();
+}
+
+/* ----------------------------------------------------------------------
+   queue trials of the next search phase which have not been timed yet
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::next_pppm_phase()
+{
+  // ad differentiation is not available for all PPPM variants
+
+  int ndiff = 2;
+  if (domain->triclinic || utils::strmatch(force->kspace_style,"/kk$")) ndiff = 1;
+
+  std::vector<PPPMTrial> candidates;
+  PPPMTrial trial = {0, 0, base_cutoff, 0, 0, 0, 0.0};
+  if (!trials.empty()) {
+    trial = trials.front();
+    for (const auto &one : trials)
+      if (one.time < trial.time) trial = one;
+  }
+
+  if (tune_phase == 1) {
+    for (int iorder = order_min; iorder <= order_max; iorder++) {
+      for (int idiff = 0; idiff < ndiff; idiff++) {
+        trial.order = iorder;
+        trial.diff = idiff;
+        candidates.push_back(trial);
+      }
+    }
+  } else if (tune_phase == 2) {
+    for (int i = 0; i < NCUTOFF; i++) {
+      trial.cutoff = base_cutoff * (cut_lo + i*(cut_hi-cut_lo)/(NCUTOFF-1));
+      candidates.push_back(trial);
+    }
+  } else if (tune_phase == 3) {
+    PPPMTrial one = trial;
+    if (trial.order > order_min) {
+      one.order = trial.order - 1;
+      candidates.push_back(one);
+    }
+    if (trial.order < order_max) {
+      one.order = trial.order + 1;
+      candidates.push_back(one);
+    }
+    if (ndiff > 1) {
+      one = trial;
+      one.diff = 1 - trial.diff;
+      candidates.push_back(one);
+    }
+  }
+  tune_phase++;
+
+  for (const auto &candidate : candidates) {
+    bool done = false;
+    for (const auto &one : trials)
+      if ((one.order == candidate.order) && (one.diff == candidate.diff) &&
+          (fabs(one.cutoff - candidate.cutoff) <= 1.0e-8*candidate.cutoff)) done = true;
+    if (!done) pending.push_back(candidate);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   switch to the PPPM settings of a trial
+   mesh and g_ewald are chosen by PPPM to meet the accuracy
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::apply_pppm_trial(const PPPMTrial &trial)
+{
+  auto words = utils::split_words(fmt::format("mesh 0 0 0 gewald 0 order {} diff {}",
+                                              trial.order, trial.diff ? "ad" : "ik"));
+  std::vector<char *> args;
+  for (auto &word : words) args.push_back((char *) word.c_str());
+  force->kspace->modify_params(args.size(),args.data());
+
+  pair_cut_coul = trial.cutoff;
+  update_pair_style(force->pair_style,pair_cut_coul);
+  reinit_styles();
+}
+
+/* ----------------------------------------------------------------------
+   accumulated time of the sections affected by the PPPM settings
+   maximum across procs, so that all procs take the same decisions
+------------------------------------------------------------------------- */
+
+double FixTuneKspace::get_pppm_time()
+{
+  double mytime, time;
+  if (timer->has_normal())
+    mytime = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH) +
+      timer->get_wall(Timer::KSPACE) + timer->get_wall(Timer::COMM);
+  else mytime = timer->elapsed(Timer::TOTAL);
+  MPI_Allreduce(&mytime,&time,1,MPI_DOUBLE,MPI_MAX,world);
+  return time;
+}
+
+/* ----------------------------------------------------------------------
+   key of the tuning results for the current system in the cache file
+------------------------------------------------------------------------- */
+
+std::string FixTuneKspace::cache_key()
+{
+  return fmt::format("{} {} {} {} {} {:.8g}", atom->natoms, comm->nprocs, comm->nthreads,
+                     force->kspace_style, force->pair_style, force->kspace->accuracy);
+}
+
+/* ----------------------------------------------------------------------
+   look up settings for the current system in the cache file
+   the last matching entry is used
+   file format: one line per tuning run with the key from cache_key()
+     followed by order, diff, cutoff, mesh, and time per step
+------------------------------------------------------------------------- */
+
+bool FixTuneKspace::read_cache(PPPMTrial &trial)
+{
+  if (cachefile.empty()) return false;
+
+  int found = 0;
+  double cutoff = 0.0;
+  int settings[2] = {0, 0};
+
+  if ((comm->me == 0) && platform::file_is_readable(cachefile)) {
+    const auto key = utils::split_words(cache_key());
+    try {
+      TextFileReader reader(cachefile, "fix tune/kspace cache");
+      char *line;
+      while ((line = reader.next_line())) {
+        auto words = utils::split_words(line);
+        if (words.size() < key.size() + 7) continue;
+        if (!std::equal(key.begin(), key.end(), words.begin())) continue;
+        ValueTokenizer values(line);
+        values.skip(key.size());
+        settings[0] = values.next_int();
+        settings[1] = (values.next_string() == "ad") ? 1 : 0;
+        cutoff = values.next_double();
+        found = 1;
+      }
+    } catch (std::exception &e) {
+      error->one(FLERR, "Error reading fix tune/kspace cache file {}: {}", cachefile, e.what());
+    }
+  }
+
+  MPI_Bcast(&found,1,MPI_INT,0,world);
+  if (!found) return false;
+  MPI_Bcast(settings,2,MPI_INT,0,world);
+  MPI_Bcast(&cutoff,1,MPI_DOUBLE,0,world);
+  trial = {settings[0], settings[1], cutoff, 0, 0, 0, 0.0};
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   append result of the search to the cache file, called by proc 0 only
+------------------------------------------------------------------------- */
+
+void FixTuneKspace::write_cache(const PPPMTrial &trial)
+{
+  if (cachefile.empty()) return;
+
+  FILE *fp = fopen(cachefile.c_str(),"a");
+  if (fp == nullptr) {
+    error->warning(FLERR,"Cannot open fix tune/kspace cache file {}: {}",
+                   cachefile, utils::getsyserror());
+    return;
+  }
+  if (platform::ftell(fp) == 0)
+    fmt::print(fp,"# natoms nprocs nthreads kspace_style pair_style accuracy "
+               "order diff cutoff nx ny nz time/step\n");
+  fmt::print(fp,"{} {} {} {:.10g} {} {} {} {:.8g}\n", cache_key(), trial.order,
+             trial.diff ? "ad" : "ik", trial.cutoff, trial.nx, trial.ny, trial.nz, trial.time);
+  fclose(fp);
+}
+
 /* ----------------------------------------------------------------------
    bracket a minimum using parabolic extrapolation
 ------------------------------------------------------------------------- */
@@ -22,6 +22,8 @@ FixStyle(tune/kspace,FixTuneKspace);
 
 #include "fix.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class FixTuneKspace : public Fix {
@@ -43,6 +45,7 @@ class FixTuneKspace : public Fix {
 
  private:
   int nevery;
+  int search;    // STYLE = select kspace style and cutoff, PPPM = tune PPPM parameters
 
   int last_step;        // previous timestep when timing info was collected
   double last_spcpu;    // old elapsed CPU time value
@@ -71,6 +74,37 @@ class FixTuneKspace : public Fix {
   bool keep_bracketing, first_brent_pass;
   bool converged, need_fd2_brent;
 
+  // joint tuning of PPPM order, differentiation, and Coulomb cutoff
+
+  struct PPPMTrial {
+    int order;        // PPPM stencil order
+    int diff;         // 0 = ik, 1 = ad differentiation
+    double cutoff;    // real space Coulomb cutoff
+    int nx, ny, nz;   // PPPM mesh chosen for the accuracy
+    double time;      // time per step of pair, neighbor, kspace, and comm
+  };
+
+  int order_min, order_max;     // range of PPPM orders to test
+  double cut_lo, cut_hi;        // range of cutoffs to test, relative to initial cutoff
+  std::string cachefile;        // file with results of previous tuning runs
+  int tune_phase;               // 0 = not started, > 0 = phase of the search
+  int need_baseline;            // 1 if timing of current trial must be restarted
+  bigint trial_step;            // timestep when current trial started
+  double trial_start;           // timer value when current trial started
+  double base_cutoff;           // Coulomb cutoff at start of tuning
+  PPPMTrial current;            // trial that is currently timed
+  std::vector<PPPMTrial> pending;    // trials that are yet to be timed
+  std::vector<PPPMTrial> trials;     // trials that have been timed
+
+  void tune_pppm();
+  void next_pppm_phase();
+  void apply_pppm_trial(const PPPMTrial &);
+  void reinit_styles();
+  double get_pppm_time();
+  std::string cache_key();
+  bool read_cache(PPPMTrial &);
+  void write_cache(const PPPMTrial &);
+
   inline void shft3(double &a, double &b, double &c, const double d)
   {
     a = b;
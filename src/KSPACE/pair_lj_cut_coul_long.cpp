@@ -45,6 +45,7 @@ PairLJCutCoulLong::PairLJCutCoulLong(LAMMPS *lmp) : Pair(lmp)
   ewaldflag = pppmflag = 1;
   respa_enable = 1;
   writedata = 1;
+  overlap_enable = 1;
   ftable = nullptr;
   qdist = 0.0;
   cut_respa = nullptr;
@@ -48,6 +48,7 @@ PairLJCutTIP4PLong::PairLJCutTIP4PLong(LAMMPS *lmp) :
   single_enable = 0;
   respa_enable = 0;
   writedata = 1;
+  overlap_enable = 0;
 
   nmax = 0;
   hneigh = nullptr;
@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "plan_cache.h"
+
+using namespace LAMMPS_NS;
+
+namespace {
+
+// max # of unused plans kept per group of procs
+
+constexpr int MAXUNUSED = 8;
+
+struct CacheEntry {
+  MPI_Group group;             // procs the plan was created for
+  std::vector<int> key;        // arguments the plan was created with
+  void *plan;
+  int nbuf;
+  int inuse;
+  int id;                      // creation index, identical on all procs of group
+  void (*destroy)(void *);
+};
+
+struct Cache {
+  std::vector<CacheEntry> entries;
+  int lastid = 0;
+
+  // plans hold MPI communicators which cannot be freed after MPI_Finalize(),
+  //   so at exit they are only released if MPI is still active
+
+  ~Cache()
+  {
+    if (entries.empty()) return;
+    int flag;
+    MPI_Finalized(&flag);
+    if (flag) return;
+    for (auto &entry : entries) {
+      if (!entry.inuse) entry.destroy(entry.plan);
+      MPI_Group_free(&entry.group);
+    }
+  }
+};
+
+Cache &cache()
+{
+  static Cache instance;
+  return instance;
+}
+
+bool same_group(MPI_Group group, MPI_Comm comm)
+{
+  MPI_Group cgroup;
+  int result;
+  MPI_Comm_group(comm, &cgroup);
+  MPI_Group_compare(group, cgroup, &result);
+  MPI_Group_free(&cgroup);
+  return result == MPI_IDENT;
+}
+
+/* ----------------------------------------------------------------------
+   destroy oldest unused plans of the group of comm beyond MAXUNUSED
+   the cache content for a group is the same on all its procs,
+     so all of them evict the same plans
+------------------------------------------------------------------------- */
+
+void evict(Cache &c, MPI_Comm comm)
+{
+  int nunused = 0;
+  for (auto &entry : c.entries)
+    if (!entry.inuse && same_group(entry.group, comm)) nunused++;
+
+  // entries are stored in order of creation, oldest first
+
+  for (auto it = c.entries.begin(); nunused > MAXUNUSED && it != c.entries.end();) {
+    if (!it->inuse && same_group(it->group, comm)) {
+      it->destroy(it->plan);
+      MPI_Group_free(&it->group);
+      it = c.entries.erase(it);
+      nunused--;
+    } else
+      ++it;
+  }
+}
+}    // namespace
+
+/* ----------------------------------------------------------------------
+   look up unused plan for key on comm, collective over comm
+   a plan is reused only if all procs of comm find the same cached plan
+------------------------------------------------------------------------- */
+
+void *PlanCache::acquire(MPI_Comm comm, const std::vector<int> &key, int *nbuf)
+{
+  auto &c = cache();
+
+  CacheEntry *match = nullptr;
+  for (auto &entry : c.entries)
+    if (!entry.inuse && (entry.key == key) && same_group(entry.group, comm)) match = &entry;
+
+  int myid[2], allid[2];
+  myid[0] = match ? match->id : -1;
+  myid[1] = -myid[0];
+  MPI_Allreduce(myid, allid, 2, MPI_INT, MPI_MAX, comm);
+  if ((allid[0] < 0) || (allid[0] != -allid[1])) return nullptr;
+
+  match->inuse = 1;
+  *nbuf = match->nbuf;
+  return match->plan;
+}
+
+/* ----------------------------------------------------------------------
+   store newly created plan, collective over comm
+------------------------------------------------------------------------- */
+
+void PlanCache::insert(MPI_Comm comm, const std::vector<int> &key, void *plan, int nbuf,
+                       void (*destroy)(void *))
+{
+  auto &c = cache();
+
+  // agree on an id which is larger than all ids known on any proc of comm
+
+  int id = c.lastid + 1;
+  MPI_Allreduce(&id, &c.lastid, 1, MPI_INT, MPI_MAX, comm);
+
+  CacheEntry entry;
+  MPI_Comm_group(comm, &entry.group);
+  entry.key = key;
+  entry.plan = plan;
+  entry.nbuf = nbuf;
+  entry.inuse = 1;
+  entry.id = c.lastid;
+  entry.destroy = destroy;
+  c.entries.push_back(entry);
+
+  evict(c, comm);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PlanCache::release(void *plan)
+{
+  for (auto &entry : cache().entries)
+    if (entry.plan == plan) entry.inuse = 0;
+}
@@ -0,0 +1,48 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PLAN_CACHE_H
+#define LMP_PLAN_CACHE_H
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace LAMMPS_NS {
+
+// process-wide cache of 3d FFT and remap plans
+// plans that are no longer used are kept and handed out again when a
+//   plan with the same key is requested on the same group of procs,
+//   so re-creating FFTs after a box or grid change is cheap
+// acquire() and insert() are collective over the communicator
+
+namespace PlanCache {
+
+  // cached plan matching key and comm, marked as in use, or nullptr
+  // nbuf is set to the buffer size reported when the plan was created
+
+  void *acquire(MPI_Comm comm, const std::vector<int> &key, int *nbuf);
+
+  // add newly created plan to the cache, marked as in use
+  // destroy is called when the plan is evicted from the cache
+
+  void insert(MPI_Comm comm, const std::vector<int> &key, void *plan, int nbuf,
+              void (*destroy)(void *));
+
+  // mark plan as unused, it stays in the cache for later reuse
+
+  void release(void *plan);
+}    // namespace PlanCache
+}    // namespace LAMMPS_NS
+
+#endif
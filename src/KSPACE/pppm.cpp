@@ -24,6 +24,7 @@
 #include "angle.h"
 #include "atom.h"
 #include "bond.h"
+#include "comm.h"
 #include "domain.h"
 #include "error.h"
 #include "fft3d_wrap.h"
@@ -50,6 +51,12 @@ static constexpr double SMALL = 0.00001;
 static constexpr double EPS_HOC = 1.0e-7;
 static constexpr FFT_SCALAR ZEROF = 0.0;
 
+// cache-blocked charge assignment: TILE = edge of a tile in grid cells, must be >= MAXORDER-1
+// TILECHUNK = # of atoms whose stencil weights are computed together
+
+static constexpr int TILE = 8;
+static constexpr int TILECHUNK = 64;
+
 enum { REVERSE_RHO };
 enum { FORWARD_IK, FORWARD_AD, FORWARD_IK_PERATOM, FORWARD_AD_PERATOM };
 
@@ -65,7 +72,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   sf_precoeff4(nullptr), sf_precoeff5(nullptr), sf_precoeff6(nullptr),
   acons(nullptr), fft1(nullptr), fft2(nullptr), remap(nullptr), gc(nullptr),
   gc_buf1(nullptr), gc_buf2(nullptr), density_A_brick(nullptr), density_B_brick(nullptr), density_A_fft(nullptr),
-  density_B_fft(nullptr), part2grid(nullptr), boxlo(nullptr)
+  density_B_fft(nullptr), part2grid(nullptr), tile_first(nullptr), tile_atoms(nullptr),
+  atom2tile(nullptr), boxlo(nullptr)
 {
   peratom_allocate_flag = 0;
   group_allocate_flag = 0;
@@ -83,7 +91,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
 
-  nfft_both = 0;
+  nfft_both = nfft_kspace = ncomplex = 0;
+  nxhi_kspace = 0;
   nxhi_in = nxlo_in = nxhi_out = nxlo_out = 0;
   nyhi_in = nylo_in = nyhi_out = nylo_out = 0;
   nzhi_in = nzlo_in = nzhi_out = nzlo_out = 0;
@@ -94,6 +103,8 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   v0_brick = v1_brick = v2_brick = v3_brick = v4_brick = v5_brick = nullptr;
   greensfn = nullptr;
   work1 = work2 = nullptr;
+  workvd = nullptr;
+  batch_stride = 0;
   vg = nullptr;
   fkx = fky = fkz = nullptr;
 
@@ -114,6 +125,9 @@ PPPM::PPPM(LAMMPS *lmp) : KSpace(lmp),
   nmax = 0;
   part2grid = nullptr;
 
+  ntilex = ntiley = ntilez = 0;
+  maxtile = maxtileatom = 0;
+
   // define acons coefficients for estimation of kspace errors
   // see JCP 109, pg 7698 for derivation of coefficients
   // higher order coefficients may be computed if needed
@@ -174,6 +188,9 @@ PPPM::~PPPM()
   if (peratom_allocate_flag) PPPM::deallocate_peratom();
   if (group_allocate_flag) PPPM::deallocate_groups();
   memory->destroy(part2grid);
+  memory->destroy(tile_first);
+  memory->destroy(tile_atoms);
+  memory->destroy(atom2tile);
   memory->destroy(acons);
 }
 
@@ -196,6 +213,17 @@ void PPPM::init()
     error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and kspace_modify diff ad");
   if (domain->triclinic && slabflag)
     error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and slab correction");
+  if (r2c_flag) {
+    if (strcmp(force->kspace_style,"pppm") != 0 && strcmp(force->kspace_style,"pppm/cg") != 0 &&
+        strcmp(force->kspace_style,"pppm/tip4p") != 0)
+      error->all(FLERR,"Kspace_modify r2c yes is not supported by kspace style {}",
+                 force->kspace_style);
+    if (domain->triclinic)
+      error->all(FLERR,"Cannot (yet) use PPPM with triclinic box and kspace_modify r2c yes");
+  }
+  if (tiling_flag && strcmp(force->kspace_style,"pppm") != 0)
+    error->all(FLERR,"Kspace_modify tiling yes is not supported by kspace style {}",
+               force->kspace_style);
   if (domain->dimension == 2)
     error->all(FLERR,"Cannot use PPPM with 2d simulation");
 
@@ -415,7 +443,7 @@ void PPPM::setup()
 
   double per;
 
-  for (i = nxlo_fft; i <= nxhi_fft; i++) {
+  for (i = nxlo_fft; i <= nxhi_kspace; i++) {
     per = i - nx_pppm*(2*i/nx_pppm);
     fkx[i] = unitkx*per;
   }
@@ -437,7 +465,7 @@ void PPPM::setup()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++) {
     for (j = nylo_fft; j <= nyhi_fft; j++) {
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kspace; i++) {
         sqk = fkx[i]*fkx[i] + fky[j]*fky[j] + fkz[k]*fkz[k];
         if (sqk == 0.0) {
           vg[n][0] = 0.0;
@@ -454,12 +482,28 @@ void PPPM::setup()
           vg[n][3] = vterm*fkx[i]*fky[j];
           vg[n][4] = vterm*fkx[i]*fkz[k];
           vg[n][5] = vterm*fky[j]*fkz[k];
+          if (r2c_flag) {
+            if ((2*i == nx_pppm) != (2*j == ny_pppm)) vg[n][3] = 0.0;
+            if ((2*i == nx_pppm) != (2*k == nz_pppm)) vg[n][4] = 0.0;
+            if ((2*j == ny_pppm) != (2*k == nz_pppm)) vg[n][5] = 0.0;
+          }
         }
         n++;
       }
     }
   }
 
+  // with r2c FFTs only the part of the K-space data that is even in k
+  //   is used, which is what the real part of a complex FFT retains
+  // odd off-diagonal virial terms with one Nyquist index are removed above
+  // the gradient at the Nyquist index is odd, so it is set to zero
+
+  if (r2c_flag) {
+    if (nx_pppm % 2 == 0 && nxhi_kspace == nx_pppm/2) fkx[nx_pppm/2] = 0.0;
+    if (ny_pppm % 2 == 0 && nylo_fft <= ny_pppm/2 && ny_pppm/2 <= nyhi_fft) fky[ny_pppm/2] = 0.0;
+    if (nz_pppm % 2 == 0 && nzlo_fft <= nz_pppm/2 && nz_pppm/2 <= nzhi_fft) fkz[nz_pppm/2] = 0.0;
+  }
+
   if (differentiation_flag == 1) compute_gf_ad();
   else compute_gf_ik();
 }
@@ -778,19 +822,31 @@ void PPPM::allocate()
 
   nfft_both = MAX(nfft,nfft_brick);
 
+  // nfft_kspace = K-space points in x-pencil decomposition on this proc
+  // ncomplex = complex values in work1 and work2
+  // with r2c FFTs these hold only the half of K-space with 0 <= kx <= nx/2,
+  //   but work1 is also used as real buffer with nfft_both values
+
+  nfft_kspace = (nxhi_kspace-nxlo_fft+1) * (nyhi_fft-nylo_fft+1) *
+    (nzhi_fft-nzlo_fft+1);
+
+  if (r2c_flag) ncomplex = MAX(nfft_kspace,(nfft_both+1)/2);
+  else ncomplex = nfft_both;
+  int nkspace = r2c_flag ? nfft_kspace : nfft_both;
+
   // allocate distributed grid data
 
   memory->create3d_offset(density_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
                           nxlo_out,nxhi_out,"pppm:density_brick");
 
   memory->create(density_fft,nfft_both,"pppm:density_fft");
-  memory->create(greensfn,nfft_both,"pppm:greensfn");
-  memory->create(work1,2*nfft_both,"pppm:work1");
-  memory->create(work2,2*nfft_both,"pppm:work2");
-  memory->create(vg,nfft_both,6,"pppm:vg");
+  memory->create(greensfn,nkspace,"pppm:greensfn");
+  memory->create(work1,2*ncomplex,"pppm:work1");
+  memory->create(work2,2*ncomplex,"pppm:work2");
+  memory->create(vg,nkspace,6,"pppm:vg");
 
   if (triclinic == 0) {
-    memory->create1d_offset(fkx,nxlo_fft,nxhi_fft,"pppm:fkx");
+    memory->create1d_offset(fkx,nxlo_fft,nxhi_kspace,"pppm:fkx");
     memory->create1d_offset(fky,nylo_fft,nyhi_fft,"pppm:fky");
     memory->create1d_offset(fkz,nzlo_fft,nzhi_fft,"pppm:fkz");
   } else {
@@ -803,12 +859,12 @@ void PPPM::allocate()
     memory->create3d_offset(u_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
                           nxlo_out,nxhi_out,"pppm:u_brick");
 
-    memory->create(sf_precoeff1,nfft_both,"pppm:sf_precoeff1");
-    memory->create(sf_precoeff2,nfft_both,"pppm:sf_precoeff2");
-    memory->create(sf_precoeff3,nfft_both,"pppm:sf_precoeff3");
-    memory->create(sf_precoeff4,nfft_both,"pppm:sf_precoeff4");
-    memory->create(sf_precoeff5,nfft_both,"pppm:sf_precoeff5");
-    memory->create(sf_precoeff6,nfft_both,"pppm:sf_precoeff6");
+    memory->create(sf_precoeff1,nkspace,"pppm:sf_precoeff1");
+    memory->create(sf_precoeff2,nkspace,"pppm:sf_precoeff2");
+    memory->create(sf_precoeff3,nkspace,"pppm:sf_precoeff3");
+    memory->create(sf_precoeff4,nkspace,"pppm:sf_precoeff4");
+    memory->create(sf_precoeff5,nkspace,"pppm:sf_precoeff5");
+    memory->create(sf_precoeff6,nkspace,"pppm:sf_precoeff6");
 
   } else {
     memory->create3d_offset(vdx_brick,nzlo_out,nzhi_out,nylo_out,nyhi_out,
@@ -833,23 +889,32 @@ void PPPM::allocate()
   // 1st FFT keeps data in FFT decomposition
   // 2nd FFT returns data in 3d brick decomposition
   // remap takes data from 3d brick to FFT decomposition
+  // with r2c FFTs, 1st FFT is real-to-complex, 2nd is complex-to-real
 
   int tmp;
 
   fft1 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
                    nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
-                   0,0,&tmp,collective_flag);
+                   nxlo_fft,nxhi_kspace,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                   0,0,&tmp,collective_flag,r2c_flag ? FFT3d::FORWARD : 0);
 
   fft2 = new FFT3d(lmp,world,nx_pppm,ny_pppm,nz_pppm,
-                   nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
+                   nxlo_fft,nxhi_kspace,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
-                   0,0,&tmp,collective_flag);
+                   0,0,&tmp,collective_flag,r2c_flag ? FFT3d::BACKWARD : 0);
 
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
                     1,0,0,FFT_PRECISION,collective_flag);
+
+  // with non-blocking remaps, the 3 gradients for ik differentiation
+  //   are transformed together as one batch by the 2nd FFT
+
+  if (collective_flag == 2 && differentiation_flag == 0 && !r2c_flag && !triclinic) {
+    batch_stride = fft2->batch_stride();
+    if (batch_stride) memory->create(workvd,6*batch_stride,"pppm:workvd");
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -882,6 +947,8 @@ void PPPM::deallocate()
   memory->destroy(greensfn);
   memory->destroy(work1);
   memory->destroy(work2);
+  memory->destroy(workvd);
+  batch_stride = 0;
   memory->destroy(vg);
 
   if (triclinic == 0) {
@@ -1403,6 +1470,11 @@ void PPPM::set_grid_local()
   nyhi_fft = (me_y+1)*ny_pppm/npey_fft - 1;
   nzlo_fft = me_z*nz_pppm/npez_fft;
   nzhi_fft = (me_z+1)*nz_pppm/npez_fft - 1;
+
+  // with r2c FFTs only x indices 0 to nx_pppm/2 are stored in K-space
+  //   the remaining half follows from Hermitian symmetry
+
+  nxhi_kspace = r2c_flag ? nx_pppm/2 : nxhi_fft;
 }
 
 /* ----------------------------------------------------------------------
@@ -1469,7 +1541,7 @@ void PPPM::compute_gf_ik()
       lper = l - ny_pppm*(2*l/ny_pppm);
       sny = square(sin(0.5*unitky*lper*yprd/ny_pppm));
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kspace; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         snx = square(sin(0.5*unitkx*kper*xprd/nx_pppm));
 
@@ -1645,7 +1717,7 @@ void PPPM::compute_gf_ad()
       argy = 0.5*qy*yprd/ny_pppm;
       wy = powsinxx(argy,twoorder);
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
+      for (k = nxlo_fft; k <= nxhi_kspace; k++) {
         kper = k - nx_pppm*(2*k/nx_pppm);
         qx = unitkx*kper;
         snx = square(sin(0.5*qx*xprd/nx_pppm));
@@ -1703,82 +1775,96 @@ void PPPM::compute_gf_ad()
 
 /* ----------------------------------------------------------------------
    compute self force coefficients for ad-differentiation scheme
+   with r2c FFTs the coefficients of the mirror image -k of a point
+     with 0 < kx < nx_pppm/2 are added, since it is not stored
 ------------------------------------------------------------------------- */
 
 void PPPM::compute_sf_precoeff()
 {
-  int i,k,l,m,n;
-  int nx,ny,nz,kper,lper,mper;
-  double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
-  double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
-  double u0,u1,u2,u3,u4,u5,u6;
-  double sum1,sum2,sum3,sum4,sum5,sum6;
+  int k,l,m,n;
+  double sum[6],mirror[6];
 
   n = 0;
   for (m = nzlo_fft; m <= nzhi_fft; m++) {
-    mper = m - nz_pppm*(2*m/nz_pppm);
-
     for (l = nylo_fft; l <= nyhi_fft; l++) {
-      lper = l - ny_pppm*(2*l/ny_pppm);
+      for (k = nxlo_fft; k <= nxhi_kspace; k++) {
+        compute_sf_precoeff_one(k,l,m,sum);
+        if (r2c_flag && k > 0 && 2*k != nx_pppm) {
+          compute_sf_precoeff_one(nx_pppm-k,(ny_pppm-l) % ny_pppm,(nz_pppm-m) % nz_pppm,mirror);
+          for (int i = 0; i < 6; i++) sum[i] += mirror[i];
+        }
 
-      for (k = nxlo_fft; k <= nxhi_fft; k++) {
-        kper = k - nx_pppm*(2*k/nx_pppm);
+        // store values
 
-        sum1 = sum2 = sum3 = sum4 = sum5 = sum6 = 0.0;
-        for (i = 0; i < 5; i++) {
-
-          qx0 = MY_2PI*(kper+nx_pppm*(i-2));
-          qx1 = MY_2PI*(kper+nx_pppm*(i-1));
-          qx2 = MY_2PI*(kper+nx_pppm*(i  ));
-          wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
-          wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
-          wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
-
-          qy0 = MY_2PI*(lper+ny_pppm*(i-2));
-          qy1 = MY_2PI*(lper+ny_pppm*(i-1));
-          qy2 = MY_2PI*(lper+ny_pppm*(i  ));
-          wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
-          wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
-          wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
-
-          qz0 = MY_2PI*(mper+nz_pppm*(i-2));
-          qz1 = MY_2PI*(mper+nz_pppm*(i-1));
-          qz2 = MY_2PI*(mper+nz_pppm*(i  ));
-
-          wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
-          wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
-          wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
-        }
+        sf_precoeff1[n] = sum[0];
+        sf_precoeff2[n] = sum[1];
+        sf_precoeff3[n] = sum[2];
+        sf_precoeff4[n] = sum[3];
+        sf_precoeff5[n] = sum[4];
+        sf_precoeff6[n++] = sum[5];
+      }
+    }
+  }
+}
 
-        for (nx = 0; nx < 5; nx++) {
-          for (ny = 0; ny < 5; ny++) {
-            for (nz = 0; nz < 5; nz++) {
-              u0 = wx0[nx]*wy0[ny]*wz0[nz];
-              u1 = wx1[nx]*wy0[ny]*wz0[nz];
-              u2 = wx2[nx]*wy0[ny]*wz0[nz];
-              u3 = wx0[nx]*wy1[ny]*wz0[nz];
-              u4 = wx0[nx]*wy2[ny]*wz0[nz];
-              u5 = wx0[nx]*wy0[ny]*wz1[nz];
-              u6 = wx0[nx]*wy0[ny]*wz2[nz];
-
-              sum1 += u0*u1;
-              sum2 += u0*u2;
-              sum3 += u0*u3;
-              sum4 += u0*u4;
-              sum5 += u0*u5;
-              sum6 += u0*u6;
-            }
-          }
-        }
+/* ----------------------------------------------------------------------
+   compute 6 self force coefficients of a single grid point k,l,m
+------------------------------------------------------------------------- */
 
-        // store values
+void PPPM::compute_sf_precoeff_one(int k, int l, int m, double *sum)
+{
+  int i,nx,ny,nz;
+  double wx0[5],wy0[5],wz0[5],wx1[5],wy1[5],wz1[5],wx2[5],wy2[5],wz2[5];
+  double qx0,qy0,qz0,qx1,qy1,qz1,qx2,qy2,qz2;
+  double u0,u1,u2,u3,u4,u5,u6;
 
-        sf_precoeff1[n] = sum1;
-        sf_precoeff2[n] = sum2;
-        sf_precoeff3[n] = sum3;
-        sf_precoeff4[n] = sum4;
-        sf_precoeff5[n] = sum5;
-        sf_precoeff6[n++] = sum6;
+  const int kper = k - nx_pppm*(2*k/nx_pppm);
+  const int lper = l - ny_pppm*(2*l/ny_pppm);
+  const int mper = m - nz_pppm*(2*m/nz_pppm);
+
+  for (i = 0; i < 6; i++) sum[i] = 0.0;
+  for (i = 0; i < 5; i++) {
+
+    qx0 = MY_2PI*(kper+nx_pppm*(i-2));
+    qx1 = MY_2PI*(kper+nx_pppm*(i-1));
+    qx2 = MY_2PI*(kper+nx_pppm*(i  ));
+    wx0[i] = powsinxx(0.5*qx0/nx_pppm,order);
+    wx1[i] = powsinxx(0.5*qx1/nx_pppm,order);
+    wx2[i] = powsinxx(0.5*qx2/nx_pppm,order);
+
+    qy0 = MY_2PI*(lper+ny_pppm*(i-2));
+    qy1 = MY_2PI*(lper+ny_pppm*(i-1));
+    qy2 = MY_2PI*(lper+ny_pppm*(i  ));
+    wy0[i] = powsinxx(0.5*qy0/ny_pppm,order);
+    wy1[i] = powsinxx(0.5*qy1/ny_pppm,order);
+    wy2[i] = powsinxx(0.5*qy2/ny_pppm,order);
+
+    qz0 = MY_2PI*(mper+nz_pppm*(i-2));
+    qz1 = MY_2PI*(mper+nz_pppm*(i-1));
+    qz2 = MY_2PI*(mper+nz_pppm*(i  ));
+
+    wz0[i] = powsinxx(0.5*qz0/nz_pppm,order);
+    wz1[i] = powsinxx(0.5*qz1/nz_pppm,order);
+    wz2[i] = powsinxx(0.5*qz2/nz_pppm,order);
+  }
+
+  for (nx = 0; nx < 5; nx++) {
+    for (ny = 0; ny < 5; ny++) {
+      for (nz = 0; nz < 5; nz++) {
+        u0 = wx0[nx]*wy0[ny]*wz0[nz];
+        u1 = wx1[nx]*wy0[ny]*wz0[nz];
+        u2 = wx2[nx]*wy0[ny]*wz0[nz];
+        u3 = wx0[nx]*wy1[ny]*wz0[nz];
+        u4 = wx0[nx]*wy2[ny]*wz0[nz];
+        u5 = wx0[nx]*wy0[ny]*wz1[nz];
+        u6 = wx0[nx]*wy0[ny]*wz2[nz];
+
+        sum[0] += u0*u1;
+        sum[1] += u0*u2;
+        sum[2] += u0*u3;
+        sum[3] += u0*u4;
+        sum[4] += u0*u5;
+        sum[5] += u0*u6;
       }
     }
   }
@@ -1828,6 +1914,59 @@ void PPPM::particle_map()
   }
 
   if (flag) error->one(FLERR,"Out of range atoms - cannot compute PPPM");
+
+  if (tiling_flag) bin_tiles();
+}
+
+/* ----------------------------------------------------------------------
+   sort my particles into tiles of TILE^3 grid cells by their stencil origin
+   tiles cover all origins whose stencil fits in my 3d brick (incl ghosts)
+   tile_atoms = atoms of each tile, from tile_first[t] to tile_first[t+1]-1
+------------------------------------------------------------------------- */
+
+void PPPM::bin_tiles()
+{
+  int i,itile;
+
+  int nlocal = atom->nlocal;
+
+  if (nlocal > maxtileatom) {
+    maxtileatom = atom->nmax;
+    memory->destroy(tile_atoms);
+    memory->destroy(atom2tile);
+    memory->create(tile_atoms,maxtileatom,"pppm:tile_atoms");
+    memory->create(atom2tile,maxtileatom,"pppm:atom2tile");
+  }
+
+  const int tilexlo = nxlo_out - nlower;
+  const int tileylo = nylo_out - nlower;
+  const int tilezlo = nzlo_out - nlower;
+  ntilex = (nxhi_out - nupper - tilexlo) / TILE + 1;
+  ntiley = (nyhi_out - nupper - tileylo) / TILE + 1;
+  ntilez = (nzhi_out - nupper - tilezlo) / TILE + 1;
+  const int ntiles = ntilex*ntiley*ntilez;
+
+  if (ntiles+1 > maxtile) {
+    maxtile = ntiles+1;
+    memory->destroy(tile_first);
+    memory->create(tile_first,maxtile,"pppm:tile_first");
+  }
+
+  // counting sort of atoms by tile
+
+  for (itile = 0; itile <= ntiles; itile++) tile_first[itile] = 0;
+
+  for (i = 0; i < nlocal; i++) {
+    itile = ((part2grid[i][2]-tilezlo)/TILE * ntiley +
+             (part2grid[i][1]-tileylo)/TILE) * ntilex + (part2grid[i][0]-tilexlo)/TILE;
+    atom2tile[i] = itile;
+    tile_first[itile+1]++;
+  }
+
+  for (itile = 0; itile < ntiles; itile++) tile_first[itile+1] += tile_first[itile];
+  for (i = 0; i < nlocal; i++) tile_atoms[tile_first[atom2tile[i]]++] = i;
+  for (itile = ntiles; itile > 0; itile--) tile_first[itile] = tile_first[itile-1];
+  tile_first[0] = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -1839,6 +1978,11 @@ void PPPM::particle_map()
 
 void PPPM::make_rho()
 {
+  if (tiling_flag) {
+    make_rho_tiled();
+    return;
+  }
+
   int l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
 
@@ -1925,13 +2069,18 @@ void PPPM::poisson_ik()
 
   // transform charge density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  // with r2c FFTs the real density is transformed directly
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+  if (r2c_flag) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft_kspace; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
+
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
   // global energy and virial contribution
 
@@ -1940,9 +2089,10 @@ void PPPM::poisson_ik()
   double s2 = scaleinv*scaleinv;
 
   if (eflag_global || vflag_global) {
-    if (vflag_global) {
+    if (r2c_flag) ev_kspace_half(s2);
+    else if (vflag_global) {
       n = 0;
-      for (i = 0; i < nfft; i++) {
+      for (i = 0; i < nfft_kspace; i++) {
         eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
         if (eflag_global) energy += eng;
@@ -1950,7 +2100,7 @@ void PPPM::poisson_ik()
       }
     } else {
       n = 0;
-      for (i = 0; i < nfft; i++) {
+      for (i = 0; i < nfft_kspace; i++) {
         energy +=
           s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         n += 2;
@@ -1962,7 +2112,7 @@ void PPPM::poisson_ik()
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
@@ -1982,12 +2132,51 @@ void PPPM::poisson_ik()
   // FFT leaves data in 3d brick decomposition
   // copy it into inner portion of vdx,vdy,vdz arrays
 
+  // with non-blocking remaps all 3 gradients are transformed together,
+  //   so their remaps overlap with each other and with the 1d FFTs
+
+  if (batch_stride) {
+    FFT_SCALAR *workx = workvd;
+    FFT_SCALAR *worky = workvd + 2*batch_stride;
+    FFT_SCALAR *workz = workvd + 4*batch_stride;
+
+    n = 0;
+    for (k = nzlo_fft; k <= nzhi_fft; k++)
+      for (j = nylo_fft; j <= nyhi_fft; j++)
+        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+          workx[n] = -fkx[i]*work1[n+1];
+          workx[n+1] = fkx[i]*work1[n];
+          worky[n] = -fky[j]*work1[n+1];
+          worky[n+1] = fky[j]*work1[n];
+          workz[n] = -fkz[k]*work1[n+1];
+          workz[n+1] = fkz[k]*work1[n];
+          n += 2;
+        }
+
+    fft2->compute_batch(workvd,3,FFT3d::BACKWARD);
+
+    n = 0;
+    for (k = nzlo_in; k <= nzhi_in; k++)
+      for (j = nylo_in; j <= nyhi_in; j++)
+        for (i = nxlo_in; i <= nxhi_in; i++) {
+          vdx_brick[k][j][i] = workx[n];
+          vdy_brick[k][j][i] = worky[n];
+          vdz_brick[k][j][i] = workz[n];
+          n += 2;
+        }
+    return;
+  }
+
+  // with r2c FFTs the gradients come back as real values
+
+  const int nstep = r2c_flag ? 1 : 2;
+
   // x direction gradient
 
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kspace; i++) {
         work2[n] = -fkx[i]*work1[n+1];
         work2[n+1] = fkx[i]*work1[n];
         n += 2;
@@ -2000,7 +2189,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdx_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   // y direction gradient
@@ -2008,7 +2197,7 @@ void PPPM::poisson_ik()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kspace; i++) {
         work2[n] = -fky[j]*work1[n+1];
         work2[n+1] = fky[j]*work1[n];
         n += 2;
@@ -2021,7 +2210,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdy_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   // z direction gradient
@@ -2029,7 +2218,7 @@ void PPPM::poisson_ik()
   n = 0;
   for (k = nzlo_fft; k <= nzhi_fft; k++)
     for (j = nylo_fft; j <= nyhi_fft; j++)
-      for (i = nxlo_fft; i <= nxhi_fft; i++) {
+      for (i = nxlo_fft; i <= nxhi_kspace; i++) {
         work2[n] = -fkz[k]*work1[n+1];
         work2[n+1] = fkz[k]*work1[n];
         n += 2;
@@ -2042,7 +2231,7 @@ void PPPM::poisson_ik()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         vdz_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 }
 
@@ -2127,13 +2316,18 @@ void PPPM::poisson_ad()
 
   // transform charge density (r -> k)
 
-  n = 0;
-  for (i = 0; i < nfft; i++) {
-    work1[n++] = density_fft[i];
-    work1[n++] = ZEROF;
-  }
+  // with r2c FFTs the real density is transformed directly
+
+  if (r2c_flag) fft1->compute(density_fft,work1,FFT3d::FORWARD);
+  else {
+    n = 0;
+    for (i = 0; i < nfft_kspace; i++) {
+      work1[n++] = density_fft[i];
+      work1[n++] = ZEROF;
+    }
 
-  fft1->compute(work1,work1,FFT3d::FORWARD);
+    fft1->compute(work1,work1,FFT3d::FORWARD);
+  }
 
   // global energy and virial contribution
 
@@ -2142,9 +2336,10 @@ void PPPM::poisson_ad()
   double s2 = scaleinv*scaleinv;
 
   if (eflag_global || vflag_global) {
-    if (vflag_global) {
+    if (r2c_flag) ev_kspace_half(s2);
+    else if (vflag_global) {
       n = 0;
-      for (i = 0; i < nfft; i++) {
+      for (i = 0; i < nfft_kspace; i++) {
         eng = s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         for (j = 0; j < 6; j++) virial[j] += eng*vg[i][j];
         if (eflag_global) energy += eng;
@@ -2152,7 +2347,7 @@ void PPPM::poisson_ad()
       }
     } else {
       n = 0;
-      for (i = 0; i < nfft; i++) {
+      for (i = 0; i < nfft_kspace; i++) {
         energy +=
           s2 * greensfn[i] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
         n += 2;
@@ -2164,7 +2359,7 @@ void PPPM::poisson_ad()
   // multiply by Green's function to get V(k)
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work1[n++] *= scaleinv * greensfn[i];
     work1[n++] *= scaleinv * greensfn[i];
   }
@@ -2174,7 +2369,7 @@ void PPPM::poisson_ad()
   if (vflag_atom) poisson_peratom();
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n];
     work2[n+1] = work1[n+1];
     n += 2;
@@ -2182,12 +2377,13 @@ void PPPM::poisson_ad()
 
   fft2->compute(work2,work2,FFT3d::BACKWARD);
 
+  const int nstep = r2c_flag ? 1 : 2;
   n = 0;
   for (k = nzlo_in; k <= nzhi_in; k++)
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         u_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 }
 
@@ -2198,12 +2394,13 @@ void PPPM::poisson_ad()
 void PPPM::poisson_peratom()
 {
   int i,j,k,n;
+  const int nstep = r2c_flag ? 1 : 2;
 
   // energy
 
   if (eflag_atom && differentiation_flag != 1) {
     n = 0;
-    for (i = 0; i < nfft; i++) {
+    for (i = 0; i < nfft_kspace; i++) {
       work2[n] = work1[n];
       work2[n+1] = work1[n+1];
       n += 2;
@@ -2216,7 +2413,7 @@ void PPPM::poisson_peratom()
       for (j = nylo_in; j <= nyhi_in; j++)
         for (i = nxlo_in; i <= nxhi_in; i++) {
           u_brick[k][j][i] = work2[n];
-          n += 2;
+          n += nstep;
         }
   }
 
@@ -2225,7 +2422,7 @@ void PPPM::poisson_peratom()
   if (!vflag_atom) return;
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][0];
     work2[n+1] = work1[n+1]*vg[i][0];
     n += 2;
@@ -2238,11 +2435,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v0_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][1];
     work2[n+1] = work1[n+1]*vg[i][1];
     n += 2;
@@ -2255,11 +2452,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v1_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][2];
     work2[n+1] = work1[n+1]*vg[i][2];
     n += 2;
@@ -2272,11 +2469,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v2_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][3];
     work2[n+1] = work1[n+1]*vg[i][3];
     n += 2;
@@ -2289,11 +2486,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v3_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][4];
     work2[n+1] = work1[n+1]*vg[i][4];
     n += 2;
@@ -2306,11 +2503,11 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v4_brick[k][j][i] = work2[n];
-        n += 2;
+        n += nstep;
       }
 
   n = 0;
-  for (i = 0; i < nfft; i++) {
+  for (i = 0; i < nfft_kspace; i++) {
     work2[n] = work1[n]*vg[i][5];
     work2[n+1] = work1[n+1]*vg[i][5];
     n += 2;
@@ -2323,7 +2520,33 @@ void PPPM::poisson_peratom()
     for (j = nylo_in; j <= nyhi_in; j++)
       for (i = nxlo_in; i <= nxhi_in; i++) {
         v5_brick[k][j][i] = work2[n];
+        n += nstep;
+      }
+}
+
+/* ----------------------------------------------------------------------
+   global energy and virial from half of K-space stored with r2c FFTs
+   points with 0 < kx < nx_pppm/2 stand for themselves and their
+     mirror image -k, so they are counted twice
+------------------------------------------------------------------------- */
+
+void PPPM::ev_kspace_half(double s2)
+{
+  int i,j,k,m,n;
+  double eng,wgt;
+
+  n = 0;
+  m = 0;
+  for (k = nzlo_fft; k <= nzhi_fft; k++)
+    for (j = nylo_fft; j <= nyhi_fft; j++)
+      for (i = nxlo_fft; i <= nxhi_kspace; i++) {
+        wgt = (i == 0 || 2*i == nx_pppm) ? s2 : 2.0*s2;
+        eng = wgt * greensfn[m] * (work1[n]*work1[n] + work1[n+1]*work1[n+1]);
+        if (vflag_global)
+          for (int iv = 0; iv < 6; iv++) virial[iv] += eng*vg[m][iv];
+        if (eflag_global) energy += eng;
         n += 2;
+        m++;
       }
 }
 
@@ -2343,6 +2566,11 @@ void PPPM::fieldforce()
 
 void PPPM::fieldforce_ik()
 {
+  if (tiling_flag) {
+    fieldforce_ik_tiled();
+    return;
+  }
+
   int i,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz,x0,y0,z0;
   FFT_SCALAR ekx,eky,ekz;
@@ -2401,6 +2629,11 @@ void PPPM::fieldforce_ik()
 
 void PPPM::fieldforce_ad()
 {
+  if (tiling_flag) {
+    fieldforce_ad_tiled();
+    return;
+  }
+
   int i,l,m,n,nx,ny,nz,mx,my,mz;
   FFT_SCALAR dx,dy,dz;
   FFT_SCALAR ekx,eky,ekz;
@@ -2482,6 +2715,264 @@ void PPPM::fieldforce_ad()
   }
 }
 
+/* ----------------------------------------------------------------------
+   stencil weights of a chunk of n particles in SoA layout
+   w[dim][k-klo][a] = weight of stencil pt k in dim for particle a
+     at distance dist[dim][a], as computed by compute_rho1d()
+   coeff = rho_coeff with ncoeff = order, or drho_coeff with order-1
+------------------------------------------------------------------------- */
+
+static void tile_weights(int n, FFT_SCALAR dist[3][TILECHUNK],
+                         FFT_SCALAR w[3][MAXORDER][TILECHUNK],
+                         FFT_SCALAR **coeff, int klo, int khi, int ncoeff)
+{
+  for (int dim = 0; dim < 3; dim++) {
+    const FFT_SCALAR *d = dist[dim];
+    for (int k = klo; k <= khi; k++) {
+      FFT_SCALAR *wk = w[dim][k-klo];
+      for (int a = 0; a < n; a++) wk[a] = ZEROF;
+      for (int l = ncoeff-1; l >= 0; l--) {
+        const FFT_SCALAR c = coeff[l][k];
+        for (int a = 0; a < n; a++) wk[a] = c + wk[a]*d[a];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as make_rho(), but tile by tile as sorted by bin_tiles()
+   stencils of tiles whose indices have the same parity in each dim
+     cannot overlap, so the 8 sets of such tiles are done one after
+     the other and the tiles of one set in parallel by the threads
+------------------------------------------------------------------------- */
+
+void PPPM::make_rho_tiled()
+{
+  memset(&(density_brick[nzlo_out][nylo_out][nxlo_out]),0,
+         ngrid*sizeof(FFT_SCALAR));
+
+  double *q = atom->q;
+  double **x = atom->x;
+  const int ntiles = ntilex*ntiley*ntilez;
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(comm->nthreads) default(shared)
+#endif
+  {
+    FFT_SCALAR dist[3][TILECHUNK];
+    FFT_SCALAR w[3][MAXORDER][TILECHUNK];
+    FFT_SCALAR wx[MAXORDER];
+
+    for (int color = 0; color < 8; color++) {
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+      for (int itile = 0; itile < ntiles; itile++) {
+        const int tx = itile % ntilex;
+        const int ty = (itile / ntilex) % ntiley;
+        const int tz = itile / (ntilex*ntiley);
+        if (((tx & 1) | ((ty & 1) << 1) | ((tz & 1) << 2)) != color) continue;
+
+        for (int first = tile_first[itile]; first < tile_first[itile+1]; first += TILECHUNK) {
+          const int *list = &tile_atoms[first];
+          const int n = MIN(TILECHUNK,tile_first[itile+1]-first);
+
+          for (int a = 0; a < n; a++) {
+            const int i = list[a];
+            dist[0][a] = part2grid[i][0]+shiftone - (x[i][0]-boxlo[0])*delxinv;
+            dist[1][a] = part2grid[i][1]+shiftone - (x[i][1]-boxlo[1])*delyinv;
+            dist[2][a] = part2grid[i][2]+shiftone - (x[i][2]-boxlo[2])*delzinv;
+          }
+          tile_weights(n,dist,w,rho_coeff,nlower,nupper,order);
+
+          for (int a = 0; a < n; a++) {
+            const int i = list[a];
+            const int nx = part2grid[i][0]+nlower;
+            const int ny = part2grid[i][1]+nlower;
+            const int nz = part2grid[i][2]+nlower;
+            for (int l = 0; l < order; l++) wx[l] = w[0][l][a];
+
+            const FFT_SCALAR z0 = delvolinv * q[i];
+            for (int k = 0; k < order; k++) {
+              const FFT_SCALAR y0 = z0*w[2][k][a];
+              for (int m = 0; m < order; m++) {
+                const FFT_SCALAR x0 = y0*w[1][m][a];
+                FFT_SCALAR *rho = &density_brick[nz+k][ny+m][nx];
+                for (int l = 0; l < order; l++) rho[l] += x0*wx[l];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as fieldforce_ik(), but tile by tile as sorted by bin_tiles()
+------------------------------------------------------------------------- */
+
+void PPPM::fieldforce_ik_tiled()
+{
+  double *q = atom->q;
+  double **x = atom->x;
+  double **f = atom->f;
+  const int ntiles = ntilex*ntiley*ntilez;
+  const double qscale = qqrd2e * scale;
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(comm->nthreads) default(shared)
+#endif
+  {
+    FFT_SCALAR dist[3][TILECHUNK];
+    FFT_SCALAR w[3][MAXORDER][TILECHUNK];
+    FFT_SCALAR wx[MAXORDER];
+
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int itile = 0; itile < ntiles; itile++) {
+      for (int first = tile_first[itile]; first < tile_first[itile+1]; first += TILECHUNK) {
+        const int *list = &tile_atoms[first];
+        const int n = MIN(TILECHUNK,tile_first[itile+1]-first);
+
+        for (int a = 0; a < n; a++) {
+          const int i = list[a];
+          dist[0][a] = part2grid[i][0]+shiftone - (x[i][0]-boxlo[0])*delxinv;
+          dist[1][a] = part2grid[i][1]+shiftone - (x[i][1]-boxlo[1])*delyinv;
+          dist[2][a] = part2grid[i][2]+shiftone - (x[i][2]-boxlo[2])*delzinv;
+        }
+        tile_weights(n,dist,w,rho_coeff,nlower,nupper,order);
+
+        for (int a = 0; a < n; a++) {
+          const int i = list[a];
+          const int nx = part2grid[i][0]+nlower;
+          const int ny = part2grid[i][1]+nlower;
+          const int nz = part2grid[i][2]+nlower;
+          for (int l = 0; l < order; l++) wx[l] = w[0][l][a];
+
+          FFT_SCALAR ekx = ZEROF, eky = ZEROF, ekz = ZEROF;
+          for (int k = 0; k < order; k++) {
+            const FFT_SCALAR z0 = w[2][k][a];
+            for (int m = 0; m < order; m++) {
+              const FFT_SCALAR y0 = z0*w[1][m][a];
+              const FFT_SCALAR *vx = &vdx_brick[nz+k][ny+m][nx];
+              const FFT_SCALAR *vy = &vdy_brick[nz+k][ny+m][nx];
+              const FFT_SCALAR *vz = &vdz_brick[nz+k][ny+m][nx];
+              for (int l = 0; l < order; l++) {
+                const FFT_SCALAR x0 = y0*wx[l];
+                ekx -= x0*vx[l];
+                eky -= x0*vy[l];
+                ekz -= x0*vz[l];
+              }
+            }
+          }
+
+          // convert E-field to force
+
+          const double qfactor = qscale * q[i];
+          f[i][0] += qfactor*ekx;
+          f[i][1] += qfactor*eky;
+          if (slabflag != 2) f[i][2] += qfactor*ekz;
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   same as fieldforce_ad(), but tile by tile as sorted by bin_tiles()
+------------------------------------------------------------------------- */
+
+void PPPM::fieldforce_ad_tiled()
+{
+  double *prd = domain->prd;
+  const double hx_inv = nx_pppm/prd[0];
+  const double hy_inv = ny_pppm/prd[1];
+  const double hz_inv = nz_pppm/prd[2];
+
+  double *q = atom->q;
+  double **x = atom->x;
+  double **f = atom->f;
+  const int ntiles = ntilex*ntiley*ntilez;
+  const double qfactor = qqrd2e * scale;
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(comm->nthreads) default(shared)
+#endif
+  {
+    FFT_SCALAR dist[3][TILECHUNK];
+    FFT_SCALAR w[3][MAXORDER][TILECHUNK];
+    FFT_SCALAR dw[3][MAXORDER][TILECHUNK];
+    FFT_SCALAR wx[MAXORDER],dwx[MAXORDER];
+
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+    for (int itile = 0; itile < ntiles; itile++) {
+      for (int first = tile_first[itile]; first < tile_first[itile+1]; first += TILECHUNK) {
+        const int *list = &tile_atoms[first];
+        const int n = MIN(TILECHUNK,tile_first[itile+1]-first);
+
+        for (int a = 0; a < n; a++) {
+          const int i = list[a];
+          dist[0][a] = part2grid[i][0]+shiftone - (x[i][0]-boxlo[0])*delxinv;
+          dist[1][a] = part2grid[i][1]+shiftone - (x[i][1]-boxlo[1])*delyinv;
+          dist[2][a] = part2grid[i][2]+shiftone - (x[i][2]-boxlo[2])*delzinv;
+        }
+        tile_weights(n,dist,w,rho_coeff,nlower,nupper,order);
+        tile_weights(n,dist,dw,drho_coeff,nlower,nupper,order-1);
+
+        for (int a = 0; a < n; a++) {
+          const int i = list[a];
+          const int nx = part2grid[i][0]+nlower;
+          const int ny = part2grid[i][1]+nlower;
+          const int nz = part2grid[i][2]+nlower;
+          for (int l = 0; l < order; l++) {
+            wx[l] = w[0][l][a];
+            dwx[l] = dw[0][l][a];
+          }
+
+          FFT_SCALAR ekx = ZEROF, eky = ZEROF, ekz = ZEROF;
+          for (int k = 0; k < order; k++) {
+            for (int m = 0; m < order; m++) {
+              const FFT_SCALAR *u = &u_brick[nz+k][ny+m][nx];
+              for (int l = 0; l < order; l++) {
+                ekx += dwx[l]*w[1][m][a]*w[2][k][a]*u[l];
+                eky += wx[l]*dw[1][m][a]*w[2][k][a]*u[l];
+                ekz += wx[l]*w[1][m][a]*dw[2][k][a]*u[l];
+              }
+            }
+          }
+          ekx *= hx_inv;
+          eky *= hy_inv;
+          ekz *= hz_inv;
+
+          // convert E-field to force and subtract self forces
+
+          const double s1 = x[i][0]*hx_inv;
+          const double s2 = x[i][1]*hy_inv;
+          const double s3 = x[i][2]*hz_inv;
+          double sf = sf_coeff[0]*sin(2*MY_PI*s1);
+          sf += sf_coeff[1]*sin(4*MY_PI*s1);
+          sf *= 2*q[i]*q[i];
+          f[i][0] += qfactor*(ekx*q[i] - sf);
+
+          sf = sf_coeff[2]*sin(2*MY_PI*s2);
+          sf += sf_coeff[3]*sin(4*MY_PI*s2);
+          sf *= 2*q[i]*q[i];
+          f[i][1] += qfactor*(eky*q[i] - sf);
+
+          sf = sf_coeff[4]*sin(2*MY_PI*s3);
+          sf += sf_coeff[5]*sin(4*MY_PI*s3);
+          sf *= 2*q[i]*q[i];
+          if (slabflag != 2) f[i][2] += qfactor*(ekz*q[i] - sf);
+        }
+      }
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    interpolate from grid to get per-atom energy/virial
 ------------------------------------------------------------------------- */
@@ -2919,17 +3410,17 @@ int PPPM::timing_1d(int n, double &time1d)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < 2*ncomplex; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = platform::walltime();
 
   for (int i = 0; i < n; i++) {
-    fft1->timing1d(work1,nfft_both,FFT3d::FORWARD);
-    fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
+    fft1->timing1d(work1,ncomplex,FFT3d::FORWARD);
+    fft2->timing1d(work1,ncomplex,FFT3d::BACKWARD);
     if (differentiation_flag != 1) {
-      fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
-      fft2->timing1d(work1,nfft_both,FFT3d::BACKWARD);
+      fft2->timing1d(work1,ncomplex,FFT3d::BACKWARD);
+      fft2->timing1d(work1,ncomplex,FFT3d::BACKWARD);
     }
   }
 
@@ -2949,7 +3440,7 @@ int PPPM::timing_3d(int n, double &time3d)
 {
   double time1,time2;
 
-  for (int i = 0; i < 2*nfft_both; i++) work1[i] = ZEROF;
+  for (int i = 0; i < 2*ncomplex; i++) work1[i] = ZEROF;
 
   MPI_Barrier(world);
   time1 = platform::walltime();
@@ -2987,10 +3478,14 @@ double PPPM::memory_usage()
     bytes += (double)4 * nbrick * sizeof(FFT_SCALAR);
   }
 
+  int nkspace = r2c_flag ? nfft_kspace : nfft_both;
   if (triclinic) bytes += (double)3 * nfft_both * sizeof(double);
-  bytes += (double)6 * nfft_both * sizeof(double);
-  bytes += (double)nfft_both * sizeof(double);
-  bytes += (double)nfft_both*5 * sizeof(FFT_SCALAR);
+  bytes += (double)6 * nkspace * sizeof(double);
+  bytes += (double)nkspace * sizeof(double);
+  bytes += (double)nfft_both * sizeof(FFT_SCALAR);
+  bytes += (double)ncomplex*4 * sizeof(FFT_SCALAR);
+
+  if (batch_stride) bytes += (double)6 * batch_stride * sizeof(FFT_SCALAR);
 
   if (peratom_allocate_flag)
     bytes += (double)6 * nbrick * sizeof(FFT_SCALAR);
@@ -3004,6 +3499,10 @@ double PPPM::memory_usage()
 
   bytes += (double)(ngc_buf1 + ngc_buf2) * npergrid * sizeof(FFT_SCALAR);
 
+  // tiles for charge assignment
+
+  bytes += (double)(2 * maxtileatom + maxtile) * sizeof(int);
+
   return bytes;
 }
 
@@ -3025,6 +3524,10 @@ void PPPM::compute_group_group(int groupbit_A, int groupbit_B, int AA_flag)
     error->all(FLERR,"Cannot (yet) use kspace_modify "
                "diff ad with compute group/group");
 
+  if (r2c_flag)
+    error->all(FLERR,"Cannot (yet) use kspace_modify "
+               "r2c yes with compute group/group");
+
   if (!group_allocate_flag) allocate_groups();
 
   // convert atoms from box to lamda coords
@@ -57,6 +57,9 @@ class PPPM : public KSpace {
   int nxlo_fft, nylo_fft, nzlo_fft, nxhi_fft, nyhi_fft, nzhi_fft;
   int nlower, nupper;
   int ngrid, nfft_brick, nfft, nfft_both;
+  int nxhi_kspace;    // upper x index of K-space data, nx_pppm/2 with r2c FFTs
+  int nfft_kspace;    // # of K-space points on this proc
+  int ncomplex;       // # of complex values in work1 and work2
 
   FFT_SCALAR ***density_brick;
   FFT_SCALAR ***vdx_brick, ***vdy_brick, ***vdz_brick;
@@ -68,6 +71,8 @@ class PPPM : public KSpace {
   double *fkx, *fky, *fkz;
   FFT_SCALAR *density_fft;
   FFT_SCALAR *work1, *work2;
+  FFT_SCALAR *workvd;    // 3 data sets for batched FFTs of the gradients
+  int batch_stride;      // # of complex values per data set in workvd, 0 if not used
 
   double *gf_b;
   FFT_SCALAR **rho1d, **rho_coeff, **drho1d, **drho_coeff;
@@ -94,6 +99,12 @@ class PPPM : public KSpace {
   int **part2grid;    // storage for particle -> grid mapping
   int nmax;
 
+  int ntilex, ntiley, ntilez;    // # of tiles of grid cells in each dim
+  int *tile_first;               // index of 1st atom of each tile in tile_atoms
+  int *tile_atoms;               // local atoms sorted by tile of their stencil
+  int *atom2tile;                // tile of each local atom
+  int maxtile, maxtileatom;
+
   double *boxlo;
   // TIP4P settings
   int typeH, typeO;    // atom types of TIP4P water H and O atoms
@@ -119,6 +130,7 @@ class PPPM : public KSpace {
   virtual void compute_gf_ik();
   virtual void compute_gf_ad();
   void compute_sf_precoeff();
+  void compute_sf_precoeff_one(int, int, int, double *);
 
   virtual void particle_map();
   virtual void make_rho();
@@ -132,7 +144,13 @@ class PPPM : public KSpace {
   virtual void fieldforce_ik();
   virtual void fieldforce_ad();
 
+  void bin_tiles();
+  void make_rho_tiled();
+  void fieldforce_ik_tiled();
+  void fieldforce_ad_tiled();
+
   virtual void poisson_peratom();
+  void ev_kspace_half(double);
   virtual void fieldforce_peratom();
   void procs2grid2d(int, int, int, int *, int *);
   void compute_rho1d(const FFT_SCALAR &, const FFT_SCALAR &, const FFT_SCALAR &);
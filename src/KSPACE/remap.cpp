@@ -23,6 +23,12 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static void remap_3d_nonblocking(FFT_SCALAR *, FFT_SCALAR *, int, int, int,
+                                 struct remap_plan_3d *,
+                                 void (*)(FFT_SCALAR *, void *), void *);
+static void remap_3d_setup_batch(struct remap_plan_3d *, int);
+static void remap_3d_free_batch(struct remap_plan_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d remaps:
 
@@ -65,7 +71,7 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
 {
   // use point-to-point communication
 
-  if (!plan->usecollective) {
+  if (plan->usecollective == REMAP_P2P) {
     int i,isend,irecv;
     FFT_SCALAR *scratch;
 
@@ -110,96 +116,214 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
                    &out[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
     }
 
+  // use non-blocking communication with persistent requests
+
+  } else if (plan->usecollective == REMAP_NONBLOCKING) {
+    remap_3d_nonblocking(in,out,1,0,0,plan,nullptr,nullptr);
+
   // use All2Allv collective for remap communication
+  // counts, offsets, and buffers were set up with the plan
 
   } else {
     if (plan->commringlen > 0) {
-      int isend,irecv;
-
-      // create send and recv buffers for alltoallv collective
-
-      int sendBufferSize = 0;
-      int recvBufferSize = 0;
-      for (int i=0;i<plan->nsend;i++)
-        sendBufferSize += plan->send_size[i];
-      for (int i=0;i<plan->nrecv;i++)
-        recvBufferSize += plan->recv_size[i];
-
-      auto packedSendBuffer = (FFT_SCALAR *) malloc(sizeof(FFT_SCALAR) * sendBufferSize);
-      auto packedRecvBuffer = (FFT_SCALAR *) malloc(sizeof(FFT_SCALAR) * recvBufferSize);
-
-      int *sendcnts = (int *) malloc(sizeof(int) * plan->commringlen);
-      int *rcvcnts = (int *) malloc(sizeof(int) * plan->commringlen);
-      int *sdispls = (int *) malloc(sizeof(int) * plan->commringlen);
-      int *rdispls = (int *) malloc(sizeof(int) * plan->commringlen);
-      int *nrecvmap = (int *) malloc(sizeof(int) * plan->commringlen);
-
-      // create and populate send data, count and displacement buffers
-
-      int currentSendBufferOffset = 0;
-      for (isend = 0; isend < plan->commringlen; isend++) {
-        sendcnts[isend] = 0;
-        sdispls[isend] = 0;
-        int foundentry = 0;
-        for (int i=0;(i<plan->nsend && !foundentry); i++) {
-          if (plan->send_proc[i] == plan->commringlist[isend]) {
-            foundentry = 1;
-            sendcnts[isend] = plan->send_size[i];
-            sdispls[isend] = currentSendBufferOffset;
-            plan->pack(&in[plan->send_offset[i]],
-                       &packedSendBuffer[currentSendBufferOffset],
-                       &plan->packplan[i]);
-            currentSendBufferOffset += plan->send_size[i];
-          }
-        }
+      int iring;
+
+      for (iring = 0; iring < plan->commringlen; iring++) {
+        const int isend = plan->sendmap[iring];
+        if (isend >= 0)
+          plan->pack(&in[plan->send_offset[isend]],
+                     &plan->packedsend[plan->sdispls[iring]],
+                     &plan->packplan[isend]);
       }
 
-      // create and populate recv count and displacement buffers
-
-      int currentRecvBufferOffset = 0;
-      for (irecv = 0; irecv < plan->commringlen; irecv++) {
-        rcvcnts[irecv] = 0;
-        rdispls[irecv] = 0;
-        nrecvmap[irecv] = -1;
-        int foundentry = 0;
-        for (int i=0;(i<plan->nrecv && !foundentry); i++) {
-          if (plan->recv_proc[i] == plan->commringlist[irecv]) {
-            foundentry = 1;
-            rcvcnts[irecv] = plan->recv_size[i];
-            rdispls[irecv] = currentRecvBufferOffset;
-            currentRecvBufferOffset += plan->recv_size[i];
-            nrecvmap[irecv] = i;
-          }
-        }
-      }
-
-      MPI_Alltoallv(packedSendBuffer, sendcnts, sdispls,
-                    MPI_FFT_SCALAR, packedRecvBuffer, rcvcnts,
-                    rdispls, MPI_FFT_SCALAR, plan->comm);
+      MPI_Alltoallv(plan->packedsend, plan->sendcnts, plan->sdispls,
+                    MPI_FFT_SCALAR, plan->packedrecv, plan->rcvcnts,
+                    plan->rdispls, MPI_FFT_SCALAR, plan->comm);
 
       // unpack the data from the recv buffer into out
 
-      currentRecvBufferOffset = 0;
-      for (irecv = 0; irecv < plan->commringlen; irecv++) {
-        if (nrecvmap[irecv] > -1) {
-          plan->unpack(&packedRecvBuffer[currentRecvBufferOffset],
-                       &out[plan->recv_offset[nrecvmap[irecv]]],
-                       &plan->unpackplan[nrecvmap[irecv]]);
-          currentRecvBufferOffset += plan->recv_size[nrecvmap[irecv]];
-        }
+      for (iring = 0; iring < plan->commringlen; iring++) {
+        const int irecv = plan->recvmap[iring];
+        if (irecv >= 0)
+          plan->unpack(&plan->packedrecv[plan->rdispls[iring]],
+                       &out[plan->recv_offset[irecv]],
+                       &plan->unpackplan[irecv]);
       }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d remap of nbatch data sets in place
+
+   Arguments:
+   data         starting address of 1st data set on this proc
+   nbatch       # of data sets
+   stride       distance between the start of two data sets,
+                  must be large enough for input and output of the remap
+   buf          extra memory required for remap, as for remap_3d()
+   plan         plan returned by previous call to remap_3d_create_plan
+   ready        function called with the address of each data set
+                  as soon as its remap is complete, can be nullptr
+   ptr          passed on to ready()
+
+   with non-blocking remaps, the messages of all data sets are in flight
+     together and ready() can work on one data set while others arrive
+------------------------------------------------------------------------- */
+
+void remap_3d_batch(FFT_SCALAR *data, int nbatch, int stride, FFT_SCALAR *buf,
+                    struct remap_plan_3d *plan,
+                    void (*ready)(FFT_SCALAR *, void *), void *ptr)
+{
+  if (plan->usecollective == REMAP_NONBLOCKING) {
+    remap_3d_nonblocking(data,data,nbatch,stride,stride,plan,ready,ptr);
+    return;
+  }
+
+  for (int ibatch = 0; ibatch < nbatch; ibatch++) {
+    FFT_SCALAR *one = &data[(size_t) ibatch*stride];
+    remap_3d(one,one,buf,plan);
+    if (ready) ready(one,ptr);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Non-blocking remap of nbatch data sets via persistent requests
+   data set i is read from in + i*instride, written to out + i*outstride
+   all data is packed before any is unpacked, so in can be the same as out
+   each send is started as soon as it is packed
+   messages are unpacked in the order they arrive
+------------------------------------------------------------------------- */
+
+static void remap_3d_nonblocking(FFT_SCALAR *in, FFT_SCALAR *out, int nbatch,
+                                 int instride, int outstride,
+                                 struct remap_plan_3d *plan,
+                                 void (*ready)(FFT_SCALAR *, void *), void *ptr)
+{
+  int i,ibatch,isend,irecv,ireq;
+
+  if (nbatch > plan->nbatch) remap_3d_setup_batch(plan,nbatch);
 
-      // free temporary data structures
+  const int nsend = plan->nsend;
+  const int nrecv = plan->nrecv;
+  FFT_SCALAR *sendbuf = plan->sendbuf;
+  FFT_SCALAR *recvbuf = plan->recvbuf;
 
-      free(sendcnts);
-      free(rcvcnts);
-      free(sdispls);
-      free(rdispls);
-      free(nrecvmap);
-      free(packedSendBuffer);
-      free(packedRecvBuffer);
+  // post all recvs
+
+  for (i = 0; i < nbatch*nrecv; i++) MPI_Start(&plan->recvreq[i]);
+
+  // pack and start sends, one data set after the other
+
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    const size_t inoffset = (size_t) ibatch*instride;
+    const size_t bufoffset = (size_t) ibatch*plan->sendtotal;
+    for (isend = 0; isend < nsend; isend++) {
+      plan->pack(&in[inoffset + plan->send_offset[isend]],
+                 &sendbuf[bufoffset + plan->send_bufloc[isend]],
+                 &plan->packplan[isend]);
+      MPI_Start(&plan->sendreq[ibatch*nsend + isend]);
     }
   }
+
+  // pack self data of all data sets before any data is unpacked
+
+  if (plan->self) {
+    for (ibatch = 0; ibatch < nbatch; ibatch++)
+      plan->pack(&in[(size_t) ibatch*instride + plan->send_offset[nsend]],
+                 &recvbuf[(size_t) ibatch*plan->recvtotal + plan->recv_bufloc[nrecv]],
+                 &plan->packplan[nsend]);
+  }
+
+  // unpack self data, data sets without recvs are complete
+
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    FFT_SCALAR *one = &out[(size_t) ibatch*outstride];
+    if (plan->self)
+      plan->unpack(&recvbuf[(size_t) ibatch*plan->recvtotal + plan->recv_bufloc[nrecv]],
+                   &one[plan->recv_offset[nrecv]],&plan->unpackplan[nrecv]);
+    plan->pending[ibatch] = nrecv;
+    if (nrecv == 0 && ready) ready(one,ptr);
+  }
+
+  // unpack messages as they arrive
+  // hand each data set to ready() once all its messages are unpacked
+
+  for (i = 0; i < nbatch*nrecv; i++) {
+    MPI_Waitany(nbatch*nrecv,plan->recvreq,&ireq,MPI_STATUS_IGNORE);
+    ibatch = ireq / nrecv;
+    irecv = ireq % nrecv;
+    FFT_SCALAR *one = &out[(size_t) ibatch*outstride];
+    plan->unpack(&recvbuf[(size_t) ibatch*plan->recvtotal + plan->recv_bufloc[irecv]],
+                 &one[plan->recv_offset[irecv]],&plan->unpackplan[irecv]);
+    plan->pending[ibatch]--;
+    if (plan->pending[ibatch] == 0 && ready) ready(one,ptr);
+  }
+
+  if (nsend) MPI_Waitall(nbatch*nsend,plan->sendreq,MPI_STATUS_IGNORE);
+}
+
+/* ----------------------------------------------------------------------
+   (re)allocate buffers and persistent requests of a non-blocking remap
+     for up to nbatch data sets
+   message tag is the index of the data set
+------------------------------------------------------------------------- */
+
+static void remap_3d_setup_batch(struct remap_plan_3d *plan, int nbatch)
+{
+  int i,ibatch;
+
+  remap_3d_free_batch(plan);
+
+  const int nsend = plan->nsend;
+  const int nrecv = plan->nrecv;
+
+  plan->nbatch = nbatch;
+  plan->sendbuf = nullptr;
+  plan->recvbuf = nullptr;
+  plan->sendreq = nullptr;
+  plan->recvreq = nullptr;
+
+  if (plan->sendtotal)
+    plan->sendbuf = (FFT_SCALAR *) malloc((size_t) nbatch*plan->sendtotal*sizeof(FFT_SCALAR));
+  if (plan->recvtotal)
+    plan->recvbuf = (FFT_SCALAR *) malloc((size_t) nbatch*plan->recvtotal*sizeof(FFT_SCALAR));
+  if (nsend) plan->sendreq = (MPI_Request *) malloc(nbatch*nsend*sizeof(MPI_Request));
+  if (nrecv) plan->recvreq = (MPI_Request *) malloc(nbatch*nrecv*sizeof(MPI_Request));
+  plan->pending = (int *) malloc(nbatch*sizeof(int));
+
+  for (ibatch = 0; ibatch < nbatch; ibatch++) {
+    for (i = 0; i < nsend; i++)
+      MPI_Send_init(&plan->sendbuf[(size_t) ibatch*plan->sendtotal + plan->send_bufloc[i]],
+                    plan->send_size[i],MPI_FFT_SCALAR,plan->send_proc[i],ibatch,
+                    plan->comm,&plan->sendreq[ibatch*nsend + i]);
+    for (i = 0; i < nrecv; i++)
+      MPI_Recv_init(&plan->recvbuf[(size_t) ibatch*plan->recvtotal + plan->recv_bufloc[i]],
+                    plan->recv_size[i],MPI_FFT_SCALAR,plan->recv_proc[i],ibatch,
+                    plan->comm,&plan->recvreq[ibatch*nrecv + i]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   free buffers and persistent requests of a non-blocking remap
+------------------------------------------------------------------------- */
+
+static void remap_3d_free_batch(struct remap_plan_3d *plan)
+{
+  if (plan->nbatch == 0) return;
+
+  for (int i = 0; i < plan->nbatch*plan->nsend; i++) MPI_Request_free(&plan->sendreq[i]);
+  for (int i = 0; i < plan->nbatch*plan->nrecv; i++) MPI_Request_free(&plan->recvreq[i]);
+
+  free(plan->sendbuf);
+  free(plan->recvbuf);
+  free(plan->sendreq);
+  free(plan->recvreq);
+  free(plan->pending);
+
+  plan->sendbuf = nullptr;
+  plan->recvbuf = nullptr;
+  plan->nbatch = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -224,7 +348,11 @@ void remap_3d(FFT_SCALAR *in, FFT_SCALAR *out, FFT_SCALAR *buf,
    precision            precision of data
                           1 = single precision (4 bytes per datum)
                           2 = double precision (8 bytes per datum)
-   usecollective        whether to use collective MPI or point-to-point
+   usecollective        communication pattern of remap
+                          0 = point-to-point with blocking sends
+                          1 = MPI_Alltoallv collective
+                          2 = non-blocking point-to-point with
+                              persistent requests, uses own buffers
 ------------------------------------------------------------------------- */
 
 struct remap_plan_3d *remap_3d_create_plan(
@@ -252,6 +380,12 @@ struct remap_plan_3d *remap_3d_create_plan(
   plan = (struct remap_plan_3d *) malloc(sizeof(struct remap_plan_3d));
   if (plan == nullptr) return nullptr;
   plan->usecollective = usecollective;
+  plan->commringlist = nullptr;
+  plan->sendcnts = plan->sdispls = plan->rcvcnts = plan->rdispls = nullptr;
+  plan->sendmap = plan->recvmap = nullptr;
+  plan->packedsend = plan->packedrecv = nullptr;
+  plan->send_bufloc = nullptr;
+  plan->nbatch = 0;
 
   // store parameters in local data structs
 
@@ -341,7 +475,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // plan->nsend = # of sends not including self
 
   if (nsend && plan->send_proc[nsend-1] == me) {
-    if (plan->usecollective) // for collectives include self in nsend list
+    if (plan->usecollective == REMAP_COLLECTIVE) // for collectives include self in nsend list
       plan->nsend = nsend;
     else
       plan->nsend = nsend - 1;
@@ -453,9 +587,7 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   // create sub-comm rank list
 
-  if (plan->usecollective) {
-    plan->commringlist = nullptr;
-
+  if (plan->usecollective == REMAP_COLLECTIVE) {
     // merge recv and send rank lists
     // ask Steve Plimpton about method to more accurately determine
     // maximum number of procs contributing to pencil
@@ -558,7 +690,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // for collectives include self in the nsend list
 
   if (nrecv && plan->recv_proc[nrecv-1] == me) {
-    if (plan->usecollective) plan->nrecv = nrecv;
+    if (plan->usecollective == REMAP_COLLECTIVE) plan->nrecv = nrecv;
     else plan->nrecv = nrecv - 1;
   } else plan->nrecv = nrecv;
 
@@ -582,7 +714,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   for (nsend = 0; nsend < plan->nsend; nsend++)
     size = MAX(size,plan->send_size[nsend]);
 
-  if (size) {
+  if (size && plan->usecollective != REMAP_NONBLOCKING) {
     plan->sendbuf = (FFT_SCALAR *) malloc(size*sizeof(FFT_SCALAR));
     if (plan->sendbuf == nullptr) return nullptr;
   }
@@ -592,7 +724,7 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   plan->scratch = nullptr;
 
-  if (memory == 1) {
+  if (memory == 1 && plan->usecollective != REMAP_NONBLOCKING) {
     if (nrecv > 0) {
       plan->scratch =
         (FFT_SCALAR *) malloc((size_t)nqty*out.isize*out.jsize*out.ksize *
@@ -601,11 +733,69 @@ struct remap_plan_3d *remap_3d_create_plan(
     }
   }
 
+  // for collectives, set up counts, offsets, and buffers for alltoallv
+  // sendmap/recvmap = index of send/recv with each rank on the ring
+
+  if (plan->usecollective == REMAP_COLLECTIVE && plan->commringlen > 0) {
+    const int len = plan->commringlen;
+    plan->sendcnts = (int *) malloc(len*sizeof(int));
+    plan->sdispls = (int *) malloc(len*sizeof(int));
+    plan->rcvcnts = (int *) malloc(len*sizeof(int));
+    plan->rdispls = (int *) malloc(len*sizeof(int));
+    plan->sendmap = (int *) malloc(len*sizeof(int));
+    plan->recvmap = (int *) malloc(len*sizeof(int));
+
+    int sendtotal = 0;
+    int recvtotal = 0;
+    for (i = 0; i < len; i++) {
+      plan->sendcnts[i] = plan->sdispls[i] = 0;
+      plan->sendmap[i] = -1;
+      for (j = 0; j < plan->nsend; j++) {
+        if (plan->send_proc[j] == plan->commringlist[i]) {
+          plan->sendcnts[i] = plan->send_size[j];
+          plan->sdispls[i] = sendtotal;
+          plan->sendmap[i] = j;
+          sendtotal += plan->send_size[j];
+          break;
+        }
+      }
+      plan->rcvcnts[i] = plan->rdispls[i] = 0;
+      plan->recvmap[i] = -1;
+      for (j = 0; j < plan->nrecv; j++) {
+        if (plan->recv_proc[j] == plan->commringlist[i]) {
+          plan->rcvcnts[i] = plan->recv_size[j];
+          plan->rdispls[i] = recvtotal;
+          plan->recvmap[i] = j;
+          recvtotal += plan->recv_size[j];
+          break;
+        }
+      }
+    }
+
+    plan->packedsend = (FFT_SCALAR *) malloc((size_t) MAX(sendtotal,1)*sizeof(FFT_SCALAR));
+    plan->packedrecv = (FFT_SCALAR *) malloc((size_t) MAX(recvtotal,1)*sizeof(FFT_SCALAR));
+    if (plan->packedsend == nullptr || plan->packedrecv == nullptr) return nullptr;
+  }
+
+  // for non-blocking remaps, each send gets its own place in sendbuf,
+  // recvs use the same layout as in scratch
+
+  if (plan->usecollective == REMAP_NONBLOCKING) {
+    plan->send_bufloc = (int *) malloc(MAX(plan->nsend,1)*sizeof(int));
+    plan->sendtotal = 0;
+    for (i = 0; i < plan->nsend; i++) {
+      plan->send_bufloc[i] = plan->sendtotal;
+      plan->sendtotal += plan->send_size[i];
+    }
+    plan->recvtotal = 0;
+    for (i = 0; i < nrecv; i++) plan->recvtotal += plan->recv_size[i];
+  }
+
   // if using collective and the commringlist is NOT empty create a
   // communicator for the plan based off an MPI_Group created with
   // ranks from the commringlist
 
-  if ((plan->usecollective && (plan->commringlen > 0))) {
+  if ((plan->usecollective == REMAP_COLLECTIVE) && (plan->commringlen > 0)) {
     MPI_Group orig_group, new_group;
     MPI_Comm_group(comm, &orig_group);
     MPI_Group_incl(orig_group, plan->commringlen,
@@ -616,7 +806,7 @@ struct remap_plan_3d *remap_3d_create_plan(
   // if using collective and the comm ring list is empty create
   // a communicator for the plan with an empty group
 
-  else if ((plan->usecollective) && (plan->commringlen == 0)) {
+  else if ((plan->usecollective == REMAP_COLLECTIVE) && (plan->commringlen == 0)) {
     MPI_Comm_create(comm, MPI_GROUP_EMPTY, &plan->comm);
   }
 
@@ -624,6 +814,10 @@ struct remap_plan_3d *remap_3d_create_plan(
 
   else MPI_Comm_dup(comm,&plan->comm);
 
+  // persistent requests of non-blocking remaps for a single data set
+
+  if (plan->usecollective == REMAP_NONBLOCKING) remap_3d_setup_batch(plan,1);
+
   // return pointer to plan
 
   return plan;
@@ -637,12 +831,27 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
 {
   // free MPI communicator
 
-  if (!(plan->usecollective) || (plan->commringlen != 0))
+  // free persistent requests before their communicator
+
+  if (plan->usecollective == REMAP_NONBLOCKING) {
+    remap_3d_free_batch(plan);
+    free(plan->send_bufloc);
+  }
+
+  if ((plan->usecollective != REMAP_COLLECTIVE) || (plan->commringlen != 0))
     MPI_Comm_free(&plan->comm);
 
-  if (plan->usecollective) {
+  if (plan->usecollective == REMAP_COLLECTIVE) {
     if (plan->commringlist != nullptr)
       free(plan->commringlist);
+    free(plan->sendcnts);
+    free(plan->sdispls);
+    free(plan->rcvcnts);
+    free(plan->rdispls);
+    free(plan->sendmap);
+    free(plan->recvmap);
+    free(plan->packedsend);
+    free(plan->packedrecv);
   }
 
   // free internal arrays
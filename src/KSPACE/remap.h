@@ -15,6 +15,10 @@
 
 #include "lmpfftsettings.h"
 
+// communication pattern of a 3d remap, set by usecollective
+
+enum { REMAP_P2P = 0, REMAP_COLLECTIVE = 1, REMAP_NONBLOCKING = 2 };
+
 // details of how to do a 3d remap
 
 struct remap_plan_3d {
@@ -42,6 +46,26 @@ struct remap_plan_3d {
   int usecollective;                  // use collective or point-to-point MPI
   int commringlen;                    // length of commringlist
   int *commringlist;                  // ranks on communication ring of this plan
+
+  // persistent data for collective remaps
+
+  int *sendcnts, *sdispls;          // send count and offset for each rank on ring
+  int *rcvcnts, *rdispls;           // recv count and offset for each rank on ring
+  int *sendmap, *recvmap;           // send/recv index for each rank on ring, -1 if none
+  FFT_SCALAR *packedsend;           // send buffer for alltoallv
+  FFT_SCALAR *packedrecv;           // recv buffer for alltoallv
+
+  // persistent data for non-blocking remaps
+  // messages of all data sets of a batched remap are in flight together
+
+  int *send_bufloc;                 // offset in sendbuf of each send
+  int sendtotal;                    // size of all sends of one data set
+  int recvtotal;                    // size of all recvs of one data set, including self
+  int nbatch;                       // # of data sets buffers and requests are set up for
+  MPI_Request *sendreq;             // persistent send request for each send and data set
+  MPI_Request *recvreq;             // persistent recv request for each recv and data set
+  FFT_SCALAR *recvbuf;              // buffer for all recvs of all data sets
+  int *pending;                     // # of recvs still missing for each data set
 };
 
 // collision between 2 regions
@@ -55,6 +79,8 @@ struct extent_3d {
 // function prototypes
 
 void remap_3d(FFT_SCALAR *, FFT_SCALAR *, FFT_SCALAR *, struct remap_plan_3d *);
+void remap_3d_batch(FFT_SCALAR *, int, int, FFT_SCALAR *, struct remap_plan_3d *,
+                    void (*)(FFT_SCALAR *, void *), void *);
 struct remap_plan_3d *remap_3d_create_plan(MPI_Comm, int, int, int, int, int, int, int, int, int,
                                            int, int, int, int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
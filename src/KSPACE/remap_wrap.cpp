@@ -15,9 +15,15 @@
 #include "remap_wrap.h"
 
 #include "error.h"
+#include "plan_cache.h"
 
 using namespace LAMMPS_NS;
 
+static void destroy_plan(void *ptr)
+{
+  remap_3d_destroy_plan((struct remap_plan_3d *) ptr);
+}
+
 /* ---------------------------------------------------------------------- */
 
 Remap::Remap(LAMMPS *lmp, MPI_Comm comm,
@@ -28,18 +34,29 @@ Remap::Remap(LAMMPS *lmp, MPI_Comm comm,
              int nqty, int permute, int memory,
              int precision, int usecollective) : Pointers(lmp)
 {
+  // reuse a cached plan if one was created before with the same settings
+  // the key has a different length than those of FFT3d plans
+
+  std::vector<int> key = {in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
+                          out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
+                          nqty,permute,memory,precision,usecollective};
+  int nbuf;
+  plan = (struct remap_plan_3d *) PlanCache::acquire(comm,key,&nbuf);
+  if (plan) return;
+
   plan = remap_3d_create_plan(comm,
                               in_ilo,in_ihi,in_jlo,in_jhi,in_klo,in_khi,
                               out_ilo,out_ihi,out_jlo,out_jhi,out_klo,out_khi,
                               nqty,permute,memory,precision,usecollective);
   if (plan == nullptr) error->one(FLERR,"Could not create 3d remap plan");
+  PlanCache::insert(comm,key,plan,0,destroy_plan);
 }
 
 /* ---------------------------------------------------------------------- */
 
 Remap::~Remap()
 {
-  remap_3d_destroy_plan(plan);
+  PlanCache::release(plan);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -87,6 +87,8 @@ DumpNetCDF::DumpNetCDF(LAMMPS *lmp, int narg, char **arg) :
   sortcol = 0;
   binary = 1;
   flush_flag = 0;
+  mpiio_allow = 0;
+  async_allow = 0;
 
   if (multiproc)
     error->all(FLERR,"Multi-processor writes are not supported.");
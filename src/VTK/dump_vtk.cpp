@@ -108,6 +108,8 @@ DumpVTK::DumpVTK(LAMMPS *lmp, int narg, char **arg) :
   DumpCustom(lmp, narg, arg)
 {
   if (narg == 5) error->all(FLERR,"No dump vtk arguments specified");
+  mpiio_allow = 0;
+  async_allow = 0;
 
   pack_choice.clear();
   vtype.clear();
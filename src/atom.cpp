@@ -39,6 +39,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
+#include <vector>
 
 #ifdef LMP_GPU
 #include "fix_gpu.h"
@@ -103,8 +105,10 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp), atom_style(nullptr), avec(nullptr), a
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
+  sortorder = SORT_BIN;
   maxbin = maxnext = 0;
   binhead = nullptr;
+  binorder = nullptr;
   next = permute = nullptr;
 
   // --------------------------------------------------------------------
@@ -294,6 +298,7 @@ Atom::~Atom()
 
   delete[] firstgroupname;
   memory->destroy(binhead);
+  memory->destroy(binorder);
   memory->destroy(next);
   memory->destroy(permute);
 
@@ -379,6 +384,7 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortorder = old->sortorder;
   if (old->firstgroupname)
     firstgroupname = utils::strdup(old->firstgroupname);
 }
@@ -843,6 +849,20 @@ void Atom::modify_params(int narg, char **arg)
       }
       iarg += 2;
     } else if (strcmp(arg[iarg],"sort") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort", error);
+      if (strcmp(arg[iarg+1],"bin") == 0) {
+        sortorder = SORT_BIN;
+        iarg += 2;
+        continue;
+      } else if (strcmp(arg[iarg+1],"morton") == 0) {
+        sortorder = SORT_MORTON;
+        iarg += 2;
+        continue;
+      } else if (strcmp(arg[iarg+1],"hilbert") == 0) {
+        sortorder = SORT_HILBERT;
+        iarg += 2;
+        continue;
+      }
       if (iarg+3 > narg) utils::missing_cmd_args(FLERR, "atom_modify sort", error);
       sortfreq = utils::inumeric(FLERR,arg[iarg+1],false,lmp);
       userbinsize = utils::numeric(FLERR,arg[iarg+2],false,lmp);
@@ -1046,7 +1066,7 @@ void Atom::deallocate_topology()
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel, int triclinic_general)
+                      int labelflag, int *ilabel, int triclinic_general, int localflag)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1056,10 +1076,17 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   std::string typestr;
   auto location = "Atoms section of data file";
 
+  // with localflag, only this proc has seen these lines, so errors cannot be collective
+
+  auto data_error = [&](const std::string &mesg) {
+    if (localflag) error->one(FLERR, mesg);
+    error->all(FLERR, mesg);
+  };
+
   // use the first line to detect and validate the number of words/tokens per line
 
   next = strchr(buf,'\n');
-  if (!next) error->all(FLERR, "Missing data in {}", location);
+  if (!next) data_error(fmt::format("Missing data in {}", location));
   *next = '\0';
   auto values = Tokenizer(buf).as_vector();
   int nwords = values.size();
@@ -1071,8 +1098,8 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
   }
 
   if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
-    error->all(FLERR,"Incorrect format in {}: {}{}", location,
-               utils::trim(buf), utils::errorurl(2));
+    data_error(fmt::format("Incorrect format in {}: {}{}", location,
+                           utils::trim(buf), utils::errorurl(2)));
 
   *next = '\n';
 
@@ -1091,8 +1118,23 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     epsilon[2] = domain->prd[2] * EPSILON;
   }
 
+  // with localflag, keep every atom inside the global box,
+  //   the caller migrates them to their owning procs
+
   double sublo[3],subhi[3];
-  if (triclinic == 0) {
+  if (localflag) {
+    if (triclinic == 0) {
+      for (int dim = 0; dim < 3; dim++) {
+        sublo[dim] = domain->boxlo[dim];
+        subhi[dim] = domain->boxhi[dim];
+      }
+    } else {
+      for (int dim = 0; dim < 3; dim++) {
+        sublo[dim] = 0.0;
+        subhi[dim] = 1.0;
+      }
+    }
+  } else if (triclinic == 0) {
     sublo[0] = domain->sublo[0]; subhi[0] = domain->subhi[0];
     sublo[1] = domain->sublo[1]; subhi[1] = domain->subhi[1];
     sublo[2] = domain->sublo[2]; subhi[2] = domain->subhi[2];
@@ -1102,7 +1144,15 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
   }
 
-  if (comm->layout != Comm::LAYOUT_TILED) {
+  if (localflag) {
+    for (int dim = 0; dim < 3; dim++) {
+      if (domain->periodicity[dim]) {
+        sublo[dim] -= epsilon[dim];
+        subhi[dim] += epsilon[dim];
+      }
+    }
+
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
     if (domain->xperiodic) {
       if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
       if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
@@ -1147,7 +1197,7 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
-    if (!next) error->all(FLERR, "Missing data in {}", location);
+    if (!next) data_error(fmt::format("Missing data in {}", location));
     *next = '\0';
     auto values = Tokenizer(buf).as_vector();
     int nvalues = values.size();
@@ -1160,19 +1210,19 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
 
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
-      error->all(FLERR, "Incorrect format in {}: {}{}", location,
-                 utils::trim(buf), utils::errorurl(2));
+      data_error(fmt::format("Incorrect format in {}: {}{}", location,
+                             utils::trim(buf), utils::errorurl(2)));
 
     // extract the atom coords and image flags (if they exist)
 
     } else {
       int imx = 0, imy = 0, imz = 0;
       if (imageflag) {
-        imx = utils::inumeric(FLERR,values[iptr],false,lmp);
-        imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
-        imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
+        imx = utils::inumeric(FLERR,values[iptr],localflag,lmp);
+        imy = utils::inumeric(FLERR,values[iptr+1],localflag,lmp);
+        imz = utils::inumeric(FLERR,values[iptr+2],localflag,lmp);
         if ((dimension == 2) && (imz != 0))
-          error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+          data_error("Z-direction image flag must be 0 for 2d-systems");
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
@@ -1181,16 +1231,16 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
         (((imageint) (imy + IMGMAX) & IMGMASK) << IMGBITS) |
         (((imageint) (imz + IMGMAX) & IMGMASK) << IMG2BITS);
 
-      xdata[0] = utils::numeric(FLERR,values[xptr],false,lmp);
-      xdata[1] = utils::numeric(FLERR,values[xptr+1],false,lmp);
-      xdata[2] = utils::numeric(FLERR,values[xptr+2],false,lmp);
+      xdata[0] = utils::numeric(FLERR,values[xptr],localflag,lmp);
+      xdata[1] = utils::numeric(FLERR,values[xptr+1],localflag,lmp);
+      xdata[2] = utils::numeric(FLERR,values[xptr+2],localflag,lmp);
 
       // for 2d simulation:
       // check if z coord is within EPS_ZCOORD of zero and set to zero
 
       if (dimension == 2) {
         if (fabs(xdata[2]) > EPS_ZCOORD)
-          error->all(FLERR,"Read_data atom z coord is non-zero for 2d simulation");
+          data_error("Read_data atom z coord is non-zero for 2d simulation");
         xdata[2] = 0.0;
       }
 
@@ -1266,27 +1316,34 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
    call style-specific routine to parse line-
 ------------------------------------------------------------------------ */
 
-void Atom::data_vels(int n, char *buf, tagint id_offset)
+void Atom::data_vels(int n, char *buf, tagint id_offset, int localflag)
 {
   int m;
   char *next;
 
+  // with localflag, only this proc has seen these lines, so errors cannot be collective
+
+  auto data_error = [&](const std::string &mesg) {
+    if (localflag) error->one(FLERR, mesg);
+    error->all(FLERR, mesg);
+  };
+
   // loop over lines of atom velocities
   // tokenize the line into values
   // if I own atom tag, unpack its values
 
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
-    if (!next) error->all(FLERR, "Missing data in Velocities section of data file");
+    if (!next) data_error("Missing data in Velocities section of data file");
     *next = '\0';
     auto values = Tokenizer(utils::trim_comment(buf)).as_vector();
     if (values.size() == 0) {
       // skip over empty or comment lines
     } else if ((int)values.size() != avec->size_data_vel) {
-      error->all(FLERR, "Incorrect format in Velocities section of data file: {}{}",
-                 utils::trim(buf), utils::errorurl(2));
+      data_error(fmt::format("Incorrect format in Velocities section of data file: {}{}",
+                             utils::trim(buf), utils::errorurl(2)));
     } else {
-      tagint tagdata = utils::tnumeric(FLERR,values[0],false,lmp) + id_offset;
+      tagint tagdata = utils::tnumeric(FLERR,values[0],localflag,lmp) + id_offset;
       if (tagdata <= 0 || tagdata > map_tag_max)
         error->one(FLERR,"Invalid atom ID {} in Velocities section of data file: {}", tagdata, buf);
       if ((m = map(tagdata)) >= 0) avec->data_vel(m,values);
@@ -1303,7 +1360,7 @@ void Atom::data_vels(int n, char *buf, tagint id_offset)
 ------------------------------------------------------------------------- */
 
 void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
-                      int type_offset, int labelflag, int *ilabel)
+                      int type_offset, int labelflag, int *ilabel, int localflag)
 {
   int m,itype;
   tagint atom1,atom2;
@@ -1312,9 +1369,16 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
   int newton_bond = force->newton_bond;
   auto location = "Bonds section of data file";
 
+  // with localflag, only this proc has seen these lines, so errors cannot be collective
+
+  auto data_error = [&](const std::string &mesg) {
+    if (localflag) error->one(FLERR, mesg);
+    error->all(FLERR, mesg);
+  };
+
   for (int i = 0; i < n; i++) {
     next = strchr(buf,'\n');
-    if (!next) error->all(FLERR, "Missing data in {}", location);
+    if (!next) data_error(fmt::format("Missing data in {}", location));
     *next = '\0';
     auto values = Tokenizer(buf).as_vector();
     int nwords = values.size();
@@ -1329,11 +1393,11 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
     // Bonds line is: number(ignored), bond type, atomID 1, atomID 2
     if (nwords > 0) {
       if (nwords != 4)
-        error->all(FLERR, "Incorrect format in {}: {}{}", location,
-                   utils::trim(buf), utils::errorurl(2));
+        data_error(fmt::format("Incorrect format in {}: {}{}", location,
+                               utils::trim(buf), utils::errorurl(2)));
       typestr = utils::utf8_subst(values[1]);
-      atom1 = utils::tnumeric(FLERR, values[2], false, lmp);
-      atom2 = utils::tnumeric(FLERR, values[3], false, lmp);
+      atom1 = utils::tnumeric(FLERR, values[2], localflag, lmp);
+      atom2 = utils::tnumeric(FLERR, values[3], localflag, lmp);
       if (id_offset) {
         atom1 += id_offset;
         atom2 += id_offset;
@@ -1341,16 +1405,18 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
 
       switch (utils::is_type(typestr)) {
         case 0: {    // numeric
-          itype = utils::inumeric(FLERR, typestr, false, lmp) + type_offset;
+          itype = utils::inumeric(FLERR, typestr, localflag, lmp) + type_offset;
           if ((itype < 1) || (itype > nbondtypes))
-            error->all(FLERR, "Invalid bond type {} in {}: {}", itype, location, utils::trim(buf));
+            data_error(fmt::format("Invalid bond type {} in {}: {}", itype, location,
+                                   utils::trim(buf)));
           if (labelflag) itype = ilabel[itype - 1];
           break;
         }
         case 1: {    // type label
-          if (!atom->labelmapflag) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (!atom->labelmapflag)
+            data_error(fmt::format("Invalid {}: {}", location, utils::trim(buf)));
           itype = lmap->find(typestr, Atom::BOND);
-          if (itype == -1) error->all(FLERR, "Invalid {}: {}", location, utils::trim(buf));
+          if (itype == -1) data_error(fmt::format("Invalid {}: {}", location, utils::trim(buf)));
           break;
         }
         default:    // invalid
@@ -1360,9 +1426,10 @@ void Atom::data_bonds(int n, char *buf, int *count, tagint id_offset,
 
       if ((atom1 <= 0) || (atom1 > map_tag_max) ||
           (atom2 <= 0) || (atom2 > map_tag_max) || (atom1 == atom2))
-        error->all(FLERR,"Invalid atom ID in {}: {}", location, utils::trim(buf));
+        data_error(fmt::format("Invalid atom ID in {}: {}", location, utils::trim(buf)));
       if ((itype <= 0) || (itype > nbondtypes))
-        error->all(FLERR,"Invalid bond type {} in {}: {}", itype, location, utils::trim(buf));
+        data_error(fmt::format("Invalid bond type {} in {}: {}", itype, location,
+                               utils::trim(buf)));
       if ((m = map(atom1)) >= 0) {
         if (count) count[m]++;
         else {
@@ -2361,9 +2428,11 @@ void Atom::sort()
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
 
+  // bins are visited in raster order or along a space-filling curve
+
   n = 0;
   for (m = 0; m < nbins; m++) {
-    i = binhead[m];
+    i = (sortorder == SORT_BIN) ? binhead[m] : binhead[binorder[m]];
     while (i >= 0) {
       permute[n++] = i;
       i = next[i];
@@ -2546,9 +2615,90 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binorder);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    memory->create(binorder,maxbin,"atom:binorder");
+  }
+
+  if (sortorder != SORT_BIN) setup_sort_order();
+}
+
+/* ----------------------------------------------------------------------
+   order sort bins along a Morton (Z-order) or Hilbert curve
+   binorder[M] = index of Mth bin to visit when sorting
+   keys are built from bin indices padded to a power-of-2 grid,
+   Hilbert keys use the transpose algorithm of J. Skilling,
+   AIP Conf Proc 707, 381 (2004)
+------------------------------------------------------------------------- */
+
+void Atom::setup_sort_order()
+{
+  const int ndim = domain->dimension;
+  const int nmax = MAX(MAX(nbinx,nbiny),nbinz);
+  int nbits = 1;
+  while ((1 << nbits) < nmax) nbits++;
+
+  // keys do not fit into 64 bits: fall back to raster order
+
+  if (ndim*nbits > 63) {
+    for (int m = 0; m < nbins; m++) binorder[m] = m;
+    return;
   }
+
+  std::vector<std::pair<uint64_t,int>> keys(nbins);
+  unsigned int coord[3];
+  int ibin = 0;
+
+  for (int iz = 0; iz < nbinz; iz++) {
+    for (int iy = 0; iy < nbiny; iy++) {
+      for (int ix = 0; ix < nbinx; ix++) {
+        coord[0] = ix;
+        coord[1] = iy;
+        coord[2] = iz;
+
+        if (sortorder == SORT_HILBERT) {
+
+          // inverse undo excess work
+
+          const unsigned int mbit = 1U << (nbits-1);
+          for (unsigned int q = mbit; q > 1; q >>= 1) {
+            const unsigned int p = q - 1;
+            for (int d = 0; d < ndim; d++) {
+              if (coord[d] & q) coord[0] ^= p;
+              else {
+                const unsigned int t = (coord[0] ^ coord[d]) & p;
+                coord[0] ^= t;
+                coord[d] ^= t;
+              }
+            }
+          }
+
+          // Gray encode
+
+          for (int d = 1; d < ndim; d++) coord[d] ^= coord[d-1];
+          unsigned int t = 0;
+          for (unsigned int q = mbit; q > 1; q >>= 1)
+            if (coord[ndim-1] & q) t ^= q - 1;
+          for (int d = 0; d < ndim; d++) coord[d] ^= t;
+        }
+
+        // interleave bits, most significant first
+
+        uint64_t key = 0;
+        for (int b = nbits-1; b >= 0; b--)
+          for (int d = 0; d < ndim; d++)
+            key = (key << 1) | ((coord[d] >> b) & 1);
+
+        keys[ibin].first = key;
+        keys[ibin].second = ibin;
+        ibin++;
+      }
+    }
+  }
+
+  std::sort(keys.begin(), keys.end());
+  for (int m = 0; m < nbins; m++) binorder[m] = keys[m].second;
 }
 
 /* ----------------------------------------------------------------------
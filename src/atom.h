@@ -36,6 +36,7 @@ class Atom : protected Pointers {
   enum { ATOM = 0, BOND = 1, ANGLE = 2, DIHEDRAL = 3, IMPROPER = 4 };
   enum { NUMERIC = 0, LABELS = 1 };
   enum { MAP_NONE = 0, MAP_ARRAY = 1, MAP_HASH = 2, MAP_YES = 3 };
+  enum { SORT_BIN = 0, SORT_MORTON = 1, SORT_HILBERT = 2 };
 
   // atom counts
 
@@ -284,6 +285,7 @@ class Atom : protected Pointers {
   int sortfreq;          // sort atoms every this many steps, 0 = off
   bigint nextsort;       // next timestep to sort on
   double userbinsize;    // requested sort bin size
+  int sortorder;         // order of sort bins: SORT_BIN, SORT_MORTON, SORT_HILBERT
 
   // indices of atoms with same ID
 
@@ -329,9 +331,9 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int);
-  void data_vels(int, char *, tagint);
-  void data_bonds(int, char *, int *, tagint, int, int, int *);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int, int);
+  void data_vels(int, char *, tagint, int);
+  void data_bonds(int, char *, int *, tagint, int, int, int *, int);
   void data_angles(int, char *, int *, tagint, int, int, int *);
   void data_dihedrals(int, char *, int *, tagint, int, int, int *);
   void data_impropers(int, char *, int *, tagint, int, int, int *);
@@ -430,6 +432,7 @@ class Atom : protected Pointers {
   int maxbin;                          // max # of bins
   int maxnext;                         // max size of next,permute
   int *binhead;                        // 1st atom in each bin
+  int *binorder;                       // bin indices in space-filling curve order
   int *next;                           // next atom in bin
   int *permute;                        // permutation vector
   double bininvx, bininvy, bininvz;    // inverse actual bin sizes
@@ -437,6 +440,7 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
+  void setup_sort_order();
   int next_prime(int);
 };
 
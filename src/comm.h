@@ -35,6 +35,8 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int overlap;                  // 1 if forward/reverse comm may overlap with pair forces
+  int persistent;               // 1 if forward/reverse comm uses persistent MPI requests
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
@@ -85,6 +87,15 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // forward/reverse comm of atom coords/forces split into two halves,
+  // so that computation can proceed in between
+  // default is to do all the work in start
+
+  virtual void forward_comm_start() { forward_comm(); }
+  virtual void forward_comm_finish() {}
+  virtual void reverse_comm_start() { reverse_comm(); }
+  virtual void reverse_comm_finish() {}
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *) = 0;
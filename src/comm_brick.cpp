@@ -29,6 +29,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "pair.h"
+#include "timer.h"
 
 #include <cmath>
 #include <cstring>
@@ -38,6 +39,21 @@ using namespace LAMMPS_NS;
 static constexpr double BUFFACTOR = 1.5;
 static constexpr int BUFMIN = 1024;
 static constexpr double BIG = 1.0e20;
+static constexpr int OVERLAP_TAG = 4096;
+
+enum { FORWARD_SEND = 1, FORWARD_RECV = 2, REVERSE_SEND = 4, REVERSE_RECV = 8 };
+
+/* ----------------------------------------------------------------------
+   wait for a message of the per-step communication
+   recorded as a separate event when writing a timer event trace
+------------------------------------------------------------------------- */
+
+static void wait_traced(Timer *timer, MPI_Request *request)
+{
+  double start = timer->trace_start();
+  MPI_Wait(request,MPI_STATUS_IGNORE);
+  timer->trace_stop("MPI_Wait","MPI",start);
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -78,6 +94,20 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+
+  memory->destroy(sendowned);
+  memory->destroy(recvfinal);
+  memory->destroy(overlap_offset);
+  delete[] overlap_recv;
+  delete[] overlap_send;
+  memory->destroy(buf_overlap);
+
+  free_persistent();
+  delete[] forward_send_req;
+  delete[] forward_recv_req;
+  delete[] reverse_send_req;
+  delete[] reverse_recv_req;
+  delete[] persist_flag;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -125,6 +155,18 @@ void CommBrick::init_buffers()
     maxsendlist[i] = BUFMIN;
     memory->create(sendlist[i],BUFMIN,"comm:sendlist[i]");
   }
+
+  maxoverlap = maxoverlapbuf = 0;
+  overlap_pending = 0;
+  sendowned = recvfinal = overlap_offset = nullptr;
+  overlap_recv = overlap_send = nullptr;
+  buf_overlap = nullptr;
+
+  persist_valid = maxpersist = npersist = 0;
+  persist_flag = nullptr;
+  forward_send_req = forward_recv_req = nullptr;
+  reverse_send_req = reverse_recv_req = nullptr;
+  persist_x = persist_f = persist_send = persist_recv = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -543,6 +585,11 @@ void CommBrick::forward_comm(int /*dummy*/)
   double **x = atom->x;
   double *buf;
 
+  if (persistent && check_persistent()) {
+    forward_comm_persistent();
+    return;
+  }
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
@@ -556,13 +603,13 @@ void CommBrick::forward_comm(int /*dummy*/)
         }
         n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_forward_recv[iswap]) wait_traced(timer,&request);
       } else if (ghost_velocity) {
         if (size_forward_recv[iswap])
           MPI_Irecv(buf_recv,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
         n = avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_forward_recv[iswap]) wait_traced(timer,&request);
         avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_recv);
       } else {
         if (size_forward_recv[iswap])
@@ -570,7 +617,7 @@ void CommBrick::forward_comm(int /*dummy*/)
                     recvproc[iswap],0,world,&request);
         n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (size_forward_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_forward_recv[iswap]) wait_traced(timer,&request);
         avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_recv);
       }
 
@@ -590,6 +637,86 @@ void CommBrick::forward_comm(int /*dummy*/)
   }
 }
 
+/* ----------------------------------------------------------------------
+   start forward communication of atom coords
+   post all receives and send all swaps that only send owned atoms,
+     so that work on owned atoms can be done while messages are in flight
+   only done if comm_x_only is set and setup_overlap() was called,
+     otherwise this does a regular blocking forward_comm()
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  if (!comm_x_only || !overlap || !maxoverlap) {
+    forward_comm();
+    return;
+  }
+
+  double **x = atom->x;
+  int offset = 0;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    overlap_offset[iswap] = offset;
+    offset += size_forward*sendnum[iswap];
+    if ((sendproc[iswap] != me) && size_forward_recv[iswap])
+      MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                recvproc[iswap],OVERLAP_TAG+iswap,world,&overlap_recv[iswap]);
+  }
+
+  for (int iswap = 0; iswap < nswap; iswap++)
+    if (sendowned[iswap]) forward_swap(iswap);
+
+  overlap_pending = 1;
+}
+
+/* ----------------------------------------------------------------------
+   complete forward communication started by forward_comm_start()
+   remaining swaps forward ghost atoms received in earlier swaps,
+     so those must have arrived before they are packed
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  if (!overlap_pending) return;
+
+  int iwait = 0;
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendowned[iswap]) continue;
+    for (; iwait < iswap; iwait++)
+      if ((sendproc[iwait] != me) && size_forward_recv[iwait])
+        wait_traced(timer,&overlap_recv[iwait]);
+    forward_swap(iswap);
+  }
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] == me) continue;
+    if ((iswap >= iwait) && size_forward_recv[iswap])
+      wait_traced(timer,&overlap_recv[iswap]);
+    if (sendnum[iswap]) wait_traced(timer,&overlap_send[iswap]);
+  }
+  overlap_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   pack and send atom coords of one swap of a split forward comm
+   if other proc is self, copy directly to x
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_swap(int iswap)
+{
+  AtomVec *avec = atom->avec;
+
+  if (sendproc[iswap] != me) {
+    double *buf = buf_overlap + overlap_offset[iswap];
+    int n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf,pbc_flag[iswap],pbc[iswap]);
+    if (n)
+      MPI_Isend(buf,n,MPI_DOUBLE,sendproc[iswap],OVERLAP_TAG+iswap,world,&overlap_send[iswap]);
+  } else if (sendnum[iswap]) {
+    avec->pack_comm(sendnum[iswap],sendlist[iswap],atom->x[firstrecv[iswap]],
+                    pbc_flag[iswap],pbc[iswap]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    reverse communication of forces on atoms every timestep
    other per-atom attributes may also be sent via pack/unpack routines
@@ -603,6 +730,11 @@ void CommBrick::reverse_comm()
   double **f = atom->f;
   double *buf;
 
+  if (persistent && check_persistent()) {
+    reverse_comm_persistent();
+    return;
+  }
+
   // exchange data with another proc
   // if other proc is self, just copy
   // if comm_f_only set, exchange or copy directly from f, don't pack
@@ -616,13 +748,13 @@ void CommBrick::reverse_comm()
           buf = f[firstrecv[iswap]];
           MPI_Send(buf,size_reverse_send[iswap],MPI_DOUBLE,recvproc[iswap],0,world);
         }
-        if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_reverse_recv[iswap]) wait_traced(timer,&request);
       } else {
         if (size_reverse_recv[iswap])
           MPI_Irecv(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,&request);
         n = avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,recvproc[iswap],0,world);
-        if (size_reverse_recv[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (size_reverse_recv[iswap]) wait_traced(timer,&request);
       }
       avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
 
@@ -638,6 +770,73 @@ void CommBrick::reverse_comm()
   }
 }
 
+/* ----------------------------------------------------------------------
+   start reverse communication of forces on atoms
+   post all receives and send forces of ghost atoms of all swaps
+     which do not receive contributions from later swaps
+   forces on ghost atoms must be complete, but forces on owned atoms
+     may still be added to until reverse_comm_finish()
+   only done if comm_f_only is set and setup_overlap() was called,
+     otherwise this does a regular blocking reverse_comm()
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_start()
+{
+  if (!comm_f_only || !overlap || !maxoverlap) {
+    reverse_comm();
+    return;
+  }
+
+  double **f = atom->f;
+  int offset = 0;
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    overlap_offset[iswap] = offset;
+    offset += size_reverse_recv[iswap];
+    if ((sendproc[iswap] != me) && size_reverse_recv[iswap])
+      MPI_Irecv(buf_overlap+overlap_offset[iswap],size_reverse_recv[iswap],MPI_DOUBLE,
+                sendproc[iswap],OVERLAP_TAG+iswap,world,&overlap_recv[iswap]);
+  }
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--)
+    if (recvfinal[iswap] && (sendproc[iswap] != me) && size_reverse_send[iswap])
+      MPI_Isend(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                recvproc[iswap],OVERLAP_TAG+iswap,world,&overlap_send[iswap]);
+
+  overlap_pending = 1;
+}
+
+/* ----------------------------------------------------------------------
+   complete reverse communication started by reverse_comm_start()
+   swaps are processed in the same order as in reverse_comm(),
+     sending the remaining ghost atom forces once they are complete
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_finish()
+{
+  if (!overlap_pending) return;
+
+  AtomVec *avec = atom->avec;
+  double **f = atom->f;
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    if (sendproc[iswap] != me) {
+      if (!recvfinal[iswap] && size_reverse_send[iswap])
+        MPI_Isend(f[firstrecv[iswap]],size_reverse_send[iswap],MPI_DOUBLE,
+                  recvproc[iswap],OVERLAP_TAG+iswap,world,&overlap_send[iswap]);
+      if (size_reverse_recv[iswap]) wait_traced(timer,&overlap_recv[iswap]);
+      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_overlap+overlap_offset[iswap]);
+    } else if (sendnum[iswap]) {
+      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],f[firstrecv[iswap]]);
+    }
+  }
+
+  for (int iswap = 0; iswap < nswap; iswap++)
+    if ((sendproc[iswap] != me) && size_reverse_send[iswap])
+      wait_traced(timer,&overlap_send[iswap]);
+  overlap_pending = 0;
+}
+
 /* ----------------------------------------------------------------------
    exchange: move atoms to correct processors
    atoms exchanged with all 6 stencil neighbors
@@ -733,12 +932,12 @@ void CommBrick::exchange()
 
       MPI_Irecv(buf_recv,nrecv1,MPI_DOUBLE,procneigh[dim][1],0,world,&request);
       MPI_Send(buf_send,nsend,MPI_DOUBLE,procneigh[dim][0],0,world);
-      MPI_Wait(&request,MPI_STATUS_IGNORE);
+      wait_traced(timer,&request);
 
       if (procgrid[dim] > 2) {
         MPI_Irecv(&buf_recv[nrecv1],nrecv2,MPI_DOUBLE,procneigh[dim][0],0,world,&request);
         MPI_Send(buf_send,nsend,MPI_DOUBLE,procneigh[dim][1],0,world);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
+        wait_traced(timer,&request);
       }
     }
 
@@ -780,6 +979,10 @@ void CommBrick::borders()
   MPI_Request request;
   AtomVec *avec = atom->avec;
 
+  // message sizes change, so persistent requests must be recreated
+
+  free_persistent();
+
   // After exchanging/sorting, need to reconstruct collection array for border communication
   if (mode == Comm::MULTI) neighbor->build_collection(0);
 
@@ -926,7 +1129,7 @@ void CommBrick::borders()
         if (nrecv) MPI_Irecv(buf_recv,nrecv*size_border,MPI_DOUBLE,
                              recvproc[iswap],0,world,&request);
         if (n) MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
-        if (nrecv) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        if (nrecv) wait_traced(timer,&request);
         buf = buf_recv;
       } else {
         nrecv = nsend;
@@ -973,11 +1176,248 @@ void CommBrick::borders()
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // dependencies between swaps for split forward/reverse comm
+
+  if (overlap) setup_overlap();
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
 }
 
+/* ----------------------------------------------------------------------
+   check if persistent requests can be used for forward/reverse comm
+   (re)create them if swaps changed or any buffer they use was reallocated
+   return 1 if they can be used, 0 if not
+------------------------------------------------------------------------- */
+
+int CommBrick::check_persistent()
+{
+  if (lmp->kokkos) return 0;
+
+  double *x = atom->x ? atom->x[0] : nullptr;
+  double *f = atom->f ? atom->f[0] : nullptr;
+  if (persist_valid && (x == persist_x) && (f == persist_f) &&
+      (buf_send == persist_send) && (buf_recv == persist_recv)) return 1;
+
+  free_persistent();
+  setup_persistent();
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   create persistent send/recv requests for forward/reverse comm
+   message sizes and buffers are fixed between calls to borders():
+     comm_x_only recvs and comm_f_only sends use x and f directly,
+     all other messages use buf_send and buf_recv
+   swaps with self or with nothing to send or recv get no request
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_persistent()
+{
+  if (maxswap > maxpersist) {
+    delete[] forward_send_req;
+    delete[] forward_recv_req;
+    delete[] reverse_send_req;
+    delete[] reverse_recv_req;
+    delete[] persist_flag;
+    maxpersist = maxswap;
+    forward_send_req = new MPI_Request[maxpersist];
+    forward_recv_req = new MPI_Request[maxpersist];
+    reverse_send_req = new MPI_Request[maxpersist];
+    reverse_recv_req = new MPI_Request[maxpersist];
+    persist_flag = new int[maxpersist];
+  }
+
+  double **x = atom->x;
+  double **f = atom->f;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    persist_flag[iswap] = 0;
+    if (sendproc[iswap] == me) continue;
+
+    if (size_forward_recv[iswap]) {
+      double *buf = comm_x_only ? x[firstrecv[iswap]] : buf_recv;
+      MPI_Recv_init(buf,size_forward_recv[iswap],MPI_DOUBLE,recvproc[iswap],0,world,
+                    &forward_recv_req[iswap]);
+      persist_flag[iswap] |= FORWARD_RECV;
+    }
+    if (sendnum[iswap]) {
+      MPI_Send_init(buf_send,size_forward*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,world,
+                    &forward_send_req[iswap]);
+      persist_flag[iswap] |= FORWARD_SEND;
+    }
+    if (size_reverse_recv[iswap]) {
+      MPI_Recv_init(buf_recv,size_reverse_recv[iswap],MPI_DOUBLE,sendproc[iswap],0,world,
+                    &reverse_recv_req[iswap]);
+      persist_flag[iswap] |= REVERSE_RECV;
+    }
+    if (size_reverse_send[iswap]) {
+      double *buf = comm_f_only ? f[firstrecv[iswap]] : buf_send;
+      MPI_Send_init(buf,size_reverse_send[iswap],MPI_DOUBLE,recvproc[iswap],0,world,
+                    &reverse_send_req[iswap]);
+      persist_flag[iswap] |= REVERSE_SEND;
+    }
+  }
+  npersist = nswap;
+
+  persist_x = x ? x[0] : nullptr;
+  persist_f = f ? f[0] : nullptr;
+  persist_send = buf_send;
+  persist_recv = buf_recv;
+  persist_valid = 1;
+}
+
+/* ----------------------------------------------------------------------
+   free persistent requests, must not be active
+   uses persist_flag since swaps may have changed since they were created
+------------------------------------------------------------------------- */
+
+void CommBrick::free_persistent()
+{
+  if (!persist_valid) return;
+
+  for (int iswap = 0; iswap < npersist; iswap++) {
+    if (persist_flag[iswap] & FORWARD_RECV) MPI_Request_free(&forward_recv_req[iswap]);
+    if (persist_flag[iswap] & FORWARD_SEND) MPI_Request_free(&forward_send_req[iswap]);
+    if (persist_flag[iswap] & REVERSE_RECV) MPI_Request_free(&reverse_recv_req[iswap]);
+    if (persist_flag[iswap] & REVERSE_SEND) MPI_Request_free(&reverse_send_req[iswap]);
+  }
+  persist_valid = npersist = 0;
+}
+
+/* ----------------------------------------------------------------------
+   forward communication of atom coords with persistent requests
+   same as forward_comm(), but without setting up each message
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_persistent()
+{
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    if (sendproc[iswap] != me) {
+      if (size_forward_recv[iswap]) MPI_Start(&forward_recv_req[iswap]);
+      if (sendnum[iswap]) {
+        if (ghost_velocity)
+          avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        else
+          avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        MPI_Start(&forward_send_req[iswap]);
+      }
+      if (size_forward_recv[iswap]) wait_traced(timer,&forward_recv_req[iswap]);
+      if (sendnum[iswap]) wait_traced(timer,&forward_send_req[iswap]);
+      if (comm_x_only) continue;
+      if (ghost_velocity) avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_recv);
+      else avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_recv);
+
+    } else {
+      if (comm_x_only) {
+        if (sendnum[iswap])
+          avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                          x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+      } else if (ghost_velocity) {
+        avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_send);
+      } else {
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],buf_send,pbc_flag[iswap],pbc[iswap]);
+        avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reverse communication of forces on atoms with persistent requests
+   same as reverse_comm(), but without setting up each message
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_persistent()
+{
+  AtomVec *avec = atom->avec;
+  double **f = atom->f;
+
+  for (int iswap = nswap-1; iswap >= 0; iswap--) {
+    if (sendproc[iswap] != me) {
+      if (size_reverse_recv[iswap]) MPI_Start(&reverse_recv_req[iswap]);
+      if (size_reverse_send[iswap]) {
+        if (!comm_f_only) avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
+        MPI_Start(&reverse_send_req[iswap]);
+      }
+      if (size_reverse_recv[iswap]) wait_traced(timer,&reverse_recv_req[iswap]);
+      if (size_reverse_send[iswap]) wait_traced(timer,&reverse_send_req[iswap]);
+      avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_recv);
+
+    } else {
+      if (comm_f_only) {
+        if (sendnum[iswap])
+          avec->unpack_reverse(sendnum[iswap],sendlist[iswap],f[firstrecv[iswap]]);
+      } else {
+        avec->pack_reverse(recvnum[iswap],firstrecv[iswap],buf_send);
+        avec->unpack_reverse(sendnum[iswap],sendlist[iswap],buf_send);
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   find which swaps of a split forward/reverse comm can be started early
+   sendowned = swap sends only owned atoms, so its forward comm
+     does not depend on ghost atoms received in an earlier swap
+   recvfinal = no later swap sends any of the ghost atoms received in this
+     swap, so their forces are complete before the reverse comm starts
+   also allocate per-swap buffers, which must remain valid until finish
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_overlap()
+{
+  int i,iswap,jswap,lo,hi;
+
+  if (nswap > maxoverlap) {
+    memory->destroy(sendowned);
+    memory->destroy(recvfinal);
+    memory->destroy(overlap_offset);
+    delete[] overlap_recv;
+    delete[] overlap_send;
+    maxoverlap = maxswap;
+    memory->create(sendowned,maxoverlap,"comm:sendowned");
+    memory->create(recvfinal,maxoverlap,"comm:recvfinal");
+    memory->create(overlap_offset,maxoverlap,"comm:overlap_offset");
+    overlap_recv = new MPI_Request[maxoverlap];
+    overlap_send = new MPI_Request[maxoverlap];
+  }
+
+  const int nlocal = atom->nlocal;
+  for (iswap = 0; iswap < nswap; iswap++) recvfinal[iswap] = 1;
+
+  int nforward = 0;
+  int nreverse = 0;
+  for (iswap = 0; iswap < nswap; iswap++) {
+    lo = nlocal + atom->nghost;
+    hi = -1;
+    for (i = 0; i < sendnum[iswap]; i++) {
+      if (sendlist[iswap][i] < nlocal) continue;
+      lo = MIN(lo,sendlist[iswap][i]);
+      hi = MAX(hi,sendlist[iswap][i]);
+    }
+    sendowned[iswap] = (hi < 0) ? 1 : 0;
+    for (jswap = 0; jswap < iswap; jswap++)
+      if ((lo < firstrecv[jswap] + recvnum[jswap]) && (hi >= firstrecv[jswap]))
+        recvfinal[jswap] = 0;
+
+    nforward += size_forward*sendnum[iswap];
+    nreverse += size_reverse_recv[iswap];
+  }
+
+  int max = MAX(nforward,nreverse);
+  if (max > maxoverlapbuf) {
+    memory->destroy(buf_overlap);
+    maxoverlapbuf = static_cast<int> (BUFFACTOR * max);
+    memory->create(buf_overlap,maxoverlapbuf,"comm:buf_overlap");
+  }
+}
+
 /* ----------------------------------------------------------------------
    forward communication invoked by a Pair
    nsize used only to set recv buffer limit
@@ -1651,5 +2091,6 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += memory->usage(buf_overlap,maxoverlapbuf);
   return bytes;
 }
@@ -32,6 +32,11 @@ class CommBrick : public Comm {
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
 
+  void forward_comm_start() override;     // post forward comm of atom coords
+  void forward_comm_finish() override;    // complete forward comm of atom coords
+  void reverse_comm_start() override;     // post reverse comm of forces
+  void reverse_comm_finish() override;    // complete reverse comm of forces
+
   void forward_comm(class Pair *) override;                 // forward comm from a Pair
   void reverse_comm(class Pair *) override;                 // reverse comm from a Pair
   void forward_comm(class Bond *) override;                 // forward comm from a Bond
@@ -77,10 +82,41 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  // split forward/reverse comm for overlap with computation
+
+  int maxoverlap;                // # of swaps overlap arrays are allocated for
+  int overlap_pending;           // 1 if a split comm has been started but not finished
+  int *sendowned;                // 1 if swap sends only owned atoms
+  int *recvfinal;                // 1 if no later swap adds forces to recv atoms of swap
+  int *overlap_offset;           // offset of each swap into buf_overlap
+  MPI_Request *overlap_recv;     // recv request of each swap
+  MPI_Request *overlap_send;     // send request of each swap
+  double *buf_overlap;           // per-swap send (forward) or recv (reverse) buffers
+  int maxoverlapbuf;             // current size of buf_overlap
+
+  // persistent requests for forward/reverse comm of each swap
+  // valid until next borders() or until any of the buffers is reallocated
+
+  int persist_valid;             // 1 if persistent requests are set up
+  int maxpersist;                // # of swaps persistent arrays are allocated for
+  int npersist;                  // # of swaps with persistent requests
+  int *persist_flag;             // bitmask of requests created for each swap
+  MPI_Request *forward_send_req, *forward_recv_req;
+  MPI_Request *reverse_send_req, *reverse_recv_req;
+  double *persist_x, *persist_f;                   // x,f used by current requests
+  double *persist_send, *persist_recv;             // buf_send,buf_recv used by requests
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
   int updown(int, int, int, double, int, double *);
+  void setup_overlap();
+  void forward_swap(int);
+  int check_persistent();
+  void setup_persistent();
+  void free_persistent();
+  void forward_comm_persistent();
+  void reverse_comm_persistent();
   // compare cutoff to procs
   virtual void grow_send(int, int);       // reallocate send buffer
   virtual void grow_recv(int);            // free/allocate recv buffer
@@ -21,6 +21,7 @@
 #include "group.h"
 #include "memory.h"
 #include "modify.h"
+#include "timer.h"
 
 #include <cstring>
 
@@ -73,6 +74,7 @@ Compute::Compute(LAMMPS *lmp, int narg, char **arg) :
   comm_forward = comm_reverse = 0;
   dynamic = 0;
   dynamic_group_allow = 1;
+  time_detail = 0.0;
 
   initialized_flag = 0;
   invoked_scalar = invoked_vector = invoked_array = -1;
@@ -153,6 +155,63 @@ void Compute::modify_params(int narg, char **arg)
   }
 }
 
+/* ----------------------------------------------------------------------
+   wrappers for callers of compute_*() to time each compute separately
+------------------------------------------------------------------------- */
+
+double Compute::invoke_scalar()
+{
+  double start = timer->detail_start();
+  double value = compute_scalar();
+  timer->detail_stop(time_detail,start);
+  return value;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Compute::invoke_vector()
+{
+  double start = timer->detail_start();
+  compute_vector();
+  timer->detail_stop(time_detail,start);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Compute::invoke_array()
+{
+  double start = timer->detail_start();
+  compute_array();
+  timer->detail_stop(time_detail,start);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Compute::invoke_peratom()
+{
+  double start = timer->detail_start();
+  compute_peratom();
+  timer->detail_stop(time_detail,start);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Compute::invoke_local()
+{
+  double start = timer->detail_start();
+  compute_local();
+  timer->detail_stop(time_detail,start);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Compute::invoke_pergrid()
+{
+  double start = timer->detail_start();
+  compute_pergrid();
+  timer->detail_stop(time_detail,start);
+}
+
 /* ----------------------------------------------------------------------
    calculate adjustment in DOF due to fixes
 ------------------------------------------------------------------------- */
@@ -99,6 +99,8 @@ class Compute : protected Pointers {
 
   double dof;    // degrees-of-freedom for temperature
 
+  double time_detail;    // wall time spent in this compute, with "timer detail"
+
   int comm_forward;           // size of forward communication (0 if none)
   int comm_reverse;           // size of reverse communication (0 if none)
   int dynamic_group_allow;    // 1 if can be used with dynamic group, else 0
@@ -127,6 +129,15 @@ class Compute : protected Pointers {
   virtual void compute_pergrid() {}
   virtual void set_arrays(int) {}
 
+  // call compute_*() and add its time to time_detail with "timer detail"
+
+  double invoke_scalar();
+  void invoke_vector();
+  void invoke_array();
+  void invoke_peratom();
+  void invoke_local();
+  void invoke_pergrid();
+
   virtual int pack_forward_comm(int, int *, double *, int, int *) { return 0; }
   virtual void unpack_forward_comm(int, int, double *) {}
   virtual int pack_reverse_comm(int, int, double *) { return 0; }
@@ -397,7 +397,7 @@ void ComputeCentroidStressAtom::compute_peratom()
       // invoke temperature if it hasn't been already
       // this ensures bias factor is pre-computed
 
-      if (keflag && temperature->invoked_scalar != update->ntimestep) temperature->compute_scalar();
+      if (keflag && temperature->invoked_scalar != update->ntimestep) temperature->invoke_scalar();
 
       if (rmass) {
         for (i = 0; i < nlocal; i++)
@@ -968,7 +968,7 @@ void ComputeChunkAtom::assign_chunk_ids()
 
   } else if (which == ArgInfo::COMPUTE) {
     if (!(cchunk->invoked_flag & Compute::INVOKED_PERATOM)) {
-      cchunk->compute_peratom();
+      cchunk->invoke_peratom();
       cchunk->invoked_flag |= Compute::INVOKED_PERATOM;
     }
 
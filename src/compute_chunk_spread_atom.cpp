@@ -238,7 +238,7 @@ void ComputeChunkSpreadAtom::compute_peratom()
 
       if (val.argindex == 0) {
         if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
-          compute->compute_vector();
+          compute->invoke_vector();
           compute->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         double *cvector = compute->vector;
@@ -252,7 +252,7 @@ void ComputeChunkSpreadAtom::compute_peratom()
 
       } else {
         if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
-          compute->compute_array();
+          compute->invoke_array();
           compute->invoked_flag |= Compute::INVOKED_ARRAY;
         }
         int icol = val.argindex-1;
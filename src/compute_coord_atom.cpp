@@ -189,7 +189,7 @@ void ComputeCoordAtom::compute_peratom()
 
   if (cstyle == ORIENT) {
     if (!(c_orientorder->invoked_flag & Compute::INVOKED_PERATOM)) {
-      c_orientorder->compute_peratom();
+      c_orientorder->invoke_peratom();
       c_orientorder->invoked_flag |= Compute::INVOKED_PERATOM;
     }
     nqlist = c_orientorder->nqlist;
@@ -269,7 +269,7 @@ void ComputeGlobalAtom::compute_peratom()
   if (reference.which == ArgInfo::COMPUTE) {
 
     if (!(reference.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-      reference.val.c->compute_peratom();
+      reference.val.c->invoke_peratom();
       reference.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
     }
 
@@ -325,7 +325,7 @@ void ComputeGlobalAtom::compute_peratom()
       if (val.which == ArgInfo::COMPUTE) {
 
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val.val.c->compute_vector();
+          val.val.c->invoke_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
 
@@ -381,7 +381,7 @@ void ComputeGlobalAtom::compute_peratom()
       if (val.which == ArgInfo::COMPUTE) {
 
         if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-          val.val.c->compute_array();
+          val.val.c->invoke_array();
           val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
 
@@ -99,15 +99,15 @@ void ComputeHeatFlux::compute_vector()
   // invoke 3 computes if they haven't been already
 
   if (!(c_ke->invoked_flag & Compute::INVOKED_PERATOM)) {
-    c_ke->compute_peratom();
+    c_ke->invoke_peratom();
     c_ke->invoked_flag |= Compute::INVOKED_PERATOM;
   }
   if (!(c_pe->invoked_flag & Compute::INVOKED_PERATOM)) {
-    c_pe->compute_peratom();
+    c_pe->invoke_peratom();
     c_pe->invoked_flag |= Compute::INVOKED_PERATOM;
   }
   if (!(c_stress->invoked_flag & Compute::INVOKED_PERATOM)) {
-    c_stress->compute_peratom();
+    c_stress->invoke_peratom();
     c_stress->invoked_flag |= Compute::INVOKED_PERATOM;
   }
 
@@ -235,7 +235,7 @@ double ComputePressure::compute_scalar()
 
   if (keflag) {
     if (temperature->invoked_scalar != update->ntimestep)
-      temperature->compute_scalar();
+      temperature->invoke_scalar();
   }
 
   if (dimension == 3) {
@@ -279,7 +279,7 @@ void ComputePressure::compute_vector()
   double *ke_tensor;
   if (keflag) {
     if (temperature->invoked_vector != update->ntimestep)
-      temperature->compute_vector();
+      temperature->invoke_vector();
     ke_tensor = temperature->vector;
   }
 
@@ -525,7 +525,7 @@ double ComputeReduce::compute_one(int m, int flag)
 
     if (input_mode == PERATOM) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-        val.val.c->compute_peratom();
+        val.val.c->invoke_peratom();
         val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
 
@@ -550,7 +550,7 @@ double ComputeReduce::compute_one(int m, int flag)
 
     } else if (input_mode == LOCAL) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
-        val.val.c->compute_local();
+        val.val.c->invoke_local();
         val.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
       }
 
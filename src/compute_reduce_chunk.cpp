@@ -290,7 +290,7 @@ void ComputeReduceChunk::compute_one(int m, double *vchunk, int nstride)
 
   if (val.which == ArgInfo::COMPUTE) {
     if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-      val.val.c->compute_peratom();
+      val.val.c->invoke_peratom();
       val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
     }
 
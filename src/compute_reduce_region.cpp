@@ -102,7 +102,7 @@ double ComputeReduceRegion::compute_one(int m, int flag)
   } else if (val.which == ArgInfo::COMPUTE) {
 
     if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-      val.val.c->compute_peratom();
+      val.val.c->invoke_peratom();
       val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
     }
 
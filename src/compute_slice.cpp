@@ -239,7 +239,7 @@ void ComputeSlice::extract_one(int m, double *vec, int stride)
   if (val.which == ArgInfo::COMPUTE) {
     if (val.argindex == 0) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-        val.val.c->compute_vector();
+        val.val.c->invoke_vector();
         val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
       }
       double *cvector = val.val.c->vector;
@@ -251,7 +251,7 @@ void ComputeSlice::extract_one(int m, double *vec, int stride)
 
     } else {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-        val.val.c->compute_array();
+        val.val.c->invoke_array();
         val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
       }
       double **carray = val.val.c->array;
@@ -227,7 +227,7 @@ double ComputeTempSphere::compute_scalar()
   invoked_scalar = update->ntimestep;
 
   if (tempbias) {
-    if (tbias->invoked_scalar != update->ntimestep) tbias->compute_scalar();
+    if (tbias->invoked_scalar != update->ntimestep) tbias->invoke_scalar();
     tbias->remove_bias_all();
   }
 
@@ -276,7 +276,7 @@ void ComputeTempSphere::compute_vector()
   invoked_vector = update->ntimestep;
 
   if (tempbias) {
-    if (tbias->invoked_vector != update->ntimestep) tbias->compute_vector();
+    if (tbias->invoked_vector != update->ntimestep) tbias->invoke_vector();
     tbias->remove_bias_all();
   }
 
@@ -28,7 +28,10 @@
 #include "variable.h"
 
 #include <cstring>
+#include <exception>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace LAMMPS_NS;
 
@@ -42,6 +45,19 @@ static constexpr double EPSILON = 1.0e-6;
 
 enum { ASCEND, DESCEND };
 
+// copy of the data of one snapshot that is written by a background thread
+// data = per-atom data of all procs in my cluster, in doubles or chars
+// nlines,offset = length and start of the data of each proc in data
+// errmesg = error reported by the thread, empty if none
+
+struct Dump::AsyncWriter {
+  std::thread thread;
+  std::vector<char> data;
+  std::vector<int> nlines;
+  std::vector<bigint> offset;
+  std::string errmesg;
+};
+
 /* ---------------------------------------------------------------------- */
 
 Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
@@ -50,7 +66,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
     nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
     idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
-    imagepbc(nullptr), irregular(nullptr)
+    imagepbc(nullptr), irregular(nullptr), async(nullptr)
 {
   MPI_Comm_rank(world, &me);
   MPI_Comm_size(world, &nprocs);
@@ -65,6 +81,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   filename = utils::strdup(arg[4]);
 
   comm_forward = comm_reverse = 0;
+  time_detail = 0.0;
 
   first_flag = 0;
   flush_flag = 1;
@@ -77,6 +94,10 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  mpiio_allow = 0;
+  mpiio_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -140,6 +161,12 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // background thread is normally finished by Output before deleting a dump,
+  // since destructors of derived classes may free data used by the thread
+
+  sync(0);
+  delete async;
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -200,6 +227,11 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  sync();
+
+  if (async_flag && mpiio_flag)
+    error->all(FLERR,"Cannot use dump_modify async and mpiio together");
+
   init_style();
 
   if (!sort_flag) {
@@ -328,6 +360,10 @@ void Dump::write()
   imageint *imagehold;
   double **xhold,**vhold;
 
+  // previous snapshot must be complete before anything is changed
+
+  sync();
+
   // simulation box bounds
 
   if (domain->triclinic == 0) {
@@ -447,11 +483,11 @@ void Dump::write()
 
   if (filewriter && write_header_flag) write_header(nheader);
 
-  // if buffering, convert doubles into strings
+  // if buffering or writing with MPI-IO, convert doubles into strings
   // ensure sbuf is sized for communicating
   // cannot buffer if output is to binary file
 
-  if (buffer_flag && !binary) {
+  if ((buffer_flag || mpiio_flag) && !binary) {
     nsme = convert_string(nme,buf);
     int nsmin,nsmax;
     MPI_Allreduce(&nsme,&nsmin,1,MPI_INT,MPI_MIN,world);
@@ -473,9 +509,14 @@ void Dump::write()
   MPI_Status status;
   MPI_Request request;
 
+  // all procs write their own buf or sbuf with MPI-IO
+
+  if (mpiio_flag) {
+    write_mpiio();
+
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  } else if (buffer_flag == 0 || binary) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
         if (iproc) {
@@ -486,9 +527,10 @@ void Dump::write()
           nlines /= size_one;
         } else nlines = nme;
 
-        write_data(nlines,buf);
+        if (async_flag) async_add(nlines,buf,nlines*size_one*sizeof(double));
+        else write_data(nlines,buf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -507,9 +549,10 @@ void Dump::write()
           MPI_Get_count(&status,MPI_CHAR,&nchars);
         } else nchars = nsme;
 
-        write_data(nchars,(double *) sbuf);
+        if (async_flag) async_add(nchars,sbuf,nchars);
+        else write_data(nchars,(double *) sbuf);
       }
-      if (flush_flag && fp) fflush(fp);
+      if (flush_flag && fp && !async_flag) fflush(fp);
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -530,7 +573,14 @@ void Dump::write()
 
   if (refreshflag) irefresh->refresh();
 
-  if (filewriter && fp != nullptr) write_footer();
+  // background thread completes the file output of this snapshot
+
+  if (async_flag && filewriter) {
+    async_write();
+    return;
+  }
+
+  if (filewriter) write_footer();
 
   if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
 
@@ -581,6 +631,10 @@ void Dump::openfile()
     }
   }
 
+  // all procs need the file name to write to it with MPI-IO
+
+  mpiio_name = filecurrent;
+
   // each proc with filewriter = 1 opens a file
 
   if (filewriter) {
@@ -602,6 +656,133 @@ void Dump::openfile()
   if (multifile) delete[] filecurrent;
 }
 
+/* ----------------------------------------------------------------------
+   all procs write their part of a snapshot into the file with MPI-IO
+   proc 0 has written the header before with stdio
+   offset of my data follows from sizes of all lower procs, so
+     the data is in the same order as when proc 0 gathers it
+   binary data is written as for write_data(), preceded by its length
+------------------------------------------------------------------------- */
+
+void Dump::write_mpiio()
+{
+  bigint header_end = 0;
+  if (filewriter) {
+    fflush(fp);
+    header_end = platform::ftell(fp);
+  }
+  MPI_Bcast(&header_end,1,MPI_LMP_BIGINT,0,world);
+
+  int ndouble = nme*size_one;
+  bigint mysize = nsme;
+  if (binary) mysize = sizeof(int) + (bigint) ndouble*sizeof(double);
+
+  bigint myoffset = 0;
+  bigint total;
+  MPI_Exscan(&mysize,&myoffset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (me == 0) myoffset = 0;
+  MPI_Allreduce(&mysize,&total,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  MPI_File fh;
+  int err = MPI_File_open(world,mpiio_name.c_str(),MPI_MODE_WRONLY,MPI_INFO_NULL,&fh);
+  int err_any;
+  MPI_Allreduce(&err,&err_any,1,MPI_INT,MPI_MAX,world);
+  if (err_any != MPI_SUCCESS) {
+    if (err == MPI_SUCCESS) MPI_File_close(&fh);
+    error->all(FLERR,"Cannot open dump file {} with MPI-IO", mpiio_name);
+  }
+
+  int io_error = 0;
+  MPI_Offset where = header_end + myoffset;
+  if (binary) {
+    if (MPI_File_write_at_all(fh,where,&ndouble,1,MPI_INT,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+      io_error = 1;
+    where += sizeof(int);
+    if (MPI_File_write_at_all(fh,where,buf,ndouble,MPI_DOUBLE,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+      io_error = 1;
+  } else {
+    if (MPI_File_write_at_all(fh,where,sbuf,nsme,MPI_CHAR,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+      io_error = 1;
+  }
+  if (MPI_File_close(&fh) != MPI_SUCCESS) io_error = 1;
+
+  int io_error_any;
+  MPI_Allreduce(&io_error,&io_error_any,1,MPI_INT,MPI_MAX,world);
+  if (io_error_any) error->all(FLERR,"Error writing dump {} with MPI-IO", id);
+
+  // proc 0 continues with stdio at the end of the snapshot
+
+  if (filewriter) platform::fseek(fp,header_end + total);
+}
+
+/* ----------------------------------------------------------------------
+   append data of one proc to the snapshot for the background thread
+   n = # of lines (or chars for string output) in ptr, nbytes = size of ptr
+   capacity of the copy is retained, so it only grows with the snapshot size
+------------------------------------------------------------------------- */
+
+void Dump::async_add(int n, const void *ptr, int nbytes)
+{
+  auto &data = async->data;
+  bigint start = data.size();
+  data.resize(start + nbytes);
+  if (nbytes) memcpy(data.data() + start, ptr, nbytes);
+  async->nlines.push_back(n);
+  async->offset.push_back(start);
+}
+
+/* ----------------------------------------------------------------------
+   start background thread which writes the data of the current snapshot,
+   the footer and closes the file if it is one file per snapshot
+   only one snapshot can be in flight, the next call to write() waits
+     for the thread via sync(), which throttles output that falls behind
+------------------------------------------------------------------------- */
+
+void Dump::async_write()
+{
+  async->thread = std::thread([this] {
+    try {
+      for (std::size_t i = 0; i < async->nlines.size(); i++)
+        write_data(async->nlines[i], (double *) (async->data.data() + async->offset[i]));
+      if (flush_flag && fp) fflush(fp);
+      write_footer();
+      if (fp && ferror(fp)) async->errmesg = utils::getsyserror();
+    } catch (std::exception &e) {
+      async->errmesg = e.what();
+    }
+
+    if (multifile) {
+      if (compressed) {
+        if (fp != nullptr) platform::pclose(fp);
+      } else {
+        if (fp != nullptr) fclose(fp);
+      }
+      fp = nullptr;
+    }
+
+    async->data.clear();
+    async->nlines.clear();
+    async->offset.clear();
+  });
+}
+
+/* ----------------------------------------------------------------------
+   wait until the background thread has written the previous snapshot
+   report = 1 to stop with an error if the thread failed, 0 to ignore it
+------------------------------------------------------------------------- */
+
+void Dump::sync(int report)
+{
+  if (!async || !async->thread.joinable()) return;
+
+  async->thread.join();
+  if (!async->errmesg.empty()) {
+    std::string mesg = async->errmesg;
+    async->errmesg.clear();
+    if (report) error->one(FLERR, "Error writing dump {}: {}", id, mesg);
+  }
+}
+
 /* ----------------------------------------------------------------------
    parallel sort of buf across all procs
    changes nme, reorders datums in buf, grows buf if necessary
@@ -1049,6 +1230,10 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  // settings must not change while the background thread is writing
+
+  sync();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1056,6 +1241,14 @@ void Dump::modify_params(int narg, char **arg)
       append_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      if (async_flag && !async) async = new AsyncWriter;
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"balance") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify balance", error);
       if (nprocs > 1)
@@ -1234,6 +1427,16 @@ void Dump::modify_params(int narg, char **arg)
       }
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"mpiio") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify mpiio", error);
+      mpiio_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (mpiio_flag) {
+        if (mpiio_allow == 0) error->all(FLERR,"Dump_modify mpiio yes not allowed for this style");
+        if (multiproc) error->all(FLERR,"Cannot use dump_modify mpiio with % in dump file name");
+        if (compressed) error->all(FLERR,"Cannot use dump_modify mpiio with compressed dump file");
+      }
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"nfile") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify nfile", error);
       if (!multiproc)
@@ -36,6 +36,8 @@ class Dump : protected Pointers {
   int comm_forward;    // size of forward communication (0 if none)
   int comm_reverse;    // size of reverse communication (0 if none)
 
+  double time_detail;    // wall time spent in this dump, with "timer detail"
+
 #if defined(LMP_QSORT)
   // static variable across all Dump objects
   static Dump *dumpptr;    // holds a ptr to Dump currently being used
@@ -53,6 +55,7 @@ class Dump : protected Pointers {
 
   void modify_params(int, char **);
   virtual double memory_usage();
+  void sync(int report = 1);
 
  protected:
   int me, nprocs;    // proc info
@@ -66,6 +69,7 @@ class Dump : protected Pointers {
   int filewriter;          // 1 if this proc writes a file, else 0
   int fileproc;            // ID of proc in my cluster who writes to file
   char *multiname;         // filename with % converted to cluster ID
+  std::string mpiio_name;  // name of currently open file for MPI-IO output
   MPI_Comm clustercomm;    // MPI communicator within my cluster of procs
 
   int flush_flag;           // 0 if no flush, 1 if flush every dump
@@ -74,6 +78,10 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if file output is done by a background thread
+  int mpiio_allow;          // 1 if style allows for mpiio_flag, 0 if not
+  int mpiio_flag;           // 1 if all procs write to file with MPI-IO, 0 if not
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -151,6 +159,9 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  struct AsyncWriter;      // data of background thread for asynchronous output
+  AsyncWriter *async;
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) { return 0; }
@@ -162,6 +173,9 @@ class Dump : protected Pointers {
   virtual void write_footer() {}
 
   void pbc_allocate();
+  void write_mpiio();
+  void async_add(int, const void *, int);
+  void async_write();
   double compute_time();
 
   void sort();
@@ -0,0 +1,325 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "dump_columnar.h"
+
+#include "domain.h"
+#include "error.h"
+#include "update.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(LAMMPS_ZSTD)
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   file layout, all values in native byte order:
+     file header: 16 chars MAGIC_STRING padded with NUL, int ENDIAN,
+                  int FORMAT_REVISION, int len + unit style string
+     per frame:   bigint framesize = # of bytes that follow in this frame
+                  bigint timestep, bigint natoms, double time,
+                  int triclinic, int boundary[3][2], double box[9],
+                  int ncol, per column: int len + label, int type,
+                                        int encoding, bigint nbytes
+                  followed by the encoded data of each column
+     frame index: bigint nframes, nframes x (bigint timestep, bigint offset),
+                  bigint offset of frame index, 8 chars INDEX_MAGIC
+   the frame index is written when the file is closed, without it
+     a reader can still step through the frames via their framesize
+------------------------------------------------------------------------- */
+
+/* ---------------------------------------------------------------------- */
+
+DumpColumnar::DumpColumnar(LAMMPS *lmp, int narg, char **arg) :
+    DumpCustom(lmp, narg, arg), frame_natoms(0), frame_step(0), frame_time(0.0),
+    frame_triclinic(0)
+{
+  if (compressed) error->all(FLERR, "Dump columnar files cannot be compressed externally");
+
+  // always binary output, always written as one chunk per frame
+
+  binary = 1;
+  buffer_allow = 0;
+  buffer_flag = 0;
+  mpiio_allow = 0;
+  async_allow = 0;
+
+  filter = 0;
+  compress = 0;
+  zstd_level = 3;
+
+  for (auto &b : frame_boundary) b[0] = b[1] = 0;
+  for (auto &b : frame_box) b = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   frame index of a single file is complete once all frames are written
+------------------------------------------------------------------------- */
+
+DumpColumnar::~DumpColumnar()
+{
+  if (filewriter && fp && !multifile) write_index();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::init_style()
+{
+  if (append_flag) error->all(FLERR, "Dump columnar does not support dump_modify append");
+  if (!write_header_flag) error->all(FLERR, "Dump columnar requires dump_modify header yes");
+  if (triclinic_general)
+    error->all(FLERR, "Dump columnar does not support dump_modify triclinic/general");
+
+  DumpCustom::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   open new file and write file header
+------------------------------------------------------------------------- */
+
+void DumpColumnar::openfile()
+{
+  if (singlefile_opened) return;
+  Dump::openfile();
+
+  index_step.clear();
+  index_offset.clear();
+
+  if (filewriter && fp) {
+    char magic[16];
+    memset(magic, 0, sizeof(magic));
+    strncpy(magic, MAGIC_STRING, sizeof(magic) - 1);
+    fwrite(magic, sizeof(char), sizeof(magic), fp);
+    int endian = ENDIAN;
+    int revision = FORMAT_REVISION;
+    fwrite(&endian, sizeof(int), 1, fp);
+    fwrite(&revision, sizeof(int), 1, fp);
+    int len = strlen(update->unit_style);
+    fwrite(&len, sizeof(int), 1, fp);
+    fwrite(update->unit_style, sizeof(char), len, fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store header info of this frame, the frame is written as a whole
+   by write_footer() once the data of all procs has arrived
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_header(bigint ndump)
+{
+  frame_natoms = ndump;
+  frame_step = update->ntimestep;
+  frame_time = compute_time();
+  frame_triclinic = domain->triclinic;
+  for (int i = 0; i < 3; i++) {
+    frame_boundary[i][0] = domain->boundary[i][0];
+    frame_boundary[i][1] = domain->boundary[i][1];
+  }
+  frame_box[0] = boxxlo;
+  frame_box[1] = boxxhi;
+  frame_box[2] = boxylo;
+  frame_box[3] = boxyhi;
+  frame_box[4] = boxzlo;
+  frame_box[5] = boxzhi;
+  frame_box[6] = frame_triclinic ? boxxy : 0.0;
+  frame_box[7] = frame_triclinic ? boxxz : 0.0;
+  frame_box[8] = frame_triclinic ? boxyz : 0.0;
+
+  framebuf.clear();
+  framebuf.reserve(ndump * size_one);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write_data(int n, double *mybuf)
+{
+  framebuf.insert(framebuf.end(), mybuf, mybuf + (bigint) n * size_one);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DumpColumnar::write_footer()
+{
+  write_frame();
+  if (multifile) write_index();
+  else if (flush_flag) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   transpose frame into columns, encode and write them
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_frame()
+{
+  frame_natoms = framebuf.size() / size_one;
+  auto labels = utils::split_words(columns);
+  int ncol = size_one;
+
+  std::vector<std::vector<char>> blobs(ncol);
+  std::vector<int> types(ncol), encodings(ncol);
+  bigint framesize = 2 * sizeof(bigint) + sizeof(double) + 7 * sizeof(int) + 9 * sizeof(double) +
+      sizeof(int);
+  for (int icol = 0; icol < ncol; icol++) {
+    types[icol] = (vtype[icol] == Dump::DOUBLE) ? FLOAT64 : INT64;
+    encodings[icol] = encode_column(icol, blobs[icol]);
+    framesize += 3 * sizeof(int) + labels[icol].size() + sizeof(bigint) + blobs[icol].size();
+  }
+
+  index_step.push_back(frame_step);
+  index_offset.push_back(platform::ftell(fp));
+
+  fwrite(&framesize, sizeof(bigint), 1, fp);
+  fwrite(&frame_step, sizeof(bigint), 1, fp);
+  fwrite(&frame_natoms, sizeof(bigint), 1, fp);
+  fwrite(&frame_time, sizeof(double), 1, fp);
+  fwrite(&frame_triclinic, sizeof(int), 1, fp);
+  fwrite(&frame_boundary[0][0], sizeof(int), 6, fp);
+  fwrite(frame_box, sizeof(double), 9, fp);
+  fwrite(&ncol, sizeof(int), 1, fp);
+
+  for (int icol = 0; icol < ncol; icol++) {
+    int len = labels[icol].size();
+    bigint nbytes = blobs[icol].size();
+    fwrite(&len, sizeof(int), 1, fp);
+    fwrite(labels[icol].c_str(), sizeof(char), len, fp);
+    fwrite(&types[icol], sizeof(int), 1, fp);
+    fwrite(&encodings[icol], sizeof(int), 1, fp);
+    fwrite(&nbytes, sizeof(bigint), 1, fp);
+  }
+
+  for (int icol = 0; icol < ncol; icol++)
+    fwrite(blobs[icol].data(), sizeof(char), blobs[icol].size(), fp);
+}
+
+/* ----------------------------------------------------------------------
+   append frame index and trailer at current file position
+------------------------------------------------------------------------- */
+
+void DumpColumnar::write_index()
+{
+  bigint where = platform::ftell(fp);
+  bigint nframes = index_step.size();
+  fwrite(&nframes, sizeof(bigint), 1, fp);
+  for (bigint i = 0; i < nframes; i++) {
+    fwrite(&index_step[i], sizeof(bigint), 1, fp);
+    fwrite(&index_offset[i], sizeof(bigint), 1, fp);
+  }
+  fwrite(&where, sizeof(bigint), 1, fp);
+  fwrite(INDEX_MAGIC, sizeof(char), 8, fp);
+  if (flush_flag) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   encode column icol of current frame into out
+   integer columns are stored as 64-bit integers, others as doubles
+   DELTA stores differences to the previous value for integers and
+     XOR with the bits of the previous value for doubles
+   SHUFFLE groups the bytes by significance, which helps compression
+   zstd compression is skipped for a column if it does not reduce its size
+   return encoding flags that were applied
+------------------------------------------------------------------------- */
+
+int DumpColumnar::encode_column(int icol, std::vector<char> &out)
+{
+  const bigint n = frame_natoms;
+  std::vector<uint64_t> bits(n);
+
+  if (vtype[icol] == Dump::DOUBLE) {
+    for (bigint i = 0; i < n; i++) memcpy(&bits[i], &framebuf[i * size_one + icol], 8);
+  } else {
+    for (bigint i = 0; i < n; i++)
+      bits[i] = static_cast<uint64_t>(static_cast<int64_t>(framebuf[i * size_one + icol]));
+  }
+
+  int encoding = 0;
+  if (filter & DELTA) {
+    encoding |= DELTA;
+    if (vtype[icol] == Dump::DOUBLE) {
+      for (bigint i = n - 1; i > 0; i--) bits[i] ^= bits[i - 1];
+    } else {
+      for (bigint i = n - 1; i > 0; i--) bits[i] -= bits[i - 1];
+    }
+  }
+
+  std::vector<char> raw(n * 8);
+  if (filter & SHUFFLE) {
+    encoding |= SHUFFLE;
+    const auto *src = (const unsigned char *) bits.data();
+    for (bigint i = 0; i < n; i++)
+      for (int b = 0; b < 8; b++) raw[b * n + i] = src[i * 8 + b];
+  } else if (n) {
+    memcpy(raw.data(), bits.data(), n * 8);
+  }
+
+#if defined(LAMMPS_ZSTD)
+  if (compress && n) {
+    out.resize(ZSTD_compressBound(raw.size()));
+    size_t nbytes = ZSTD_compress(out.data(), out.size(), raw.data(), raw.size(), zstd_level);
+    if (ZSTD_isError(nbytes))
+      error->one(FLERR, "Error compressing dump columnar data: {}", ZSTD_getErrorName(nbytes));
+    if (nbytes < raw.size()) {
+      out.resize(nbytes);
+      return encoding | ZSTD;
+    }
+  }
+#endif
+
+  out.swap(raw);
+  return encoding;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int DumpColumnar::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0], "compress") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compress", error);
+    if (strcmp(arg[1], "none") == 0) {
+      compress = 0;
+    } else if (strcmp(arg[1], "zstd") == 0) {
+#if defined(LAMMPS_ZSTD)
+      compress = 1;
+#else
+      error->all(FLERR, "Dump columnar zstd compression requires LAMMPS compiled with zstd support");
+#endif
+    } else {
+      error->all(FLERR, "Unknown dump_modify compress setting: {}", arg[1]);
+    }
+    return 2;
+  }
+
+  if (strcmp(arg[0], "compression_level") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify compression_level", error);
+    zstd_level = utils::inumeric(FLERR, arg[1], false, lmp);
+    return 2;
+  }
+
+  if (strcmp(arg[0], "filter") == 0) {
+    if (narg < 2) utils::missing_cmd_args(FLERR, "dump_modify filter", error);
+    if (strcmp(arg[1], "none") == 0)
+      filter = 0;
+    else if (strcmp(arg[1], "shuffle") == 0)
+      filter = SHUFFLE;
+    else if (strcmp(arg[1], "delta") == 0)
+      filter = DELTA | SHUFFLE;
+    else
+      error->all(FLERR, "Unknown dump_modify filter setting: {}", arg[1]);
+    return 2;
+  }
+
+  return DumpCustom::modify_param(narg, arg);
+}
@@ -0,0 +1,75 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef DUMP_CLASS
+// clang-format off
+DumpStyle(columnar,DumpColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_DUMP_COLUMNAR_H
+#define LMP_DUMP_COLUMNAR_H
+
+#include "dump_custom.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class DumpColumnar : public DumpCustom {
+ public:
+  DumpColumnar(class LAMMPS *, int, char **);
+  ~DumpColumnar() override;
+
+  // layout of the file, must match ReaderColumnar
+
+  static constexpr const char *MAGIC_STRING = "LAMMPSCOLUMNAR";
+  static constexpr const char *INDEX_MAGIC = "COLINDEX";
+  static constexpr int FORMAT_REVISION = 0x0001;
+  static constexpr int ENDIAN = 0x0001;
+  enum { INT64, FLOAT64 };                          // column data types
+  enum { SHUFFLE = 1 << 0, DELTA = 1 << 1, ZSTD = 1 << 2 };    // column encoding flags
+
+ protected:
+  int filter;       // SHUFFLE and DELTA flags applied to each column
+  int compress;     // 1 if columns are compressed with zstd
+  int zstd_level;   // compression level for zstd
+
+  bigint frame_natoms;          // # of atoms in current frame
+  bigint frame_step;            // timestep of current frame
+  double frame_time;            // simulation time of current frame
+  int frame_triclinic;          // box info of current frame
+  int frame_boundary[3][2];
+  double frame_box[9];
+  std::vector<double> framebuf;    // per-atom data of current frame, row by row
+
+  std::vector<bigint> index_step;      // timestep of each frame in file
+  std::vector<bigint> index_offset;    // file offset of each frame in file
+
+  void init_style() override;
+  void openfile() override;
+  void write_header(bigint) override;
+  void write_data(int, double *) override;
+  void write_footer() override;
+  int modify_param(int, char **) override;
+
+  void write_frame();
+  void write_index();
+  int encode_column(int, std::vector<char> &);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -87,6 +87,8 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  mpiio_allow = 1;
+  async_allow = 1;
 
   triclinic_general = 0;
   nthresh = 0;
@@ -621,7 +623,7 @@ int DumpCustom::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_PERATOM)) {
-        compute[i]->compute_peratom();
+        compute[i]->invoke_peratom();
         compute[i]->invoked_flag |= Compute::INVOKED_PERATOM;
       }
     }
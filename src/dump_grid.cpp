@@ -531,7 +531,7 @@ int DumpGrid::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_PERGRID)) {
-        compute[i]->compute_pergrid();
+        compute[i]->invoke_pergrid();
         compute[i]->invoked_flag |= Compute::INVOKED_PERGRID;
       }
     }
@@ -71,6 +71,8 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
   // force binary flag on to avoid corrupted output on Windows
 
   binary = 1;
+  mpiio_allow = 0;
+  async_allow = 0;
   multifile_override = 0;
 
   // flag has_id as true to avoid bogus warnings about atom IDs for dump styles derived from DumpCustom
@@ -693,7 +695,7 @@ void DumpImage::write()
         error->all(FLERR,"Grid compute ID {} used in dump image cannot be invoked "
                    "before initialization by a run", grid_compute->id);
       if (!(grid_compute->invoked_flag & Compute::INVOKED_PERGRID)) {
-        grid_compute->compute_pergrid();
+        grid_compute->invoke_pergrid();
         grid_compute->invoked_flag |= Compute::INVOKED_PERGRID;
       }
     }
@@ -900,6 +902,8 @@ void DumpImage::create_image()
   double mat[3][3];
 
   // render my atoms
+  // with multiple threads, each thread loops over all atoms
+  //   and renders only the rows of the image it owns, see Image::thread_rows()
 
   if (atomflag) {
     double **x = atom->x;
@@ -907,44 +911,52 @@ void DumpImage::create_image()
     int *tri = atom->tri;
     int *body = atom->body;
 
-    m = 0;
-    for (i = 0; i < nchoose; i++) {
-      j = clist[i];
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(comm->nthreads) default(shared)
+#endif
+    {
+      double rgb[3];
+      double *color = nullptr;
+      double diameter = 0.0;
+      int itype;
+
+      for (int i = 0; i < nchoose; i++) {
+        int j = clist[i];
+        int m = i*size_one;
+
+        if (acolor == TYPE) {
+          itype = static_cast<int> (buf[m]);
+          color = colortype[itype];
+        } else if (acolor == ELEMENT) {
+          itype = static_cast<int> (buf[m]);
+          color = colorelement[itype];
+        } else if (acolor == ATTRIBUTE) {
+          color = image->map_value2color(0,buf[m],rgb);
+        } else color = image->color2rgb("white");
+
+        if (adiam == NUMERIC) {
+          diameter = adiamvalue;
+        } else if (adiam == TYPE) {
+          itype = static_cast<int> (buf[m+1]);
+          diameter = diamtype[itype];
+        } else if (adiam == ELEMENT) {
+          itype = static_cast<int> (buf[m+1]);
+          diameter = diamelement[itype];
+        } else if (adiam == ATTRIBUTE) {
+          diameter = buf[m+1];
+        }
 
-      if (acolor == TYPE) {
-        itype = static_cast<int> (buf[m]);
-        color = colortype[itype];
-      } else if (acolor == ELEMENT) {
-        itype = static_cast<int> (buf[m]);
-        color = colorelement[itype];
-      } else if (acolor == ATTRIBUTE) {
-        color = image->map_value2color(0,buf[m]);
-      } else color = image->color2rgb("white");
-
-      if (adiam == NUMERIC) {
-        diameter = adiamvalue;
-      } else if (adiam == TYPE) {
-        itype = static_cast<int> (buf[m+1]);
-        diameter = diamtype[itype];
-      } else if (adiam == ELEMENT) {
-        itype = static_cast<int> (buf[m+1]);
-        diameter = diamelement[itype];
-      } else if (adiam == ATTRIBUTE) {
-        diameter = buf[m+1];
-      }
+        // do not draw if line,tri,body keywords enabled and atom is one of those
 
-      // do not draw if line,tri,body keywords enabled and atom is one of those
+        int drawflag = 1;
+        if (extraflag) {
+          if (lineflag && line[j] >= 0) drawflag = 0;
+          if (triflag && tri[j] >= 0) drawflag = 0;
+          if (bodyflag && body[j] >= 0) drawflag = 0;
+        }
 
-      drawflag = 1;
-      if (extraflag) {
-        if (lineflag && line[j] >= 0) drawflag = 0;
-        if (triflag && tri[j] >= 0) drawflag = 0;
-        if (bodyflag && body[j] >= 0) drawflag = 0;
+        if (drawflag) image->draw_sphere(x[j],color,diameter);
       }
-
-      if (drawflag) image->draw_sphere(x[j],color,diameter);
-
-      m += size_one;
     }
   }
 
@@ -1159,91 +1171,105 @@ void DumpImage::create_image()
 
     comm->forward_comm(this);
 
-    for (i = 0; i < nchoose; i++) {
-      atom1 = clist[i];
-      if (molecular == Atom::MOLECULAR) n = num_bond[atom1];
-      else {
-        if (molindex[atom1] < 0) continue;
-        imol = molindex[atom1];
-        iatom = molatom[atom1];
-        n = onemols[imol]->num_bond[iatom];
-      }
+    // with multiple threads, each thread loops over all bonds, as for atoms
 
-      for (m = 0; m < n; m++) {
-        if (molecular == Atom::MOLECULAR) {
-          btype = bond_type[atom1][m];
-          atom2 = atom->map(bond_atom[atom1][m]);
-        } else {
-          tagprev = tag[i] - iatom - 1;
-          btype = atom->map(onemols[imol]->bond_type[iatom][m]);
-          atom2 = atom->map(onemols[imol]->bond_atom[iatom][m]+tagprev);
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(comm->nthreads) default(shared)
+#endif
+    {
+      double rgb1[3],rgb2[3],xmid[3];
+      double *color = nullptr, *color1 = nullptr, *color2 = nullptr;
+      double diameter = 0.0;
+      double delx,dely,delz;
+      int n,m,imol,iatom,atom1,atom2,btype,itype;
+      tagint tagprev;
+
+      for (int i = 0; i < nchoose; i++) {
+        atom1 = clist[i];
+        if (molecular == Atom::MOLECULAR) n = num_bond[atom1];
+        else {
+          if (molindex[atom1] < 0) continue;
+          imol = molindex[atom1];
+          iatom = molatom[atom1];
+          n = onemols[imol]->num_bond[iatom];
         }
 
-        if (atom2 < 0 || !chooseghost[atom2]) continue;
-        if (newton_bond == 0 && tag[atom1] > tag[atom2]) continue;
-        if (btype == 0) continue;
-
-        if (bcolor == ATOM) {
-          if (acolor == TYPE) {
-            color1 = colortype[type[atom1]];
-            color2 = colortype[type[atom2]];
-          } else if (acolor == ELEMENT) {
-            color1 = colorelement[type[atom1]];
-            color2 = colorelement[type[atom2]];
-          } else if (acolor == ATTRIBUTE) {
-            color1 = image->map_value2color(0,bufcopy[atom1][0]);
-            color2 = image->map_value2color(0,bufcopy[atom2][0]);
+        for (m = 0; m < n; m++) {
+          if (molecular == Atom::MOLECULAR) {
+            btype = bond_type[atom1][m];
+            atom2 = atom->map(bond_atom[atom1][m]);
           } else {
-            color1 = image->color2rgb("white");
-            color2 = image->color2rgb("white");
+            tagprev = tag[i] - iatom - 1;
+            btype = atom->map(onemols[imol]->bond_type[iatom][m]);
+            atom2 = atom->map(onemols[imol]->bond_atom[iatom][m]+tagprev);
           }
-        } else if (bcolor == TYPE) {
-          itype = btype;
-          if (itype < 0) itype = -itype;
-          color = bcolortype[itype];
-        }
 
-        if (bdiam == NUMERIC) {
-          diameter = bdiamvalue;
-        } else if (bdiam == ATOM) {
-          if (adiam == NUMERIC) {
-            diameter = adiamvalue;
-          } else if (adiam == TYPE) {
-            diameter = MIN(diamtype[type[atom1]],diamtype[type[atom1]]);
-          } else if (adiam == ELEMENT) {
-            diameter = MIN(diamelement[type[atom1]],diamelement[type[atom1]]);
-          } else if (adiam == ATTRIBUTE) {
-            diameter = MIN(bufcopy[atom1][1],bufcopy[atom2][1]);
+          if (atom2 < 0 || !chooseghost[atom2]) continue;
+          if (newton_bond == 0 && tag[atom1] > tag[atom2]) continue;
+          if (btype == 0) continue;
+
+          if (bcolor == ATOM) {
+            if (acolor == TYPE) {
+              color1 = colortype[type[atom1]];
+              color2 = colortype[type[atom2]];
+            } else if (acolor == ELEMENT) {
+              color1 = colorelement[type[atom1]];
+              color2 = colorelement[type[atom2]];
+            } else if (acolor == ATTRIBUTE) {
+              color1 = image->map_value2color(0,bufcopy[atom1][0],rgb1);
+              color2 = image->map_value2color(0,bufcopy[atom2][0],rgb2);
+            } else {
+              color1 = image->color2rgb("white");
+              color2 = image->color2rgb("white");
+            }
+          } else if (bcolor == TYPE) {
+            itype = btype;
+            if (itype < 0) itype = -itype;
+            color = bcolortype[itype];
           }
-        } else if (bdiam == TYPE) {
-          itype = btype;
-          if (itype < 0) itype = -itype;
-          diameter = bdiamtype[itype];
-        }
 
-        // draw cylinder in 2 pieces if bcolor = ATOM
-        // or bond crosses periodic boundary
-
-        delx = x[atom2][0] - x[atom1][0];
-        dely = x[atom2][1] - x[atom1][1];
-        delz = x[atom2][2] - x[atom1][2];
-
-        if (bcolor == ATOM || domain->minimum_image_check(delx,dely,delz)) {
-          domain->minimum_image(delx,dely,delz);
-          xmid[0] = x[atom1][0] + 0.5*delx;
-          xmid[1] = x[atom1][1] + 0.5*dely;
-          xmid[2] = x[atom1][2] + 0.5*delz;
-          if (bcolor == ATOM)
-            image->draw_cylinder(x[atom1],xmid,color1,diameter,3);
-          else image->draw_cylinder(x[atom1],xmid,color,diameter,3);
-          xmid[0] = x[atom2][0] - 0.5*delx;
-          xmid[1] = x[atom2][1] - 0.5*dely;
-          xmid[2] = x[atom2][2] - 0.5*delz;
-          if (bcolor == ATOM)
-            image->draw_cylinder(xmid,x[atom2],color2,diameter,3);
-          else image->draw_cylinder(xmid,x[atom2],color,diameter,3);
-
-        } else image->draw_cylinder(x[atom1],x[atom2],color,diameter,3);
+          if (bdiam == NUMERIC) {
+            diameter = bdiamvalue;
+          } else if (bdiam == ATOM) {
+            if (adiam == NUMERIC) {
+              diameter = adiamvalue;
+            } else if (adiam == TYPE) {
+              diameter = MIN(diamtype[type[atom1]],diamtype[type[atom1]]);
+            } else if (adiam == ELEMENT) {
+              diameter = MIN(diamelement[type[atom1]],diamelement[type[atom1]]);
+            } else if (adiam == ATTRIBUTE) {
+              diameter = MIN(bufcopy[atom1][1],bufcopy[atom2][1]);
+            }
+          } else if (bdiam == TYPE) {
+            itype = btype;
+            if (itype < 0) itype = -itype;
+            diameter = bdiamtype[itype];
+          }
+
+          // draw cylinder in 2 pieces if bcolor = ATOM
+          // or bond crosses periodic boundary
+
+          delx = x[atom2][0] - x[atom1][0];
+          dely = x[atom2][1] - x[atom1][1];
+          delz = x[atom2][2] - x[atom1][2];
+
+          if (bcolor == ATOM || domain->minimum_image_check(delx,dely,delz)) {
+            domain->minimum_image(delx,dely,delz);
+            xmid[0] = x[atom1][0] + 0.5*delx;
+            xmid[1] = x[atom1][1] + 0.5*dely;
+            xmid[2] = x[atom1][2] + 0.5*delz;
+            if (bcolor == ATOM)
+              image->draw_cylinder(x[atom1],xmid,color1,diameter,3);
+            else image->draw_cylinder(x[atom1],xmid,color,diameter,3);
+            xmid[0] = x[atom2][0] - 0.5*delx;
+            xmid[1] = x[atom2][1] - 0.5*dely;
+            xmid[2] = x[atom2][2] - 0.5*delz;
+            if (bcolor == ATOM)
+              image->draw_cylinder(xmid,x[atom2],color2,diameter,3);
+            else image->draw_cylinder(xmid,x[atom2],color,diameter,3);
+
+          } else image->draw_cylinder(x[atom1],x[atom2],color,diameter,3);
+        }
       }
     }
   }
@@ -65,6 +65,7 @@ DumpLocal::DumpLocal(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   // computes & fixes which the dump accesses
 
@@ -333,7 +334,7 @@ int DumpLocal::count()
         error->all(FLERR,"Dump compute ID {} cannot be invoked before initialization by a run",
           compute[i]->id);
       if (!(compute[i]->invoked_flag & Compute::INVOKED_LOCAL)) {
-        compute[i]->compute_local();
+        compute[i]->invoke_local();
         compute[i]->invoked_flag |= Compute::INVOKED_LOCAL;
       }
     }
@@ -38,6 +38,7 @@ DumpXYZ::DumpXYZ(LAMMPS *lmp, int narg, char **arg) : Dump(lmp, narg, arg),
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
   sort_flag = 1;
   sortcol = 0;
 
@@ -18,25 +18,29 @@
 #include "atom.h"
 #include "atom_vec.h"
 #include "comm.h"
+#include "compute.h"
+#include "dump.h"
 #include "error.h"
+#include "fix.h"
 #include "force.h"
 #include "kspace.h"
 #include "memory.h"             // IWYU pragma: keep
 #include "min.h"
+#include "modify.h"
 #include "molecule.h"
 #include "neighbor.h"           // IWYU pragma: keep
 #include "output.h"
-#include "pair.h"
+#include "pair_hybrid.h"
 #include "thermo.h"
 #include "timer.h"              // IWYU pragma: keep
 #include "universe.h"
 #include "update.h"
+#include "write_restart.h"
 
 #include <cmath>
 #include <cstring>
 
 #ifdef LMP_OPENMP
-#include "modify.h"
 #include "fix_omp.h"
 #include "thr_data.h"
 #endif
@@ -48,6 +52,11 @@ using namespace LAMMPS_NS;
 static void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log);
+static void counter_stats(const char *label, Timer *t, enum Timer::ttype tt,
+                          MPI_Comm world, const int me, FILE *scr, FILE *log);
+static void detail_timings(const std::string &label, int width, double time, MPI_Comm world,
+                           const int nprocs, const int me, double time_loop,
+                           FILE *scr, FILE *log);
 
 #ifdef LMP_OPENMP
 static void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
@@ -75,6 +84,12 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // complete pending asynchronous dump and restart output, so the
+  // files are complete when a run ends
+
+  for (auto &dump : output->get_dump_list()) dump->sync();
+  if (output->restart) output->restart->sync();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -356,6 +371,65 @@ void Finish::end(int flag)
     }
   }
 
+  // hardware performance counters for the same sections
+  // counters are summed over all procs and threads
+
+  if (timeflag && timer->has_normal() && timer->has_counters()) {
+    if (me == 0)
+      utils::logmesg(lmp,"\nHardware counter breakdown:\nSection |   cycles   |   instr.   "
+                     "|  IPC  |LLC MPKI|%brmiss\n---------------------------------------"
+                     "--------------------\n");
+
+    counter_stats("Pair",timer,Timer::PAIR,world,me,screen,logfile);
+    if (atom->molecular != Atom::ATOMIC)
+      counter_stats("Bond",timer,Timer::BOND,world,me,screen,logfile);
+    if (force->kspace)
+      counter_stats("Kspace",timer,Timer::KSPACE,world,me,screen,logfile);
+    counter_stats("Neigh",timer,Timer::NEIGH,world,me,screen,logfile);
+    counter_stats("Comm",timer,Timer::COMM,world,me,screen,logfile);
+    counter_stats("Output",timer,Timer::OUTPUT,world,me,screen,logfile);
+    counter_stats("Modify",timer,Timer::MODIFY,world,me,screen,logfile);
+    if (timer->has_sync())
+      counter_stats("Sync",timer,Timer::SYNC,world,me,screen,logfile);
+    counter_stats("Other",timer,Timer::TOTAL,world,me,screen,logfile);
+  }
+
+  // per-instance breakdown of fixes, computes, pair sub-styles, and dumps
+  // compute times include computes they invoke themselves
+
+  if (timeflag && timer->has_detail()) {
+    std::vector<std::pair<std::string, double>> items;
+
+    for (const auto &ifix : modify->get_fix_list())
+      items.emplace_back(fmt::format("fix {} ({})",ifix->id,ifix->style),ifix->time_detail);
+    for (const auto &icompute : modify->get_compute_list())
+      items.emplace_back(fmt::format("compute {} ({})",icompute->id,icompute->style),
+                         icompute->time_detail);
+
+    auto hybrid = dynamic_cast<PairHybrid *>(force->pair);
+    if (hybrid) {
+      for (int m = 0; m < hybrid->nstyles; m++) {
+        std::string label = fmt::format("pair {}",hybrid->keywords[m]);
+        if (hybrid->multiple[m]) label += fmt::format(":{}",hybrid->multiple[m]);
+        items.emplace_back(label,hybrid->styles[m]->time_detail);
+      }
+    }
+
+    for (int idump = 0; idump < output->ndump; idump++)
+      items.emplace_back(fmt::format("dump {} ({})",output->dump[idump]->id,
+                                     output->dump[idump]->style),output->dump[idump]->time_detail);
+
+    int width = 8;
+    for (const auto &item : items) width = MAX(width,(int) item.first.size()+1);
+
+    if (me == 0)
+      utils::logmesg(lmp,"\nDetailed timing breakdown:\n{:<{}s}|  min time  |  avg time  "
+                     "|  max time  |%varavg| %total\n{:-<{}s}\n","Instance",width,"",width+55);
+
+    for (const auto &item : items)
+      detail_timings(item.first,width,item.second,world,nprocs,me,time_loop,screen,logfile);
+  }
+
 #ifdef LMP_OPENMP
   FixOMP *fixomp = dynamic_cast<FixOMP *>(modify->get_fix_by_id("package_omp"));
 
@@ -538,6 +612,8 @@ void Finish::end(int flag)
       if ((atom->molecular != Atom::ATOMIC) && (atom->natoms > 0))
         mesg += fmt::format("Ave special neighs/atom = {:.8}\n",nspec_all/atom->natoms);
       mesg += fmt::format("Neighbor list builds = {}\n",neighbor->ncalls);
+      if (neighbor->partial_flag)
+        mesg += fmt::format("Partial neighbor list builds = {}\n",neighbor->npartial);
       if (neighbor->dist_check)
         mesg += fmt::format("Dangerous builds = {}\n",neighbor->ndanger);
       else mesg += "Dangerous builds not checked\n";
@@ -545,6 +621,10 @@ void Finish::end(int flag)
     }
   }
 
+  // append events of this run to the timer event trace
+
+  if (timer->has_trace()) timer->trace_write();
+
   if (logfile) fflush(logfile);
 }
 
@@ -641,6 +721,80 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
   }
 }
 
+/* ----------------------------------------------------------------------
+   print hardware counters of one timer section, Timer::TOTAL for the rest
+   IPC = instructions per cycle
+   LLC MPKI = last level cache misses per 1000 instructions
+   %brmiss = percentage of mispredicted branches
+------------------------------------------------------------------------- */
+
+void counter_stats(const char *label, Timer *t, enum Timer::ttype tt,
+                   MPI_Comm world, const int me, FILE *scr, FILE *log)
+{
+  double count[Timer::NUM_COUNTER], sum[Timer::NUM_COUNTER];
+
+  for (int i = 0; i < Timer::NUM_COUNTER; i++) {
+    auto ct = (enum Timer::ctype) i;
+    count[i] = t->get_counter(tt,ct);
+    if (tt == Timer::TOTAL) count[i] -= t->get_counter(Timer::ALL,ct);
+  }
+  MPI_Allreduce(count,sum,Timer::NUM_COUNTER,MPI_DOUBLE,MPI_SUM,world);
+
+  if (me == 0) {
+    std::string mesg = fmt::format("{:<8s}|",label);
+    if (t->has_counter(Timer::CYCLES)) mesg += fmt::format(" {:<10.5g} |",sum[Timer::CYCLES]);
+    else mesg += "     -      |";
+    if (t->has_counter(Timer::INSTRUCTIONS))
+      mesg += fmt::format(" {:<10.5g} |",sum[Timer::INSTRUCTIONS]);
+    else mesg += "     -      |";
+
+    if (t->has_counter(Timer::CYCLES) && t->has_counter(Timer::INSTRUCTIONS) &&
+        (sum[Timer::CYCLES] > 0.0))
+      mesg += fmt::format("{:6.2f} |",sum[Timer::INSTRUCTIONS]/sum[Timer::CYCLES]);
+    else mesg += "     - |";
+    if (t->has_counter(Timer::LLC_MISSES) && t->has_counter(Timer::INSTRUCTIONS) &&
+        (sum[Timer::INSTRUCTIONS] > 0.0))
+      mesg += fmt::format("{:7.3f} |",1000.0*sum[Timer::LLC_MISSES]/sum[Timer::INSTRUCTIONS]);
+    else mesg += "      - |";
+    if (t->has_counter(Timer::BRANCH_MISSES) && t->has_counter(Timer::BRANCHES) &&
+        (sum[Timer::BRANCHES] > 0.0))
+      mesg += fmt::format("{:7.2f}\n",100.0*sum[Timer::BRANCH_MISSES]/sum[Timer::BRANCHES]);
+    else mesg += "      -\n";
+
+    if (scr) fputs(mesg.c_str(),scr);
+    if (log) fputs(mesg.c_str(),log);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void detail_timings(const std::string &label, int width, double time, MPI_Comm world,
+                    const int nprocs, const int me, double time_loop, FILE *scr, FILE *log)
+{
+  double tmp, time_max, time_min, time_sq;
+
+  MPI_Allreduce(&time,&time_min,1,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(&time,&time_max,1,MPI_DOUBLE,MPI_MAX,world);
+  time_sq = time*time;
+  MPI_Allreduce(&time,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time = tmp/nprocs;
+  MPI_Allreduce(&time_sq,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time_sq = tmp/nprocs;
+
+  if ((time > 0.001) && ((time_sq/time - time) > 1.0e-10))
+    time_sq = sqrt(time_sq/time - time)*100.0;
+  else
+    time_sq = 0.0;
+
+  if (me == 0) {
+    std::string mesg = fmt::format("{:<{}s}| {:<10.5g} | {:<10.5g} | {:<10.5g} |{:6.1f} |"
+                                   "{:6.2f}\n",label,width,time_min,time,time_max,time_sq,
+                                   time/time_loop*100.0);
+    if (scr) fputs(mesg.c_str(),scr);
+    if (log) fputs(mesg.c_str(),log);
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 #ifdef LMP_OPENMP
@@ -88,6 +88,7 @@ Fix::Fix(LAMMPS *lmp, int /*narg*/, char **arg) :
 
   comm_forward = comm_reverse = comm_border = 0;
   restart_reset = 0;
+  time_detail = 0.0;
 
   // reasonable defaults
   // however, each fix that uses these values should explicitly set them
@@ -127,6 +127,8 @@ class Fix : protected Pointers {
 
   int restart_reset;    // 1 if restart just re-initialized fix
 
+  double time_detail;    // wall time spent in this fix, with "timer detail"
+
   // KOKKOS flags and variables
 
   int kokkosable;              // 1 if Kokkos fix
@@ -294,7 +294,7 @@ void FixAveAtom::end_of_step()
 
     } else if (val.which == ArgInfo::COMPUTE) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-        val.val.c->compute_peratom();
+        val.val.c->invoke_peratom();
         val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
 
@@ -637,7 +637,7 @@ void FixAveChunk::end_of_step()
     } else if (val.which == ArgInfo::TEMPERATURE) {
 
       if (biasflag) {
-        if (tbias->invoked_scalar != ntimestep) tbias->compute_scalar();
+        if (tbias->invoked_scalar != ntimestep) tbias->invoke_scalar();
         tbias->remove_bias_all();
       }
 
@@ -670,7 +670,7 @@ void FixAveChunk::end_of_step()
 
     } else if (val.which == ArgInfo::COMPUTE) {
       if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-        val.val.c->compute_peratom();
+        val.val.c->invoke_peratom();
         val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
       double *vector = val.val.c->vector_atom;
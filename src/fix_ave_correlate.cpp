@@ -393,13 +393,13 @@ void FixAveCorrelate::end_of_step()
 
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
-          val.val.c->compute_scalar();
+          val.val.c->invoke_scalar();
           val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         scalar = val.val.c->scalar;
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val.val.c->compute_vector();
+          val.val.c->invoke_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         scalar = val.val.c->vector[val.argindex-1];
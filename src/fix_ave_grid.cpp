@@ -904,7 +904,7 @@ void FixAveGrid::atom2grid()
     } else if (which[m] == ArgInfo::TEMPERATURE) {
 
       if (biasflag) {
-        if (tbias->invoked_scalar != update->ntimestep) tbias->compute_scalar();
+        if (tbias->invoked_scalar != update->ntimestep) tbias->invoke_scalar();
         tbias->remove_bias_all();
       }
 
@@ -967,7 +967,7 @@ void FixAveGrid::atom2grid()
       if (which[m] == ArgInfo::COMPUTE) {
         Compute *compute = modify->get_compute_by_index(n);
         if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
-          compute->compute_peratom();
+          compute->invoke_peratom();
           compute->invoked_flag |= Compute::INVOKED_PERATOM;
         }
         if (j == 0) ovector = compute->vector_atom;
@@ -1076,7 +1076,7 @@ void FixAveGrid::grid2grid()
     if (which[m] == ArgInfo::COMPUTE) {
       compute = modify->get_compute_by_index(n);
       if (!(compute->invoked_flag & Compute::INVOKED_PERGRID)) {
-        compute->compute_pergrid();
+        compute->invoke_pergrid();
         compute->invoked_flag |= Compute::INVOKED_PERGRID;
       }
     } else if (which[m] == ArgInfo::FIX) fix = modify->get_fix_by_index(n);
@@ -521,13 +521,13 @@ void FixAveHisto::end_of_step()
       if (kind == GLOBAL && mode == SCALAR) {
         if (j == 0) {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
-            val.val.c->compute_scalar();
+            val.val.c->invoke_scalar();
             val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
           }
           bin_one(val.val.c->scalar);
         } else {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-            val.val.c->compute_vector();
+            val.val.c->invoke_vector();
             val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
           }
           bin_one(val.val.c->vector[j-1]);
@@ -535,13 +535,13 @@ void FixAveHisto::end_of_step()
       } else if (kind == GLOBAL && mode == VECTOR) {
         if (j == 0) {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-            val.val.c->compute_vector();
+            val.val.c->invoke_vector();
             val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
           }
           bin_vector(val.val.c->size_vector,val.val.c->vector,1);
         } else {
           if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-            val.val.c->compute_array();
+            val.val.c->invoke_array();
             val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
           }
           if (val.val.c->array)
@@ -551,7 +551,7 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == PERATOM) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-          val.val.c->compute_peratom();
+          val.val.c->invoke_peratom();
           val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
         }
         if (j == 0)
@@ -561,7 +561,7 @@ void FixAveHisto::end_of_step()
 
       } else if (kind == LOCAL) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
-          val.val.c->compute_local();
+          val.val.c->invoke_local();
           val.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
         }
         if (j == 0)
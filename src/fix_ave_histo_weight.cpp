@@ -137,13 +137,13 @@ void FixAveHistoWeight::end_of_step()
     if (kind == GLOBAL && mode == SCALAR) {
       if (j == 0) {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
-          val1.val.c->compute_scalar();
+          val1.val.c->invoke_scalar();
           val1.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         weight = val1.val.c->scalar;
       } else {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val1.val.c->compute_vector();
+          val1.val.c->invoke_vector();
           val1.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         weight = val1.val.c->vector[j-1];
@@ -151,14 +151,14 @@ void FixAveHistoWeight::end_of_step()
     } else if (kind == GLOBAL && mode == VECTOR) {
       if (j == 0) {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val1.val.c->compute_vector();
+          val1.val.c->invoke_vector();
           val1.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         weights = val1.val.c->vector;
         stride = 1;
       } else {
         if (!(val1.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-          val1.val.c->compute_array();
+          val1.val.c->invoke_array();
           val1.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
         if (val1.val.c->array) weights = &val1.val.c->array[0][j-1];
@@ -166,7 +166,7 @@ void FixAveHistoWeight::end_of_step()
       }
     } else if (kind == PERATOM) {
       if (!(val1.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-        val1.val.c->compute_peratom();
+        val1.val.c->invoke_peratom();
         val1.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
       if (j == 0) {
@@ -178,7 +178,7 @@ void FixAveHistoWeight::end_of_step()
       }
     } else if (kind == LOCAL) {
       if (!(val1.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
-        val1.val.c->compute_local();
+        val1.val.c->invoke_local();
         val1.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
       }
       if (j == 0) {
@@ -262,13 +262,13 @@ void FixAveHistoWeight::end_of_step()
     if (kind == GLOBAL && mode == SCALAR) {
       if (j == 0) {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
-          val0.val.c->compute_scalar();
+          val0.val.c->invoke_scalar();
           val0.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         bin_one_weights(val0.val.c->scalar,weight);
       } else {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val0.val.c->compute_vector();
+          val0.val.c->invoke_vector();
           val0.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         bin_one_weights(val0.val.c->vector[j-1],weight);
@@ -276,14 +276,14 @@ void FixAveHistoWeight::end_of_step()
     } else if (kind == GLOBAL && mode == VECTOR) {
       if (j == 0) {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val0.val.c->compute_vector();
+          val0.val.c->invoke_vector();
           val0.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         bin_vector_weights(val0.val.c->size_vector,val0.val.c->vector,1,
                            weights,stride);
       } else {
         if (!(val0.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-          val0.val.c->compute_array();
+          val0.val.c->invoke_array();
           val0.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
         if (val0.val.c->array)
@@ -293,7 +293,7 @@ void FixAveHistoWeight::end_of_step()
 
     } else if (kind == PERATOM) {
       if (!(val0.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-        val0.val.c->compute_peratom();
+        val0.val.c->invoke_peratom();
         val0.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
       }
       if (j == 0)
@@ -304,7 +304,7 @@ void FixAveHistoWeight::end_of_step()
 
     } else if (kind == LOCAL) {
       if (!(val0.val.c->invoked_flag & Compute::INVOKED_LOCAL)) {
-        val0.val.c->compute_local();
+        val0.val.c->invoke_local();
         val0.val.c->invoked_flag |= Compute::INVOKED_LOCAL;
       }
       if (j == 0)
@@ -540,13 +540,13 @@ void FixAveTime::invoke_scalar(bigint ntimestep)
 
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_SCALAR)) {
-          val.val.c->compute_scalar();
+          val.val.c->invoke_scalar();
           val.val.c->invoked_flag |= Compute::INVOKED_SCALAR;
         }
         scalar = val.val.c->scalar;
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val.val.c->compute_vector();
+          val.val.c->invoke_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         if (val.varlen && (val.val.c->size_vector < val.argindex)) scalar = 0.0;
@@ -729,7 +729,7 @@ void FixAveTime::invoke_vector(bigint ntimestep)
     if (val.which == ArgInfo::COMPUTE) {
       if (val.argindex == 0) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_VECTOR)) {
-          val.val.c->compute_vector();
+          val.val.c->invoke_vector();
           val.val.c->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         double *cvector = val.val.c->vector;
@@ -738,7 +738,7 @@ void FixAveTime::invoke_vector(bigint ntimestep)
 
       } else {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_ARRAY)) {
-          val.val.c->compute_array();
+          val.val.c->invoke_array();
           val.val.c->invoked_flag |= Compute::INVOKED_ARRAY;
         }
         double **carray = val.val.c->array;
@@ -635,7 +635,7 @@ void FixLangevin::post_force_templated()
     flangevin_allocated = 1;
   }
 
-  if (Tp_BIAS) temperature->compute_scalar();
+  if (Tp_BIAS) temperature->invoke_scalar();
 
   for (int i = 0; i < nlocal; i++) {
     if (mask[i] & groupbit) {
@@ -732,7 +732,7 @@ void FixNH::setup(int /*vflag*/)
 {
   // tdof needed by compute_temp_target()
 
-  t_current = temperature->compute_scalar();
+  t_current = temperature->invoke_scalar();
   tdof = temperature->dof;
 
   // t_target is needed by NVT and NPT in compute_scalar()
@@ -754,7 +754,7 @@ void FixNH::setup(int /*vflag*/)
       if (p_temp_flag) {
         t0 = p_temp;
       } else {
-        t0 = temperature->compute_scalar();
+        t0 = temperature->invoke_scalar();
         if (t0 < EPSILON)
           error->all(FLERR,"Current temperature too close to zero, consider using ptemp keyword");
       }
@@ -765,8 +765,8 @@ void FixNH::setup(int /*vflag*/)
   if (pstat_flag) compute_press_target();
 
   if (pstat_flag) {
-    if (pstyle == ISO) pressure->compute_scalar();
-    else pressure->compute_vector();
+    if (pstyle == ISO) pressure->invoke_scalar();
+    else pressure->invoke_vector();
     couple();
     pressure->addstep(update->ntimestep+1);
   }
@@ -835,11 +835,11 @@ void FixNH::initial_integrate(int /*vflag*/)
 
   if (pstat_flag) {
     if (pstyle == ISO) {
-      temperature->compute_scalar();
-      pressure->compute_scalar();
+      temperature->invoke_scalar();
+      pressure->invoke_scalar();
     } else {
-      temperature->compute_vector();
-      pressure->compute_vector();
+      temperature->invoke_vector();
+      pressure->invoke_vector();
     }
     couple();
     pressure->addstep(update->ntimestep+1);
@@ -883,14 +883,14 @@ void FixNH::final_integrate()
   //     since temp->compute() in initial_integrate()
 
   if (which == BIAS && neighbor->ago == 0)
-    t_current = temperature->compute_scalar();
+    t_current = temperature->invoke_scalar();
 
   if (pstat_flag) nh_v_press();
 
   // compute new T,P after velocities rescaled by nh_v_press()
   // compute appropriately coupled elements of mvv_current
 
-  t_current = temperature->compute_scalar();
+  t_current = temperature->invoke_scalar();
   tdof = temperature->dof;
 
   // need to recompute pressure to account for change in KE
@@ -898,10 +898,10 @@ void FixNH::final_integrate()
   // compute appropriately coupled elements of mvv_current
 
   if (pstat_flag) {
-    if (pstyle == ISO) pressure->compute_scalar();
+    if (pstyle == ISO) pressure->invoke_scalar();
     else {
-      temperature->compute_vector();
-      pressure->compute_vector();
+      temperature->invoke_vector();
+      pressure->invoke_vector();
     }
     couple();
     pressure->addstep(update->ntimestep+1);
@@ -949,11 +949,11 @@ void FixNH::initial_integrate_respa(int /*vflag*/, int ilevel, int /*iloop*/)
 
     if (pstat_flag) {
       if (pstyle == ISO) {
-        temperature->compute_scalar();
-        pressure->compute_scalar();
+        temperature->invoke_scalar();
+        pressure->invoke_scalar();
       } else {
-        temperature->compute_vector();
-        pressure->compute_vector();
+        temperature->invoke_vector();
+        pressure->invoke_vector();
       }
       couple();
       pressure->addstep(update->ntimestep+1);
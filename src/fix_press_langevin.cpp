@@ -511,9 +511,9 @@ void FixPressLangevin::post_force(int /*vflag*/)
   // compute current pressure tensor and add kinetic term
 
   if (pstyle == ISO) {
-    pressure->compute_scalar();
+    pressure->invoke_scalar();
   } else {
-    pressure->compute_vector();
+    pressure->invoke_vector();
   }
 
   couple_pressure();
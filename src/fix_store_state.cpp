@@ -459,7 +459,7 @@ void FixStoreState::end_of_step()
 
       if (val.which == ArgInfo::COMPUTE) {
         if (!(val.val.c->invoked_flag & Compute::INVOKED_PERATOM)) {
-          val.val.c->compute_peratom();
+          val.val.c->invoke_peratom();
           val.val.c->invoked_flag |= Compute::INVOKED_PERATOM;
         }
 
@@ -131,7 +131,7 @@ void FixTempBerendsen::init()
 
 void FixTempBerendsen::end_of_step()
 {
-  double t_current = temperature->compute_scalar();
+  double t_current = temperature->invoke_scalar();
   double tdof = temperature->dof;
 
   // there is nothing to do, if there are no degrees of freedom
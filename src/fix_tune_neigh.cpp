@@ -0,0 +1,306 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_tune_neigh.h"
+
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "kspace.h"
+#include "memory.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "timer.h"
+#include "update.h"
+
+#include <climits>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum { SKIN, DONE };
+
+// clang-format off
+
+/* ---------------------------------------------------------------------- */
+
+FixTuneNeigh::FixTuneNeigh(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg), skins(nullptr), cost(nullptr), safe(nullptr), minago(nullptr)
+{
+  if (narg < 4) utils::missing_cmd_args(FLERR,"fix tune/neigh",error);
+
+  vector_flag = 1;
+  size_vector = 3;
+  extvector = 0;
+  global_freq = 1;
+
+  nevery = utils::inumeric(FLERR,arg[3],false,lmp);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix tune/neigh N value: {}", nevery);
+
+  // optional args
+
+  skinlo = 0.5*neighbor->skin;
+  skinhi = 2.0*neighbor->skin;
+  nskin = 6;
+  reneighflag = 1;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"skin") == 0) {
+      if (iarg+4 > narg) utils::missing_cmd_args(FLERR,"fix tune/neigh skin",error);
+      skinlo = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+      skinhi = utils::numeric(FLERR,arg[iarg+2],false,lmp);
+      nskin = utils::inumeric(FLERR,arg[iarg+3],false,lmp);
+      if (skinlo <= 0.0 || skinhi < skinlo)
+        error->all(FLERR,"Illegal fix tune/neigh skin range: {} {}", skinlo, skinhi);
+      if (nskin < 1) error->all(FLERR,"Illegal fix tune/neigh skin count: {}", nskin);
+      iarg += 4;
+    } else if (strcmp(arg[iarg],"reneigh") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"fix tune/neigh reneigh",error);
+      reneighflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else error->all(FLERR,"Unknown fix tune/neigh keyword: {}", arg[iarg]);
+  }
+
+  if (skinhi == skinlo) nskin = 1;
+
+  memory->create(skins,nskin,"tune/neigh:skins");
+  memory->create(cost,nskin,"tune/neigh:cost");
+  memory->create(safe,nskin,"tune/neigh:safe");
+  memory->create(minago,nskin,"tune/neigh:minago");
+
+  for (int i = 0; i < nskin; i++) {
+    if (nskin == 1) skins[i] = skinlo;
+    else skins[i] = skinlo + i*(skinhi-skinlo)/(nskin-1);
+  }
+
+  // trials are switched by forced reneighboring
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+  stage = SKIN;
+  itrial = -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixTuneNeigh::~FixTuneNeigh()
+{
+  memory->destroy(skins);
+  memory->destroy(cost);
+  memory->destroy(safe);
+  memory->destroy(minago);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTuneNeigh::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTuneNeigh::init()
+{
+  if (!force->pair) error->all(FLERR,"Fix tune/neigh requires a pair style");
+  if (lmp->kokkos) error->all(FLERR,"Fix tune/neigh is not supported by the KOKKOS package");
+  if (!utils::strmatch(update->integrate_style,"^verlet"))
+    error->all(FLERR,"Fix tune/neigh requires run style verlet");
+  if (neighbor->style != Neighbor::BIN && neighbor->style != Neighbor::NSQ)
+    error->all(FLERR,"Fix tune/neigh requires neighbor style bin or nsq");
+  if (neighbor->build_once)
+    error->all(FLERR,"Fix tune/neigh cannot be used with neigh_modify once yes");
+  if (!timer->has_normal())
+    error->all(FLERR,"Fix tune/neigh requires timer level normal or full");
+
+  // a tuning that was interrupted by the end of a run starts over
+  // user settings are only stored before the first trial changed them
+  // Neighbor::init() resets the count of dangerous builds for each run
+
+  if (stage == SKIN) {
+    if (itrial < 0) {
+      every_user = neighbor->every;
+      delay_user = neighbor->delay;
+      check_user = neighbor->dist_check;
+    }
+    itrial = -1;
+    next_reneighbor = update->ntimestep + 1;
+  }
+  dangerstart = 0;
+}
+
+/* ----------------------------------------------------------------------
+   called on every reneighboring step
+   record # of steps since previous build, switch skin at end of each trial
+   once tuned, fall back to checking every step if builds become dangerous
+------------------------------------------------------------------------- */
+
+void FixTuneNeigh::pre_exchange()
+{
+  if (stage == DONE) {
+    if (neighbor->ndanger > dangerstart && (neighbor->every > 1 || neighbor->delay > 0)) {
+      neighbor->every = 1;
+      neighbor->delay = 0;
+      if (comm->me == 0)
+        error->warning(FLERR,"Fix tune/neigh detected dangerous builds, "
+                       "resetting to neigh_modify every 1 delay 0 check yes");
+    }
+    dangerstart = neighbor->ndanger;
+    return;
+  }
+
+  if (update->ntimestep != next_reneighbor) {
+    minago_now = MIN(minago_now,neighbor->ago);
+    return;
+  }
+
+  if (itrial >= 0) {
+    double mytime = (elapsed() - timestart) / (update->ntimestep - trialstart);
+    MPI_Allreduce(&mytime,&cost[itrial],1,MPI_DOUBLE,MPI_MAX,world);
+    safe[itrial] = (neighbor->ndanger == dangerstart);
+    minago[itrial] = minago_now;
+  }
+
+  itrial++;
+  if (itrial < nskin) {
+    neighbor->every = 1;
+    neighbor->delay = 0;
+    neighbor->dist_check = 1;
+    apply_skin(skins[itrial]);
+    next_reneighbor = update->ntimestep + nevery;
+    start_trial();
+  } else {
+    choose_skin();
+    next_reneighbor = -1;
+    stage = DONE;
+    dangerstart = neighbor->ndanger;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start timing a new trial
+------------------------------------------------------------------------- */
+
+void FixTuneNeigh::start_trial()
+{
+  trialstart = update->ntimestep;
+  dangerstart = neighbor->ndanger;
+  timestart = elapsed();
+  minago_now = INT_MAX;
+}
+
+/* ----------------------------------------------------------------------
+   accumulated time of all parts of a step which depend on the skin
+------------------------------------------------------------------------- */
+
+double FixTuneNeigh::elapsed()
+{
+  return timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH) +
+    timer->get_wall(Timer::COMM);
+}
+
+/* ----------------------------------------------------------------------
+   switch to new skin distance
+   same steps as for a box change, plus grids which depend on the skin
+   caller forces a full reneighboring on this step
+------------------------------------------------------------------------- */
+
+void FixTuneNeigh::apply_skin(double newskin)
+{
+  neighbor->reset_skin(newskin);
+  comm->setup();
+  if (neighbor->style) neighbor->setup_bins();
+  domain->subbox_too_small_check(newskin);
+
+  modify->reset_grid();
+  force->pair->reset_grid();
+  if (force->kspace) force->kspace->reset_grid();
+}
+
+/* ----------------------------------------------------------------------
+   switch to fastest safe skin and print timings of all trials
+------------------------------------------------------------------------- */
+
+void FixTuneNeigh::choose_skin()
+{
+  int ibest = -1;
+  for (int i = 0; i < nskin; i++)
+    if (safe[i] && (ibest < 0 || cost[i] < cost[ibest])) ibest = i;
+
+  // if all were dangerous, the largest skin is the safest choice
+
+  if (ibest < 0) {
+    ibest = nskin-1;
+    if (comm->me == 0)
+      error->warning(FLERR,"Fix tune/neigh found dangerous builds for all skin distances");
+  }
+
+  apply_skin(skins[ibest]);
+  if (reneighflag) choose_reneigh(minago[ibest]);
+  else {
+    neighbor->every = every_user;
+    neighbor->delay = delay_user;
+    neighbor->dist_check = check_user;
+  }
+
+  if (comm->me == 0) {
+    std::string mesg = "Fix tune/neigh timings:\n       skin  time/step  min-interval  safe\n";
+    for (int i = 0; i < nskin; i++) {
+      mesg += fmt::format("  {:9.4g}  {:9.4g}  ",skins[i],cost[i]);
+      if (minago[i] == INT_MAX) mesg += "           -";
+      else mesg += fmt::format("{:12d}",minago[i]);
+      mesg += fmt::format("  {}\n", safe[i] ? "yes" : "no");
+    }
+    mesg += fmt::format("Fix tune/neigh settings: neighbor {} {}, neigh_modify every {} "
+                        "delay {} check {}\n", neighbor->skin,
+                        (neighbor->style == Neighbor::NSQ) ? "nsq" : "bin", neighbor->every,
+                        neighbor->delay, neighbor->dist_check ? "yes" : "no");
+    utils::logmesg(lmp,mesg);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set every/delay from shortest interval between distance triggered builds
+   with checks every step, no build happens before that interval, so delay
+     can be up to half of it without making builds dangerous
+   every is limited so atoms move at most ~10% of the trigger distance
+     between the trigger and the next check
+   if no build was triggered during the trial, the trial length is the bound
+     and only delay is set, since the speed of the atoms is unknown
+------------------------------------------------------------------------- */
+
+void FixTuneNeigh::choose_reneigh(int interval)
+{
+  if (interval > nevery) neighbor->every = 1;
+  else neighbor->every = MAX(1,interval/10);
+  interval = MIN(interval,nevery);
+  neighbor->delay = (interval/2 / neighbor->every) * neighbor->every;
+  neighbor->dist_check = 1;
+}
+
+/* ----------------------------------------------------------------------
+   return current skin, every, delay
+------------------------------------------------------------------------- */
+
+double FixTuneNeigh::compute_vector(int n)
+{
+  if (n == 0) return neighbor->skin;
+  if (n == 1) return neighbor->every;
+  return neighbor->delay;
+}
@@ -0,0 +1,65 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(tune/neigh,FixTuneNeigh);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_TUNE_NEIGH_H
+#define LMP_FIX_TUNE_NEIGH_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTuneNeigh : public Fix {
+ public:
+  FixTuneNeigh(class LAMMPS *, int, char **);
+  ~FixTuneNeigh() override;
+  int setmask() override;
+  void init() override;
+  void pre_exchange() override;
+  double compute_vector(int) override;
+
+ private:
+  int nevery;           // # of timesteps per trial
+  int nskin;            // # of skin distances to try
+  double skinlo, skinhi;    // range of skin distances to try
+  int reneighflag;      // 1 if every/delay are tuned as well
+  int every_user, delay_user, check_user;    // settings before tuning
+
+  int stage;            // SKIN while trials are running, DONE afterwards
+  int itrial;           // index of current skin trial, -1 before first
+  double *skins;        // skin distance of each trial
+  double *cost;         // Pair+Neigh+Comm time per step of each trial
+  int *safe;            // 1 if no dangerous builds during trial
+  int *minago;          // min # of steps between builds during trial
+
+  bigint trialstart;    // timestep current trial started on
+  bigint dangerstart;   // neighbor->ndanger when current trial started
+  double timestart;     // Pair+Neigh+Comm time when current trial started
+  int minago_now;       // min # of steps between builds in current trial
+
+  void start_trial();
+  double elapsed();
+  void apply_skin(double);
+  void choose_skin();
+  void choose_reneigh(int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
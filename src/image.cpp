@@ -18,15 +18,21 @@
 
 #include "image.h"
 
+#include "comm.h"
 #include "error.h"
 #include "math_const.h"
 #include "math_extra.h"
 #include "memory.h"
-#include "random_mars.h"
 
 #include <cctype>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <utility>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 #ifdef LAMMPS_JPEG
 #include <jpeglib.h>
@@ -118,12 +124,12 @@ Image::Image(LAMMPS *lmp, int nmap_caller) :
   backLightColor[1] = 0.9;
   backLightColor[2] = 0.9;
 
-  random = nullptr;
-
   // MPI_Gatherv vectors
 
   recvcounts = nullptr;
   displs = nullptr;
+  pixelcounts = nullptr;
+  pixeldispls = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -144,10 +150,10 @@ Image::~Image()
   memory->destroy(surfacecopy);
   memory->destroy(rgbcopy);
 
-  if (random) delete random;
-
   memory->destroy(recvcounts);
   memory->destroy(displs);
+  memory->destroy(pixelcounts);
+  memory->destroy(pixeldispls);
 }
 
 /* ----------------------------------------------------------------------
@@ -171,6 +177,26 @@ void Image::buffers()
   memory->create(depthcopy,npixels,"image:depthcopy");
   memory->create(surfacecopy,2*npixels,"image:surfacecopy");
   memory->create(rgbcopy,3*npixels,"image:rgbcopy");
+
+  // size and offset of the strip of the image each proc owns after merge()
+
+  memory->destroy(recvcounts);
+  memory->destroy(displs);
+  memory->destroy(pixelcounts);
+  memory->destroy(pixeldispls);
+  memory->create(recvcounts,nprocs,"image:recvcounts");
+  memory->create(displs,nprocs,"image:displs");
+  memory->create(pixelcounts,nprocs,"image:pixelcounts");
+  memory->create(pixeldispls,nprocs,"image:pixeldispls");
+
+  int lo,hi;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    strip(iproc,lo,hi);
+    pixelcounts[iproc] = hi - lo;
+    pixeldispls[iproc] = lo;
+    recvcounts[iproc] = 3 * (hi - lo);
+    displs[iproc] = 3 * lo;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -270,7 +296,6 @@ void Image::view_params(double boxxlo, double boxxhi, double boxylo,
   // adjust strength of the SSAO
 
   if (ssao) {
-    if (!random) random = new RanMars(lmp,seed+me);
     SSAORadius = maxdel * 0.05 * ssaoint;
     SSAOSamples = static_cast<int> (8.0 + 32.0*ssaoint);
     SSAOJitter = MY_PI / 12;
@@ -308,84 +333,90 @@ void Image::clear()
 /* ----------------------------------------------------------------------
    merge image from each processor into one composite image
    done pixel by pixel, respecting depth buffer
-   hi procs send to lo procs, cascading down logarithmically
+   procs beyond the largest power of 2 first send their image to a lower proc
+   then binary-swap compositing: in each stage, pairs of procs exchange
+     one half of the pixels they are responsible for and composite the other,
+     so that each proc ends up with a strip of the final image
+   the strips are gathered to proc 0 for output
 ------------------------------------------------------------------------- */
 
 void Image::merge()
 {
-  MPI_Request requests[3];
+  int npow2 = 1;
+  while (2*npow2 <= nprocs) npow2 *= 2;
+
+  if (me >= npow2) {
+    MPI_Send(imageBuffer,npixels*3,MPI_BYTE,me-npow2,0,world);
+    MPI_Send(depthBuffer,npixels,MPI_DOUBLE,me-npow2,0,world);
+    if (ssao) MPI_Send(surfaceBuffer,npixels*2,MPI_DOUBLE,me-npow2,0,world);
+
+  } else if (me+npow2 < nprocs) {
+    MPI_Request requests[3];
+    MPI_Irecv(rgbcopy,npixels*3,MPI_BYTE,me+npow2,0,world,&requests[0]);
+    MPI_Irecv(depthcopy,npixels,MPI_DOUBLE,me+npow2,0,world,&requests[1]);
+    if (ssao)
+      MPI_Irecv(surfacecopy,npixels*2,MPI_DOUBLE,me+npow2,0,world,&requests[2]);
+    if (ssao) MPI_Waitall(3,requests,MPI_STATUS_IGNORE);
+    else MPI_Waitall(2,requests,MPI_STATUS_IGNORE);
+    composite(0,npixels,0);
+  }
 
-  int nhalf = 1;
-  while (nhalf < nprocs) nhalf *= 2;
-  nhalf /= 2;
+  // lo/hi = range of pixels this proc is currently responsible for
+  // the half with the higher pixels goes to the proc with the bit set
+  // on equal depth the pixel of the lower proc is kept, as in a serial merge
+
+  int lo = 0;
+  int hi = npixels;
+
+  if (me < npow2) {
+    for (int mask = 1; mask < npow2; mask *= 2) {
+      int partner = me ^ mask;
+      int mid = lo + (hi-lo)/2;
+      int keeplo,keephi,sendlo,sendhi;
+      if (me & mask) {
+        keeplo = mid; keephi = hi;
+        sendlo = lo; sendhi = mid;
+      } else {
+        keeplo = lo; keephi = mid;
+        sendlo = mid; sendhi = hi;
+      }
 
-  while (nhalf) {
-    if (me < nhalf && me+nhalf < nprocs) {
-      MPI_Irecv(rgbcopy,npixels*3,MPI_BYTE,me+nhalf,0,world,&requests[0]);
-      MPI_Irecv(depthcopy,npixels,MPI_DOUBLE,me+nhalf,0,world,&requests[1]);
+      MPI_Sendrecv(imageBuffer+3*sendlo,3*(sendhi-sendlo),MPI_BYTE,partner,0,
+                   rgbcopy+3*keeplo,3*(keephi-keeplo),MPI_BYTE,partner,0,
+                   world,MPI_STATUS_IGNORE);
+      MPI_Sendrecv(depthBuffer+sendlo,sendhi-sendlo,MPI_DOUBLE,partner,0,
+                   depthcopy+keeplo,keephi-keeplo,MPI_DOUBLE,partner,0,
+                   world,MPI_STATUS_IGNORE);
       if (ssao)
-        MPI_Irecv(surfacecopy,npixels*2,MPI_DOUBLE,
-                  me+nhalf,0,world,&requests[2]);
-      if (ssao) MPI_Waitall(3,requests,MPI_STATUS_IGNORE);
-      else MPI_Waitall(2,requests,MPI_STATUS_IGNORE);
-
-      for (int i = 0; i < npixels; i++) {
-        if (depthBuffer[i] < 0 || (depthcopy[i] >= 0 &&
-                                   depthcopy[i] < depthBuffer[i])) {
-          depthBuffer[i] = depthcopy[i];
-          imageBuffer[i*3+0] = rgbcopy[i*3+0];
-          imageBuffer[i*3+1] = rgbcopy[i*3+1];
-          imageBuffer[i*3+2] = rgbcopy[i*3+2];
-          if (ssao) {
-            surfaceBuffer[i*2+0] = surfacecopy[i*2+0];
-            surfaceBuffer[i*2+1] = surfacecopy[i*2+1];
-          }
-        }
-      }
+        MPI_Sendrecv(surfaceBuffer+2*sendlo,2*(sendhi-sendlo),MPI_DOUBLE,partner,0,
+                     surfacecopy+2*keeplo,2*(keephi-keeplo),MPI_DOUBLE,partner,0,
+                     world,MPI_STATUS_IGNORE);
 
-    } else if (me >= nhalf && me < 2*nhalf) {
-      MPI_Send(imageBuffer,npixels*3,MPI_BYTE,me-nhalf,0,world);
-      MPI_Send(depthBuffer,npixels,MPI_DOUBLE,me-nhalf,0,world);
-      if (ssao) MPI_Send(surfaceBuffer,npixels*2,MPI_DOUBLE,me-nhalf,0,world);
+      composite(keeplo,keephi,partner < me);
+      lo = keeplo;
+      hi = keephi;
     }
-
-    nhalf /= 2;
-  }
+  } else lo = hi = 0;
 
   // extra SSAO enhancement
-  // bcast full image to all procs
-  // each works on subset of pixels
-  // MPI_Gather() result back to proc 0
-  // use Gatherv() if subset of pixels is not the same size on every proc
+  // each proc works on its own strip of pixels
+  // shading samples the depth of neighboring pixels,
+  //   so the full depth buffer is assembled on all procs
 
   if (ssao) {
-    MPI_Bcast(imageBuffer,npixels*3,MPI_BYTE,0,world);
-    MPI_Bcast(surfaceBuffer,npixels*2,MPI_DOUBLE,0,world);
-    MPI_Bcast(depthBuffer,npixels,MPI_DOUBLE,0,world);
-    compute_SSAO();
-
-    int pixelstart = 3 * static_cast<int> (1.0*me/nprocs * npixels);
-    int pixelstop = 3 * static_cast<int> (1.0*(me+1)/nprocs * npixels);
-    int mypixels = pixelstop - pixelstart;
-
-    if (npixels % nprocs == 0) {
-      MPI_Gather(imageBuffer+pixelstart,mypixels,MPI_BYTE,
-                 rgbcopy,mypixels,MPI_BYTE,0,world);
-
-    } else {
-      if (recvcounts == nullptr) {
-        memory->create(recvcounts,nprocs,"image:recvcounts");
-        memory->create(displs,nprocs,"image:displs");
-        MPI_Allgather(&mypixels,1,MPI_INT,recvcounts,1,MPI_INT,world);
-        displs[0] = 0;
-        for (int i = 1; i < nprocs; i++)
-          displs[i] = displs[i-1] + recvcounts[i-1];
-      }
-
-      MPI_Gatherv(imageBuffer+pixelstart,mypixels,MPI_BYTE,
-                  rgbcopy,recvcounts,displs,MPI_BYTE,0,world);
+    if (nprocs > 1) {
+      MPI_Allgatherv(depthBuffer+lo,hi-lo,MPI_DOUBLE,
+                     depthcopy,pixelcounts,pixeldispls,MPI_DOUBLE,world);
+      std::swap(depthBuffer,depthcopy);
     }
+    compute_SSAO(lo,hi);
+  }
 
+  // MPI_Gatherv() strips back to proc 0
+
+  if (nprocs > 1) {
+    MPI_Gatherv(imageBuffer+3*lo,3*(hi-lo),MPI_BYTE,
+                rgbcopy,recvcounts,displs,MPI_BYTE,0,world);
     writeBuffer = rgbcopy;
   } else {
     writeBuffer = imageBuffer;
@@ -412,6 +443,70 @@ void Image::merge()
   }
 }
 
+/* ----------------------------------------------------------------------
+   composite received pixels lo to hi-1 into my image
+   lowflag = 1 if received pixels come from a lower proc and win on equal depth
+------------------------------------------------------------------------- */
+
+void Image::composite(int lo, int hi, int lowflag)
+{
+  for (int i = lo; i < hi; i++) {
+    if (depthcopy[i] < 0) continue;
+    if (depthBuffer[i] < 0 || depthcopy[i] < depthBuffer[i] ||
+        (lowflag && depthcopy[i] == depthBuffer[i])) {
+      depthBuffer[i] = depthcopy[i];
+      imageBuffer[i*3+0] = rgbcopy[i*3+0];
+      imageBuffer[i*3+1] = rgbcopy[i*3+1];
+      imageBuffer[i*3+2] = rgbcopy[i*3+2];
+      if (ssao) {
+        surfaceBuffer[i*2+0] = surfacecopy[i*2+0];
+        surfaceBuffer[i*2+1] = surfacecopy[i*2+1];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   range of pixels lo to hi-1 that proc owns after binary-swap in merge()
+------------------------------------------------------------------------- */
+
+void Image::strip(int proc, int &lo, int &hi)
+{
+  int npow2 = 1;
+  while (2*npow2 <= nprocs) npow2 *= 2;
+
+  lo = hi = 0;
+  if (proc >= npow2) return;
+
+  hi = npixels;
+  for (int mask = 1; mask < npow2; mask *= 2) {
+    int mid = lo + (hi-lo)/2;
+    if (proc & mask) lo = mid;
+    else hi = mid;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   range of image rows ylo to yhi-1 the calling thread renders
+   inside a parallel region, each thread of the team owns a band of rows,
+     so all threads can render the same objects without conflicts
+   outside a parallel region, this is the entire image
+------------------------------------------------------------------------- */
+
+void Image::thread_rows(int &ylo, int &yhi)
+{
+  ylo = 0;
+  yhi = height;
+#if defined(_OPENMP)
+  const int nthreads = omp_get_num_threads();
+  if (nthreads > 1) {
+    const int tid = omp_get_thread_num();
+    ylo = static_cast<int> ((bigint) height * tid / nthreads);
+    yhi = static_cast<int> ((bigint) height * (tid+1) / nthreads);
+  }
+#endif
+}
+
 /* ----------------------------------------------------------------------
    draw simulation bounding box as 12 cylinders
 ------------------------------------------------------------------------- */
@@ -483,9 +578,12 @@ void Image::draw_sphere(double *x, double *surfaceColor, double diameter)
   xc += width / 2;
   yc += height / 2;
 
-  for (iy = yc - pixelRadius; iy <= yc + pixelRadius; iy++) {
+  int ylo,yhi;
+  thread_rows(ylo,yhi);
+
+  for (iy = MAX(yc - pixelRadius,ylo); iy <= MIN(yc + pixelRadius,yhi-1); iy++) {
     for (ix = xc - pixelRadius; ix <= xc + pixelRadius; ix++) {
-      if (iy < 0 || iy >= height || ix < 0 || ix >= width) continue;
+      if (ix < 0 || ix >= width) continue;
 
       surface[1] = ((iy - yc) - height_error) * pixelWidth;
       surface[0] = ((ix - xc) - width_error) * pixelWidth;
@@ -545,9 +643,12 @@ void Image::draw_cube(double *x, double *surfaceColor, double diameter)
   xc += width / 2;
   yc += height / 2;
 
-  for (int iy = yc - pixelHalfWidth; iy <= yc + pixelHalfWidth; iy ++) {
+  int ylo,yhi;
+  thread_rows(ylo,yhi);
+
+  for (int iy = MAX(yc - pixelHalfWidth,ylo); iy <= MIN(yc + pixelHalfWidth,yhi-1); iy ++) {
     for (int ix = xc - pixelHalfWidth; ix <= xc + pixelHalfWidth; ix ++) {
-      if (iy < 0 || iy >= height || ix < 0 || ix >= width) continue;
+      if (ix < 0 || ix >= width) continue;
 
       double sy = ((iy - yc) - height_error) * pixelWidth;
       double sx = ((ix - xc) - width_error) * pixelWidth;
@@ -699,9 +800,12 @@ void Image::draw_cylinder(double *x, double *y,
 
   double a = camLDir[0] * camLDir[0];
 
-  for (int iy = yc - pixelHalfHeight; iy <= yc + pixelHalfHeight; iy ++) {
+  int ylo,yhi;
+  thread_rows(ylo,yhi);
+
+  for (int iy = MAX(yc - pixelHalfHeight,ylo); iy <= MIN(yc + pixelHalfHeight,yhi-1); iy ++) {
     for (int ix = xc - pixelHalfWidth; ix <= xc + pixelHalfWidth; ix ++) {
-      if (iy < 0 || iy >= height || ix < 0 || ix >= width) continue;
+      if (ix < 0 || ix >= width) continue;
 
       double sy = ((iy - yc) - height_error) * pixelWidth;
       double sx = ((ix - xc) - width_error) * pixelWidth;
@@ -823,9 +927,12 @@ void Image::draw_triangle(double *x, double *y, double *z, double *surfaceColor)
   int pixelDown = static_cast<int> (pixelDownFull + 0.5);
   int pixelUp = static_cast<int> (pixelUpFull + 0.5);
 
-  for (int iy = yc - pixelDown; iy <= yc + pixelUp; iy ++) {
+  int ylo,yhi;
+  thread_rows(ylo,yhi);
+
+  for (int iy = MAX(yc - pixelDown,ylo); iy <= MIN(yc + pixelUp,yhi-1); iy ++) {
     for (int ix = xc - pixelLeft; ix <= xc + pixelRight; ix ++) {
-      if (iy < 0 || iy >= height || ix < 0 || ix >= width) continue;
+      if (ix < 0 || ix >= width) continue;
 
       double sy = ((iy - yc) - height_error) * pixelWidth;
       double sx = ((ix - xc) - width_error) * pixelWidth;
@@ -936,9 +1043,25 @@ void Image::draw_pixel(int ix, int iy, double depth,
   imageBuffer[2 + ix*3 + iy*width*3] = static_cast<int>(c[2] * 255.0);
 }
 
+/* ----------------------------------------------------------------------
+   uniform random number in [0,1) for a pixel, used for the SSAO jitter
+   a hash of seed and pixel index, so shading is independent of the
+     number of procs and threads and can be computed in any order
+------------------------------------------------------------------------- */
+
+static double jitter(int seed, int index)
+{
+  uint64_t z = ((uint64_t) (uint32_t) seed << 32) + (uint32_t) index;
+  z += 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
 /* ---------------------------------------------------------------------- */
 
-void Image::compute_SSAO()
+void Image::compute_SSAO(int pixelstart, int pixelstop)
 {
   // used for rasterizing the spheres
 
@@ -956,11 +1079,8 @@ void Image::compute_SSAO()
   // x = column # from 0 to width-1
   // y = row # from 0 to height-1
 
-  int pixelstart = static_cast<int> (1.0*me/nprocs * npixels);
-  int pixelstop = static_cast<int> (1.0*(me+1)/nprocs * npixels);
-
 #if defined(_OPENMP)
-#pragma omp parallel for
+#pragma omp parallel for num_threads(comm->nthreads) schedule(dynamic,256)
 #endif
   for (int index = pixelstart; index < pixelstop; index++) {
     int x = index % width;
@@ -973,7 +1093,7 @@ void Image::compute_SSAO()
     double sy = surfaceBuffer[index * 2 + 1];
     double sin_t = -sqrt(sx*sx + sy*sy);
 
-    double mytheta = random->uniform() * SSAOJitter;
+    double mytheta = jitter(seed,index) * SSAOJitter;
     double ao = 0.0;
 
     for (int s = 0; s < SSAOSamples; s ++) {
@@ -1209,6 +1329,16 @@ double *Image::map_value2color(int index, double value)
   return maps[index]->value2color(value);
 }
 
+/* ----------------------------------------------------------------------
+   same as above, but an interpolated color is stored in caller's rgb
+   safe to call from multiple threads with different rgb
+------------------------------------------------------------------------- */
+
+double *Image::map_value2color(int index, double value, double *rgb)
+{
+  return maps[index]->value2color(value,rgb);
+}
+
 /* ----------------------------------------------------------------------
    add a new color to username and userrgb
    redefine RGB values in userrgb if name already exists
@@ -1958,6 +2088,17 @@ int ColorMap::minmax(double mindynamic, double maxdynamic)
 ------------------------------------------------------------------------- */
 
 double *ColorMap::value2color(double value)
+{
+  return value2color(value,interpolate);
+}
+
+/* ----------------------------------------------------------------------
+   convert value into an RGB color via color map
+   interpolated colors are stored in rgb
+   return pointer to 3-vector
+------------------------------------------------------------------------- */
+
+double *ColorMap::value2color(double value, double *rgb)
 {
   double lo;//,hi;
 
@@ -1979,13 +2120,13 @@ double *ColorMap::value2color(double value)
       if (value >= mentry[i].svalue && value <= mentry[i+1].svalue) {
         double fraction = (value-mentry[i].svalue) /
           (mentry[i+1].svalue-mentry[i].svalue);
-        interpolate[0] = mentry[i].color[0] +
+        rgb[0] = mentry[i].color[0] +
           fraction*(mentry[i+1].color[0]-mentry[i].color[0]);
-        interpolate[1] = mentry[i].color[1] +
+        rgb[1] = mentry[i].color[1] +
           fraction*(mentry[i+1].color[1]-mentry[i].color[1]);
-        interpolate[2] = mentry[i].color[2] +
+        rgb[2] = mentry[i].color[2] +
           fraction*(mentry[i+1].color[2]-mentry[i].color[2]);
-        return interpolate;
+        return rgb;
       }
   } else if (mstyle == DISCRETE) {
     for (int i = 0; i < nentry; i++)
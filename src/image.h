@@ -61,6 +61,7 @@ class Image : protected Pointers {
   int map_reset(int, int, char **);
   int map_minmax(int, double, double);
   double *map_value2color(int, double);
+  double *map_value2color(int, double, double *);
 
   int addcolor(char *, double, double, double);
   double *element2color(char *);
@@ -79,9 +80,10 @@ class Image : protected Pointers {
   double *depthcopy, *surfacecopy;
   unsigned char *imageBuffer, *rgbcopy, *writeBuffer;
 
-  // MPI_Gatherv
+  // strip of composited image owned by each proc, in bytes and pixels
 
   int *recvcounts, *displs;
+  int *pixelcounts, *pixeldispls;
 
   // constant view params
 
@@ -121,14 +123,13 @@ class Image : protected Pointers {
   char **username;
   double **userrgb;
 
-  // SSAO RNG
-
-  class RanMars *random;
-
   // internal methods
 
   void draw_pixel(int, int, double, double *, double *);
-  void compute_SSAO();
+  void thread_rows(int &, int &);
+  void strip(int, int &, int &);
+  void composite(int, int, int);
+  void compute_SSAO(int, int);
 
   // inline functions
 
@@ -160,6 +161,7 @@ class ColorMap : protected Pointers {
   int reset(int, char **);
   int minmax(double, double);
   double *value2color(double);
+  double *value2color(double, double *);
 
  private:
   class Image *image;              // caller with color2rgb() method
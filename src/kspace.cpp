@@ -61,6 +61,9 @@ KSpace::KSpace(LAMMPS *lmp) : Pointers(lmp)
   collective_flag = 0;
 #endif
 
+  r2c_flag = 0;
+  tiling_flag = 0;
+
   kewaldflag = 0;
 
   order_6 = 5;
@@ -549,6 +552,21 @@ void KSpace::modify_params(int narg, char **arg)
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       collective_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"remap") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      if (strcmp(arg[iarg+1],"p2p") == 0) collective_flag = 0;
+      else if (strcmp(arg[iarg+1],"collective") == 0) collective_flag = 1;
+      else if (strcmp(arg[iarg+1],"nonblocking") == 0) collective_flag = 2;
+      else error->all(FLERR,"Unknown kspace_modify remap setting: {}",arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"r2c") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      r2c_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tiling") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
+      tiling_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"diff") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal kspace_modify command");
       if (strcmp(arg[iarg+1],"ad") == 0) differentiation_flag = 1;
@@ -87,7 +87,10 @@ class KSpace : protected Pointers {
 
   int compute_flag;       // 0 if skip compute()
   int fftbench;           // 0 if skip FFT timing
-  int collective_flag;    // 1 if use MPI collectives for FFT/remap
+  int collective_flag;    // remap for FFTs: 0 = point-to-point, 1 = MPI collectives,
+                          //   2 = non-blocking point-to-point
+  int r2c_flag;           // 1 if use real-to-complex FFTs
+  int tiling_flag;        // 1 if PPPM assigns charges and interpolates tile by tile
   int stagger_flag;       // 1 if using staggered PPPM grids
 
   double splittol;    // tolerance for when to truncate splitting
@@ -2057,13 +2057,13 @@ void *lammps_extract_compute(void *handle, const char *id, int style, int type)
       if (type == LMP_TYPE_SCALAR) {
         if (!compute->scalar_flag) return nullptr;
         if (compute->invoked_scalar != lmp->update->ntimestep)
-          compute->compute_scalar();
+          compute->invoke_scalar();
         return (void *) &compute->scalar;
       }
       if ((type == LMP_TYPE_VECTOR) || (type == LMP_SIZE_VECTOR)) {
         if (!compute->vector_flag) return nullptr;
         if (compute->invoked_vector != lmp->update->ntimestep)
-          compute->compute_vector();
+          compute->invoke_vector();
         if (type == LMP_TYPE_VECTOR)
           return (void *) compute->vector;
         else
@@ -2072,7 +2072,7 @@ void *lammps_extract_compute(void *handle, const char *id, int style, int type)
       if ((type == LMP_TYPE_ARRAY) || (type == LMP_SIZE_ROWS) || (type == LMP_SIZE_COLS)) {
         if (!compute->array_flag) return nullptr;
         if (compute->invoked_array != lmp->update->ntimestep)
-          compute->compute_array();
+          compute->invoke_array();
         if (type == LMP_TYPE_ARRAY)
           return (void *) compute->array;
         else if (type == LMP_SIZE_ROWS)
@@ -2085,7 +2085,7 @@ void *lammps_extract_compute(void *handle, const char *id, int style, int type)
     if (style == LMP_STYLE_ATOM) {
       if (!compute->peratom_flag) return nullptr;
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
       if (type == LMP_TYPE_VECTOR) return (void *) compute->vector_atom;
       if (type == LMP_TYPE_ARRAY) return (void *) compute->array_atom;
       if (type == LMP_SIZE_COLS) return (void *) &compute->size_peratom_cols;
@@ -2094,7 +2094,7 @@ void *lammps_extract_compute(void *handle, const char *id, int style, int type)
     if (style == LMP_STYLE_LOCAL) {
       if (!compute->local_flag) return nullptr;
       if (compute->invoked_local != lmp->update->ntimestep)
-        compute->compute_local();
+        compute->invoke_local();
       if (type == LMP_TYPE_SCALAR) return (void *) &compute->size_local_rows;  /* for backward compatibility */
       if (type == LMP_TYPE_VECTOR) return (void *) compute->vector_local;
       if (type == LMP_TYPE_ARRAY) return (void *) compute->array_local;
@@ -3994,7 +3994,7 @@ void lammps_gather(void *handle, const char *name, int type, int count, void *da
       }
 
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
 
       if (count==1) vptr = (void *) compute->vector_atom;
       else vptr = (void *) compute->array_atom;
@@ -4267,7 +4267,7 @@ void lammps_gather_concat(void *handle, const char *name, int type, int count,
       }
 
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
 
       if (count==1) vptr = (void *) compute->vector_atom;
       else vptr = (void *) compute->array_atom;
@@ -4552,7 +4552,7 @@ void lammps_gather_subset(void *handle, const char *name, int type, int count,
       }
 
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
 
       if (count==1) vptr = (void *) compute->vector_atom;
       else vptr = (void *) compute->array_atom;
@@ -4827,7 +4827,7 @@ void lammps_scatter(void *handle, const char *name, int type, int count,
       }
 
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
 
       if (count==1) vptr = (void *) compute->vector_atom;
       else vptr = (void *) compute->array_atom;
@@ -5075,7 +5075,7 @@ void lammps_scatter_subset(void *handle, const char *name,int type, int count, i
       }
 
       if (compute->invoked_peratom != lmp->update->ntimestep)
-        compute->compute_peratom();
+        compute->invoke_peratom();
 
       if (count==1) vptr = (void *) compute->vector_atom;
       else vptr = (void *) compute->array_atom;
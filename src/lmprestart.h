@@ -38,7 +38,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      EXTRA_BOND_PER_ATOM,EXTRA_ANGLE_PER_ATOM,EXTRA_DIHEDRAL_PER_ATOM,
      EXTRA_IMPROPER_PER_ATOM,EXTRA_SPECIAL_PER_ATOM,ATOM_MAXSPECIAL,
      NELLIPSOIDS,NLINES,NTRIS,NBODIES,ATIME,ATIMESTEP,LABELMAP,
-     TRICLINIC_GENERAL,ROTATE_G2R};
+     TRICLINIC_GENERAL,ROTATE_G2R,ATOM_SORTORDER};
 
 #define LB_FACTOR 1.1
 
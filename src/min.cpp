@@ -323,7 +323,7 @@ void Min::setup(int flag)
 
   // stats for initial thermo output
 
-  ecurrent = pe_compute->compute_scalar();
+  ecurrent = pe_compute->invoke_scalar();
   if (nextra_global) ecurrent += modify->min_energy(fextra);
   if (output->thermo->normflag) ecurrent /= atom->natoms;
 
@@ -404,7 +404,7 @@ void Min::setup_minimal(int flag)
 
   // stats for Finish to print
 
-  ecurrent = pe_compute->compute_scalar();
+  ecurrent = pe_compute->invoke_scalar();
   if (nextra_global) ecurrent += modify->min_energy(fextra);
   if (output->thermo->normflag) ecurrent /= atom->natoms;
 
@@ -589,7 +589,7 @@ double Min::energy_force(int resetflag)
   // compute potential energy of system
   // normalize if thermo PE does
 
-  double energy = pe_compute->compute_scalar();
+  double energy = pe_compute->invoke_scalar();
   if (nextra_global) energy += modify->min_energy(fextra);
   if (output->thermo->normflag) energy /= atom->natoms;
 
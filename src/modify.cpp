@@ -25,6 +25,7 @@
 #include "input.h"
 #include "memory.h"
 #include "region.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 
@@ -395,8 +396,12 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
-    fix[list_initial_integrate[i]]->initial_integrate(vflag);
+  for (int i = 0; i < n_initial_integrate; i++) {
+    Fix *ifix = fix[list_initial_integrate[i]];
+    double start = timer->detail_start();
+    ifix->initial_integrate(vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -405,7 +410,12 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++) fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    Fix *ifix = fix[list_post_integrate[i]];
+    double start = timer->detail_start();
+    ifix->post_integrate();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -414,7 +424,12 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++) fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    Fix *ifix = fix[list_pre_exchange[i]];
+    double start = timer->detail_start();
+    ifix->pre_exchange();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -423,7 +438,12 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++) fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    Fix *ifix = fix[list_pre_neighbor[i]];
+    double start = timer->detail_start();
+    ifix->pre_neighbor();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -432,7 +452,12 @@ void Modify::pre_neighbor()
 
 void Modify::post_neighbor()
 {
-  for (int i = 0; i < n_post_neighbor; i++) fix[list_post_neighbor[i]]->post_neighbor();
+  for (int i = 0; i < n_post_neighbor; i++) {
+    Fix *ifix = fix[list_post_neighbor[i]];
+    double start = timer->detail_start();
+    ifix->post_neighbor();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -441,7 +466,12 @@ void Modify::post_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++) fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    Fix *ifix = fix[list_pre_force[i]];
+    double start = timer->detail_start();
+    ifix->pre_force(vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -449,7 +479,12 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++) fix[list_pre_reverse[i]]->pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    Fix *ifix = fix[list_pre_reverse[i]];
+    double start = timer->detail_start();
+    ifix->pre_reverse(eflag, vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -461,11 +496,21 @@ void Modify::pre_reverse(int eflag, int vflag)
 void Modify::post_force(int vflag)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++) fix[list_post_force_group[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force_group; i++) {
+      Fix *ifix = fix[list_post_force_group[i]];
+      double start = timer->detail_start();
+      ifix->post_force(vflag);
+      timer->detail_stop(ifix->time_detail,start);
+    }
   }
 
   if (n_post_force) {
-    for (int i = 0; i < n_post_force; i++) fix[list_post_force[i]]->post_force(vflag);
+    for (int i = 0; i < n_post_force; i++) {
+      Fix *ifix = fix[list_post_force[i]];
+      double start = timer->detail_start();
+      ifix->post_force(vflag);
+      timer->detail_stop(ifix->time_detail,start);
+    }
   }
 }
 
@@ -475,7 +520,12 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++) fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    Fix *ifix = fix[list_final_integrate[i]];
+    double start = timer->detail_start();
+    ifix->final_integrate();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -485,8 +535,13 @@ void Modify::final_integrate()
 
 void Modify::end_of_step()
 {
-  for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0) fix[list_end_of_step[i]]->end_of_step();
+  for (int i = 0; i < n_end_of_step; i++) {
+    if (update->ntimestep % end_of_step_every[i]) continue;
+    Fix *ifix = fix[list_end_of_step[i]];
+    double start = timer->detail_start();
+    ifix->end_of_step();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -580,8 +635,12 @@ void Modify::setup_pre_force_respa(int vflag, int ilevel)
 
 void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_initial_integrate_respa; i++)
-    fix[list_initial_integrate_respa[i]]->initial_integrate_respa(vflag, ilevel, iloop);
+  for (int i = 0; i < n_initial_integrate_respa; i++) {
+    Fix *ifix = fix[list_initial_integrate_respa[i]];
+    double start = timer->detail_start();
+    ifix->initial_integrate_respa(vflag, ilevel, iloop);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -590,8 +649,12 @@ void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 
 void Modify::post_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_post_integrate_respa; i++)
-    fix[list_post_integrate_respa[i]]->post_integrate_respa(ilevel, iloop);
+  for (int i = 0; i < n_post_integrate_respa; i++) {
+    Fix *ifix = fix[list_post_integrate_respa[i]];
+    double start = timer->detail_start();
+    ifix->post_integrate_respa(ilevel, iloop);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -600,8 +663,12 @@ void Modify::post_integrate_respa(int ilevel, int iloop)
 
 void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_pre_force_respa; i++)
-    fix[list_pre_force_respa[i]]->pre_force_respa(vflag, ilevel, iloop);
+  for (int i = 0; i < n_pre_force_respa; i++) {
+    Fix *ifix = fix[list_pre_force_respa[i]];
+    double start = timer->detail_start();
+    ifix->pre_force_respa(vflag, ilevel, iloop);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -612,13 +679,21 @@ void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 {
   if (n_post_force_group) {
-    for (int i = 0; i < n_post_force_group; i++)
-      fix[list_post_force_group[i]]->post_force_respa(vflag, ilevel, iloop);
+    for (int i = 0; i < n_post_force_group; i++) {
+      Fix *ifix = fix[list_post_force_group[i]];
+      double start = timer->detail_start();
+      ifix->post_force_respa(vflag, ilevel, iloop);
+      timer->detail_stop(ifix->time_detail,start);
+    }
   }
 
   if (n_post_force_respa) {
-    for (int i = 0; i < n_post_force_respa; i++)
-      fix[list_post_force_respa[i]]->post_force_respa(vflag, ilevel, iloop);
+    for (int i = 0; i < n_post_force_respa; i++) {
+      Fix *ifix = fix[list_post_force_respa[i]];
+      double start = timer->detail_start();
+      ifix->post_force_respa(vflag, ilevel, iloop);
+      timer->detail_stop(ifix->time_detail,start);
+    }
   }
 }
 
@@ -628,8 +703,12 @@ void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 
 void Modify::final_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_final_integrate_respa; i++)
-    fix[list_final_integrate_respa[i]]->final_integrate_respa(ilevel, iloop);
+  for (int i = 0; i < n_final_integrate_respa; i++) {
+    Fix *ifix = fix[list_final_integrate_respa[i]];
+    double start = timer->detail_start();
+    ifix->final_integrate_respa(ilevel, iloop);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -638,7 +717,12 @@ void Modify::final_integrate_respa(int ilevel, int iloop)
 
 void Modify::min_pre_exchange()
 {
-  for (int i = 0; i < n_min_pre_exchange; i++) fix[list_min_pre_exchange[i]]->min_pre_exchange();
+  for (int i = 0; i < n_min_pre_exchange; i++) {
+    Fix *ifix = fix[list_min_pre_exchange[i]];
+    double start = timer->detail_start();
+    ifix->min_pre_exchange();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -647,7 +731,12 @@ void Modify::min_pre_exchange()
 
 void Modify::min_pre_neighbor()
 {
-  for (int i = 0; i < n_min_pre_neighbor; i++) fix[list_min_pre_neighbor[i]]->min_pre_neighbor();
+  for (int i = 0; i < n_min_pre_neighbor; i++) {
+    Fix *ifix = fix[list_min_pre_neighbor[i]];
+    double start = timer->detail_start();
+    ifix->min_pre_neighbor();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -656,7 +745,12 @@ void Modify::min_pre_neighbor()
 
 void Modify::min_post_neighbor()
 {
-  for (int i = 0; i < n_min_post_neighbor; i++) fix[list_min_post_neighbor[i]]->min_post_neighbor();
+  for (int i = 0; i < n_min_post_neighbor; i++) {
+    Fix *ifix = fix[list_min_post_neighbor[i]];
+    double start = timer->detail_start();
+    ifix->min_post_neighbor();
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -665,7 +759,12 @@ void Modify::min_post_neighbor()
 
 void Modify::min_pre_force(int vflag)
 {
-  for (int i = 0; i < n_min_pre_force; i++) fix[list_min_pre_force[i]]->min_pre_force(vflag);
+  for (int i = 0; i < n_min_pre_force; i++) {
+    Fix *ifix = fix[list_min_pre_force[i]];
+    double start = timer->detail_start();
+    ifix->min_pre_force(vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -674,8 +773,12 @@ void Modify::min_pre_force(int vflag)
 
 void Modify::min_pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_min_pre_reverse; i++)
-    fix[list_min_pre_reverse[i]]->min_pre_reverse(eflag, vflag);
+  for (int i = 0; i < n_min_pre_reverse; i++) {
+    Fix *ifix = fix[list_min_pre_reverse[i]];
+    double start = timer->detail_start();
+    ifix->min_pre_reverse(eflag, vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -684,7 +787,12 @@ void Modify::min_pre_reverse(int eflag, int vflag)
 
 void Modify::min_post_force(int vflag)
 {
-  for (int i = 0; i < n_min_post_force; i++) fix[list_min_post_force[i]]->min_post_force(vflag);
+  for (int i = 0; i < n_min_post_force; i++) {
+    Fix *ifix = fix[list_min_post_force[i]];
+    double start = timer->detail_start();
+    ifix->min_post_force(vflag);
+    timer->detail_stop(ifix->time_detail,start);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -21,6 +21,8 @@
 #include "my_page.h"
 #include "memory.h"
 
+#include <algorithm>
+
 using namespace LAMMPS_NS;
 
 static constexpr int PGDELTA = 1;
@@ -43,6 +45,7 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   occasional = 0;
   ghost = 0;
   ssa = 0;
+  cluster = 0;
   history = 0;
   respaouter = 0;
   respamiddle = 0;
@@ -79,6 +82,20 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
   ipage_inner = nullptr;
   ipage_middle = nullptr;
 
+  // cluster pair lists
+
+  nicluster = ncluster = maxcluster = 0;
+  clusteratom = nullptr;
+  numjcluster = nullptr;
+  firstjcluster = nullptr;
+  cpage = nullptr;
+
+  // split of I atoms into interior and boundary rows
+
+  ninterior = maxsplit = 0;
+  ilist_split = nullptr;
+  splitstamp = -1;
+
   // Kokkos package
 
   kokkos = 0;
@@ -120,6 +137,15 @@ NeighList::~NeighList()
     delete [] ipage_middle;
   }
 
+  if (cluster) {
+    memory->destroy(clusteratom);
+    memory->destroy(numjcluster);
+    memory->sfree(firstjcluster);
+    delete [] cpage;
+  }
+
+  memory->destroy(ilist_split);
+
   delete [] iskip;
   memory->destroy(ijskip);
 }
@@ -141,6 +167,7 @@ void NeighList::post_constructor(NeighRequest *nq)
   occasional = nq->occasional;
   ghost = nq->ghost;
   ssa = nq->ssa;
+  cluster = nq->cluster;
   history = nq->history;
   respaouter = nq->respaouter;
   respamiddle = nq->respamiddle;
@@ -196,6 +223,14 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
     for (int i = 0; i < nmypage; i++)
       ipage_middle[i].init(oneatom,pgsize,PGDELTA);
   }
+
+  // two ints per J cluster, one I cluster may see up to oneatom J clusters
+
+  if (cluster) {
+    cpage = new MyPage<int>[nmypage];
+    for (int i = 0; i < nmypage; i++)
+      cpage[i].init(2*oneatom,2*pgsize,PGDELTA);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -248,6 +283,84 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   grow per-cluster data to allow for n clusters of owned and ghost atoms
+   triggered by cluster neighbor list build
+------------------------------------------------------------------------- */
+
+void NeighList::grow_cluster(int n)
+{
+  if (n <= maxcluster) return;
+  maxcluster = n + n/4;
+
+  memory->destroy(clusteratom);
+  memory->destroy(numjcluster);
+  memory->sfree(firstjcluster);
+  memory->create(clusteratom,maxcluster*CLUSTERSIZE,"neighlist:clusteratom");
+  memory->create(numjcluster,maxcluster,"neighlist:numjcluster");
+  firstjcluster = (int **) memory->smalloc(maxcluster*sizeof(int *),
+                                           "neighlist:firstjcluster");
+}
+
+/* ----------------------------------------------------------------------
+   count atom pairs encoded in the cluster pair masks
+------------------------------------------------------------------------- */
+
+bigint NeighList::cluster_pairs()
+{
+  bigint npair = 0;
+  for (int ic = 0; ic < nicluster; ic++) {
+    const int *jlist = firstjcluster[ic];
+    for (int jj = 0; jj < numjcluster[ic]; jj++) {
+      unsigned int bits = jlist[2*jj+1];
+      while (bits) {
+        bits &= bits - 1;
+        npair++;
+      }
+    }
+  }
+  return npair;
+}
+
+/* ----------------------------------------------------------------------
+   reorder I atoms so that rows whose J neighbors are all owned atoms
+     come first, followed by rows with ghost atom neighbors
+   order within each group is kept
+   only redone if the list was rebuilt since the last call
+------------------------------------------------------------------------- */
+
+void NeighList::split_interior()
+{
+  const bigint stamp = neighbor->ncalls + neighbor->npartial;
+  if (stamp == splitstamp) return;
+  splitstamp = stamp;
+
+  if (inum > maxsplit) {
+    memory->destroy(ilist_split);
+    maxsplit = atom->nmax;
+    memory->create(ilist_split,maxsplit,"neighlist:ilist_split");
+  }
+
+  // interior rows are stored from the front, boundary rows from the back
+
+  const int nlocal = atom->nlocal;
+  int nboundary = 0;
+  ninterior = 0;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    int jj;
+    for (jj = 0; jj < jnum; jj++)
+      if ((jlist[jj] & NEIGHMASK) >= nlocal) break;
+    if (jj == jnum) ilist_split[ninterior++] = i;
+    else ilist_split[inum - (++nboundary)] = i;
+  }
+
+  std::reverse(ilist_split + ninterior, ilist_split + inum);
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -285,6 +398,7 @@ void NeighList::print_attributes()
   printf("  %d = kokkos host\n",rq->kokkos_host);
   printf("  %d = kokkos device\n",rq->kokkos_device);
   printf("  %d = ssa flag\n",ssa);
+  printf("  %d = cluster flag\n",cluster);
   printf("\n");
   printf("  %d = skip flag\n",rq->skip);
   printf("  %d = off2on\n",rq->off2on);
@@ -335,5 +449,17 @@ double NeighList::memory_usage()
     }
   }
 
+  if (cluster) {
+    bytes += memory->usage(clusteratom,maxcluster*CLUSTERSIZE);
+    bytes += memory->usage(numjcluster,maxcluster);
+    bytes += (double)maxcluster * sizeof(int *);
+    if (cpage) {
+      for (int i = 0; i < nmypage; i++)
+        bytes += cpage[i].size();
+    }
+  }
+
+  bytes += memory->usage(ilist_split,maxsplit);
+
   return bytes;
 }
@@ -37,6 +37,7 @@ class NeighList : protected Pointers {
   int occasional;     // 0 if build every reneighbor, 1 if not
   int ghost;          // 1 if list stores neighbors of ghosts
   int ssa;            // 1 if list stores Shardlow data
+  int cluster;        // 1 if list stores cluster pairs
   int history;        // 1 if there is neigh history (FixNeighHist)
   int respaouter;     // 1 if list is a rRespa outer list
   int respamiddle;    // 1 if there is also a rRespa middle list
@@ -77,6 +78,29 @@ class NeighList : protected Pointers {
   MyPage<int> *ipage_inner;     // pages of neighbor indices for inner
   MyPage<int> *ipage_middle;    // pages of neighbor indices for middle
 
+  // data structs to store cluster pairs of CLUSTERSIZE atoms each
+  // each J entry is a pair of ints: J cluster index and a bitmask
+  //   with bit a*CLUSTERSIZE+b set if atoms a of I and b of J interact
+  // per-atom neighbors above then only hold pairs with special bits set
+
+  static constexpr int CLUSTERSIZE = 4;
+
+  int nicluster;           // # of clusters of owned atoms, stored first
+  int ncluster;            // # of clusters of owned and ghost atoms
+  int maxcluster;          // size of allocated per-cluster arrays
+  int *clusteratom;        // CLUSTERSIZE atom indices per cluster, -1 if unused
+  int *numjcluster;        // # of J clusters for each I cluster
+  int **firstjcluster;     // ptr to 1st J cluster entry of each I cluster
+  MyPage<int> *cpage;      // pages of cluster pair entries
+
+  // I atoms reordered so rows with only owned J neighbors come first
+  // those rows can be computed before ghost atom coords are communicated
+
+  int ninterior;         // # of I atoms with only owned J neighbors
+  int *ilist_split;      // local indices of I atoms, interior ones first
+  int maxsplit;          // size of ilist_split
+  bigint splitstamp;     // neighbor build count ilist_split was made for
+
   // atom types to skip when building list
   // copied info from corresponding request into realloced vec/array
 
@@ -107,6 +131,9 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);    // setup page data structures
   void grow(int, int);           // grow all data structs
+  void grow_cluster(int);        // grow per-cluster data structs
+  bigint cluster_pairs();        // # of atom pairs stored as cluster pairs
+  void split_interior();         // setup ilist_split and ninterior
   void print_attributes();       // debug routine
   int get_maxlocal() { return maxatom; }
   double memory_usage();
@@ -80,6 +80,7 @@ class NeighRequest : protected Pointers {
   int kokkos_host;     // set by KOKKOS package
   int kokkos_device;
   int ssa;          // set by DPD-REACT package, for Shardlow lists
+  int cluster;      // 1 if list stores cluster pairs for vectorized kernels
   int cut;          // 1 if use a non-standard cutoff length
   double cutoff;    // special cutoff distance for this list
 
@@ -138,6 +139,7 @@ class NeighRequest : protected Pointers {
   void set_kokkos_host(int);
   void set_skip(int *, int **);
   void enable_full();
+  void enable_cluster();
   void enable_ghost();
   void enable_intel();
 
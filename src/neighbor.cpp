@@ -135,6 +135,8 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   oneatom = 2000;
   binsizeflag = 0;
   build_once = 0;
+  partial_flag = 0;
+  partial_pending = 0;
   cluster_check = 0;
   ago = -1;
 
@@ -196,6 +198,18 @@ pairclass(nullptr), pairnames(nullptr), pairmasks(nullptr)
   maxhold = 0;
   xhold = nullptr;
   lastcall = -1;
+
+  // data for partial rebuilds
+
+  partial_active = partial_request = 0;
+  npartial = 0;
+  cutpartialsq = 0.0;
+  maxpart = maxpartbin = 0;
+  xpart = nullptr;
+  dpart = nullptr;
+  partflag = nullptr;
+  dirty = nullptr;
+  binflag = binnear = nullptr;
   last_setup_bins = -1;
 
   // pair exclusion list info
@@ -279,6 +293,12 @@ Neighbor::~Neighbor()
   delete neigh_improper;
 
   memory->destroy(xhold);
+  memory->destroy(xpart);
+  memory->destroy(dpart);
+  memory->destroy(partflag);
+  memory->destroy(dirty);
+  memory->destroy(binflag);
+  memory->destroy(binnear);
 
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
@@ -306,7 +326,7 @@ void Neighbor::init()
   int i,j,n;
 
   overlap_topo = 0;
-  ncalls = ndanger = 0;
+  ncalls = ndanger = npartial = 0;
   dimension = domain->dimension;
   triclinic = domain->triclinic;
   newton_pair = force->newton_pair;
@@ -357,32 +377,7 @@ void Neighbor::init()
     cuttypesq = new double[n+1];
   }
 
-  double cutoff,delta,cut;
-  cutneighmin = BIG;
-  cutneighmax = 0.0;
-
-  for (i = 1; i <= n; i++) {
-    cuttype[i] = cuttypesq[i] = 0.0;
-    for (j = 1; j <= n; j++) {
-      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
-      else cutoff = 0.0;
-      if (cutoff > 0.0) delta = skin;
-      else delta = 0.0;
-      cut = cutoff + delta;
-
-      cutneighsq[i][j] = cut*cut;
-      cuttype[i] = MAX(cuttype[i],cut);
-      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
-      cutneighmin = MIN(cutneighmin,cut);
-      cutneighmax = MAX(cutneighmax,cut);
-
-      if (force->pair && force->pair->ghostneigh) {
-        cut = force->pair->cutghost[i][j] + skin;
-        cutneighghostsq[i][j] = cut*cut;
-      } else cutneighghostsq[i][j] = cut*cut;
-    }
-  }
-  cutneighmaxsq = cutneighmax * cutneighmax;
+  init_cutneigh();
 
   // Define cutoffs for multi
   if (style == Neighbor::MULTI) {
@@ -677,6 +672,10 @@ void Neighbor::init()
 
   if (!same && (nrequest > 0) && (comm->me == 0)) print_pairwise_info();
 
+  // check if lists of this run can be rebuilt partially
+
+  init_partial();
+
   // can now delete requests so next run can make new ones
   // print_pairwise_info() made use of requests
   // set of NeighLists now stores all needed info
@@ -694,6 +693,102 @@ void Neighbor::init()
   init_topology();
 }
 
+/* ----------------------------------------------------------------------
+   set neighbor cutoffs from pair cutoffs and skin
+------------------------------------------------------------------------- */
+
+void Neighbor::init_cutneigh()
+{
+  int n = atom->ntypes;
+  double cutoff,delta,cut;
+  cutneighmin = BIG;
+  cutneighmax = 0.0;
+
+  for (int i = 1; i <= n; i++) {
+    cuttype[i] = cuttypesq[i] = 0.0;
+    for (int j = 1; j <= n; j++) {
+      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
+      else cutoff = 0.0;
+      if (cutoff > 0.0) delta = skin;
+      else delta = 0.0;
+      cut = cutoff + delta;
+
+      cutneighsq[i][j] = cut*cut;
+      cuttype[i] = MAX(cuttype[i],cut);
+      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
+      cutneighmin = MIN(cutneighmin,cut);
+      cutneighmax = MAX(cutneighmax,cut);
+
+      if (force->pair && force->pair->ghostneigh) {
+        cut = force->pair->cutghost[i][j] + skin;
+        cutneighghostsq[i][j] = cut*cut;
+      } else cutneighghostsq[i][j] = cut*cut;
+    }
+  }
+  cutneighmaxsq = cutneighmax * cutneighmax;
+}
+
+/* ----------------------------------------------------------------------
+   change skin distance during a run
+   only valid for styles whose cutoffs depend on nothing but pair cutoffs and skin
+   caller must trigger a full reneighboring before lists are used again
+   and redo Comm::setup() and setup_bins() for the new cutoff
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double newskin)
+{
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i] && neigh_pair[i]->cutoff_custom > 0.0)
+      error->all(FLERR,"Cannot change neighbor skin with custom neighbor list cutoffs");
+
+  skin = newskin;
+  triggersq = 0.25*skin*skin;
+  init_cutneigh();
+
+  for (int i = 0; i < nbin; i++) neigh_bin[i]->copy_neighbor_info();
+  for (int i = 0; i < nstencil; i++) neigh_stencil[i]->copy_neighbor_info();
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i]) neigh_pair[i]->copy_neighbor_info();
+}
+
+/* ----------------------------------------------------------------------
+   determine if partial rebuilds can be used in this run
+   requires binned lists built by NPair styles that support it,
+     or lists derived from them, and a box that does not change
+------------------------------------------------------------------------- */
+
+void Neighbor::init_partial()
+{
+  partial_active = 0;
+  if (!partial_flag) return;
+
+  int flag = 1;
+  if (style != Neighbor::BIN || !dist_check || build_once || boxcheck || lmp->kokkos) flag = 0;
+  if (npair_perpetual == 0) flag = 0;
+
+  for (int i = 0; i < npair_perpetual; i++) {
+    NeighList *list = lists[plist[i]];
+    if (list->copy || list->listskip || list->listfull) continue;
+    if (!neigh_pair[plist[i]]->partial || list->ghost || list->history || list->respaouter ||
+        list->ssa)
+      flag = 0;
+  }
+
+  if (flag && comm->cutghostuser <= cutneighmax && me == 0)
+    error->warning(FLERR,"Neigh_modify rebuild partial requires comm_modify cutoff > "
+                   "neighbor cutoff {} to avoid full rebuilds", cutneighmax);
+
+  if (!flag) {
+    if (me == 0)
+      error->warning(FLERR,"Neighbor list settings do not support partial rebuilds, "
+                     "using full rebuilds");
+    return;
+  }
+
+  partial_active = 1;
+  if (atom->nmax > maxpart) grow_partial();
+}
+
 /* ----------------------------------------------------------------------
    create and initialize lists of Nbin, Nstencil, NPair classes
    lists have info on all classes in 3 style*.h files
@@ -1281,6 +1376,7 @@ void Neighbor::morph_skip()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // 2 lists are a match
 
@@ -1404,8 +1500,10 @@ void Neighbor::morph_halffull()
 
     // these lists are created other ways, no need for halffull
     // do want to process skip lists
+    // cluster lists cannot be derived from a per-atom full list
 
     if (irq->copy) continue;
+    if (irq->cluster) continue;
 
     // check all other lists
 
@@ -1444,6 +1542,7 @@ void Neighbor::morph_halffull()
       if (irq->kokkos_host != jrq->kokkos_host) continue;
       if (irq->kokkos_device != jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1553,6 +1652,7 @@ void Neighbor::morph_copy_trim()
       if (irq->kokkos_host && !jrq->kokkos_host) continue;
       if (irq->kokkos_device && !jrq->kokkos_device) continue;
       if (irq->ssa != jrq->ssa) continue;
+      if (irq->cluster != jrq->cluster) continue;
 
       // skip flag must be same
       // if both are skip lists, skip info must match
@@ -1989,9 +2089,11 @@ int Neighbor::choose_stencil(NeighRequest *rq)
   else if (rq->newton == 2) newtflag = 0;
 
   // request a full stencil if building full neighbor list or newton is off
+  // cluster lists always search the full stencil and apply the half rule per pair
   int fullflag = 0;
   if (rq->full) fullflag = 1;
   if (!newtflag) fullflag = 1;
+  if (rq->cluster) fullflag = 1;
 
   //printf("STENCIL RQ FLAGS: hff %d %d n %d g %d s %d newtflag %d fullflag %d\n",
   //       rq->half,rq->full,rq->newton,rq->ghost,rq->ssa,
@@ -2161,6 +2263,7 @@ int Neighbor::choose_pair(NeighRequest *rq)
     if (!rq->kokkos_device != !(mask & NP_KOKKOS_DEVICE)) continue;
     if (!rq->kokkos_host != !(mask & NP_KOKKOS_HOST)) continue;
     if (!rq->ssa != !(mask & NP_SSA)) continue;
+    if (!rq->cluster != !(mask & NP_CLUSTER)) continue;
 
     if (!rq->skip != !(mask & NP_SKIP)) continue;
 
@@ -2309,8 +2412,11 @@ void Neighbor::setup_bins()
 
 /* ---------------------------------------------------------------------- */
 
-int Neighbor::decide()
+int Neighbor::decide(int partialok)
 {
+  partial_pending = 0;
+  partial_request = partialok && partial_active;
+
   if (must_check) {
     bigint n = update->ntimestep;
     if (restart_check && n == output->next_restart) return 1;
@@ -2374,6 +2480,8 @@ int Neighbor::check_distance()
     }
   } else deltasq = triggersq;
 
+  if (partial_request) return check_partial();
+
   double **x = atom->x;
   int nlocal = atom->nlocal;
   if (includegroup) nlocal = atom->nfirst;
@@ -2393,6 +2501,55 @@ int Neighbor::check_distance()
   return flagall;
 }
 
+/* ----------------------------------------------------------------------
+   variant of check_distance() when partial rebuilds are possible
+   return 1 if any atom moved far enough since last full build to
+     require new ghost atoms, i.e. a full build
+   else set partial_pending if any atom moved the trigger distance
+     since the last rebuild of its own row, plus the distance it had moved
+     when rows of its neighbors were last rebuilt
+   flags hot owned atoms in partflag for build_partial()
+------------------------------------------------------------------------- */
+
+int Neighbor::check_partial()
+{
+  double delx,dely,delz,rsq,dist;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int ncheck = includegroup ? atom->nfirst : nlocal;
+
+  if (atom->nmax > maxpart) grow_partial();
+
+  int flag[2] = {0,0};
+  for (int i = 0; i < ncheck; i++) {
+    delx = x[i][0] - xhold[i][0];
+    dely = x[i][1] - xhold[i][1];
+    delz = x[i][2] - xhold[i][2];
+    rsq = delx*delx + dely*dely + delz*delz;
+    if (rsq > cutpartialsq) flag[0] = 1;
+
+    delx = x[i][0] - xpart[i][0];
+    dely = x[i][1] - xpart[i][1];
+    delz = x[i][2] - xpart[i][2];
+    dist = sqrt(delx*delx + dely*dely + delz*delz) + dpart[i];
+    if (dist*dist > triggersq) {
+      partflag[i][0] = 1.0;
+      flag[1] = 1;
+    } else partflag[i][0] = 0.0;
+  }
+  for (int i = ncheck; i < nlocal; i++) partflag[i][0] = 0.0;
+
+  int flagall[2];
+  MPI_Allreduce(flag,flagall,2,MPI_INT,MPI_MAX,world);
+  if (flagall[0]) {
+    if (ago == MAX(every,delay)) ndanger++;
+    return 1;
+  }
+  if (flagall[1]) partial_pending = 1;
+  return 0;
+}
+
 /* ----------------------------------------------------------------------
    build perpetual neighbor lists
    called at setup and every few timesteps during run or minimization
@@ -2432,6 +2589,15 @@ void Neighbor::build(int topoflag)
       xhold[i][1] = x[i][1];
       xhold[i][2] = x[i][2];
     }
+    if (partial_active) {
+      if (atom->nmax > maxpart) grow_partial();
+      for (i = 0; i < nlocal; i++) {
+        xpart[i][0] = x[i][0];
+        xpart[i][1] = x[i][1];
+        xpart[i][2] = x[i][2];
+        dpart[i] = 0.0;
+      }
+    }
     if (boxcheck) {
       if (triclinic == 0) {
         boxlo_hold[0] = bboxlo[0];
@@ -2466,6 +2632,20 @@ void Neighbor::build(int topoflag)
     }
   }
 
+  // partial rebuilds reuse ghost atoms and bins of this build
+  // all atoms a new row may need are ghosts if no atom moves more than
+  //   1/2 of the extra ghost cutoff beyond the neighbor cutoff
+  // moving more than one bin could also place ghost atoms outside the bins
+
+  if (partial_active) {
+    NBin *nb = neigh_bin[0];
+    double cutpartial = 0.5 * (MAX(comm->cutghostuser,cutneighmax) - cutneighmax);
+    cutpartial = MIN(cutpartial,nb->binsizex);
+    cutpartial = MIN(cutpartial,nb->binsizey);
+    if (dimension == 3) cutpartial = MIN(cutpartial,nb->binsizez);
+    cutpartialsq = cutpartial*cutpartial;
+  }
+
   // build pairwise lists for all perpetual NPair/NeighList
   // grow() with nlocal/nall args so that only realloc if have to
 
@@ -2483,6 +2663,152 @@ void Neighbor::build(int topoflag)
   if ((atom->molecular != Atom::ATOMIC) && topoflag && !overlap_topo) build_topology();
 }
 
+/* ----------------------------------------------------------------------
+   partial rebuild of perpetual neighbor lists
+   called instead of build() when check_partial() found atoms that moved
+     the trigger distance, but no atom moved far enough to require
+     new ghost atoms, so no exchange or borders was done
+   hot atoms = moved trigger distance since their row was last rebuilt
+   dirty atoms = in bins within stencil range of a bin with a hot atom
+   rows of dirty atoms are rebuilt, pairs of other atoms are kept
+   ghost atoms get hot/dirty flags from their owning procs
+   lists derived from other lists (copy, skip, halffull) are rebuilt in full
+------------------------------------------------------------------------- */
+
+void Neighbor::build_partial()
+{
+  int i,m;
+
+  partial_pending = 0;
+  ago = 0;
+  npartial++;
+  lastcall = update->ntimestep;
+
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+  double **x = atom->x;
+
+  if (atom->nmax > maxpart) grow_partial();
+
+  // hot flags of owned atoms were set by check_partial()
+
+  comm->forward_comm_array(1,partflag);
+
+  // rebin all atoms at their current coords
+
+  for (i = 0; i < nbin; i++) {
+    neigh_bin[i]->bin_atoms_setup(nall);
+    neigh_bin[i]->bin_atoms();
+  }
+
+  // dirty owned atoms are near a hot atom, then flag ghosts from their owners
+
+  NBin *nb = neigh_bin[0];
+  int *atom2bin = nb->atom2bin;
+  flag_bins_near(nb);
+
+  for (i = 0; i < nlocal; i++)
+    partflag[i][0] = binnear[atom2bin[i]] ? 1.0 : 0.0;
+  comm->forward_comm_array(1,partflag);
+
+  for (i = 0; i < nall; i++)
+    dirty[i] = (partflag[i][0] > 0.0) ? 1 : 0;
+
+  // clean owned atoms near a dirty atom get new pairs at current coords
+  // remember how far they had moved, so check_partial() accounts for it
+  // dirty owned atoms start over at current coords
+
+  flag_bins_near(nb);
+
+  double delx,dely,delz;
+
+  for (i = 0; i < nlocal; i++) {
+    if (dirty[i]) {
+      xpart[i][0] = x[i][0];
+      xpart[i][1] = x[i][1];
+      xpart[i][2] = x[i][2];
+      dpart[i] = 0.0;
+    } else if (binnear[atom2bin[i]]) {
+      delx = x[i][0] - xpart[i][0];
+      dely = x[i][1] - xpart[i][1];
+      delz = x[i][2] - xpart[i][2];
+      dpart[i] = MAX(dpart[i],sqrt(delx*delx + dely*dely + delz*delz));
+    }
+  }
+
+  // rebuild rows of dirty atoms in all perpetual lists
+
+  for (i = 0; i < npair_perpetual; i++) {
+    m = plist[i];
+    neigh_pair[m]->build_setup();
+    if (lists[m]->copy || lists[m]->listskip || lists[m]->listfull)
+      neigh_pair[m]->build(lists[m]);
+    else neigh_pair[m]->build_partial(lists[m],dirty);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   binnear = 1 for all bins within stencil range of a bin
+     that contains an owned or ghost atom with partflag set
+------------------------------------------------------------------------- */
+
+void Neighbor::flag_bins_near(NBin *nb)
+{
+  int i,ibin,ix,iy,iz,jx,jy,jz;
+
+  int mbinx = nb->mbinx;
+  int mbiny = nb->mbiny;
+  int mbinz = nb->mbinz;
+  int mbinxy = mbinx*mbiny;
+  int mbins = nb->mbins;
+  int *atom2bin = nb->atom2bin;
+  int nall = atom->nlocal + atom->nghost;
+
+  if (mbins > maxpartbin) {
+    maxpartbin = mbins;
+    memory->destroy(binflag);
+    memory->destroy(binnear);
+    memory->create(binflag,maxpartbin,"neigh:binflag");
+    memory->create(binnear,maxpartbin,"neigh:binnear");
+  }
+
+  for (ibin = 0; ibin < mbins; ibin++) binflag[ibin] = binnear[ibin] = 0;
+  for (i = 0; i < nall; i++)
+    if (partflag[i][0] > 0.0) binflag[atom2bin[i]] = 1;
+
+  int sx = static_cast<int> (cutneighmax*nb->bininvx);
+  if (sx*nb->binsizex < cutneighmax) sx++;
+  int sy = static_cast<int> (cutneighmax*nb->bininvy);
+  if (sy*nb->binsizey < cutneighmax) sy++;
+  int sz = static_cast<int> (cutneighmax*nb->bininvz);
+  if (sz*nb->binsizez < cutneighmax) sz++;
+  if (dimension == 2) sz = 0;
+
+  for (ibin = 0; ibin < mbins; ibin++) {
+    if (!binflag[ibin]) continue;
+    iz = ibin / mbinxy;
+    iy = (ibin - iz*mbinxy) / mbinx;
+    ix = ibin - iz*mbinxy - iy*mbinx;
+    for (jz = MAX(iz-sz,0); jz <= MIN(iz+sz,mbinz-1); jz++)
+      for (jy = MAX(iy-sy,0); jy <= MIN(iy+sy,mbiny-1); jy++)
+        for (jx = MAX(ix-sx,0); jx <= MIN(ix+sx,mbinx-1); jx++)
+          binnear[jz*mbinxy + jy*mbinx + jx] = 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   grow per-atom arrays used by partial rebuilds
+------------------------------------------------------------------------- */
+
+void Neighbor::grow_partial()
+{
+  maxpart = atom->nmax;
+  memory->grow(xpart,maxpart,3,"neigh:xpart");
+  memory->grow(dpart,maxpart,"neigh:dpart");
+  memory->grow(partflag,maxpart,1,"neigh:partflag");
+  memory->grow(dirty,maxpart,"neigh:dirty");
+}
+
 /* ----------------------------------------------------------------------
    build topology neighbor lists: bond, angle, dihedral, improper
    copy their list info back to Neighbor for access by bond/angle/etc classes
@@ -2639,6 +2965,12 @@ void Neighbor::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify once", error);
       build_once = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"rebuild") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify rebuild", error);
+      if (strcmp(arg[iarg+1],"full") == 0) partial_flag = 0;
+      else if (strcmp(arg[iarg+1],"partial") == 0) partial_flag = 1;
+      else error->all(FLERR,"Unknown neigh_modify rebuild argument: {}", arg[iarg+1]);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"page") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "neigh_modify page", error);
       old_pgsize = pgsize;
@@ -2971,6 +3303,7 @@ bigint Neighbor::get_nneigh_half()
       int *numneigh = neighbor->lists[m]->numneigh;
       for (int i = 0; i < inum; i++)
         nneighhalf += numneigh[ilist[i]];
+      if (lists[m]->cluster) nneighhalf += lists[m]->cluster_pairs();
     } else if (lmp->kokkos) nneighhalf = lmp->kokkos->neigh_count(m);
   }
   return nneighhalf;
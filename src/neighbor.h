@@ -34,6 +34,8 @@ class Neighbor : protected Pointers {
   int oneatom;         // max # of neighbors for one atom
   int includegroup;    // only build pairwise lists for this group
   int build_once;      // 1 if only build lists once per run
+  int partial_flag;    // 1 if partial rebuilds of lists are allowed
+  int partial_pending; // 1 if decide() requested a partial rebuild
 
   double skin;                    // skin distance
   double cutneighmin;             // min neighbor cutoff for all type pairs
@@ -52,6 +54,7 @@ class Neighbor : protected Pointers {
 
   bigint ncalls;      // # of times build has been called
   bigint ndanger;     // # of dangerous builds
+  bigint npartial;    // # of partial builds
   bigint lastcall;    // timestep of last neighbor::build() call
 
   // geometry and static info, used by other Neigh classes
@@ -124,6 +127,7 @@ class Neighbor : protected Pointers {
   Neighbor(class LAMMPS *);
   ~Neighbor() override;
   virtual void init();
+  void reset_skin(double);
 
   // old API for creating neighbor list requests
   int request(void *, int instance = 0);
@@ -140,10 +144,11 @@ class Neighbor : protected Pointers {
   // report if we have INTEL package neighbor lists
   bool has_intel_request() const;
 
-  int decide();                     // decide whether to build or not
+  int decide(int partialok = 0);    // decide whether to build or not
   virtual int check_distance();     // check max distance moved since last build
   void setup_bins();                // setup bins based on box and cutoff
   virtual void build(int);          // build all perpetual neighbor lists
+  void build_partial();             // rebuild rows of atoms near moved atoms
   virtual void build_topology();    // pairwise topology neighbor lists
   // create a one-time pairwise neigh list
   void build_one(class NeighList *list, int preflag = 0);
@@ -193,6 +198,17 @@ class Neighbor : protected Pointers {
   double **xhold;    // atom coords at last neighbor build
   int maxhold;       // size of xhold array
 
+  int partial_active;        // 1 if partial rebuilds are possible in this run
+  int partial_request;       // 1 if caller of decide() can do a partial rebuild
+  double cutpartialsq;       // full build when atom moves this dist since last one
+  double **xpart;            // atom coords at last rebuild of its own row
+  double *dpart;             // max dist from xpart when a neighbor row was rebuilt
+  double **partflag;         // per-atom hot/dirty flag, communicated to ghosts
+  int *dirty;                // 1 if row of atom is rebuilt in partial build
+  int maxpart;               // size of partial build per-atom arrays
+  int *binflag, *binnear;    // per-bin flags for partial build
+  int maxpartbin;            // size of per-bin flag arrays
+
   int boxcheck;                           // 1 if need to store box size
   double boxlo_hold[3], boxhi_hold[3];    // box size at last neighbor build
   double corners_hold[8][3];              // box corners at last neighbor build
@@ -253,6 +269,12 @@ class Neighbor : protected Pointers {
 
   void sort_requests();
 
+  void init_partial();
+  void init_cutneigh();
+  int check_partial();
+  void grow_partial();
+  void flag_bins_near(class NBin *);
+
   void morph_unique();
   void morph_skip();
   void morph_granular();
@@ -333,7 +355,8 @@ namespace NeighConst {
     NP_HALF_FULL = 1 << 23,
     NP_OFF2ON = 1 << 24,
     NP_MULTI_OLD = 1 << 25,
-    NP_TRIM = 1 << 26
+    NP_TRIM = 1 << 26,
+    NP_CLUSTER = 1 << 27
   };
 
   enum {
@@ -348,6 +371,7 @@ namespace NeighConst {
     REQ_NEWTON_ON = 1 << 8,
     REQ_NEWTON_OFF = 1 << 9,
     REQ_SSA = 1 << 10,
+    REQ_CLUSTER = 1 << 11,
   };
 }    // namespace NeighConst
 
@@ -31,6 +31,7 @@ NPair::NPair(LAMMPS *lmp)
   : Pointers(lmp), nb(nullptr), ns(nullptr), bins(nullptr), stencil(nullptr)
 {
   last_build = -1;
+  partial = 0;
   mycutneighsq = nullptr;
   molecular = atom->molecular;
   copymode = 0;
@@ -192,6 +193,16 @@ void NPair::build_setup()
   last_build = update->ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   rebuild only the rows of atoms flagged in dirty
+   only NPair styles that set partial = 1 override this
+------------------------------------------------------------------------- */
+
+void NPair::build_partial(NeighList *list, int * /*dirty*/)
+{
+  build(list);
+}
+
 /* ----------------------------------------------------------------------
    test if atom pair i,j is excluded from neighbor list
    due to type, group, molecule settings from neigh_modify command
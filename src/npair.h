@@ -24,6 +24,7 @@ class NPair : protected Pointers {
   class NBin *nb;        // ptr to NBin instance I depend on
   class NStencil *ns;    // ptr to NStencil instance I depend on
   bigint last_build;     // last timestep build performed
+  int partial;           // 1 if build_partial() is supported
 
   double cutoff_custom;    // cutoff set by requestor
 
@@ -33,6 +34,7 @@ class NPair : protected Pointers {
   virtual void copy_neighbor_info();
   void build_setup();
   virtual void build(class NeighList *) = 0;
+  virtual void build_partial(class NeighList *, int *);
 
  protected:
   double **mycutneighsq;    // per-type cutoffs when user specified
@@ -22,8 +22,10 @@
 #include "my_page.h"
 #include "neigh_list.h"
 #include "neighbor.h"
+#include "nstencil.h"
 
 #include <cmath>
+#include <vector>
 
 using namespace LAMMPS_NS;
 using namespace NeighConst;
@@ -31,7 +33,10 @@ using namespace NeighConst;
 /* ---------------------------------------------------------------------- */
 
 template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
-NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) : NPair(lmp) {}
+NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::NPairBin(LAMMPS *lmp) : NPair(lmp)
+{
+  partial = 1;
+}
 
 /* ----------------------------------------------------------------------
    Full:
@@ -252,6 +257,252 @@ void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build(NeighList *list)
   if (!HALF) list->gnum = 0;
 }
 
+/* ----------------------------------------------------------------------
+   partial rebuild of a list previously built by build()
+   only rows of atoms with dirty[i] = 1 are rebuilt from current coords
+   every pair with at least one dirty atom is re-evaluated exactly once:
+     dirty rows scan a full box of bins around the atom
+     pairs of a clean owned atom with a dirty atom are removed from the
+       clean row and, if they belong there, appended to it again
+   dirty flags of ghost atoms must match those on the owning proc,
+     so that both procs make the same choice for a shared pair
+   storage for new rows is taken from the end of the current pages
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+void NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::build_partial(NeighList *list, int *dirty)
+{
+  int i, j, k, ii, n, m, jnum, ibin, ix, iy, iz, jx, jy, jz;
+  int *neighptr, *jlist;
+
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+  const int nall = atom->nlocal + atom->nghost;
+
+  const int sx = ns->sx;
+  const int sy = ns->sy;
+  const int sz = ns->sz;
+  const int mbinxy = mbinx * mbiny;
+
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  MyPage<int> *ipage = list->ipage;
+
+  // extra entries for clean rows: owner and encoded neighbor
+
+  std::vector<int> xrow, xent;
+
+  // rebuild rows of dirty owned atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    if (!dirty[i]) continue;
+
+    n = 0;
+    neighptr = ipage->vget();
+
+    ibin = atom2bin[i];
+    iz = ibin / mbinxy;
+    iy = (ibin - iz * mbinxy) / mbinx;
+    ix = ibin - iz * mbinxy - iy * mbinx;
+
+    for (jz = MAX(iz - sz, 0); jz <= MIN(iz + sz, mbinz - 1); jz++) {
+      for (jy = MAX(iy - sy, 0); jy <= MIN(iy + sy, mbiny - 1); jy++) {
+        for (jx = MAX(ix - sx, 0); jx <= MIN(ix + sx, mbinx - 1); jx++) {
+          for (j = binhead[jz * mbinxy + jy * mbinx + jx]; j >= 0; j = bins[j]) {
+            if (i == j) continue;
+
+            // half list: a pair of two dirty owned atoms is stored by lower index
+            //   pair of dirty I with clean owned J is always stored by I
+
+            if (HALF) {
+              if (j < nlocal) {
+                if (dirty[j] && j < i) continue;
+              } else if (!ghost_stored(i, j))
+                continue;
+            }
+
+            m = pair_entry(i, j);
+            if (m < 0) continue;
+            neighptr[n++] = m;
+
+            // full list: clean owned J also needs I in its own row
+
+            if (!HALF && (j < nlocal) && !dirty[j]) {
+              m = pair_entry(j, i);
+              if (m >= 0) {
+                xrow.push_back(j);
+                xent.push_back(m);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    ipage->vgot(n);
+    if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+  }
+
+  // dirty atoms without a row of their own (ghosts)
+  // pairs with clean owned atoms must be stored in the clean row
+
+  for (j = nlocal; j < nall; j++) {
+    if (!dirty[j]) continue;
+
+    ibin = atom2bin[j];
+    iz = ibin / mbinxy;
+    iy = (ibin - iz * mbinxy) / mbinx;
+    ix = ibin - iz * mbinxy - iy * mbinx;
+
+    for (jz = MAX(iz - sz, 0); jz <= MIN(iz + sz, mbinz - 1); jz++) {
+      for (jy = MAX(iy - sy, 0); jy <= MIN(iy + sy, mbiny - 1); jy++) {
+        for (jx = MAX(ix - sx, 0); jx <= MIN(ix + sx, mbinx - 1); jx++) {
+          for (i = binhead[jz * mbinxy + jy * mbinx + jx]; i >= 0; i = bins[i]) {
+            if (i >= nlocal || dirty[i]) continue;
+            if (HALF && !ghost_stored(i, j)) continue;
+            m = pair_entry(i, j);
+            if (m < 0) continue;
+            xrow.push_back(i);
+            xent.push_back(m);
+          }
+        }
+      }
+    }
+  }
+
+  // sort extra entries by row
+
+  const int nextra = xrow.size();
+  std::vector<int> xfirst(nlocal + 1, 0), xlist(nextra);
+  for (k = 0; k < nextra; k++) xfirst[xrow[k] + 1]++;
+  for (i = 0; i < nlocal; i++) xfirst[i + 1] += xfirst[i];
+  std::vector<int> xnext(xfirst.begin(), xfirst.end() - 1);
+  for (k = 0; k < nextra; k++) xlist[xnext[xrow[k]]++] = xent[k];
+
+  // clean rows: drop dirty neighbors, then append extra entries
+  // rows without extra entries are compacted in place
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    if (dirty[i]) continue;
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    if (xfirst[i] == xfirst[i + 1]) {
+      n = 0;
+      for (k = 0; k < jnum; k++)
+        if (!dirty[jlist[k] & NEIGHMASK]) jlist[n++] = jlist[k];
+      numneigh[i] = n;
+    } else {
+      n = 0;
+      neighptr = ipage->vget();
+      for (k = 0; k < jnum; k++)
+        if (!dirty[jlist[k] & NEIGHMASK]) neighptr[n++] = jlist[k];
+      for (k = xfirst[i]; k < xfirst[i + 1]; k++) neighptr[n++] = xlist[k];
+      firstneigh[i] = neighptr;
+      numneigh[i] = n;
+      ipage->vgot(n);
+      if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if pair of owned atom I and ghost atom J is stored in row of I
+   newton off: always, since proc owning J stores it as well
+   newton on: same criteria as build() uses for ghost atoms,
+     so that exactly one of the two procs stores the pair
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+int NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::ghost_stored(int i, int j)
+{
+  if (!NEWTON) return 1;
+
+  double **x = atom->x;
+
+  if (TRI) {
+    const double delta = 0.01 * force->angstrom;
+    tagint itag = atom->tag[i];
+    tagint jtag = atom->tag[j];
+    if (itag > jtag) {
+      if ((itag + jtag) % 2 == 0) return 0;
+    } else if (itag < jtag) {
+      if ((itag + jtag) % 2 == 1) return 0;
+    } else {
+      if (fabs(x[j][2] - x[i][2]) > delta) {
+        if (x[j][2] < x[i][2]) return 0;
+      } else if (fabs(x[j][1] - x[i][1]) > delta) {
+        if (x[j][1] < x[i][1]) return 0;
+      } else {
+        if (x[j][0] < x[i][0]) return 0;
+      }
+    }
+  } else {
+    if (x[j][2] < x[i][2]) return 0;
+    if (x[j][2] == x[i][2]) {
+      if (x[j][1] < x[i][1]) return 0;
+      if (x[j][1] == x[i][1] && x[j][0] < x[i][0]) return 0;
+    }
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   return neighbor list entry for J in row of I, including special bits
+   return -1 if pair is excluded or outside the neighbor cutoff
+------------------------------------------------------------------------- */
+
+template<int HALF, int NEWTON, int TRI, int SIZE, int ATOMONLY>
+int NPairBin<HALF, NEWTON, TRI, SIZE, ATOMONLY>::pair_entry(int i, int j)
+{
+  double **x = atom->x;
+  int *type = atom->type;
+  const int itype = type[i];
+  const int jtype = type[j];
+
+  if (exclude && exclusion(i, j, itype, jtype, atom->mask, atom->molecule)) return -1;
+
+  const double delx = x[i][0] - x[j][0];
+  const double dely = x[i][1] - x[j][1];
+  const double delz = x[i][2] - x[j][2];
+  const double rsq = delx * delx + dely * dely + delz * delz;
+
+  if (SIZE) {
+    const double cut = atom->radius[i] + atom->radius[j] + skin;
+    if (rsq > cut * cut) return -1;
+  } else if (rsq > cutneighsq[itype][jtype])
+    return -1;
+
+  if (ATOMONLY || (molecular == Atom::ATOMIC)) return j;
+
+  int which = 0;
+  tagint *tag = atom->tag;
+  if (molecular != Atom::TEMPLATE) {
+    which = find_special(atom->special[i], atom->nspecial[i], tag[j]);
+  } else {
+    const int imol = atom->molindex[i];
+    if (imol >= 0) {
+      Molecule **onemols = atom->avec->onemols;
+      const int iatom = atom->molatom[i];
+      const tagint tagprev = tag[i] - iatom - 1;
+      which = find_special(onemols[imol]->special[iatom], onemols[imol]->nspecial[iatom],
+                           tag[j] - tagprev);
+    }
+  }
+
+  if (which == 0) return j;
+  if (domain->minimum_image_check(delx, dely, delz)) return j;
+  if (which > 0) return j ^ (which << SBBITS);
+  return -1;
+}
+
 namespace LAMMPS_NS {
 template class NPairBin<0,1,0,0,0>;
 template class NPairBin<1,0,0,0,0>;
@@ -111,6 +111,11 @@ class NPairBin : public NPair {
  public:
   NPairBin(class LAMMPS *);
   void build(class NeighList *) override;
+  void build_partial(class NeighList *, int *) override;
+
+ private:
+  int ghost_stored(int, int);
+  int pair_entry(int, int);
 };
 
 }    // namespace LAMMPS_NS
@@ -0,0 +1,378 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "npair_bin_cluster.h"
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "molecule.h"
+#include "my_page.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace LAMMPS_NS;
+using namespace NeighConst;
+
+static constexpr int CLUSTERSIZE = NeighList::CLUSTERSIZE;
+
+/* ---------------------------------------------------------------------- */
+
+template<int NEWTON, int TRI>
+NPairBinCluster<NEWTON, TRI>::NPairBinCluster(LAMMPS *lmp) :
+    NPair(lmp), maxbin(0), binpos(nullptr), maxbox(0), clusterbox(nullptr), clusterbin(nullptr)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<int NEWTON, int TRI>
+NPairBinCluster<NEWTON, TRI>::~NPairBinCluster()
+{
+  memory->destroy(binpos);
+  memory->destroy(clusterbox);
+  memory->destroy(clusterbin);
+}
+
+/* ----------------------------------------------------------------------
+   binned cluster pair list construction
+     atoms are grouped into clusters of CLUSTERSIZE atoms along each row
+       of bins in x, so that clusters are filled even if bins are sparse
+     owned atoms and ghost atoms are never mixed in one cluster,
+     all clusters of owned atoms are numbered before any ghost cluster
+     each owned cluster checks the rows of the full stencil around the
+       bins it spans, J clusters are pruned by their bounding boxes
+     a pair of clusters is stored once with a bitmask of interacting atoms
+   Newtoff:
+     owned/owned pairs stored once, with J cluster >= I cluster
+     owned/ghost pairs stored on both procs
+   Newton:
+     owned/owned pairs stored as for newtoff
+     owned/ghost pairs stored by only one proc, same rule as half/bin lists
+   pairs with special bonds are stored in the per-atom part of the list
+------------------------------------------------------------------------- */
+
+template<int NEWTON, int TRI>
+void NPairBinCluster<NEWTON, TRI>::build(NeighList *list)
+{
+  int i, j, a, b, k, m, ibin, ic, jc, jfirst, jlast, which, imol, iatom, moltemplate;
+  tagint tagprev = 0;
+  double delx, dely, delz, rsq, dx, dy, dz;
+  int *neighptr;
+
+  if (includegroup)
+    error->all(FLERR, "Neighbor include group not allowed with cluster neighbor lists");
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  tagint *tag = atom->tag;
+  tagint *molecule = atom->molecule;
+  tagint **special = atom->special;
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
+
+  int *molindex = atom->molindex;
+  int *molatom = atom->molatom;
+  Molecule **onemols = atom->avec->onemols;
+  if (molecular == Atom::TEMPLATE)
+    moltemplate = 1;
+  else
+    moltemplate = 0;
+  imol = iatom = -1;
+
+  // largest neighbor cutoff, used to prune cluster pairs by their bounding boxes
+
+  const int ntypes = atom->ntypes;
+  double cutmaxsq = 0.0;
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++) cutmaxsq = MAX(cutmaxsq, cutneighsq[i][j]);
+
+  // binpos = first and last+1 slot of owned atoms, first and last+1 slot
+  //   of ghost atoms of each bin, when atoms are laid out row by row
+  // each row of bins is padded to a whole number of clusters
+
+  if (mbins > maxbin) {
+    maxbin = mbins;
+    memory->destroy(binpos);
+    memory->create(binpos, 4 * maxbin, "npair:binpos");
+  }
+
+  int nown = 0;
+  int nghost = 0;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    binpos[4 * ibin] = nown;
+    binpos[4 * ibin + 2] = nghost;
+    for (i = binhead[ibin]; i >= 0; i = bins[i]) {
+      if (i < nlocal)
+        nown++;
+      else
+        nghost++;
+    }
+    binpos[4 * ibin + 1] = nown;
+    binpos[4 * ibin + 3] = nghost;
+    if ((ibin + 1) % mbinx == 0) {
+      nown = CLUSTERSIZE * ((nown + CLUSTERSIZE - 1) / CLUSTERSIZE);
+      nghost = CLUSTERSIZE * ((nghost + CLUSTERSIZE - 1) / CLUSTERSIZE);
+    }
+  }
+
+  const int nicluster = nown / CLUSTERSIZE;
+  const int ncluster = nicluster + nghost / CLUSTERSIZE;
+  for (ibin = 0; ibin < mbins; ibin++) {
+    binpos[4 * ibin + 2] += nown;
+    binpos[4 * ibin + 3] += nown;
+  }
+
+  list->grow_cluster(ncluster);
+  list->nicluster = nicluster;
+  list->ncluster = ncluster;
+  int *clusteratom = list->clusteratom;
+
+  if (ncluster > maxbox) {
+    maxbox = list->maxcluster;
+    memory->destroy(clusterbox);
+    memory->destroy(clusterbin);
+    memory->create(clusterbox, 6 * maxbox, "npair:clusterbox");
+    memory->create(clusterbin, 2 * maxbox, "npair:clusterbin");
+  }
+
+  // assign atoms to cluster slots, unused slots at the end of a row are -1
+  // clusterbin = first and last bin spanned by each owned cluster
+
+  for (i = 0; i < CLUSTERSIZE * ncluster; i++) clusteratom[i] = -1;
+
+  for (ibin = 0; ibin < mbins; ibin++) {
+    int iown = binpos[4 * ibin];
+    int ighost = binpos[4 * ibin + 2];
+    for (i = binhead[ibin]; i >= 0; i = bins[i]) {
+      if (i < nlocal) {
+        ic = iown / CLUSTERSIZE;
+        if (iown % CLUSTERSIZE == 0) clusterbin[2 * ic] = ibin;
+        clusterbin[2 * ic + 1] = ibin;
+        clusteratom[iown++] = i;
+      } else
+        clusteratom[ighost++] = i;
+    }
+  }
+
+  for (ic = 0; ic < ncluster; ic++) {
+    double *box = &clusterbox[6 * ic];
+    i = clusteratom[CLUSTERSIZE * ic];
+    box[0] = box[3] = x[i][0];
+    box[1] = box[4] = x[i][1];
+    box[2] = box[5] = x[i][2];
+    for (a = 1; a < CLUSTERSIZE; a++) {
+      i = clusteratom[CLUSTERSIZE * ic + a];
+      if (i < 0) break;
+      box[0] = MIN(box[0], x[i][0]);
+      box[1] = MIN(box[1], x[i][1]);
+      box[2] = MIN(box[2], x[i][2]);
+      box[3] = MAX(box[3], x[i][0]);
+      box[4] = MAX(box[4], x[i][1]);
+      box[5] = MAX(box[5], x[i][2]);
+    }
+  }
+
+  // merge stencil bins into rows: offset of the row and range of x offsets
+  // an x offset is always < mbinx/2, since bins extend over the ghost region
+
+  std::vector<int> rowoff, rowlo, rowhi;
+  for (k = 0; k < nstencil; k++) {
+    int sx = ((stencil[k] % mbinx) + mbinx) % mbinx;
+    if (sx > mbinx / 2) sx -= mbinx;
+    const int off = stencil[k] - sx;
+    for (m = 0; m < (int) rowoff.size(); m++)
+      if (rowoff[m] == off) break;
+    if (m == (int) rowoff.size()) {
+      rowoff.push_back(off);
+      rowlo.push_back(sx);
+      rowhi.push_back(sx);
+    } else {
+      rowlo[m] = MIN(rowlo[m], sx);
+      rowhi[m] = MAX(rowhi[m], sx);
+    }
+  }
+  const int nstencilrow = rowoff.size();
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int *numjcluster = list->numjcluster;
+  int **firstjcluster = list->firstjcluster;
+  MyPage<int> *ipage = list->ipage;
+  MyPage<int> *cpage = list->cpage;
+
+  // special neighbors of each atom of the current I cluster
+
+  std::vector<int> specneigh[CLUSTERSIZE];
+
+  int inum = 0;
+  ipage->reset();
+  cpage->reset();
+
+  for (ic = 0; ic < nicluster; ic++) {
+    const int *iatoms = &clusteratom[CLUSTERSIZE * ic];
+    const double *ibox = &clusterbox[6 * ic];
+    const int irow = clusterbin[2 * ic] - clusterbin[2 * ic] % mbinx;
+    const int ixfirst = clusterbin[2 * ic] - irow;
+    const int ixlast = clusterbin[2 * ic + 1] - irow;
+    for (a = 0; a < CLUSTERSIZE; a++) specneigh[a].clear();
+
+    int n = 0;
+    neighptr = cpage->vget();
+
+    for (k = 0; k < nstencilrow; k++) {
+      const int jbinfirst = irow + rowoff[k] + MAX(0, ixfirst + rowlo[k]);
+      const int jbinlast = irow + rowoff[k] + MIN(mbinx - 1, ixlast + rowhi[k]);
+
+      // owned clusters, then ghost clusters overlapping this range of bins
+
+      for (int pass = 0; pass < 2; pass++) {
+        const int slotfirst = binpos[4 * jbinfirst + 2 * pass];
+        const int slotlast = binpos[4 * jbinlast + 2 * pass + 1];
+        if (slotlast <= slotfirst) continue;
+        jfirst = slotfirst / CLUSTERSIZE;
+        jlast = (slotlast - 1) / CLUSTERSIZE + 1;
+        if (pass == 0) jfirst = MAX(jfirst, ic);
+
+        for (jc = jfirst; jc < jlast; jc++) {
+          const double *jbox = &clusterbox[6 * jc];
+          dx = MAX(0.0, MAX(jbox[0] - ibox[3], ibox[0] - jbox[3]));
+          dy = MAX(0.0, MAX(jbox[1] - ibox[4], ibox[1] - jbox[4]));
+          dz = MAX(0.0, MAX(jbox[2] - ibox[5], ibox[2] - jbox[5]));
+          if (dx * dx + dy * dy + dz * dz > cutmaxsq) continue;
+
+          const int *jatoms = &clusteratom[CLUSTERSIZE * jc];
+          int bits = 0;
+
+          for (a = 0; a < CLUSTERSIZE; a++) {
+            i = iatoms[a];
+            if (i < 0) break;
+            const int itype = type[i];
+            if (moltemplate) {
+              imol = molindex[i];
+              iatom = molatom[i];
+              tagprev = tag[i] - iatom - 1;
+            }
+
+            for (b = 0; b < CLUSTERSIZE; b++) {
+              j = jatoms[b];
+              if (j < 0) break;
+              if ((jc == ic) && (b <= a)) continue;
+              if (NEWTON && (j >= nlocal) && !ghost_stored(i, j)) continue;
+
+              const int jtype = type[j];
+              if (exclude && exclusion(i, j, itype, jtype, mask, molecule)) continue;
+
+              delx = x[i][0] - x[j][0];
+              dely = x[i][1] - x[j][1];
+              delz = x[i][2] - x[j][2];
+              rsq = delx * delx + dely * dely + delz * delz;
+              if (rsq > cutneighsq[itype][jtype]) continue;
+
+              which = 0;
+              if (molecular != Atom::ATOMIC) {
+                if (!moltemplate)
+                  which = find_special(special[i], nspecial[i], tag[j]);
+                else if (imol >= 0)
+                  which = find_special(onemols[imol]->special[iatom],
+                                       onemols[imol]->nspecial[iatom], tag[j] - tagprev);
+                if ((which != 0) && domain->minimum_image_check(delx, dely, delz)) which = 0;
+              }
+
+              if (which == 0)
+                bits |= 1 << (a * CLUSTERSIZE + b);
+              else if (which > 0)
+                specneigh[a].push_back(j ^ (which << SBBITS));
+            }
+          }
+
+          if (bits) {
+            neighptr[n++] = jc;
+            neighptr[n++] = bits;
+          }
+        }
+      }
+    }
+
+    firstjcluster[ic] = neighptr;
+    numjcluster[ic] = n / 2;
+    cpage->vgot(n);
+    if (cpage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+
+    for (a = 0; a < CLUSTERSIZE; a++) {
+      i = iatoms[a];
+      if (i < 0) break;
+      neighptr = ipage->vget();
+      n = 0;
+      for (auto jspecial : specneigh[a]) neighptr[n++] = jspecial;
+      ilist[inum++] = i;
+      firstneigh[i] = neighptr;
+      numneigh[i] = n;
+      ipage->vgot(n);
+      if (ipage->status()) error->one(FLERR, "Neighbor list overflow, boost neigh_modify one");
+    }
+  }
+
+  list->inum = inum;
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if this proc stores the pair of owned atom I and ghost atom J
+   with newton on, using the same rules as the half/bin/newton lists
+------------------------------------------------------------------------- */
+
+template<int NEWTON, int TRI>
+int NPairBinCluster<NEWTON, TRI>::ghost_stored(int i, int j)
+{
+  double **x = atom->x;
+
+  if (TRI) {
+    const double delta = 0.01 * force->angstrom;
+    const tagint itag = atom->tag[i];
+    const tagint jtag = atom->tag[j];
+    if (itag > jtag) {
+      if ((itag + jtag) % 2 == 0) return 0;
+    } else if (itag < jtag) {
+      if ((itag + jtag) % 2 == 1) return 0;
+    } else {
+      if (fabs(x[j][2] - x[i][2]) > delta) {
+        if (x[j][2] < x[i][2]) return 0;
+      } else if (fabs(x[j][1] - x[i][1]) > delta) {
+        if (x[j][1] < x[i][1]) return 0;
+      } else {
+        if (x[j][0] < x[i][0]) return 0;
+      }
+    }
+  } else {
+    if (x[j][2] < x[i][2]) return 0;
+    if (x[j][2] == x[i][2]) {
+      if (x[j][1] < x[i][1]) return 0;
+      if (x[j][1] == x[i][1] && x[j][0] < x[i][0]) return 0;
+    }
+  }
+  return 1;
+}
+
+namespace LAMMPS_NS {
+template class NPairBinCluster<0,0>;
+template class NPairBinCluster<1,0>;
+template class NPairBinCluster<1,1>;
+}
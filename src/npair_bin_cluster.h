@@ -0,0 +1,60 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef NPAIR_CLASS
+// clang-format off
+typedef NPairBinCluster<0, 0> NPairHalfBinClusterNewtoff;
+NPairStyle(half/bin/cluster/newtoff,
+           NPairHalfBinClusterNewtoff,
+           NP_HALF | NP_BIN | NP_CLUSTER | NP_NEWTOFF | NP_ORTHO | NP_TRI);
+
+typedef NPairBinCluster<1, 0> NPairHalfBinClusterNewton;
+NPairStyle(half/bin/cluster/newton,
+           NPairHalfBinClusterNewton,
+           NP_HALF | NP_BIN | NP_CLUSTER | NP_NEWTON | NP_ORTHO);
+
+typedef NPairBinCluster<1, 1> NPairHalfBinClusterNewtonTri;
+NPairStyle(half/bin/cluster/newton/tri,
+           NPairHalfBinClusterNewtonTri,
+           NP_HALF | NP_BIN | NP_CLUSTER | NP_NEWTON | NP_TRI);
+// clang-format on
+#else
+
+#ifndef LMP_NPAIR_BIN_CLUSTER_H
+#define LMP_NPAIR_BIN_CLUSTER_H
+
+#include "npair.h"
+
+namespace LAMMPS_NS {
+
+template<int NEWTON, int TRI>
+class NPairBinCluster : public NPair {
+ public:
+  NPairBinCluster(class LAMMPS *);
+  ~NPairBinCluster() override;
+  void build(class NeighList *) override;
+
+ private:
+  int maxbin;           // size of binpos
+  int *binpos;          // range of owned and ghost cluster slots per bin
+  int maxbox;           // size of clusterbox and clusterbin
+  double *clusterbox;   // bounding box of each cluster, lo/hi in 3 dims
+  int *clusterbin;      // first and last bin spanned by each owned cluster
+
+  int ghost_stored(int, int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
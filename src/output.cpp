@@ -29,6 +29,7 @@
 #include "memory.h"
 #include "modify.h"
 #include "thermo.h"
+#include "timer.h"
 #include "update.h"
 #include "variable.h"
 #include "write_restart.h"
@@ -120,7 +121,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->sync(0);
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -262,7 +266,9 @@ void Output::setup(int memflag)
       // perform dump
 
       if (writeflag) {
+        double start = timer->detail_start();
         dump[idump]->write();
+        timer->detail_stop(dump[idump]->time_detail,start);
         last_dump[idump] = ntimestep;
       }
 
@@ -388,7 +394,9 @@ void Output::write(bigint ntimestep)
         // perform dump
         // set next_dump and next_time_dump
 
+        double start = timer->detail_start();
         dump[idump]->write();
+        timer->detail_stop(dump[idump]->time_detail,start);
         last_dump[idump] = ntimestep;
         calculate_next_dump(WRITE,idump,ntimestep);
 
@@ -470,7 +478,9 @@ void Output::write(bigint ntimestep)
 void Output::write_dump(bigint ntimestep)
 {
   for (int idump = 0; idump < ndump; idump++) {
+    double start = timer->detail_start();
     dump[idump]->write();
+    timer->detail_stop(dump[idump]->time_detail,start);
     last_dump[idump] = ntimestep;
   }
 }
@@ -819,6 +829,7 @@ void Output::delete_dump(const std::string &id)
   for (idump = 0; idump < ndump; idump++) if (id == dump[idump]->id) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID: {}", id);
 
+  dump[idump]->sync();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -78,6 +79,7 @@ Pair::Pair(LAMMPS *lmp) :
   writedata = 0;
   finitecutflag = 0;
   ghostneigh = 0;
+  overlap_enable = 0;
   unit_convert_flag = utils::NOCONVERT;
   did_mix = false;
 
@@ -91,6 +93,7 @@ Pair::Pair(LAMMPS *lmp) :
   // pair_modify settings
 
   compute_flag = 1;
+  time_detail = 0.0;
   manybody_flag = 0;
   offset_flag = 0;
   mix_flag = GEOMETRIC;
@@ -738,6 +741,41 @@ void Pair::compute_dummy(int eflag, int vflag)
   ev_init(eflag,vflag);
 }
 
+/* ----------------------------------------------------------------------
+   compute forces for I atoms of the neighbor list that have only
+     owned J neighbors, so ghost atom coords are not needed yet
+   compute_boundary() then does the remaining I atoms
+   requires overlap_enable, i.e. compute() only loops over list->ilist
+   only used on steps without energy or virial tallies, since compute()
+     would reset the accumulators when called a second time
+------------------------------------------------------------------------- */
+
+void Pair::compute_interior()
+{
+  list->split_interior();
+
+  const int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = list->ninterior;
+  list->ilist = list->ilist_split;
+  compute(0,0);
+  list->inum = inum;
+  list->ilist = ilist;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Pair::compute_boundary()
+{
+  const int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = inum - list->ninterior;
+  list->ilist = list->ilist_split + list->ninterior;
+  compute(0,0);
+  list->inum = inum;
+  list->ilist = ilist;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Pair::read_restart(FILE *)
@@ -63,6 +63,7 @@ class Pair : protected Pointers {
   int writedata;                  // 1 if writes coeffs to data file
   int finitecutflag;              // 1 if cut depends on finite atom size
   int ghostneigh;                 // 1 if pair style needs neighbors of ghosts
+  int overlap_enable;             // 1 if compute() may be split by rows of ilist
   double **cutghost;              // cutoff for each ghost pair
 
   int ewaldflag;         // 1 if compatible with Ewald solver
@@ -112,6 +113,7 @@ class Pair : protected Pointers {
   int allocated;       // 0/1 = whether arrays are allocated
                        //       public so external driver can check
   int compute_flag;    // 0 if skip compute()
+  double time_detail;  // wall time spent in this hybrid sub-style, with "timer detail"
   int mixed_flag;      // 1 if all itype != jtype coeffs are from mixing
   bool did_mix;        // set to true by mix_energy() to indicate that mixing was performed
 
@@ -141,6 +143,8 @@ class Pair : protected Pointers {
   void init_bitmap(double, double, int, int &, int &, int &, int &);
   virtual void modify_params(int, char **);
   void compute_dummy(int, int);
+  void compute_interior();
+  void compute_boundary();
 
   // need to be public, so can be called by pair_style reaxc
 
@@ -25,6 +25,7 @@
 #include "pair.h"
 #include "respa.h"
 #include "suffix.h"
+#include "timer.h"
 #include "update.h"
 
 #include <cstring>
@@ -130,9 +131,11 @@ void PairHybrid::compute(int eflag, int vflag)
       // outerflag is set and sub-style has a compute_outer() method
 
       if (styles[m]->compute_flag == 0) continue;
+      double start = timer->detail_start();
       if (outerflag && styles[m]->respa_enable)
         styles[m]->compute_outer(eflag,vflag_substyle);
       else styles[m]->compute(eflag,vflag_substyle);
+      timer->detail_stop(styles[m]->time_detail,start);
     }
 
     restore_special(saved_special);
@@ -220,16 +223,24 @@ void PairHybrid::del_tally_callback(Compute *ptr)
 
 void PairHybrid::compute_inner()
 {
-  for (int m = 0; m < nstyles; m++)
-    if (styles[m]->respa_enable) styles[m]->compute_inner();
+  for (int m = 0; m < nstyles; m++) {
+    if (!styles[m]->respa_enable) continue;
+    double start = timer->detail_start();
+    styles[m]->compute_inner();
+    timer->detail_stop(styles[m]->time_detail,start);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
 
 void PairHybrid::compute_middle()
 {
-  for (int m = 0; m < nstyles; m++)
-    if (styles[m]->respa_enable) styles[m]->compute_middle();
+  for (int m = 0; m < nstyles; m++) {
+    if (!styles[m]->respa_enable) continue;
+    double start = timer->detail_start();
+    styles[m]->compute_middle();
+    timer->detail_stop(styles[m]->time_detail,start);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
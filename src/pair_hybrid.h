@@ -27,6 +27,7 @@ namespace LAMMPS_NS {
 class PairHybrid : public Pair {
   friend class AtomVecDielectric;
   friend class ComputeSpin;
+  friend class Finish;
   friend class FixGPU;
   friend class FixIntel;
   friend class FixNVESpin;
@@ -37,6 +38,7 @@ class PairHybrid : public Pair {
   friend class PairDeprecated;
   friend class Respa;
   friend class Scafacos;
+  friend class Timer;
 
  public:
   PairHybrid(class LAMMPS *);
@@ -41,6 +41,7 @@ PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
   respa_enable = 1;
   born_matrix_enable = 1;
   writedata = 1;
+  overlap_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
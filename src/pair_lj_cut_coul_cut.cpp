@@ -34,6 +34,7 @@ PairLJCutCoulCut::PairLJCutCoulCut(LAMMPS *lmp) : Pair(lmp)
 {
   born_matrix_enable = 1;
   writedata = 1;
+  overlap_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -0,0 +1,411 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_cut_coul_cut_cluster.h"
+
+#include "atom.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+
+static constexpr int CS = NeighList::CLUSTERSIZE;
+static constexpr int CSQ = CS * CS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulCutCluster::PairLJCutCoulCutCluster(LAMMPS *lmp) :
+    PairLJCutCoulCut(lmp), maxpack(0), xc(nullptr), qc(nullptr), tc(nullptr), maxparam(0),
+    cutsqp(nullptr), cut_ljsqp(nullptr), cut_coulsqp(nullptr), lj1p(nullptr), lj2p(nullptr),
+    lj3p(nullptr), lj4p(nullptr), offsetp(nullptr)
+{
+  overlap_enable = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJCutCoulCutCluster::~PairLJCutCoulCutCluster()
+{
+  if (copymode) return;
+
+  memory->destroy(xc);
+  memory->destroy(qc);
+  memory->destroy(tc);
+  memory->destroy(cutsqp);
+  memory->destroy(cut_ljsqp);
+  memory->destroy(cut_coulsqp);
+  memory->destroy(lj1p);
+  memory->destroy(lj2p);
+  memory->destroy(lj3p);
+  memory->destroy(lj4p);
+  memory->destroy(offsetp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCoulCutCluster::compute(int eflag, int vflag)
+{
+  // a regular neighbor list was requested, see init_style()
+
+  if (!list->cluster) {
+    PairLJCutCoulCut::compute(eflag, vflag);
+    return;
+  }
+
+  ev_init(eflag, vflag);
+  pack_clusters();
+  pack_params();
+
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) eval<1,1,1>();
+      else eval<1,1,0>();
+    } else {
+      if (force->newton_pair) eval<1,0,1>();
+      else eval<1,0,0>();
+    }
+  } else {
+    if (force->newton_pair) eval<0,0,1>();
+    else eval<0,0,0>();
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   each I,J cluster pair is processed in two passes over its CS x CS block:
+   distances of all atom pairs are computed from the packed coordinates
+   and pairs inside the cutoff are compacted without branches, then the
+   force expression is evaluated in a SIMD loop over the compacted pairs
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairLJCutCoulCutCluster::eval()
+{
+  int a, b, m;
+  double delx[CSQ], dely[CSQ], delz[CSQ], rsq[CSQ], qiqj[CSQ];
+  double fpair[CSQ], evdw[CSQ], ecou[CSQ];
+  int pairij[CSQ], pairab[CSQ];
+  double fxi[CS], fyi[CS], fzi[CS], fxj[CS], fyj[CS], fzj[CS];
+
+  double **x = atom->x;
+  double **f = atom->f;
+  double *q = atom->q;
+  int *type = atom->type;
+  const int nlocal = atom->nlocal;
+  const int ntp1 = atom->ntypes + 1;
+  double *special_coul = force->special_coul;
+  double *special_lj = force->special_lj;
+  const double qqrd2e = force->qqrd2e;
+
+  const int nicluster = list->nicluster;
+  const int *clusteratom = list->clusteratom;
+  const int *numjcluster = list->numjcluster;
+  int **firstjcluster = list->firstjcluster;
+
+  const double *_noalias const cutsqij = cutsqp;
+  const double *_noalias const cut_ljsqij = cut_ljsqp;
+  const double *_noalias const cut_coulsqij = cut_coulsqp;
+  const double *_noalias const lj1ij = lj1p;
+  const double *_noalias const lj2ij = lj2p;
+  const double *_noalias const lj3ij = lj3p;
+  const double *_noalias const lj4ij = lj4p;
+  const double *_noalias const offsetij = offsetp;
+
+  // loop over pairs of clusters
+
+  for (int ic = 0; ic < nicluster; ic++) {
+    const double *xi = &xc[3 * CS * ic];
+    const double *qi = &qc[CS * ic];
+    const int *ti = &tc[CS * ic];
+    const int *iatoms = &clusteratom[CS * ic];
+    const int *jlist = firstjcluster[ic];
+    const int jnum = numjcluster[ic];
+
+    for (a = 0; a < CS; a++) fxi[a] = fyi[a] = fzi[a] = 0.0;
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int jc = jlist[2 * jj];
+      const int bits = jlist[2 * jj + 1];
+      const double *xj = &xc[3 * CS * jc];
+      const double *qj = &qc[CS * jc];
+      const int *tj = &tc[CS * jc];
+
+      // compact atom pairs of the block that are inside the cutoff
+
+      int npair = 0;
+      for (a = 0; a < CS; a++) {
+        const int ioff = ti[a] * ntp1;
+        for (b = 0; b < CS; b++) {
+          const int ij = ioff + tj[b];
+          const double dx = xi[a] - xj[b];
+          const double dy = xi[CS + a] - xj[CS + b];
+          const double dz = xi[2 * CS + a] - xj[2 * CS + b];
+          const double r2 = dx * dx + dy * dy + dz * dz;
+          delx[npair] = dx;
+          dely[npair] = dy;
+          delz[npair] = dz;
+          rsq[npair] = r2;
+          qiqj[npair] = qi[a] * qj[b];
+          pairij[npair] = ij;
+          pairab[npair] = a * CS + b;
+          npair += ((bits >> (a * CS + b)) & 1) & (r2 < cutsqij[ij]);
+        }
+      }
+      if (npair == 0) continue;
+
+#if defined(_OPENMP)
+#pragma omp simd
+#endif
+      for (m = 0; m < npair; m++) {
+        const int ij = pairij[m];
+        const double r2inv = 1.0 / rsq[m];
+        const double r6inv = r2inv * r2inv * r2inv;
+        const bool incoul = rsq[m] < cut_coulsqij[ij];
+        const bool inlj = rsq[m] < cut_ljsqij[ij];
+        const double forcecoul = incoul ? qqrd2e * qiqj[m] * sqrt(r2inv) : 0.0;
+        const double forcelj = inlj ? r6inv * (lj1ij[ij] * r6inv - lj2ij[ij]) : 0.0;
+        fpair[m] = (forcecoul + forcelj) * r2inv;
+        if (EFLAG) {
+          ecou[m] = forcecoul;
+          evdw[m] = inlj ? r6inv * (lj3ij[ij] * r6inv - lj4ij[ij]) - offsetij[ij] : 0.0;
+        }
+      }
+
+      for (b = 0; b < CS; b++) fxj[b] = fyj[b] = fzj[b] = 0.0;
+      for (m = 0; m < npair; m++) {
+        a = pairab[m] / CS;
+        b = pairab[m] % CS;
+        fxi[a] += delx[m] * fpair[m];
+        fyi[a] += dely[m] * fpair[m];
+        fzi[a] += delz[m] * fpair[m];
+        fxj[b] -= delx[m] * fpair[m];
+        fyj[b] -= dely[m] * fpair[m];
+        fzj[b] -= delz[m] * fpair[m];
+      }
+
+      if (NEWTON_PAIR || jc < nicluster) {
+        for (b = 0; b < CS; b++) {
+          const int j = clusteratom[CS * jc + b];
+          if (j < 0) break;
+          f[j][0] += fxj[b];
+          f[j][1] += fyj[b];
+          f[j][2] += fzj[b];
+        }
+      }
+
+      if (EVFLAG) {
+        for (m = 0; m < npair; m++)
+          ev_tally(iatoms[pairab[m] / CS], clusteratom[CS * jc + pairab[m] % CS], nlocal,
+                   NEWTON_PAIR, EFLAG ? evdw[m] : 0.0, EFLAG ? ecou[m] : 0.0, fpair[m], delx[m],
+                   dely[m], delz[m]);
+      }
+    }
+
+    for (a = 0; a < CS; a++) {
+      const int i = iatoms[a];
+      if (i < 0) break;
+      f[i][0] += fxi[a];
+      f[i][1] += fyi[a];
+      f[i][2] += fzi[a];
+    }
+  }
+
+  // loop over pairs with special bonds, stored per atom
+
+  double evdwl = 0.0;
+  double ecoul = 0.0;
+  const int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int jnum = numneigh[i];
+    if (jnum == 0) continue;
+
+    const int *jlist = firstneigh[i];
+    const int itype = type[i];
+    const double qtmp = q[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      int j = jlist[jj];
+      const double factor_lj = special_lj[sbmask(j)];
+      const double factor_coul = special_coul[sbmask(j)];
+      j &= NEIGHMASK;
+
+      const double dx = x[i][0] - x[j][0];
+      const double dy = x[i][1] - x[j][1];
+      const double dz = x[i][2] - x[j][2];
+      const double rsq = dx * dx + dy * dy + dz * dz;
+      const int jtype = type[j];
+
+      if (rsq < cutsq[itype][jtype]) {
+        const double r2inv = 1.0 / rsq;
+        double forcecoul, forcelj, r6inv = 0.0;
+
+        if (rsq < cut_coulsq[itype][jtype])
+          forcecoul = qqrd2e * qtmp * q[j] * sqrt(r2inv);
+        else
+          forcecoul = 0.0;
+
+        if (rsq < cut_ljsq[itype][jtype]) {
+          r6inv = r2inv * r2inv * r2inv;
+          forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype]);
+        } else
+          forcelj = 0.0;
+
+        const double fp = (factor_coul * forcecoul + factor_lj * forcelj) * r2inv;
+
+        f[i][0] += dx * fp;
+        f[i][1] += dy * fp;
+        f[i][2] += dz * fp;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j][0] -= dx * fp;
+          f[j][1] -= dy * fp;
+          f[j][2] -= dz * fp;
+        }
+
+        if (EFLAG) {
+          ecoul = factor_coul * forcecoul;
+          if (rsq < cut_ljsq[itype][jtype]) {
+            evdwl = r6inv * (lj3[itype][jtype] * r6inv - lj4[itype][jtype]) - offset[itype][jtype];
+            evdwl *= factor_lj;
+          } else
+            evdwl = 0.0;
+        }
+
+        if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, ecoul, fp, dx, dy, dz);
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJCutCoulCutCluster::init_style()
+{
+  PairLJCutCoulCut::init_style();
+
+  // switch to a cluster pair list unless used as hybrid sub-style
+  // cluster lists are only built with neighbor style bin and without an include group
+
+  if ((force->pair == this) && (neighbor->style == Neighbor::BIN) && !neighbor->includegroup)
+    neighbor->find_request(this)->enable_cluster();
+}
+
+/* ----------------------------------------------------------------------
+   copy current coords, charges, and types of owned and ghost atoms
+   into cluster order
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulCutCluster::pack_clusters()
+{
+  const int ncluster = list->ncluster;
+  if (ncluster > maxpack) {
+    maxpack = list->maxcluster;
+    memory->destroy(xc);
+    memory->destroy(qc);
+    memory->destroy(tc);
+    memory->create(xc, 3 * CS * maxpack, "pair:xc");
+    memory->create(qc, CS * maxpack, "pair:qc");
+    memory->create(tc, CS * maxpack, "pair:tc");
+  }
+
+  double **x = atom->x;
+  double *q = atom->q;
+  int *type = atom->type;
+  const int *clusteratom = list->clusteratom;
+
+  for (int ic = 0; ic < ncluster; ic++) {
+    double *xp = &xc[3 * CS * ic];
+    for (int a = 0; a < CS; a++) {
+      const int i = clusteratom[CS * ic + a];
+      if (i >= 0) {
+        xp[a] = x[i][0];
+        xp[CS + a] = x[i][1];
+        xp[2 * CS + a] = x[i][2];
+        qc[CS * ic + a] = q[i];
+        tc[CS * ic + a] = type[i];
+      } else {
+        xp[a] = xp[CS + a] = xp[2 * CS + a] = 0.0;
+        qc[CS * ic + a] = 0.0;
+        tc[CS * ic + a] = 0;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   flatten per-type pair coefficients, row and column 0 are for unused slots
+------------------------------------------------------------------------- */
+
+void PairLJCutCoulCutCluster::pack_params()
+{
+  const int ntp1 = atom->ntypes + 1;
+  if (ntp1 * ntp1 > maxparam) {
+    maxparam = ntp1 * ntp1;
+    memory->destroy(cutsqp);
+    memory->destroy(cut_ljsqp);
+    memory->destroy(cut_coulsqp);
+    memory->destroy(lj1p);
+    memory->destroy(lj2p);
+    memory->destroy(lj3p);
+    memory->destroy(lj4p);
+    memory->destroy(offsetp);
+    memory->create(cutsqp, maxparam, "pair:cutsqp");
+    memory->create(cut_ljsqp, maxparam, "pair:cut_ljsqp");
+    memory->create(cut_coulsqp, maxparam, "pair:cut_coulsqp");
+    memory->create(lj1p, maxparam, "pair:lj1p");
+    memory->create(lj2p, maxparam, "pair:lj2p");
+    memory->create(lj3p, maxparam, "pair:lj3p");
+    memory->create(lj4p, maxparam, "pair:lj4p");
+    memory->create(offsetp, maxparam, "pair:offsetp");
+  }
+
+  for (int i = 0; i < ntp1; i++) {
+    for (int j = 0; j < ntp1; j++) {
+      const int ij = i * ntp1 + j;
+      if (i && j) {
+        cutsqp[ij] = cutsq[i][j];
+        cut_ljsqp[ij] = cut_ljsq[i][j];
+        cut_coulsqp[ij] = cut_coulsq[i][j];
+        lj1p[ij] = lj1[i][j];
+        lj2p[ij] = lj2[i][j];
+        lj3p[ij] = lj3[i][j];
+        lj4p[ij] = lj4[i][j];
+        offsetp[ij] = offset[i][j];
+      } else {
+        cutsqp[ij] = cut_ljsqp[ij] = cut_coulsqp[ij] = 0.0;
+        lj1p[ij] = lj2p[ij] = lj3p[ij] = lj4p[ij] = offsetp[ij] = 0.0;
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJCutCoulCutCluster::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double) 4 * CS * maxpack * sizeof(double);
+  bytes += (double) CS * maxpack * sizeof(int);
+  bytes += (double) 8 * maxparam * sizeof(double);
+  return bytes;
+}
@@ -0,0 +1,53 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/cut/coul/cut/cluster,PairLJCutCoulCutCluster);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_CUT_COUL_CUT_CLUSTER_H
+#define LMP_PAIR_LJ_CUT_COUL_CUT_CLUSTER_H
+
+#include "pair_lj_cut_coul_cut.h"
+
+namespace LAMMPS_NS {
+
+class PairLJCutCoulCutCluster : public PairLJCutCoulCut {
+ public:
+  PairLJCutCoulCutCluster(class LAMMPS *);
+  ~PairLJCutCoulCutCluster() override;
+  void compute(int, int) override;
+  void init_style() override;
+  double memory_usage() override;
+
+ protected:
+  int maxpack;     // # of clusters allocated in xc,qc,tc
+  double *xc;      // per-cluster coords, x/y/z blocks of CLUSTERSIZE values
+  double *qc;      // per-cluster charges
+  int *tc;         // per-cluster atom types, 0 for unused slots
+  int maxparam;    // # of type pairs allocated in param arrays
+  double *cutsqp, *cut_ljsqp, *cut_coulsqp, *lj1p, *lj2p, *lj3p, *lj4p, *offsetp;
+
+  void pack_clusters();
+  void pack_params();
+
+ private:
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -39,6 +39,7 @@
 #include "tokenizer.h"
 #include "update.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <unordered_map>
@@ -51,6 +52,7 @@ static constexpr double LB_FACTOR = 1.1;
 static constexpr int CHUNK = 1024;
 static constexpr int DELTA = 4;       // must be 2 or larger
 static constexpr int MAXBODY = 32;    // max # of lines in one body
+static constexpr int RVOUS = 1;       // 0 for irregular, 1 for all2all
 
 // customize for new sections
 
@@ -154,6 +156,7 @@ void ReadData::command(int narg, char **arg)
       extra_improper_types = 0;
 
   groupbit = 0;
+  parallelflag = 0;
 
   nfix = 0;
   fix_index = nullptr;
@@ -326,10 +329,25 @@ void ReadData::command(int narg, char **arg)
       nfix++;
       iarg += 4;
 
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+
     } else
       error->all(FLERR, "Unknown read_data keyword {}", arg[iarg]);
   }
 
+  // distributed reading of sections requires random access to the file
+
+  datafile = arg[0];
+  if (parallelflag && platform::has_compress_extension(datafile)) {
+    if (me == 0)
+      error->warning(FLERR, "Read_data parallel is not supported for compressed files, "
+                     "reading file {} serially", datafile);
+    parallelflag = 0;
+  }
+
   // error checks
 
   if ((domain->dimension == 2) && (domain->zperiodic == 0))
@@ -1521,15 +1539,47 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+  if (parallelflag) {
+
+    // each proc parses its share of the lines and keeps all atoms inside the box
+    // then atoms are migrated to the procs owning them
+
+    char *lines;
+    int n = read_lines_parallel(natoms, lines);
     if (tlabelflag && !lmap->is_complete(Atom::ATOM))
       error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
-    atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset,
-                     shiftflag, shift, tlabelflag, lmap->lmap2lmap.atom, triclinic_general);
-    nread += nchunk;
+    if (n)
+      atom->data_atoms(n, lines, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
+                       lmap->lmap2lmap.atom, triclinic_general, 1);
+    memory->sfree(lines);
+
+    if (atom->map_style != Atom::MAP_NONE) {
+      atom->map_init();
+      atom->map_set();
+    }
+    if (domain->triclinic) domain->x2lamda(atom->nlocal);
+    auto irregular = new Irregular(lmp);
+    irregular->migrate_atoms(1);
+    delete irregular;
+    if (domain->triclinic) domain->lamda2x(atom->nlocal);
+
+    int flag[3], flagall[3];
+    for (int i = 0; i < 3; i++) flag[i] = atom->reset_image_flag[i] ? 1 : 0;
+    MPI_Allreduce(flag, flagall, 3, MPI_INT, MPI_MAX, world);
+    for (int i = 0; i < 3; i++) atom->reset_image_flag[i] = flagall[i] != 0;
+
+  } else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+        error->all(FLERR,
+                   "Label map is incomplete: all types must be assigned a unique type label");
+      atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift,
+                       tlabelflag, lmap->lmap2lmap.atom, triclinic_general, 0);
+      nread += nchunk;
+    }
   }
 
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
@@ -1611,12 +1661,26 @@ void ReadData::velocities()
     atom->map_set();
   }
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    atom->data_vels(nchunk, buffer, id_offset);
-    nread += nchunk;
+  if (parallelflag) {
+
+    // send each line to the proc that owns the atom
+
+    char *lines, *mylines;
+    int n = read_lines_parallel(natoms, lines);
+    const int column = 0;
+    int nmine = route_lines(n, lines, 1, &column, mylines);
+    if (nmine) atom->data_vels(nmine, mylines, id_offset, 1);
+    memory->sfree(lines);
+    memory->sfree(mylines);
+
+  } else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      atom->data_vels(nchunk, buffer, id_offset, 0);
+      nread += nchunk;
+    }
   }
 
   if (mapflag) {
@@ -1655,16 +1719,37 @@ void ReadData::bonds(int firstpass)
 
   bigint nread = 0;
 
-  while (nread < nbonds) {
-    nchunk = MIN(nbonds - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
+  if (parallelflag) {
+
+    // send each line to the proc(s) that own the bond atoms which store the bond
+
+    char *lines, *mylines;
+    int n = read_lines_parallel(nbonds, lines);
     if (blabelflag && !lmap->is_complete(Atom::BOND))
       error->all(FLERR,
                  "Label map is incomplete: "
                  "all types must be assigned a unique type label");
-    atom->data_bonds(nchunk, buffer, count, id_offset, boffset, blabelflag, lmap->lmap2lmap.bond);
-    nread += nchunk;
+    const int columns[2] = {2, 3};
+    int nmine = route_lines(n, lines, force->newton_bond ? 1 : 2, columns, mylines);
+    if (nmine)
+      atom->data_bonds(nmine, mylines, count, id_offset, boffset, blabelflag,
+                       lmap->lmap2lmap.bond, 1);
+    memory->sfree(lines);
+    memory->sfree(mylines);
+
+  } else {
+    while (nread < nbonds) {
+      nchunk = MIN(nbonds - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      if (blabelflag && !lmap->is_complete(Atom::BOND))
+        error->all(FLERR,
+                   "Label map is incomplete: "
+                   "all types must be assigned a unique type label");
+      atom->data_bonds(nchunk, buffer, count, id_offset, boffset, blabelflag,
+                       lmap->lmap2lmap.bond, 0);
+      nread += nchunk;
+    }
   }
 
   // if firstpass: tally max bond/atom and return
@@ -2534,6 +2619,304 @@ void ReadData::skip_lines(bigint n)
   if (eof == nullptr) error->one(FLERR, "Unexpected end of data file");
 }
 
+/* ----------------------------------------------------------------------
+   read N lines of a section in parallel, each proc gets a contiguous share
+   proc 0 finds the byte range of the section and skips over it in fp
+   all procs read their share of the range via MPI-IO
+   a line belongs to the proc whose share contains the first byte of the line
+   return # of lines read by this proc in buf, each terminated by a newline
+   buf is allocated here and must be freed by caller with memory->sfree()
+------------------------------------------------------------------------- */
+
+int ReadData::read_lines_parallel(bigint n, char *&buf)
+{
+  bigint range[2] = {0, -1};
+
+  if (me == 0) {
+    range[0] = platform::ftell(fp);
+    std::vector<char> block(CHUNK * MAXLINE);
+    bigint where = range[0];
+    bigint lastline = range[0];
+    bigint nfound = 0;
+    while (nfound < n) {
+      size_t nbytes = fread(block.data(), sizeof(char), block.size(), fp);
+      if (nbytes == 0) break;
+      char *ptr = block.data();
+      char *end = ptr + nbytes;
+      while ((nfound < n) && (ptr < end)) {
+        auto newline = (char *) memchr(ptr, '\n', end - ptr);
+        if (!newline) break;
+        ptr = newline + 1;
+        lastline = where + (ptr - block.data());
+        nfound++;
+      }
+      where += nbytes;
+    }
+
+    // last line of the file may lack a newline
+
+    if (nfound == n)
+      range[1] = lastline;
+    else if ((nfound == n - 1) && (where > lastline))
+      range[1] = where;
+    if (range[1] >= 0) platform::fseek(fp, range[1]);
+  }
+
+  MPI_Bcast(range, 2, MPI_LMP_BIGINT, 0, world);
+  if (range[1] < 0) error->all(FLERR, "Unexpected end of data file");
+
+  MPI_File fh;
+  int err = MPI_File_open(world, (char *) datafile.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+  int errall;
+  MPI_Allreduce(&err, &errall, 1, MPI_INT, MPI_MAX, world);
+  if (errall != MPI_SUCCESS)
+    error->all(FLERR, "Cannot open data file {} for parallel reading", datafile);
+
+  // my share of the range, plus the byte preceding it to detect a line start
+
+  const int nprocs = comm->nprocs;
+  const bigint length = range[1] - range[0];
+  const bigint lo = range[0] + length * me / nprocs;
+  const bigint hi = range[0] + length * (me + 1) / nprocs;
+  const bigint first = (lo > range[0]) ? lo - 1 : lo;
+  bigint nbytes = hi - first;
+
+  // collective reads in pieces that fit into an int count
+
+  const bigint maxbytes = MAXSMALLINT / 2;
+  bigint ncall = (nbytes + maxbytes - 1) / maxbytes;
+  bigint maxcall;
+  MPI_Allreduce(&ncall, &maxcall, 1, MPI_LMP_BIGINT, MPI_MAX, world);
+
+  bigint maxbuf = nbytes + MAXLINE + 2;
+  buf = (char *) memory->smalloc(maxbuf, "read_data:buf");
+  int io_error = 0;
+  bigint nread = 0;
+  for (bigint icall = 0; icall < maxcall; icall++) {
+    int count = MIN(nbytes - nread, maxbytes);
+    MPI_Status status;
+    if (MPI_File_read_at_all(fh, first + nread, buf + nread, count, MPI_CHAR, &status) !=
+        MPI_SUCCESS)
+      io_error = 1;
+    nread += count;
+  }
+
+  // skip the partial line at the start, it belongs to the previous proc
+
+  bigint start = 0;
+  if (lo > range[0]) {
+    auto newline = (char *) memchr(buf, '\n', nbytes);
+    start = newline ? (newline - buf) + 1 : nbytes;
+  }
+
+  // complete my last line with bytes beyond my share, read independently
+
+  bigint end = nbytes;
+  if ((start < nbytes) && (buf[nbytes - 1] != '\n')) {
+    bigint where = hi;
+    bool done = false;
+    while (!done && (where < range[1])) {
+      int count = MIN(range[1] - where, MAXLINE);
+      if (end + count + 1 > maxbuf) {
+        maxbuf += MAXLINE * (bigint) CHUNK;
+        buf = (char *) memory->srealloc(buf, maxbuf, "read_data:buf");
+      }
+      MPI_Status status;
+      if (MPI_File_read_at(fh, where, buf + end, count, MPI_CHAR, &status) != MPI_SUCCESS) {
+        io_error = 1;
+        break;
+      }
+      auto newline = (char *) memchr(buf + end, '\n', count);
+      if (newline) {
+        count = (newline - (buf + end)) + 1;
+        done = true;
+      }
+      end += count;
+      where += count;
+    }
+  }
+  MPI_File_close(&fh);
+
+  int io_errorall;
+  MPI_Allreduce(&io_error, &io_errorall, 1, MPI_INT, MPI_MAX, world);
+  if (io_errorall) error->all(FLERR, "Error reading data file {} in parallel", datafile);
+
+  // move my lines to the start of buf, terminate last line, and count them
+
+  int nlines = 0;
+  if (start < end) {
+    memmove(buf, buf + start, end - start);
+    end -= start;
+    if (buf[end - 1] != '\n') buf[end++] = '\n';
+    for (bigint i = 0; i < end; i++)
+      if (buf[i] == '\n') nlines++;
+  } else
+    end = 0;
+  buf[end] = '\0';
+
+  bigint mylines = nlines;
+  bigint alllines;
+  MPI_Allreduce(&mylines, &alllines, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  if (alllines != n)
+    error->all(FLERR, "Read {} lines instead of {} in parallel read of data file", alllines, n);
+
+  return nlines;
+}
+
+/* ----------------------------------------------------------------------
+   send N lines in buf to the procs that own the atoms they refer to
+   atom IDs are in columns cols[0..ncol-1] of each line
+   a rendezvous decomposition by atom ID first collects the owning proc of
+     each atom ID, then forwards each line to the owner(s)
+   lines that are blank or refer to no owned atom stay with the rendezvous proc,
+     so invalid lines are still reported by the caller
+   return # of lines received in outbuf, ordered as in the file, each
+     terminated by a newline, outbuf must be freed by caller with memory->sfree()
+------------------------------------------------------------------------- */
+
+struct OwnerRvous {
+  tagint atomID;
+  int proc;
+};
+
+struct LineRvous {
+  bigint lineID;
+  tagint atomID;
+  int proc;
+  char line[MAXLINE];
+};
+
+int ReadData::route_lines(int n, char *buf, int ncol, const int *cols, char *&outbuf)
+{
+  const int nprocs = comm->nprocs;
+  int nlocal = atom->nlocal;
+  tagint *tag = atom->tag;
+
+  // 1st rendezvous: atom ID and owning proc of each of my atoms
+
+  int *proclist;
+  memory->create(proclist, MAX(nlocal, ncol * n), "read_data:proclist");
+  auto inbuf = (OwnerRvous *) memory->smalloc((bigint) nlocal * sizeof(OwnerRvous),
+                                              "read_data:inbuf");
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    inbuf[i].atomID = tag[i];
+    inbuf[i].proc = me;
+  }
+
+  char *dummy;
+  rvous_owner.clear();
+  comm->rendezvous(RVOUS, nlocal, (char *) inbuf, sizeof(OwnerRvous), 0, proclist, rendezvous_owners,
+                   0, dummy, 0, (void *) this);
+  memory->sfree(inbuf);
+
+  // 2nd rendezvous: each line with a global line ID, once per atom ID column
+
+  bigint mylines = n;
+  bigint lineoffset = 0;
+  MPI_Exscan(&mylines, &lineoffset, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  if (me == 0) lineoffset = 0;
+
+  auto linebuf = (LineRvous *) memory->smalloc((bigint) ncol * n * sizeof(LineRvous),
+                                               "read_data:linebuf");
+  int nsend = 0;
+  char *next;
+  for (int i = 0; i < n; i++) {
+    next = strchr(buf, '\n');
+    *next = '\0';
+    if (strlen(buf) >= MAXLINE)
+      error->one(FLERR, "Line in data file is too long: {}", utils::trim(buf));
+    auto values = Tokenizer(utils::trim_comment(buf)).as_vector();
+    for (int icol = 0; icol < ncol; icol++) {
+      tagint atomID = 0;
+      if ((int) values.size() > cols[icol])
+        atomID = utils::tnumeric(FLERR, values[cols[icol]], true, lmp) + id_offset;
+      else if (icol > 0)
+        break;
+      proclist[nsend] = (atomID > 0) ? atomID % nprocs : me;
+      linebuf[nsend].lineID = lineoffset + i;
+      linebuf[nsend].atomID = atomID;
+      linebuf[nsend].proc = me;
+      strcpy(linebuf[nsend].line, buf);
+      nsend++;
+    }
+    buf = next + 1;
+  }
+
+  char *recvbuf;
+  int nrecv = comm->rendezvous(RVOUS, nsend, (char *) linebuf, sizeof(LineRvous), 0, proclist,
+                               rendezvous_lines, 0, recvbuf, sizeof(LineRvous), (void *) this);
+  memory->destroy(proclist);
+  memory->sfree(linebuf);
+  rvous_owner.clear();
+
+  // restore file order and drop duplicates, which occur when one proc owns several atoms of a line
+
+  auto recvlines = (LineRvous *) recvbuf;
+  std::vector<int> order(nrecv);
+  for (int i = 0; i < nrecv; i++) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&](int a, int b) { return recvlines[a].lineID < recvlines[b].lineID; });
+
+  outbuf = (char *) memory->smalloc((bigint) nrecv * (MAXLINE + 1) + 1, "read_data:outbuf");
+  char *ptr = outbuf;
+  int nout = 0;
+  for (int i = 0; i < nrecv; i++) {
+    if ((i > 0) && (recvlines[order[i]].lineID == recvlines[order[i - 1]].lineID)) continue;
+    int len = strlen(recvlines[order[i]].line);
+    memcpy(ptr, recvlines[order[i]].line, len);
+    ptr += len;
+    *ptr++ = '\n';
+    nout++;
+  }
+  *ptr = '\0';
+  memory->sfree(recvbuf);
+
+  return nout;
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() for 1st stage of route_lines()
+   store owning proc of each atom ID assigned to this rendezvous proc
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_owners(int n, char *inbuf, int &flag, int *& /*proclist*/,
+                                char *& /*outbuf*/, void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (OwnerRvous *) inbuf;
+
+  rptr->rvous_owner.reserve(n);
+  for (int i = 0; i < n; i++) rptr->rvous_owner[in[i].atomID] = in[i].proc;
+
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() for 2nd stage of route_lines()
+   send each line to the owner of its atom ID,
+     or keep it here if the atom ID is not owned by any proc
+------------------------------------------------------------------------- */
+
+int ReadData::rendezvous_lines(int n, char *inbuf, int &flag, int *&proclist, char *&outbuf,
+                               void *ptr)
+{
+  auto rptr = (ReadData *) ptr;
+  auto in = (LineRvous *) inbuf;
+  auto &owner = rptr->rvous_owner;
+
+  rptr->memory->create(proclist, n, "read_data:proclist");
+  for (int i = 0; i < n; i++) {
+    auto found = owner.find(in[i].atomID);
+    proclist[i] = (found != owner.end()) ? found->second : rptr->me;
+  }
+
+  outbuf = inbuf;
+  flag = 1;
+  return n;
+}
+
 /* ----------------------------------------------------------------------
    parse a line of coeffs into words, storing them in ncoeffarg,coeffarg
    trim anything from '#' onward
@@ -22,6 +22,8 @@ CommandStyle(read_data,ReadData);
 
 #include "command.h"
 
+#include <unordered_map>
+
 namespace LAMMPS_NS {
 class Fix;
 class ReadData : public Command {
@@ -80,6 +82,8 @@ class ReadData : public Command {
   int extra_atom_types, extra_bond_types, extra_angle_types;
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
+  int parallelflag;
+  std::string datafile;
 
   int nfix;
   Fix **fix_index;
@@ -94,6 +98,8 @@ class ReadData : public Command {
   void header(int);
   void parse_keyword(int);
   void skip_lines(bigint);
+  int read_lines_parallel(bigint, char *&);
+  int route_lines(int, char *, int, const int *, char *&);
   void parse_coeffs(char *, const char *, int, int, int, int, int *);
   int style_match(const char *, const char *);
 
@@ -119,6 +125,13 @@ class ReadData : public Command {
   void typelabels(int);
 
   void fix(Fix *, char *);
+
+  // owning proc of atom IDs in rendezvous decomposition, used by route_lines()
+
+  std::unordered_map<tagint, int> rvous_owner;
+
+  static int rendezvous_owners(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_lines(int, char *, int &, int *&, char *&, void *);
 };
 
 }    // namespace LAMMPS_NS
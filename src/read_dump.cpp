@@ -241,6 +241,10 @@ void ReadDump::setup_reader(int narg, char **arg)
       filereader = 1;
   }
 
+  if (indexflag && filereader)
+    for (int i = 0; i < nreader; i++)
+      readers[i]->set_index(true);
+
   // pass any arguments to readers
 
   if (narg > 0 && filereader)
@@ -1196,6 +1200,7 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
   for (int i = 0; i < nfield; i++) fieldlabel[i] = nullptr;
   scaleflag = 0;
   wrapflag = 1;
+  indexflag = 0;
 
   while (iarg < narg) {
     if (strcmp(arg[iarg],"nfile") == 0) {
@@ -1248,6 +1253,10 @@ int ReadDump::fields_and_keywords(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump wrapped", error);
       wrapflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"index") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump index", error);
+      indexflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg],"format") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "read_dump format", error);
       delete[] readerstyle;
@@ -64,6 +64,7 @@ class ReadDump : public Command {
   int trimflag, purgeflag;
   int scaleflag;        // user 0/1 if dump file coords are unscaled/scaled
   int wrapflag;         // user 0/1 if dump file coords are unwrapped/wrapped
+  int indexflag;        // 1 if readers locate snapshots via timestep index
   char *readerstyle;    // style of dump files to read
 
   int nnew;             // # of dump file atoms this proc owns
@@ -41,6 +41,10 @@
 
 using namespace LAMMPS_NS;
 
+// max # of doubles in one MPI-IO call, so that counts fit into an int
+
+static constexpr int MAXCHUNK = 1 << 27;
+
 /* ---------------------------------------------------------------------- */
 
 ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp) {}
@@ -88,8 +92,10 @@ void ReadRestart::command(int narg, char **arg)
 
   if (strchr(arg[0],'%')) multiproc = 1;
   else multiproc = 0;
-  if (utils::strmatch(arg[0],"\\.mpiio"))
-    error->all(FLERR,"MPI-IO files are no longer supported by LAMMPS");
+  if (utils::strmatch(arg[0],"\\.mpiio$")) mpiioflag = 1;
+  else mpiioflag = 0;
+  if (multiproc && mpiioflag)
+    error->all(FLERR,"Restart file name cannot use both % and .mpiio");
 
   // open single restart file or base file for multiproc case
 
@@ -158,12 +164,16 @@ void ReadRestart::command(int narg, char **arg)
 
   file_layout();
 
-  // close header file if in multiproc mode
+  // close header file if in multiproc or MPI-IO mode
+  // for MPI-IO, per-proc data starts right after the header
 
-  if (multiproc && me == 0) {
+  bigint header_size = 0;
+  if ((multiproc || mpiioflag) && me == 0) {
+    header_size = platform::ftell(fp);
     fclose(fp);
     fp = nullptr;
   }
+  if (mpiioflag) MPI_Bcast(&header_size,1,MPI_LMP_BIGINT,0,world);
 
   // read per-proc info
 
@@ -173,6 +183,18 @@ void ReadRestart::command(int narg, char **arg)
   double *buf = nullptr;
   int m,flag;
 
+  // input of single MPI-IO file
+  // each proc reads a contiguous range of per-proc chunks with collective reads
+  // each proc keeps all atoms it read, they are migrated below
+
+  if (mpiioflag) {
+    bigint nread;
+    read_mpiio(file,header_size,buf,nread);
+
+    bigint mbig = 0;
+    while (mbig < nread) mbig += avec->unpack_restart(&buf[mbig]);
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -180,7 +202,7 @@ void ReadRestart::command(int narg, char **arg)
   // if remapflag set, remap the atom to box before checking sub-domain
   // check for atom in sub-domain differs for orthogonal vs triclinic box
 
-  if (multiproc == 0) {
+  else if (multiproc == 0) {
 
     int triclinic = domain->triclinic;
     imageint *iptr;
@@ -379,7 +401,7 @@ void ReadRestart::command(int narg, char **arg)
   // for multiproc or MPI-IO files:
   // perform irregular comm to migrate atoms to correct procs
 
-  if (multiproc) {
+  if (multiproc || mpiioflag) {
 
     // if remapflag set, remap all atoms I read back to box before migrating
 
@@ -813,6 +835,8 @@ void ReadRestart::header()
       atom->sortfreq = read_int();
     } else if (flag == ATOM_SORTBIN) {
       atom->userbinsize = read_double();
+    } else if (flag == ATOM_SORTORDER) {
+      atom->sortorder = read_int();
 
     } else if (flag == COMM_MODE) {
       comm->mode = read_int();
@@ -955,6 +979,9 @@ void ReadRestart::force_fields()
 
 void ReadRestart::file_layout()
 {
+  mpiio_file = 0;
+  chunk_sizes.clear();
+
   int flag = read_int();
   while (flag >= 0) {
 
@@ -964,9 +991,78 @@ void ReadRestart::file_layout()
         error->all(FLERR,"Restart file is not a multi-proc file");
       if (multiproc && multiproc_file == 0)
         error->all(FLERR,"Restart file is a multi-proc file");
+
+    } else if (flag == MPIIO) {
+      mpiio_file = read_int();
+
+    } else if (flag == PROCSPERFILE) {
+      int n = read_int();
+      if (n < 0) error->all(FLERR,"Invalid MPI-IO layout in restart file");
+      chunk_sizes.resize(n);
+      read_bigint_vec(n,chunk_sizes.data());
     }
     flag = read_int();
   }
+
+  if (mpiioflag == 0 && mpiio_file)
+    error->all(FLERR,"Restart file is a MPI-IO file, its name must end in .mpiio");
+  if (mpiioflag && mpiio_file == 0)
+    error->all(FLERR,"Restart file is not a MPI-IO file");
+  if (mpiioflag && chunk_sizes.empty())
+    error->all(FLERR,"Invalid MPI-IO layout in restart file");
+}
+
+/* ----------------------------------------------------------------------
+   read per-proc chunks of a MPI-IO restart file in parallel
+   chunks of the procs which wrote the file are split into contiguous
+     ranges of whole chunks, one for each proc reading the file
+   header_size = # of bytes before the first chunk
+   return buf with all data read by this proc and its # of doubles
+------------------------------------------------------------------------- */
+
+void ReadRestart::read_mpiio(const std::string &file, bigint header_size,
+                             double *&buf, bigint &nread)
+{
+  int nchunks = chunk_sizes.size();
+  int ifirst = static_cast<int> ((bigint) me * nchunks / nprocs);
+  int ilast = static_cast<int> ((bigint) (me+1) * nchunks / nprocs);
+
+  bigint offset = 0;
+  for (int i = 0; i < ifirst; i++) offset += chunk_sizes[i];
+  nread = 0;
+  for (int i = ifirst; i < ilast; i++) nread += chunk_sizes[i];
+
+  buf = (double *) memory->smalloc(MAX(nread,1)*sizeof(double),"read_restart:buf");
+
+  MPI_File fh;
+  int err = MPI_File_open(world,file.c_str(),MPI_MODE_RDONLY,MPI_INFO_NULL,&fh);
+  int err_any;
+  MPI_Allreduce(&err,&err_any,1,MPI_INT,MPI_MAX,world);
+  if (err_any != MPI_SUCCESS) {
+    if (err == MPI_SUCCESS) MPI_File_close(&fh);
+    error->all(FLERR,"Cannot open MPI-IO restart file {}",file);
+  }
+
+  // collective reads in pieces of at most MAXCHUNK doubles
+  // all procs must make the same # of calls
+
+  int io_error = 0;
+  bigint ncall = (nread + MAXCHUNK - 1) / MAXCHUNK;
+  bigint maxcall;
+  MPI_Allreduce(&ncall,&maxcall,1,MPI_LMP_BIGINT,MPI_MAX,world);
+
+  for (bigint i = 0; i < maxcall; i++) {
+    bigint first = MIN(i * MAXCHUNK,nread);
+    int count = static_cast<int> (MIN(nread - first,MAXCHUNK));
+    MPI_Offset where = header_size + (offset + first) * sizeof(double);
+    if (MPI_File_read_at_all(fh,where,&buf[first],count,MPI_DOUBLE,MPI_STATUS_IGNORE)
+        != MPI_SUCCESS) io_error = 1;
+  }
+  MPI_File_close(&fh);
+
+  int io_all;
+  MPI_Allreduce(&io_error,&io_all,1,MPI_INT,MPI_MAX,world);
+  if (io_all) error->all(FLERR,"I/O error while reading MPI-IO restart file {}",file);
 }
 
 // ----------------------------------------------------------------------
@@ -1069,6 +1165,17 @@ bigint ReadRestart::read_bigint()
   return value;
 }
 
+/* ----------------------------------------------------------------------
+   read a bigint vector from restart file and bcast it
+------------------------------------------------------------------------- */
+
+void ReadRestart::read_bigint_vec(int n, bigint *vec)
+{
+  if (n < 0) error->all(FLERR,"Illegal size bigint vector read requested");
+  if (me == 0) utils::sfread(FLERR,vec,sizeof(bigint),n,fp,nullptr,error);
+  MPI_Bcast(vec,n,MPI_LMP_BIGINT,0,world);
+}
+
 /* ----------------------------------------------------------------------
    read a double from restart file and bcast it
 ------------------------------------------------------------------------- */
@@ -22,6 +22,8 @@ CommandStyle(read_restart,ReadRestart);
 
 #include "command.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class ReadRestart : public Command {
@@ -36,6 +38,9 @@ class ReadRestart : public Command {
   int multiproc;         // 0 = restart file is a single file
                          // 1 = restart file is parallel (multiple files)
   int multiproc_file;    // # of parallel files in restart
+  int mpiioflag;         // 1 = restart file is read with MPI-IO
+  int mpiio_file;        // 1 = restart file was written with MPI-IO
+  std::vector<bigint> chunk_sizes;    // # of doubles written by each proc with MPI-IO
   int nprocs_file;       // total # of procs that wrote restart file
   int revision;          // revision number of the restart file format
 
@@ -49,12 +54,14 @@ class ReadRestart : public Command {
   void format_revision();
   void check_eof_magic();
   void file_layout();
+  void read_mpiio(const std::string &, bigint, double *&, bigint &);
 
   int read_int();
   bigint read_bigint();
   double read_double();
   char *read_string();
   void read_int_vec(int, int *);
+  void read_bigint_vec(int, bigint *);
   void read_double_vec(int, double *);
 };
 
@@ -26,6 +26,7 @@ Reader::Reader(LAMMPS *lmp) : Pointers(lmp)
   fp = nullptr;
   binary = false;
   compressed = false;
+  indexflag = false;
 }
 
 // avoid resource leak
@@ -84,3 +85,151 @@ void Reader::settings(int narg, char ** /*args*/)
 {
   if (narg > 0) error->all(FLERR, "Illegal read_dump command");
 }
+
+/* ----------------------------------------------------------------------
+   match each of Nfield requested fields to a per-atom column label
+   labels = map of column labels in dump file to their column index
+   if fieldlabel set, match with explicit column
+   else infer one or more column matches from fieldtype
+   xyz flag set by scaleflag + wrapflag (if fieldlabel set) or column label
+   store column index of each field in fieldindex, -1 if not found
+   return 0 if all fields were found, -1 otherwise
+------------------------------------------------------------------------- */
+
+int Reader::match_fields(const std::map<std::string, int> &labels, int nfield, int *fieldtype,
+                         char **fieldlabel, int scaleflag, int wrapflag, int *fieldindex,
+                         int &xflag, int &yflag, int &zflag)
+{
+  // nwords = one past the largest column index, used as "not found" marker
+
+  int nwords = 0;
+  for (const auto &label : labels) nwords = MAX(nwords, label.second + 1);
+
+  int s_index,u_index,su_index;
+  xflag = UNSET;
+  yflag = UNSET;
+  zflag = UNSET;
+
+  for (int i = 0; i < nfield; i++) {
+    if (fieldlabel[i]) {
+      fieldindex[i] = find_label(fieldlabel[i], labels);
+      if (fieldtype[i] == X) xflag = 2*scaleflag + wrapflag + 1;
+      else if (fieldtype[i] == Y) yflag = 2*scaleflag + wrapflag + 1;
+      else if (fieldtype[i] == Z) zflag = 2*scaleflag + wrapflag + 1;
+    }
+
+    else if (fieldtype[i] == ID)
+      fieldindex[i] = find_label("id", labels);
+    else if (fieldtype[i] == TYPE)
+      fieldindex[i] = find_label("type", labels);
+
+    else if (fieldtype[i] == X) {
+      fieldindex[i] = find_label("x", labels);
+      xflag = NOSCALE_WRAP;
+      if (fieldindex[i] < 0) {
+        fieldindex[i] = nwords;
+        s_index = find_label("xs", labels);
+        u_index = find_label("xu", labels);
+        su_index = find_label("xsu", labels);
+        if (s_index >= 0 && s_index < fieldindex[i]) {
+          fieldindex[i] = s_index;
+          xflag = SCALE_WRAP;
+        }
+        if (u_index >= 0 && u_index < fieldindex[i]) {
+          fieldindex[i] = u_index;
+          xflag = NOSCALE_NOWRAP;
+        }
+        if (su_index >= 0 && su_index < fieldindex[i]) {
+          fieldindex[i] = su_index;
+          xflag = SCALE_NOWRAP;
+        }
+      }
+      if (fieldindex[i] == nwords) fieldindex[i] = -1;
+
+    } else if (fieldtype[i] == Y) {
+      fieldindex[i] = find_label("y", labels);
+      yflag = NOSCALE_WRAP;
+      if (fieldindex[i] < 0) {
+        fieldindex[i] = nwords;
+        s_index = find_label("ys", labels);
+        u_index = find_label("yu", labels);
+        su_index = find_label("ysu", labels);
+        if (s_index >= 0 && s_index < fieldindex[i]) {
+          fieldindex[i] = s_index;
+          yflag = SCALE_WRAP;
+        }
+        if (u_index >= 0 && u_index < fieldindex[i]) {
+          fieldindex[i] = u_index;
+          yflag = NOSCALE_NOWRAP;
+        }
+        if (su_index >= 0 && su_index < fieldindex[i]) {
+          fieldindex[i] = su_index;
+          yflag = SCALE_NOWRAP;
+        }
+      }
+      if (fieldindex[i] == nwords) fieldindex[i] = -1;
+
+    } else if (fieldtype[i] == Z) {
+      fieldindex[i] = find_label("z", labels);
+      zflag = NOSCALE_WRAP;
+      if (fieldindex[i] < 0) {
+        fieldindex[i] = nwords;
+        s_index = find_label("zs", labels);
+        u_index = find_label("zu", labels);
+        su_index = find_label("zsu", labels);
+        if (s_index >= 0 && s_index < fieldindex[i]) {
+          fieldindex[i] = s_index;
+          zflag = SCALE_WRAP;
+        }
+        if (u_index >= 0 && u_index < fieldindex[i]) {
+          fieldindex[i] = u_index;
+          zflag = NOSCALE_NOWRAP;
+        }
+        if (su_index >= 0 && su_index < fieldindex[i]) {
+          fieldindex[i] = su_index;
+          zflag = SCALE_NOWRAP;
+        }
+      }
+      if (fieldindex[i] == nwords) fieldindex[i] = -1;
+
+    } else if (fieldtype[i] == VX)
+      fieldindex[i] = find_label("vx", labels);
+    else if (fieldtype[i] == VY)
+      fieldindex[i] = find_label("vy", labels);
+    else if (fieldtype[i] == VZ)
+      fieldindex[i] = find_label("vz", labels);
+
+    else if (fieldtype[i] == FX)
+      fieldindex[i] = find_label("fx", labels);
+    else if (fieldtype[i] == FY)
+      fieldindex[i] = find_label("fy", labels);
+    else if (fieldtype[i] == FZ)
+      fieldindex[i] = find_label("fz", labels);
+
+    else if (fieldtype[i] == Q)
+      fieldindex[i] = find_label("q", labels);
+
+    else if (fieldtype[i] == IX)
+      fieldindex[i] = find_label("ix", labels);
+    else if (fieldtype[i] == IY)
+      fieldindex[i] = find_label("iy", labels);
+    else if (fieldtype[i] == IZ)
+      fieldindex[i] = find_label("iz", labels);
+  }
+
+  for (int i = 0; i < nfield; i++)
+    if (fieldindex[i] < 0) return -1;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   match label to any of N labels
+   return index of match or -1 if no match
+------------------------------------------------------------------------- */
+
+int Reader::find_label(const std::string &label, const std::map<std::string, int> &labels)
+{
+  auto it = labels.find(label);
+  if (it != labels.end()) return it->second;
+  return -1;
+}
@@ -18,6 +18,8 @@
 
 #include "pointers.h"
 
+#include <map>
+
 namespace LAMMPS_NS {
 
 class Reader : protected Pointers {
@@ -39,10 +41,17 @@ class Reader : protected Pointers {
   virtual void open_file(const std::string &);
   virtual void close_file();
 
+  void set_index(bool flag) { indexflag = flag; }
+
  protected:
   FILE *fp;           // pointer to opened file or pipe
   bool compressed;    // flag for dump file compression
   bool binary;        // flag for (native) binary files
+  bool indexflag;     // flag for using a timestep -> file offset index
+
+  int match_fields(const std::map<std::string, int> &, int, int *, char **, int, int, int *,
+                   int &, int &, int &);
+  static int find_label(const std::string &, const std::map<std::string, int> &);
 };
 
 }    // namespace LAMMPS_NS
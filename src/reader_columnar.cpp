@@ -0,0 +1,325 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "reader_columnar.h"
+
+#include "dump_columnar.h"
+#include "error.h"
+#include "memory.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+
+#if defined(LAMMPS_ZSTD)
+#include <zstd.h>
+#endif
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::ReaderColumnar(LAMMPS *lmp) :
+    Reader(lmp), iframe(0), natoms(0), iatom(0), fieldindex(nullptr)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderColumnar::~ReaderColumnar()
+{
+  memory->destroy(fieldindex);
+}
+
+/* ----------------------------------------------------------------------
+   open file, check its file header and collect the offsets of all frames
+   from the frame index or, if it is missing, by stepping through the frames
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::open_file(const std::string &file)
+{
+  if (fp != nullptr) close_file();
+
+  compressed = false;
+  binary = true;
+  fp = fopen(file.c_str(), "rb");
+  if (!fp) error->one(FLERR, "Cannot open file {}: {}", file, utils::getsyserror());
+
+  char magic[16];
+  int endian, revision, len;
+  read_buf(magic, sizeof(char), sizeof(magic));
+  magic[sizeof(magic) - 1] = '\0';
+  if (strcmp(magic, DumpColumnar::MAGIC_STRING) != 0)
+    error->one(FLERR, "File {} is not a columnar dump file", file);
+  read_buf(&endian, sizeof(int), 1);
+  read_buf(&revision, sizeof(int), 1);
+  if (endian != DumpColumnar::ENDIAN)
+    error->one(FLERR, "Columnar dump file {} has incompatible byte order", file);
+  if (revision > DumpColumnar::FORMAT_REVISION)
+    error->one(FLERR, "Columnar dump file {} has unsupported format revision {}", file, revision);
+  read_buf(&len, sizeof(int), 1);
+  if (len < 0) error->one(FLERR, "Columnar dump file {} is invalid or corrupted", file);
+  std::string units(len, '\0');
+  read_buf(&units[0], sizeof(char), len);
+
+  bigint first = platform::ftell(fp);
+  platform::fseek(fp, platform::END_OF_FILE);
+  bigint filesize = platform::ftell(fp);
+
+  index_step.clear();
+  index_offset.clear();
+  iframe = 0;
+
+  // use frame index if trailer is present and consistent, else scan frames
+
+  bigint where = -1;
+  if (filesize - first >= (bigint) (2 * sizeof(bigint))) {
+    char tag[8];
+    platform::fseek(fp, filesize - 16);
+    read_buf(&where, sizeof(bigint), 1);
+    read_buf(tag, sizeof(char), 8);
+    if ((strncmp(tag, DumpColumnar::INDEX_MAGIC, 8) != 0) || (where < first) ||
+        (where > filesize - 16 - (bigint) sizeof(bigint)))
+      where = -1;
+  }
+
+  if (where >= 0) read_index(where);
+  else scan_frames(first, filesize);
+}
+
+/* ----------------------------------------------------------------------
+   read and return time stamp of next frame
+   return 1 if no frames are left, so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderColumnar::read_time(bigint &ntimestep)
+{
+  if (iframe >= (bigint) index_step.size()) return 1;
+  ntimestep = index_step[iframe];
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip frame, no need to touch the file since all offsets are known
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::skip()
+{
+  iframe++;
+}
+
+/* ----------------------------------------------------------------------
+   read remaining header info of current frame and column directory:
+     return natoms
+     box bounds, triclinic (inferred), fieldflag (1 if any fields not found),
+     xyz flags = from input scaleflag & wrapflag
+   if fieldflag set:
+     match Nfield fields to per-atom column labels
+     allocate and set fieldindex = which column each field maps to
+     fieldtype = X,VX,IZ etc
+     fieldlabel = user-specified label or nullptr if use fieldtype default
+   xyz flags = scaleflag+wrapflag if has fieldlabel name,
+     else set by x,xs,xu,xsu
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderColumnar::read_header(double box[3][3], int &boxinfo, int &triclinic, int fieldinfo,
+                                   int nfield, int *fieldtype, char **fieldlabel, int scaleflag,
+                                   int wrapflag, int &fieldflag, int &xflag, int &yflag, int &zflag)
+{
+  bigint framesize, ntimestep;
+  double time, boxinfo9[9];
+  int boundary[3][2], ncol;
+
+  platform::fseek(fp, index_offset[iframe]);
+  read_buf(&framesize, sizeof(bigint), 1);
+  read_buf(&ntimestep, sizeof(bigint), 1);
+  read_buf(&natoms, sizeof(bigint), 1);
+  read_buf(&time, sizeof(double), 1);
+  read_buf(&triclinic, sizeof(int), 1);
+  read_buf(&boundary[0][0], sizeof(int), 6);
+  read_buf(boxinfo9, sizeof(double), 9);
+  read_buf(&ncol, sizeof(int), 1);
+  if ((natoms < 0) || (ncol <= 0)) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  boxinfo = 1;
+  for (int i = 0; i < 3; i++) {
+    box[i][0] = boxinfo9[2 * i];
+    box[i][1] = boxinfo9[2 * i + 1];
+    box[i][2] = triclinic ? boxinfo9[6 + i] : 0.0;
+  }
+
+  // column directory, the encoded column data follows in the same order
+
+  std::map<std::string, int> labels;
+  coltype.resize(ncol);
+  colencoding.resize(ncol);
+  colbytes.resize(ncol);
+  coloffset.resize(ncol);
+  for (int icol = 0; icol < ncol; icol++) {
+    int len;
+    read_buf(&len, sizeof(int), 1);
+    if (len < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+    std::string label(len, '\0');
+    read_buf(&label[0], sizeof(char), len);
+    labels[label] = icol;
+    read_buf(&coltype[icol], sizeof(int), 1);
+    read_buf(&colencoding[icol], sizeof(int), 1);
+    read_buf(&colbytes[icol], sizeof(bigint), 1);
+  }
+  bigint offset = platform::ftell(fp);
+  for (int icol = 0; icol < ncol; icol++) {
+    coloffset[icol] = offset;
+    offset += colbytes[icol];
+  }
+
+  iframe++;
+  iatom = 0;
+  coldata.clear();
+  coldata.resize(ncol);
+
+  if (!fieldinfo) return natoms;
+
+  // match each field with a column of per-atom data
+
+  memory->destroy(fieldindex);
+  memory->create(fieldindex, nfield, "read_dump:fieldindex");
+
+  fieldflag = match_fields(labels, nfield, fieldtype, fieldlabel, scaleflag, wrapflag, fieldindex,
+                           xflag, yflag, zflag);
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read N atom lines from current frame
+   store their field values in fields, in order of requested fields
+   only the columns of requested fields are read and decoded
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_atoms(int n, int nfield, double **fields)
+{
+  if (iatom + n > natoms) error->one(FLERR, "Unexpected end of dump file");
+
+  for (int k = 0; k < nfield; k++)
+    if (coldata[fieldindex[k]].empty() && natoms) decode_column(fieldindex[k]);
+
+  for (int i = 0; i < n; i++) {
+    for (int k = 0; k < nfield; k++) fields[i][k] = coldata[fieldindex[k]][iatom];
+    iatom++;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ReaderColumnar::read_buf(void *ptr, size_t size, size_t count)
+{
+  utils::sfread(FLERR, ptr, size, count, fp, nullptr, error);
+}
+
+/* ----------------------------------------------------------------------
+   read frame index stored at offset where
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::read_index(bigint where)
+{
+  bigint nframes;
+  platform::fseek(fp, where);
+  read_buf(&nframes, sizeof(bigint), 1);
+  if (nframes < 0) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  index_step.resize(nframes);
+  index_offset.resize(nframes);
+  for (bigint i = 0; i < nframes; i++) {
+    read_buf(&index_step[i], sizeof(bigint), 1);
+    read_buf(&index_offset[i], sizeof(bigint), 1);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   build frame index by stepping through the frames from offset first
+   a truncated last frame is ignored
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::scan_frames(bigint first, bigint filesize)
+{
+  bigint pos = first;
+  bigint framesize, ntimestep;
+
+  while (pos + 2 * (bigint) sizeof(bigint) <= filesize) {
+    platform::fseek(fp, pos);
+    read_buf(&framesize, sizeof(bigint), 1);
+    read_buf(&ntimestep, sizeof(bigint), 1);
+    if ((framesize <= 0) || (pos + (bigint) sizeof(bigint) + framesize > filesize)) break;
+    index_step.push_back(ntimestep);
+    index_offset.push_back(pos);
+    pos += sizeof(bigint) + framesize;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   read column icol of current frame and undo its encoding
+------------------------------------------------------------------------- */
+
+void ReaderColumnar::decode_column(int icol)
+{
+  const bigint n = natoms;
+  const int encoding = colencoding[icol];
+  std::vector<char> blob(colbytes[icol]);
+  platform::fseek(fp, coloffset[icol]);
+  read_buf(blob.data(), sizeof(char), blob.size());
+
+  if (encoding & DumpColumnar::ZSTD) {
+#if defined(LAMMPS_ZSTD)
+    std::vector<char> raw(n * 8);
+    size_t nbytes = ZSTD_decompress(raw.data(), raw.size(), blob.data(), blob.size());
+    if (ZSTD_isError(nbytes))
+      error->one(FLERR, "Error decompressing dump columnar data: {}", ZSTD_getErrorName(nbytes));
+    raw.resize(nbytes);
+    blob.swap(raw);
+#else
+    error->one(FLERR, "Reading zstd compressed columnar dump files requires LAMMPS compiled "
+               "with zstd support");
+#endif
+  }
+  if ((bigint) blob.size() != n * 8) error->one(FLERR, "Dump file is invalid or corrupted");
+
+  std::vector<uint64_t> bits(n);
+  if (encoding & DumpColumnar::SHUFFLE) {
+    auto *dst = (unsigned char *) bits.data();
+    for (bigint i = 0; i < n; i++)
+      for (int b = 0; b < 8; b++) dst[i * 8 + b] = blob[b * n + i];
+  } else {
+    memcpy(bits.data(), blob.data(), n * 8);
+  }
+
+  if (encoding & DumpColumnar::DELTA) {
+    if (coltype[icol] == DumpColumnar::FLOAT64) {
+      for (bigint i = 1; i < n; i++) bits[i] ^= bits[i - 1];
+    } else {
+      for (bigint i = 1; i < n; i++) bits[i] += bits[i - 1];
+    }
+  }
+
+  auto &data = coldata[icol];
+  data.resize(n);
+  if (coltype[icol] == DumpColumnar::FLOAT64) {
+    memcpy(data.data(), bits.data(), n * 8);
+  } else {
+    for (bigint i = 0; i < n; i++) data[i] = static_cast<double>(static_cast<int64_t>(bits[i]));
+  }
+}
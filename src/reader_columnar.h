@@ -0,0 +1,67 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+// clang-format off
+ReaderStyle(columnar,ReaderColumnar);
+// clang-format on
+#else
+
+#ifndef LMP_READER_COLUMNAR_H
+#define LMP_READER_COLUMNAR_H
+
+#include "reader.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class ReaderColumnar : public Reader {
+ public:
+  ReaderColumnar(class LAMMPS *);
+  ~ReaderColumnar() override;
+
+  int read_time(bigint &) override;
+  void skip() override;
+  bigint read_header(double[3][3], int &, int &, int, int, int *, char **, int, int, int &, int &,
+                     int &, int &) override;
+  void read_atoms(int, int, double **) override;
+
+  void open_file(const std::string &) override;
+
+ private:
+  std::vector<bigint> index_step;      // timestep of each frame in file
+  std::vector<bigint> index_offset;    // file offset of each frame in file
+  bigint iframe;                       // index of next frame to be read
+
+  bigint natoms;     // # of atoms in current frame
+  bigint iatom;      // # of atoms of current frame passed to caller so far
+  int *fieldindex;   // column index of each requested field
+
+  std::vector<int> coltype;              // data type of each column in current frame
+  std::vector<int> colencoding;          // encoding flags of each column in current frame
+  std::vector<bigint> colbytes;          // # of bytes of each column in current frame
+  std::vector<bigint> coloffset;         // file offset of each column in current frame
+  std::vector<std::vector<double>> coldata;    // decoded data of requested columns
+
+  void read_buf(void *, size_t, size_t);
+  void read_index(bigint);
+  void scan_frames(bigint, bigint);
+  void decode_column(int);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
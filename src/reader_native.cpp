@@ -25,6 +25,7 @@
 using namespace LAMMPS_NS;
 
 static constexpr int MAXLINE = 1024;        // max line length in dump file
+static constexpr char INDEX_MAGIC[] = "LAMMPSDUMPINDEX";    // 16 chars incl. NUL
 
 /* ---------------------------------------------------------------------- */
 
@@ -34,6 +35,8 @@ ReaderNative::ReaderNative(LAMMPS *lmp) : Reader(lmp)
   fieldindex = nullptr;
   maxbuf = 0;
   databuf = nullptr;
+  useindex = false;
+  iframe = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -53,6 +56,11 @@ ReaderNative::~ReaderNative()
 
 int ReaderNative::read_time(bigint &ntimestep)
 {
+  if (useindex) {
+    if (iframe >= (bigint) index_step.size()) return 1;
+    platform::fseek(fp, index_offset[iframe]);
+  }
+
   if (binary) {
     int endian = 0x0001;
     revision = 0x0001;
@@ -109,6 +117,11 @@ int ReaderNative::read_time(bigint &ntimestep)
 
 void ReaderNative::skip()
 {
+  if (useindex) {
+    iframe++;
+    return;
+  }
+
   if (binary) {
     int triclinic;
     skip_buf(sizeof(bigint));
@@ -193,6 +206,8 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
   int len = 0;
   std::string labelline;
 
+  if (useindex) iframe++;
+
   if (binary) {
     read_buf(&natoms, sizeof(bigint), 1);
 
@@ -215,8 +230,14 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
     // extract column labels and match to requested fields
     read_buf(&size_one, sizeof(int), 1);
 
+    // without field info, the previous column matching still applies
+    // and the per-atom data of the snapshot still needs to be located
+
     if (!fieldinfo) {
       skip_reading_magic_str();
+      read_buf(&nchunk, sizeof(int), 1);
+      ichunk = 0;
+      iatom_chunk = 0;
       return natoms;
     }
 
@@ -309,123 +330,8 @@ bigint ReaderNative::read_header(double box[3][3], int &boxinfo, int &triclinic,
 
   memory->create(fieldindex,nfield,"read_dump:fieldindex");
 
-  int s_index,u_index,su_index;
-  xflag = UNSET;
-  yflag = UNSET;
-  zflag = UNSET;
-
-  for (int i = 0; i < nfield; i++) {
-    if (fieldlabel[i]) {
-      fieldindex[i] = find_label(fieldlabel[i], labels);
-      if (fieldtype[i] == X) xflag = 2*scaleflag + wrapflag + 1;
-      else if (fieldtype[i] == Y) yflag = 2*scaleflag + wrapflag + 1;
-      else if (fieldtype[i] == Z) zflag = 2*scaleflag + wrapflag + 1;
-    }
-
-    else if (fieldtype[i] == ID)
-      fieldindex[i] = find_label("id", labels);
-    else if (fieldtype[i] == TYPE)
-      fieldindex[i] = find_label("type", labels);
-
-    else if (fieldtype[i] == X) {
-      fieldindex[i] = find_label("x", labels);
-      xflag = NOSCALE_WRAP;
-      if (fieldindex[i] < 0) {
-        fieldindex[i] = nwords;
-        s_index = find_label("xs", labels);
-        u_index = find_label("xu", labels);
-        su_index = find_label("xsu", labels);
-        if (s_index >= 0 && s_index < fieldindex[i]) {
-          fieldindex[i] = s_index;
-          xflag = SCALE_WRAP;
-        }
-        if (u_index >= 0 && u_index < fieldindex[i]) {
-          fieldindex[i] = u_index;
-          xflag = NOSCALE_NOWRAP;
-        }
-        if (su_index >= 0 && su_index < fieldindex[i]) {
-          fieldindex[i] = su_index;
-          xflag = SCALE_NOWRAP;
-        }
-      }
-      if (fieldindex[i] == nwords) fieldindex[i] = -1;
-
-    } else if (fieldtype[i] == Y) {
-      fieldindex[i] = find_label("y", labels);
-      yflag = NOSCALE_WRAP;
-      if (fieldindex[i] < 0) {
-        fieldindex[i] = nwords;
-        s_index = find_label("ys", labels);
-        u_index = find_label("yu", labels);
-        su_index = find_label("ysu", labels);
-        if (s_index >= 0 && s_index < fieldindex[i]) {
-          fieldindex[i] = s_index;
-          yflag = SCALE_WRAP;
-        }
-        if (u_index >= 0 && u_index < fieldindex[i]) {
-          fieldindex[i] = u_index;
-          yflag = NOSCALE_NOWRAP;
-        }
-        if (su_index >= 0 && su_index < fieldindex[i]) {
-          fieldindex[i] = su_index;
-          yflag = SCALE_NOWRAP;
-        }
-      }
-      if (fieldindex[i] == nwords) fieldindex[i] = -1;
-
-    } else if (fieldtype[i] == Z) {
-      fieldindex[i] = find_label("z", labels);
-      zflag = NOSCALE_WRAP;
-      if (fieldindex[i] < 0) {
-        fieldindex[i] = nwords;
-        s_index = find_label("zs", labels);
-        u_index = find_label("zu", labels);
-        su_index = find_label("zsu", labels);
-        if (s_index >= 0 && s_index < fieldindex[i]) {
-          fieldindex[i] = s_index;
-          zflag = SCALE_WRAP;
-        }
-        if (u_index >= 0 && u_index < fieldindex[i]) {
-          fieldindex[i] = u_index;
-          zflag = NOSCALE_NOWRAP;
-        }
-        if (su_index >= 0 && su_index < fieldindex[i]) {
-          fieldindex[i] = su_index;
-          zflag = SCALE_NOWRAP;
-        }
-      }
-      if (fieldindex[i] == nwords) fieldindex[i] = -1;
-
-    } else if (fieldtype[i] == VX)
-      fieldindex[i] = find_label("vx", labels);
-    else if (fieldtype[i] == VY)
-      fieldindex[i] = find_label("vy", labels);
-    else if (fieldtype[i] == VZ)
-      fieldindex[i] = find_label("vz", labels);
-
-    else if (fieldtype[i] == FX)
-      fieldindex[i] = find_label("fx", labels);
-    else if (fieldtype[i] == FY)
-      fieldindex[i] = find_label("fy", labels);
-    else if (fieldtype[i] == FZ)
-      fieldindex[i] = find_label("fz", labels);
-
-    else if (fieldtype[i] == Q)
-      fieldindex[i] = find_label("q", labels);
-
-    else if (fieldtype[i] == IX)
-      fieldindex[i] = find_label("ix", labels);
-    else if (fieldtype[i] == IY)
-      fieldindex[i] = find_label("iy", labels);
-    else if (fieldtype[i] == IZ)
-      fieldindex[i] = find_label("iz", labels);
-  }
-
-  // set fieldflag = -1 if any unfound fields
-
-  fieldflag = 0;
-  for (int i = 0; i < nfield; i++)
-    if (fieldindex[i] < 0) fieldflag = -1;
+  fieldflag = match_fields(labels, nfield, fieldtype, fieldlabel, scaleflag, wrapflag,
+                           fieldindex, xflag, yflag, zflag);
 
   return natoms;
 }
@@ -473,34 +379,79 @@ void ReaderNative::read_atoms(int n, int nfield, double **fields)
       }
     }
   } else {
+    std::vector<const char *> words(nwords);
     for (int i = 0; i < n; i++) {
       utils::sfgets(FLERR, line, MAXLINE, fp, nullptr, error);
 
-      // tokenize the line
-      std::vector<std::string> words = Tokenizer(line).as_vector();
+      // locate the words of the line in place, strtod() stops at the next separator
 
-      if ((int)words.size() < nwords) error->one(FLERR,"Insufficient columns in dump file");
+      char *ptr = line;
+      int iword = 0;
+      while (iword < nwords) {
+        ptr += strspn(ptr, TOKENIZER_DEFAULT_SEPARATORS);
+        if (*ptr == '\0') break;
+        words[iword++] = ptr;
+        ptr += strcspn(ptr, TOKENIZER_DEFAULT_SEPARATORS);
+      }
+
+      if (iword < nwords) error->one(FLERR,"Insufficient columns in dump file");
 
       // convert selected fields to floats
 
       for (int m = 0; m < nfield; m++)
-        fields[i][m] = atof(words[fieldindex[m]].c_str());
+        fields[i][m] = strtod(words[fieldindex[m]], nullptr);
     }
   }
 }
 
 /* ----------------------------------------------------------------------
-   match label to any of N labels
-   return index of match or -1 if no match
+   open dump file and, if requested, set up timestep -> file offset index
+   the index is read from a sidecar file with ".idx" suffix, or built by
+     stepping once through all frames and then stored in the sidecar file
+   if the dump file has grown since, only the new frames are scanned
+   only called by proc 0
 ------------------------------------------------------------------------- */
 
-int ReaderNative::find_label(const std::string &label, const std::map<std::string, int> & labels)
+void ReaderNative::open_file(const std::string &file)
 {
-  auto it = labels.find(label);
-  if (it != labels.end()) {
-      return it->second;
+  Reader::open_file(file);
+
+  useindex = false;
+  iframe = 0;
+  index_step.clear();
+  index_offset.clear();
+  if (!indexflag) return;
+
+  if (compressed) {
+    error->warning(FLERR, "Cannot use index with compressed dump file {}", file);
+    return;
   }
-  return -1;
+
+  platform::fseek(fp, platform::END_OF_FILE);
+  bigint filesize = platform::ftell(fp);
+  auto idxfile = file + ".idx";
+
+  bigint idxsize = read_index_file(idxfile);
+  if (idxsize == filesize) {
+    useindex = true;
+    return;
+  }
+
+  // rescan from last indexed frame if file was appended to, else from start
+
+  bigint first = 0;
+  if ((idxsize > 0) && (idxsize < filesize) && !index_step.empty()) {
+    first = index_offset.back();
+    index_step.pop_back();
+    index_offset.pop_back();
+  } else {
+    index_step.clear();
+    index_offset.clear();
+  }
+
+  build_index(first, filesize);
+  write_index_file(idxfile, filesize);
+  useindex = true;
 }
 
 /* ----------------------------------------------------------------------
@@ -545,6 +496,85 @@ void ReaderNative::skip_buf(size_t size)
   platform::fseek(fp,pos);
 }
 
+/* ----------------------------------------------------------------------
+   read index from sidecar file
+   return size of dump file at the time the index was written or -1
+------------------------------------------------------------------------- */
+
+bigint ReaderNative::read_index_file(const std::string &idxfile)
+{
+  FILE *idx = fopen(idxfile.c_str(), "rb");
+  if (!idx) return -1;
+
+  char magic[sizeof(INDEX_MAGIC)];
+  bigint filesize = -1;
+  bigint nframes = -1;
+  if ((fread(magic, sizeof(char), sizeof(magic), idx) != sizeof(magic)) ||
+      (memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0) ||
+      (fread(&filesize, sizeof(bigint), 1, idx) != 1) ||
+      (fread(&nframes, sizeof(bigint), 1, idx) != 1) || (nframes < 0)) {
+    fclose(idx);
+    return -1;
+  }
+
+  index_step.resize(nframes);
+  index_offset.resize(nframes);
+  for (bigint i = 0; i < nframes; i++) {
+    if ((fread(&index_step[i], sizeof(bigint), 1, idx) != 1) ||
+        (fread(&index_offset[i], sizeof(bigint), 1, idx) != 1)) {
+      filesize = -1;
+      break;
+    }
+  }
+  fclose(idx);
+  return filesize;
+}
+
+/* ----------------------------------------------------------------------
+   write index to sidecar file, warn and continue without if not possible
+------------------------------------------------------------------------- */
+
+void ReaderNative::write_index_file(const std::string &idxfile, bigint filesize)
+{
+  FILE *idx = fopen(idxfile.c_str(), "wb");
+  if (!idx) {
+    error->warning(FLERR, "Cannot write dump index file {}: {}", idxfile, utils::getsyserror());
+    return;
+  }
+
+  bigint nframes = index_step.size();
+  fwrite(INDEX_MAGIC, sizeof(char), sizeof(INDEX_MAGIC), idx);
+  fwrite(&filesize, sizeof(bigint), 1, idx);
+  fwrite(&nframes, sizeof(bigint), 1, idx);
+  for (bigint i = 0; i < nframes; i++) {
+    fwrite(&index_step[i], sizeof(bigint), 1, idx);
+    fwrite(&index_offset[i], sizeof(bigint), 1, idx);
+  }
+  if (ferror(idx))
+    error->warning(FLERR, "Error writing dump index file {}: {}", idxfile, utils::getsyserror());
+  fclose(idx);
+}
+
+/* ----------------------------------------------------------------------
+   step through frames from file offset first and record their offsets
+   a last frame extending beyond filesize is not recorded
+------------------------------------------------------------------------- */
+
+void ReaderNative::build_index(bigint first, bigint filesize)
+{
+  bigint ntimestep;
+
+  platform::fseek(fp, first);
+  while (true) {
+    bigint pos = platform::ftell(fp);
+    if (read_time(ntimestep)) break;
+    skip();
+    if (platform::ftell(fp) > filesize) break;
+    index_step.push_back(ntimestep);
+    index_offset.push_back(pos);
+  }
+}
+
 bool ReaderNative::is_known_magic_str() const
 {
   return magic_string == "DUMPATOM" || magic_string == "DUMPCUSTOM";
@@ -26,6 +26,7 @@ ReaderStyle(native,ReaderNative);
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace LAMMPS_NS {
 
@@ -40,6 +41,8 @@ class ReaderNative : public Reader {
                      int &, int &) override;
   void read_atoms(int, int, double **) override;
 
+  void open_file(const std::string &) override;
+
  private:
   int revision;
 
@@ -58,7 +61,11 @@ class ReaderNative : public Reader {
   int natom_chunk;    // number of atoms in the current chunks
   int iatom_chunk;    // index of current atom in the current chunk
 
-  int find_label(const std::string &label, const std::map<std::string, int> &labels);
+  bool useindex;                       // true if frames are located via index
+  std::vector<bigint> index_step;      // timestep of each frame in file
+  std::vector<bigint> index_offset;    // file offset of each frame in file
+  bigint iframe;                       // index of next frame to be read
+
   void read_lines(int);
 
   void read_buf(void *, size_t, size_t);
@@ -67,6 +74,10 @@ class ReaderNative : public Reader {
   void skip_reading_magic_str();
   bool is_known_magic_str() const;
   std::string read_binary_str(size_t);
+
+  bigint read_index_file(const std::string &);
+  void write_index_file(const std::string &, bigint);
+  void build_index(bigint, bigint);
 };
 
 }    // namespace LAMMPS_NS
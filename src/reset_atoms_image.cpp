@@ -94,12 +94,12 @@ void ResetAtomsImage::command(int narg, char **arg)
 
   // trigger computes
 
-  frags->compute_peratom();
-  chunk->compute_peratom();
-  flags->compute_peratom();
+  frags->invoke_peratom();
+  chunk->invoke_peratom();
+  flags->invoke_peratom();
   ifmin->compute_array();
   ifmax->compute_array();
-  cdist->compute_peratom();
+  cdist->invoke_peratom();
 
   // reset image flags for atoms in group
 
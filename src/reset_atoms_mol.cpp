@@ -169,7 +169,7 @@ void ResetAtomsMol::reset()
   // walks bond connectivity and assigns each atom a fragment ID
   // if singleflag = 0, atoms w/out bonds will be assigned fragID = 0
 
-  cfa->compute_peratom();
+  cfa->invoke_peratom();
   double *fragIDs = cfa->vector_atom;
 
   // copy fragID to molecule ID for atoms in group
@@ -191,7 +191,7 @@ void ResetAtomsMol::reset()
   // NOTE: use of compute chunk/atom limits Nmol to a 32-bit int
 
   if (compressflag) {
-    cca->compute_peratom();
+    cca->invoke_peratom();
     double *chunkIDs = cca->vector_atom;
     nchunk = cca->nchunk;
 
@@ -197,8 +197,23 @@ void TextFileReader::next_dvector(double *list, int n)
       }
     }
 
-    ValueTokenizer values(line);
-    while (values.has_next() && i < n) { list[i++] = values.next_double(); }
+    // convert words in place unless UTF-8 characters need to be substituted first
+
+    if (utils::has_utf8(line)) {
+      ValueTokenizer values(line);
+      while (values.has_next() && i < n) { list[i++] = values.next_double(); }
+    } else {
+      char *word = line;
+      while (i < n) {
+        word += strspn(word, TOKENIZER_DEFAULT_SEPARATORS);
+        if (*word == '\0') break;
+        size_t len = strcspn(word, TOKENIZER_DEFAULT_SEPARATORS);
+        if (utils::parse_double(word, len, list[i]) == 1)
+          throw InvalidFloatException(std::string(word, len));
+        word += len;
+        ++i;
+      }
+    }
   }
 }
 
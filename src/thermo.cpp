@@ -25,6 +25,7 @@
 #include "compute.h"
 #include "dihedral.h"
 #include "domain.h"
+#include "dump.h"
 #include "error.h"
 #include "fix.h"
 #include "force.h"
@@ -57,6 +58,7 @@ using namespace MathExtra;
 // CUSTOMIZATION: add a new keyword by adding it to this list:
 
 // step, elapsed, elaplong, dt, time, cpu, tpcpu, spcpu, cpuremain, part, timeremain
+// time/fix/ID, time/compute/ID, time/dump/ID, time/pair/style
 // atoms, temp, press, pe, ke, etotal
 // evdwl, ecoul, epair, ebond, eangle, edihed, eimp, emol, elong, etail
 // enthalpy, ecouple, econserve
@@ -394,17 +396,17 @@ void Thermo::compute(int flag)
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_SCALAR)) {
-        computes[i]->compute_scalar();
+        computes[i]->invoke_scalar();
         computes[i]->invoked_flag |= Compute::INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_VECTOR)) {
-        computes[i]->compute_vector();
+        computes[i]->invoke_vector();
         computes[i]->invoked_flag |= Compute::INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & Compute::INVOKED_ARRAY)) {
-        computes[i]->compute_array();
+        computes[i]->invoke_array();
         computes[i]->invoked_flag |= Compute::INVOKED_ARRAY;
       }
     }
@@ -1034,6 +1036,9 @@ void Thermo::parse_fields(const std::string &str)
     } else if (word == "ndanger") {
       addfield("Ndanger", &Thermo::compute_ndanger, BIGINT);
 
+    } else if (utils::strmatch(word, "^time/")) {
+      addfield(word.c_str(), &Thermo::compute_time_detail, FLOAT);
+
       // compute value = c_ID, fix value = f_ID, variable value = v_ID
       // count trailing [] and store int arguments
 
@@ -1185,7 +1190,7 @@ void Thermo::check_temp(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(temperature->invoked_flag & Compute::INVOKED_SCALAR)) {
-    temperature->compute_scalar();
+    temperature->invoke_scalar();
     temperature->invoked_flag |= Compute::INVOKED_SCALAR;
   }
 }
@@ -1205,7 +1210,7 @@ void Thermo::check_pe(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pe->invoked_flag & Compute::INVOKED_SCALAR)) {
-    pe->compute_scalar();
+    pe->invoke_scalar();
     pe->invoked_flag |= Compute::INVOKED_SCALAR;
   }
 }
@@ -1222,7 +1227,7 @@ void Thermo::check_press_scalar(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_SCALAR)) {
-    pressure->compute_scalar();
+    pressure->invoke_scalar();
     pressure->invoked_flag |= Compute::INVOKED_SCALAR;
   }
 }
@@ -1239,7 +1244,7 @@ void Thermo::check_press_vector(const std::string &keyword)
     error->all(FLERR, "Thermo keyword {} cannot be invoked before initialization by a run",
                keyword);
   if (!(pressure->invoked_flag & Compute::INVOKED_VECTOR)) {
-    pressure->compute_vector();
+    pressure->invoke_vector();
     pressure->invoked_flag |= Compute::INVOKED_VECTOR;
 
     // store 3x3 matrix form of symmetric pressure tensor for use in triclinic_general()
@@ -1282,7 +1287,7 @@ int Thermo::evaluate_keyword(const std::string &word, double *answer)
   //   this means keywords that use pe (pe, etotal, enthalpy)
   //     need to always invoke it even if invoked_flag is set,
   //     because evdwl/etc may have set invoked_flag w/out
-  //       actually invoking pe->compute_scalar()
+  //       actually invoking pe->invoke_scalar()
 
   if (word == "step") {
     compute_step();
@@ -1333,6 +1338,9 @@ int Thermo::evaluate_keyword(const std::string &word, double *answer)
   } else if (word == "timeremain") {
     compute_timeremain();
 
+  } else if (utils::strmatch(word, "^time/")) {
+    dvalue = time_detail(word);
+
   } else if (word == "atoms") {
     compute_atoms();
     dvalue = bivalue;
@@ -1770,6 +1778,61 @@ void Thermo::compute_timeremain()
 
 /* ---------------------------------------------------------------------- */
 
+void Thermo::compute_time_detail()
+{
+  dvalue = time_detail(keyword[ifield]);
+}
+
+/* ----------------------------------------------------------------------
+   wall time of one fix, compute, dump, or hybrid pair sub-style
+   word = time/fix/ID, time/compute/ID, time/dump/ID, or time/pair/style[:N]
+   return average over all procs, requires "timer detail"
+------------------------------------------------------------------------- */
+
+double Thermo::time_detail(const std::string &word)
+{
+  if (!timer->has_detail())
+    error->all(FLERR, "Thermo keyword {} requires timer detail", word);
+
+  double mytime = 0.0;
+  auto kind = word.substr(5, word.find('/', 5) - 5);
+  auto name = word.substr(MIN(word.size(), kind.size() + 6));
+
+  if (kind == "fix") {
+    auto ifix = modify->get_fix_by_id(name);
+    if (!ifix) error->all(FLERR, "Could not find thermo keyword {} fix ID {}", word, name);
+    mytime = ifix->time_detail;
+  } else if (kind == "compute") {
+    auto icompute = modify->get_compute_by_id(name);
+    if (!icompute)
+      error->all(FLERR, "Could not find thermo keyword {} compute ID {}", word, name);
+    mytime = icompute->time_detail;
+  } else if (kind == "dump") {
+    auto idump = output->get_dump_by_id(name);
+    if (!idump) error->all(FLERR, "Could not find thermo keyword {} dump ID {}", word, name);
+    mytime = idump->time_detail;
+  } else if (kind == "pair") {
+    int nsub = 0;
+    auto pos = name.find(':');
+    if (pos != std::string::npos) {
+      nsub = utils::inumeric(FLERR, name.substr(pos + 1), false, lmp);
+      name = name.substr(0, pos);
+    }
+    auto pair = force->pair_match(name, 1, nsub);
+    if (!pair || (pair == force->pair))
+      error->all(FLERR, "Thermo keyword {} requires pair style hybrid with sub-style {}", word,
+                 name);
+    mytime = pair->time_detail;
+  } else
+    error->all(FLERR, "Unknown keyword '{}' in thermo_style custom command", word);
+
+  double time;
+  MPI_Allreduce(&mytime, &time, 1, MPI_DOUBLE, MPI_SUM, world);
+  return time / comm->nprocs;
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Thermo::compute_atoms()
 {
   bivalue = group->count_all();
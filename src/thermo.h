@@ -151,6 +151,8 @@ class Thermo : protected Pointers {
   void compute_cpuremain();
   void compute_part();
   void compute_timeremain();
+  void compute_time_detail();
+  double time_detail(const std::string &);
 
   void compute_atoms();
   void compute_temp();
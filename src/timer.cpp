@@ -14,20 +14,55 @@
 #include "timer.h"
 
 #include "comm.h"
+#include "compute.h"
+#include "dump.h"
 #include "error.h"
+#include "fix.h"
 #include "fmt/chrono.h"
+#include "force.h"
+#include "modify.h"
+#include "output.h"
+#include "pair_hybrid.h"
 
 #include <cstring>
 #include <ctime>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 using namespace LAMMPS_NS;
 
+static const char *counter_name[] = {"cycles", "instructions", "LLC-misses", "branches",
+                                     "branch-misses"};
+
+// section names in event traces, indexed by Timer::ttype
+
+static const char *section_name[] = {"Total",  "Pair", "Bond",   "Kspace", "Neigh",
+                                     "Comm",   "Modify", "Output", "Sync",  "All",
+                                     "Dephase", "Dynamics", "Quench", "NEB",  "Repcomm",
+                                     "Repout"};
+
 /* ---------------------------------------------------------------------- */
 
 Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
 {
   _level = NORMAL;
   _sync = OFF;
+  _detail = OFF;
+  _counters = OFF;
+  counter_fd = nullptr;
+  ncounter_fd = 0;
+  for (int i = 0; i < NUM_COUNTER; i++) counter_avail[i] = 0;
+  _trace = OFF;
+  trace_origin = 0.0;
+  trace_fp = nullptr;
   _timeout = -1;
   _s_timeout = -1;
   _checkfreq = 10;
@@ -37,17 +72,306 @@ Timer::Timer(LAMMPS *_lmp) : Pointers(_lmp)
 
 /* ---------------------------------------------------------------------- */
 
+Timer::~Timer()
+{
+  _counters_close();
+
+  // events after the last run are not written, just close the JSON array
+
+  if (trace_fp) {
+    fputs("\n]\n", trace_fp);
+    fclose(trace_fp);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Timer::init()
 {
   for (int i = 0; i < NUM_TIMER; i++) {
     cpu_array[i] = 0.0;
     wall_array[i] = 0.0;
+    for (int j = 0; j < NUM_COUNTER; j++) counter_array[i][j] = 0.0;
+  }
+  if (_detail) _detail_reset();
+
+  // (re-)open counters if requested or if the number of threads changed
+
+  if (_counters && (ncounter_fd != comm->nthreads * NUM_COUNTER)) _counters_open();
+
+  // one event buffer for the main thread and for each thread
+
+  if (_trace && ((int) trace_buf.size() < comm->nthreads + 1)) {
+    trace_buf.resize(comm->nthreads + 1);
+    trace_named.resize(comm->nthreads + 1, 0);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double Timer::_detail_time() const
+{
+  return platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   zero per-instance timers of all fixes, computes, pair sub-styles, and dumps
+------------------------------------------------------------------------- */
+
+void Timer::_detail_reset()
+{
+  for (auto &ifix : modify->get_fix_list()) ifix->time_detail = 0.0;
+  for (auto &icompute : modify->get_compute_list()) icompute->time_detail = 0.0;
+  for (int i = 0; i < output->ndump; i++) output->dump[i]->time_detail = 0.0;
+
+  auto hybrid = dynamic_cast<PairHybrid *>(force->pair);
+  if (hybrid)
+    for (int m = 0; m < hybrid->nstyles; m++) hybrid->styles[m]->time_detail = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   open hardware performance counters via the Linux perf_event interface
+   counters are bound to the thread that opens them, so each thread opens its own
+   a counter is only used if it can be opened on all procs and threads
+   without any usable counter, collecting counters is turned off again
+------------------------------------------------------------------------- */
+
+void Timer::_counters_open()
+{
+  _counters_close();
+
+  const int nthreads = comm->nthreads;
+  ncounter_fd = nthreads * NUM_COUNTER;
+  counter_fd = new int[ncounter_fd];
+  for (int i = 0; i < ncounter_fd; i++) counter_fd[i] = -1;
+
+#if defined(__linux__)
+  static const uint64_t counter_config[] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES};
+
+#if defined(_OPENMP)
+#pragma omp parallel num_threads(nthreads)
+#endif
+  {
+    int tid = 0;
+#if defined(_OPENMP)
+    tid = omp_get_thread_num();
+#endif
+    for (int i = 0; i < NUM_COUNTER; i++) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = counter_config[i];
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      counter_fd[tid * NUM_COUNTER + i] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+  }
+#endif
+
+  int avail[NUM_COUNTER];
+  for (int i = 0; i < NUM_COUNTER; i++) {
+    avail[i] = 1;
+    for (int j = 0; j < nthreads; j++)
+      if (counter_fd[j * NUM_COUNTER + i] < 0) avail[i] = 0;
+  }
+  MPI_Allreduce(avail, counter_avail, NUM_COUNTER, MPI_INT, MPI_MIN, world);
+
+  std::string missing;
+  for (int i = 0; i < NUM_COUNTER; i++) {
+    if (counter_avail[i]) continue;
+    missing += std::string(" ") + counter_name[i];
+#if defined(__linux__)
+    for (int j = 0; j < nthreads; j++) {
+      int &fd = counter_fd[j * NUM_COUNTER + i];
+      if (fd >= 0) close(fd);
+      fd = -1;
+    }
+#endif
+  }
+
+  if (!counter_avail[CYCLES] && !counter_avail[INSTRUCTIONS]) {
+    _counters_close();
+    _counters = OFF;
+    if (comm->me == 0)
+      error->warning(FLERR, "Hardware performance counters are not available; "
+                     "disabling timer counters");
+    return;
+  }
+  if (missing.size() && (comm->me == 0))
+    error->warning(FLERR, "Some hardware performance counters are not available:{}", missing);
+
+  _counters_read(previous_counter);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::_counters_close()
+{
+#if defined(__linux__)
+  for (int i = 0; i < ncounter_fd; i++)
+    if (counter_fd[i] >= 0) close(counter_fd[i]);
+#endif
+  delete[] counter_fd;
+  counter_fd = nullptr;
+  ncounter_fd = 0;
+  for (int i = 0; i < NUM_COUNTER; i++) counter_avail[i] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   current counts summed over all threads of this proc
+   counts are extrapolated when the kernel had to multiplex counters
+------------------------------------------------------------------------- */
+
+void Timer::_counters_read(double *count)
+{
+  for (int i = 0; i < NUM_COUNTER; i++) count[i] = 0.0;
+
+#if defined(__linux__)
+  uint64_t buf[3];    // value, time enabled, time running
+  for (int i = 0; i < ncounter_fd; i++) {
+    if (counter_fd[i] < 0) continue;
+    if (read(counter_fd[i], buf, sizeof(buf)) != (ssize_t) sizeof(buf)) continue;
+    double value = (double) buf[0];
+    if ((buf[2] > 0) && (buf[2] < buf[1])) value *= (double) buf[1] / (double) buf[2];
+    count[i % NUM_COUNTER] += value;
+  }
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   start recording events for a trace file in Chrome trace event format
+   each proc is a process, its main thread and OpenMP threads are threads
+   clocks are aligned at a barrier, since they may not agree across nodes
+------------------------------------------------------------------------- */
+
+void Timer::_trace_open(const std::string &file)
+{
+  _trace_close();
+
+  if (comm->me == 0) {
+    trace_fp = fopen(file.c_str(), "w");
+    if (!trace_fp)
+      error->one(FLERR, "Cannot open timer trace file {}: {}", file, utils::getsyserror());
+    fputs("[", trace_fp);
+    for (int iproc = 0; iproc < comm->nprocs; iproc++)
+      fmt::print(trace_fp,
+                 "{}\n{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},\"args\":"
+                 "{{\"name\":\"rank {}\"}}}},\n{{\"name\":\"process_sort_index\",\"ph\":"
+                 "\"M\",\"pid\":{},\"args\":{{\"sort_index\":{}}}}}",
+                 iproc ? "," : "", iproc, iproc, iproc, iproc);
+  }
+
+  _trace = NORMAL;
+  trace_buf.assign(comm->nthreads + 1, std::vector<TraceEvent>());
+  trace_named.assign(comm->nthreads + 1, 0);
+  MPI_Barrier(world);
+  trace_origin = platform::walltime();
+}
+
+/* ----------------------------------------------------------------------
+   write pending events and finish trace file
+------------------------------------------------------------------------- */
+
+void Timer::_trace_close()
+{
+  if (!_trace) return;
+
+  trace_write();
+  if (trace_fp) {
+    fputs("\n]\n", trace_fp);
+    fclose(trace_fp);
+    trace_fp = nullptr;
+  }
+  _trace = OFF;
+  trace_buf.clear();
+  trace_named.clear();
+}
+
+/* ----------------------------------------------------------------------
+   record one event
+   events of the global timer go to buffer 0, those of per-thread timers
+     go to the buffer of the calling thread
+------------------------------------------------------------------------- */
+
+void Timer::_trace_event(const Timer *source, const char *name, const char *category,
+                         double start, double stop)
+{
+  int ibuf = 0;
+#if defined(_OPENMP)
+  if (source != this) ibuf = omp_get_thread_num() + 1;
+#else
+  if (source != this) ibuf = 1;
+#endif
+  if (ibuf >= (int) trace_buf.size()) return;
+  trace_buf[ibuf].push_back({name, category, start, stop});
+}
+
+/* ----------------------------------------------------------------------
+   convert recorded events to JSON and append them to trace file
+   called at the end of each run, must be called by all procs
+   proc 0 collects text of all procs one by one
+------------------------------------------------------------------------- */
+
+void Timer::trace_write()
+{
+  if (!_trace) return;
+
+  const int me = comm->me;
+  std::string text;
+
+  for (int ibuf = 0; ibuf < (int) trace_buf.size(); ibuf++) {
+    auto &events = trace_buf[ibuf];
+    if (events.empty()) continue;
+
+    if (!trace_named[ibuf]) {
+      std::string name = ibuf ? fmt::format("thread {}", ibuf - 1) : std::string("main");
+      text += fmt::format(",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},"
+                          "\"args\":{{\"name\":\"{}\"}}}}",
+                          me, ibuf, name);
+      trace_named[ibuf] = 1;
+    }
+
+    for (const auto &event : events)
+      text += fmt::format(",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":{},"
+                          "\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                          event.name, event.category, me, ibuf,
+                          (event.start - trace_origin) * 1.0e6,
+                          (event.stop - event.start) * 1.0e6);
+    events.clear();
+  }
+
+  int n = (int) text.size();
+  int nmax;
+  MPI_Allreduce(&n, &nmax, 1, MPI_INT, MPI_MAX, world);
+
+  if (me == 0) {
+    fputs(text.c_str(), trace_fp);
+    std::vector<char> buf(nmax + 1);
+    for (int iproc = 1; iproc < comm->nprocs; iproc++) {
+      MPI_Request request;
+      MPI_Status status;
+      int tmp = 0, nrecv;
+      MPI_Irecv(buf.data(), nmax, MPI_CHAR, iproc, 0, world, &request);
+      MPI_Send(&tmp, 0, MPI_INT, iproc, 0, world);
+      MPI_Wait(&request, &status);
+      MPI_Get_count(&status, MPI_CHAR, &nrecv);
+      fwrite(buf.data(), 1, nrecv, trace_fp);
+    }
+    fflush(trace_fp);
+  } else {
+    int tmp;
+    MPI_Recv(&tmp, 0, MPI_INT, 0, 0, world, MPI_STATUS_IGNORE);
+    MPI_Rsend(text.data(), n, MPI_CHAR, 0, 0, world);
   }
 }
 
 /* ---------------------------------------------------------------------- */
 
-void Timer::_stamp(enum ttype which)
+void Timer::_stamp(enum ttype which, const char *name)
 {
   double current_cpu = 0.0, current_wall = 0.0;
 
@@ -62,15 +386,34 @@ void Timer::_stamp(enum ttype which)
     wall_array[which] += delta_wall;
     cpu_array[ALL] += delta_cpu;
     wall_array[ALL] += delta_wall;
+
+    // per-thread timers of the OPENMP package record into the trace of the global timer
+
+    if (timer && timer->_trace)
+      timer->_trace_event(this, name ? name : section_name[which], section_name[which],
+                          previous_wall, current_wall);
   }
 
   previous_cpu = current_cpu;
   previous_wall = current_wall;
 
+  if (_counters) {
+    double current_counter[NUM_COUNTER];
+    _counters_read(current_counter);
+    for (int i = 0; i < NUM_COUNTER; i++) {
+      if ((which > TOTAL) && (which < NUM_TIMER)) {
+        counter_array[which][i] += current_counter[i] - previous_counter[i];
+        counter_array[ALL][i] += current_counter[i] - previous_counter[i];
+      }
+      previous_counter[i] = current_counter[i];
+    }
+  }
+
   if (which == RESET) {
     this->init();
     cpu_array[TOTAL] = current_cpu;
     wall_array[TOTAL] = current_wall;
+    for (int i = 0; i < NUM_COUNTER; i++) counter_array[TOTAL][i] = previous_counter[i];
   }
 
   if (_sync) {
@@ -80,8 +423,18 @@ void Timer::_stamp(enum ttype which)
 
     cpu_array[SYNC] += current_cpu - previous_cpu;
     wall_array[SYNC] += current_wall - previous_wall;
+    if (_trace) _trace_event(this, "MPI_Barrier", section_name[SYNC], previous_wall, current_wall);
     previous_cpu = current_cpu;
     previous_wall = current_wall;
+
+    if (_counters) {
+      double current_counter[NUM_COUNTER];
+      _counters_read(current_counter);
+      for (int i = 0; i < NUM_COUNTER; i++) {
+        counter_array[SYNC][i] += current_counter[i] - previous_counter[i];
+        previous_counter[i] = current_counter[i];
+      }
+    }
   }
 }
 
@@ -102,6 +455,11 @@ void Timer::barrier_start()
   wall_array[TOTAL] = current_wall;
   previous_cpu = current_cpu;
   previous_wall = current_wall;
+
+  if (_counters) {
+    _counters_read(previous_counter);
+    for (int i = 0; i < NUM_COUNTER; i++) counter_array[TOTAL][i] = previous_counter[i];
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -119,6 +477,13 @@ void Timer::barrier_stop()
 
   cpu_array[TOTAL] = current_cpu - cpu_array[TOTAL];
   wall_array[TOTAL] = current_wall - wall_array[TOTAL];
+
+  if (_counters) {
+    double current_counter[NUM_COUNTER];
+    _counters_read(current_counter);
+    for (int i = 0; i < NUM_COUNTER; i++)
+      counter_array[TOTAL][i] = current_counter[i] - counter_array[TOTAL][i];
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -211,10 +576,14 @@ double Timer::get_timeout_remain()
 ------------------------------------------------------------------------- */
 static const char *timer_style[] = {"off", "loop", "normal", "full"};
 static const char *timer_mode[] = {"nosync", "(dummy)", "sync"};
+static const char *timer_detail[] = {"nodetail", "(dummy)", "detail"};
+static const char *timer_counters[] = {"nocounters", "(dummy)", "counters"};
 
 void Timer::modify_params(int narg, char **arg)
 {
   int iarg = 0;
+  std::string tracefile;
+  int traceflag = -1;
   while (iarg < narg) {
     if (strcmp(arg[iarg], timer_style[OFF]) == 0) {
       _level = OFF;
@@ -228,6 +597,24 @@ void Timer::modify_params(int narg, char **arg)
       _sync = OFF;
     } else if (strcmp(arg[iarg], timer_mode[NORMAL]) == 0) {
       _sync = NORMAL;
+    } else if (strcmp(arg[iarg], timer_detail[OFF]) == 0) {
+      _detail = OFF;
+    } else if (strcmp(arg[iarg], timer_detail[NORMAL]) == 0) {
+      _detail = NORMAL;
+    } else if (strcmp(arg[iarg], timer_counters[OFF]) == 0) {
+      _counters = OFF;
+      _counters_close();
+    } else if (strcmp(arg[iarg], timer_counters[NORMAL]) == 0) {
+      _counters = NORMAL;
+    } else if (strcmp(arg[iarg], "trace") == 0) {
+      ++iarg;
+      if (iarg < narg) {
+        tracefile = arg[iarg];
+        traceflag = 1;
+      } else
+        error->all(FLERR, "Illegal timer command");
+    } else if (strcmp(arg[iarg], "notrace") == 0) {
+      traceflag = 0;
     } else if (strcmp(arg[iarg], "timeout") == 0) {
       ++iarg;
       if (iarg < narg) {
@@ -246,6 +633,13 @@ void Timer::modify_params(int narg, char **arg)
     ++iarg;
   }
 
+  // probe counters right away, so that unavailable counters are reported here
+
+  if (_counters && (ncounter_fd == 0)) _counters_open();
+
+  if (traceflag == 0) _trace_close();
+  else if (traceflag == 1) _trace_open(tracefile);
+
   timeout_start = platform::walltime();
   if (comm->me == 0) {
 
@@ -256,7 +650,10 @@ void Timer::modify_params(int narg, char **arg)
       timeout = fmt::format("{:02d}:{:%M:%S}", tv.tm_yday * 24 + tv.tm_hour, tv);
     }
 
-    utils::logmesg(lmp, "New timer settings: style={}  mode={}  timeout={}\n", timer_style[_level],
-                   timer_mode[_sync], timeout);
+    utils::logmesg(lmp,
+                   "New timer settings: style={}  mode={}  detail={}  counters={}  trace={}  "
+                   "timeout={}\n",
+                   timer_style[_level], timer_mode[_sync], timer_detail[_detail],
+                   timer_counters[_counters], _trace ? "yes" : "no", timeout);
   }
 }
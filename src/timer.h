@@ -42,27 +42,55 @@ class Timer : protected Pointers {
     NUM_TIMER
   };
   enum tlevel { OFF = 0, LOOP, NORMAL, FULL };
+  enum ctype { CYCLES = 0, INSTRUCTIONS, LLC_MISSES, BRANCHES, BRANCH_MISSES, NUM_COUNTER };
 
   Timer(class LAMMPS *);
+  ~Timer() override;
 
   void init();
 
   // inline function to reduce overhead if we want no detailed timings
 
-  void stamp(enum ttype which = START)
+  // optional name labels the section in an event trace, default is the section
+
+  void stamp(enum ttype which = START, const char *name = nullptr)
   {
-    if (_level > LOOP) _stamp(which);
+    if (_level > LOOP) _stamp(which, name);
   }
 
   void barrier_start();
   void barrier_stop();
 
+  // per-instance timings of fixes, computes, pair sub-styles, and dumps
+  // inline functions to reduce overhead if they are not requested
+
+  double detail_start() const { return _detail ? _detail_time() : 0.0; }
+  void detail_stop(double &sum, double start) const
+  {
+    if (_detail) sum += _detail_time() - start;
+  }
+
+  // events in addition to timer sections, e.g. waiting for MPI messages
+
+  double trace_start() const { return _trace ? _detail_time() : 0.0; }
+  void trace_stop(const char *name, const char *category, double start)
+  {
+    if (_trace) _trace_event(this, name, category, start, _detail_time());
+  }
+
+  // write recorded events to trace file
+  void trace_write();
+
   // accessor methods for supported level of detail
 
   bool has_loop() const { return (_level >= LOOP); }
   bool has_normal() const { return (_level >= NORMAL); }
   bool has_full() const { return (_level >= FULL); }
   bool has_sync() const { return (_sync != OFF); }
+  bool has_detail() const { return (_detail != OFF); }
+  bool has_counters() const { return (_counters != OFF); }
+  bool has_trace() const { return (_trace != OFF); }
+  bool has_counter(enum ctype which) const { return (counter_avail[which] != 0); }
   bool has_timeout() const { return (_timeout >= 0.0); }
 
   // flag if wallclock time is expired
@@ -73,6 +101,10 @@ class Timer : protected Pointers {
 
   double get_cpu(enum ttype which) const { return cpu_array[which]; };
   double get_wall(enum ttype which) const { return wall_array[which]; };
+  double get_counter(enum ttype which, enum ctype counter) const
+  {
+    return counter_array[which][counter];
+  }
 
   void set_wall(enum ttype, double);
 
@@ -109,19 +141,51 @@ class Timer : protected Pointers {
   double wall_array[NUM_TIMER];
   double previous_cpu;
   double previous_wall;
+  double counter_array[NUM_TIMER][NUM_COUNTER];
+  double previous_counter[NUM_COUNTER];
   double timeout_start;
   int _level;        // level of detail: off=0,loop=1,normal=2,full=3
   int _sync;         // if nonzero, synchronize tasks before setting the timer
+  int _detail;       // if nonzero, collect per-instance timings
+  int _counters;     // if nonzero, collect hardware performance counters
+  int _trace;        // if nonzero, record events for trace file
   int _timeout;      // max allowed wall time in seconds. infinity if negative
   int _s_timeout;    // copy of timeout for restoring after a forced timeout
   int _checkfreq;    // frequency of timeout checking
   int _nextcheck;    // loop number of next timeout check
 
+  int *counter_fd;                 // perf event file descriptors, NUM_COUNTER per thread
+  int ncounter_fd;                 // # of file descriptors
+  int counter_avail[NUM_COUNTER];  // 1 if counter is available on all procs and threads
+
+  struct TraceEvent {
+    const char *name, *category;    // string literals
+    double start, stop;
+  };
+  std::vector<std::vector<TraceEvent>> trace_buf;    // events of main thread and each thread
+  std::vector<int> trace_named;                      // 1 if thread name was written
+  double trace_origin;                               // wall time of trace start
+  FILE *trace_fp;                                    // trace file, only on proc 0
+
   // update one specific timer array
-  void _stamp(enum ttype);
+  void _stamp(enum ttype, const char *name = nullptr);
 
   // check for timeout
   bool _check_timeout();
+
+  // current wall time and reset of per-instance timings
+  double _detail_time() const;
+  void _detail_reset();
+
+  // access to hardware performance counters
+  void _counters_open();
+  void _counters_close();
+  void _counters_read(double *);
+
+  // recording of event traces
+  void _trace_open(const std::string &);
+  void _trace_close();
+  void _trace_event(const Timer *, const char *, const char *, double, double);
 };
 
 }    // namespace LAMMPS_NS
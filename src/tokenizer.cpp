@@ -153,6 +153,31 @@ std::string Tokenizer::next()
   return token;
 }
 
+/*! Retrieve next token without copying it.
+ *
+ * The returned pointer refers to the text stored in the tokenizer, so
+ * it is only valid as long as the tokenizer exists, and the token is
+ * not terminated by a NUL character.
+ *
+ * \param   len  set to the number of characters in the token
+ * \return       pointer to the first character of the next token */
+const char *Tokenizer::next_token(size_t &len)
+{
+  if (!has_next()) throw TokenizerException("No more tokens", "");
+
+  const char *token = text.c_str() + start;
+  size_t end = text.find_first_of(separators, start);
+
+  if (end == std::string::npos) {
+    len = text.size() - start;
+    start = end;
+  } else {
+    len = end - start;
+    start = text.find_first_not_of(separators, end + 1);
+  }
+  return token;
+}
+
 /*! Count number of tokens in text.
  *
  * \return   number of counted tokens */
@@ -254,9 +279,12 @@ std::string ValueTokenizer::next_string()
  * \return   value of next token */
 int ValueTokenizer::next_int()
 {
-  std::string current = tokens.next();
-  if (!utils::is_integer(current)) { throw InvalidIntegerException(current); }
-  return atoi(current.c_str());
+  size_t len;
+  const char *current = tokens.next_token(len);
+  int64_t value;
+  if ((utils::parse_int64(current, len, value) != 0) || (value < INT_MIN) || (value > INT_MAX))
+    throw InvalidIntegerException(std::string(current, len));
+  return static_cast<int>(value);
 }
 
 /*! Retrieve next token and convert to bigint
@@ -264,9 +292,13 @@ int ValueTokenizer::next_int()
  * \return   value of next token */
 bigint ValueTokenizer::next_bigint()
 {
-  std::string current = tokens.next();
-  if (!utils::is_integer(current)) { throw InvalidIntegerException(current); }
-  return ATOBIGINT(current.c_str());
+  size_t len;
+  const char *current = tokens.next_token(len);
+  int64_t value;
+  if ((utils::parse_int64(current, len, value) != 0) || (value < -MAXBIGINT - 1) ||
+      (value > MAXBIGINT))
+    throw InvalidIntegerException(std::string(current, len));
+  return static_cast<bigint>(value);
 }
 
 /*! Retrieve next token and convert to tagint
@@ -274,9 +306,13 @@ bigint ValueTokenizer::next_bigint()
  * \return   value of next token */
 tagint ValueTokenizer::next_tagint()
 {
-  std::string current = tokens.next();
-  if (!utils::is_integer(current)) { throw InvalidIntegerException(current); }
-  return ATOTAGINT(current.c_str());
+  size_t len;
+  const char *current = tokens.next_token(len);
+  int64_t value;
+  if ((utils::parse_int64(current, len, value) != 0) || (value < -MAXTAGINT - 1) ||
+      (value > MAXTAGINT))
+    throw InvalidIntegerException(std::string(current, len));
+  return static_cast<tagint>(value);
 }
 
 /*! Retrieve next token and convert to double
@@ -284,9 +320,12 @@ tagint ValueTokenizer::next_tagint()
  * \return   value of next token */
 double ValueTokenizer::next_double()
 {
-  std::string current = tokens.next();
-  if (!utils::is_double(current)) { throw InvalidFloatException(current); }
-  return atof(current.c_str());
+  size_t len;
+  const char *current = tokens.next_token(len);
+  double value;
+  if (utils::parse_double(current, len, value) == 1)
+    throw InvalidFloatException(std::string(current, len));
+  return value;
 }
 
 /*! Skip over a given number of tokens
@@ -47,6 +47,7 @@ class Tokenizer {
   bool has_next() const;
   bool contains(const std::string &str) const;
   std::string next();
+  const char *next_token(size_t &len);
 
   size_t count();
   std::vector<std::string> as_vector();
@@ -31,9 +31,9 @@
 
 #include <cctype>
 #include <cerrno>
+#include <cfloat>
 #include <cstring>
 #include <ctime>
-#include <stdexcept>
 
 /*! \file utils.cpp */
 
@@ -367,55 +367,103 @@ int utils::logical(const char *file, int line, const char *str, bool do_abort, L
 }
 
 /* ----------------------------------------------------------------------
-   read a floating point value from a string
-   generate an error if not a legitimate floating point value
-   called by various commands to check validity of their arguments
+   helper functions for numeric(), inumeric(), bnumeric(), and tnumeric()
+   the string is converted in place and only copied if it contains UTF-8
 ------------------------------------------------------------------------- */
 
-double utils::numeric(const char *file, int line, const std::string &str, bool do_abort,
-                      LAMMPS *lmp)
+static void numeric_error(const char *file, int line, const std::string &msg, bool do_abort,
+                          LAMMPS *lmp)
 {
-  if (str.empty()) {
-    const char msg[] = "Expected floating point parameter instead of"
-                       " NULL or empty string in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
+  if (do_abort)
+    lmp->error->one(file, line, msg);
+  else
+    lmp->error->all(file, line, msg);
+}
 
-  std::string buf(str);
-  if (has_utf8(buf)) buf = utf8_subst(buf);
+static bool has_utf8_chars(const char *str, std::size_t len)
+{
+  for (std::size_t i = 0; i < len; ++i)
+    if (str[i] & 0x80) return true;
+  return false;
+}
 
-  if (!is_double(buf)) {
-    std::string msg("Expected floating point parameter instead of '");
-    msg += buf + "' in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
+static double numeric_value(const char *file, int line, const char *str, std::size_t len,
+                            bool do_abort, LAMMPS *lmp)
+{
+  if (len == 0)
+    numeric_error(file, line,
+                  "Expected floating point parameter instead of"
+                  " NULL or empty string in input script or data file",
+                  do_abort, lmp);
+
+  std::string buf;
+  if (has_utf8_chars(str, len)) {
+    buf = utils::utf8_subst(std::string(str, len));
+    str = buf.c_str();
+    len = buf.size();
   }
 
-  double rv = 0;
-  try {
-    rv = stod(buf);
-  } catch (std::invalid_argument const &) {
-    auto msg = fmt::format("Floating point number {} in input script or data file is invalid", buf);
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  } catch (std::out_of_range const &) {
-    auto msg =
-        fmt::format("Floating point number {} in input script or data file is out of range", buf);
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
+  double rv = 0.0;
+  int status = utils::parse_double(str, len, rv);
+  if (status == 1)
+    numeric_error(file, line,
+                  fmt::format("Expected floating point parameter instead of '{}' in input "
+                              "script or data file",
+                              std::string(str, len)),
+                  do_abort, lmp);
+  else if (status == 2)
+    numeric_error(file, line,
+                  fmt::format("Floating point number {} in input script or data file is out of "
+                              "range",
+                              std::string(str, len)),
+                  do_abort, lmp);
+  return rv;
+}
+
+static int64_t integer_value(const char *file, int line, const char *str, std::size_t len,
+                             int64_t minval, int64_t maxval, bool do_abort, LAMMPS *lmp)
+{
+  if (len == 0)
+    numeric_error(file, line,
+                  "Expected integer parameter instead of"
+                  " NULL or empty string in input script or data file",
+                  do_abort, lmp);
+
+  std::string buf;
+  if (has_utf8_chars(str, len)) {
+    buf = utils::utf8_subst(std::string(str, len));
+    str = buf.c_str();
+    len = buf.size();
   }
+
+  int64_t rv = 0;
+  int status = utils::parse_int64(str, len, rv);
+  if (status == 1)
+    numeric_error(file, line,
+                  fmt::format("Expected integer parameter instead of '{}' in input script or "
+                              "data file",
+                              std::string(str, len)),
+                  do_abort, lmp);
+  else if ((status == 2) || (rv < minval) || (rv > maxval))
+    numeric_error(file, line,
+                  fmt::format("Integer {} in input script or data file is out of range",
+                              std::string(str, len)),
+                  do_abort, lmp);
   return rv;
 }
 
+/* ----------------------------------------------------------------------
+   read a floating point value from a string
+   generate an error if not a legitimate floating point value
+   called by various commands to check validity of their arguments
+------------------------------------------------------------------------- */
+
+double utils::numeric(const char *file, int line, const std::string &str, bool do_abort,
+                      LAMMPS *lmp)
+{
+  return numeric_value(file, line, str.c_str(), str.size(), do_abort, lmp);
+}
+
 /* ----------------------------------------------------------------------
    wrapper for numeric() that accepts a char pointer instead of a string
 ------------------------------------------------------------------------- */
@@ -423,9 +471,9 @@ double utils::numeric(const char *file, int line, const std::string &str, bool d
 double utils::numeric(const char *file, int line, const char *str, bool do_abort, LAMMPS *lmp)
 {
   if (str)
-    return numeric(file, line, std::string(str), do_abort, lmp);
+    return numeric_value(file, line, str, strlen(str), do_abort, lmp);
   else
-    return numeric(file, line, std::string(""), do_abort, lmp);
+    return numeric_value(file, line, "", 0, do_abort, lmp);
 }
 
 /* ----------------------------------------------------------------------
@@ -436,38 +484,8 @@ double utils::numeric(const char *file, int line, const char *str, bool do_abort
 
 int utils::inumeric(const char *file, int line, const std::string &str, bool do_abort, LAMMPS *lmp)
 {
-  if (str.empty()) {
-    const char msg[] = "Expected integer parameter instead of"
-                       " NULL or empty string in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  std::string buf(str);
-  if (has_utf8(buf)) buf = utf8_subst(buf);
-
-  if (!is_integer(buf)) {
-    std::string msg("Expected integer parameter instead of '");
-    msg += buf + "' in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  int rv = 0;
-  try {
-    rv = stoi(buf);
-  } catch (std::out_of_range const &) {
-    auto msg = fmt::format("Integer {} in input script or data file is out of range", buf);
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-  return rv;
+  return static_cast<int>(
+      integer_value(file, line, str.c_str(), str.size(), INT_MIN, INT_MAX, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -477,9 +495,10 @@ int utils::inumeric(const char *file, int line, const std::string &str, bool do_
 int utils::inumeric(const char *file, int line, const char *str, bool do_abort, LAMMPS *lmp)
 {
   if (str)
-    return inumeric(file, line, std::string(str), do_abort, lmp);
+    return static_cast<int>(
+        integer_value(file, line, str, strlen(str), INT_MIN, INT_MAX, do_abort, lmp));
   else
-    return inumeric(file, line, std::string(""), do_abort, lmp);
+    return static_cast<int>(integer_value(file, line, "", 0, INT_MIN, INT_MAX, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -491,39 +510,8 @@ int utils::inumeric(const char *file, int line, const char *str, bool do_abort,
 bigint utils::bnumeric(const char *file, int line, const std::string &str, bool do_abort,
                        LAMMPS *lmp)
 {
-  if (str.empty()) {
-    const char msg[] = "Expected integer parameter instead of"
-                       " NULL or empty string in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  std::string buf(str);
-  if (has_utf8(buf)) buf = utf8_subst(buf);
-
-  if (!is_integer(buf)) {
-    std::string msg("Expected integer parameter instead of '");
-    msg += buf + "' in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  long long rv = 0;
-  try {
-    rv = stoll(buf);
-    if (rv > MAXBIGINT) throw std::out_of_range("64-bit");
-  } catch (std::out_of_range const &) {
-    auto msg = fmt::format("Integer {} in input script or data file is out of range", buf);
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-  return static_cast<bigint>(rv);
+  return static_cast<bigint>(integer_value(file, line, str.c_str(), str.size(), -MAXBIGINT - 1,
+                                           MAXBIGINT, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -533,9 +521,11 @@ bigint utils::bnumeric(const char *file, int line, const std::string &str, bool
 bigint utils::bnumeric(const char *file, int line, const char *str, bool do_abort, LAMMPS *lmp)
 {
   if (str)
-    return bnumeric(file, line, std::string(str), do_abort, lmp);
+    return static_cast<bigint>(
+        integer_value(file, line, str, strlen(str), -MAXBIGINT - 1, MAXBIGINT, do_abort, lmp));
   else
-    return bnumeric(file, line, std::string(""), do_abort, lmp);
+    return static_cast<bigint>(
+        integer_value(file, line, "", 0, -MAXBIGINT - 1, MAXBIGINT, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -547,39 +537,8 @@ bigint utils::bnumeric(const char *file, int line, const char *str, bool do_abor
 tagint utils::tnumeric(const char *file, int line, const std::string &str, bool do_abort,
                        LAMMPS *lmp)
 {
-  if (str.empty()) {
-    const char msg[] = "Expected integer parameter instead of"
-                       " NULL or empty string in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  std::string buf(str);
-  if (has_utf8(buf)) buf = utf8_subst(buf);
-
-  if (!is_integer(buf)) {
-    std::string msg("Expected integer parameter instead of '");
-    msg += buf + "' in input script or data file";
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-
-  long long rv = 0;
-  try {
-    rv = stoll(buf);
-    if (rv > MAXTAGINT) throw std::out_of_range("64-bit");
-  } catch (std::out_of_range const &) {
-    auto msg = fmt::format("Integer {} in input script or data file is out of range", buf);
-    if (do_abort)
-      lmp->error->one(file, line, msg);
-    else
-      lmp->error->all(file, line, msg);
-  }
-  return static_cast<tagint>(rv);
+  return static_cast<tagint>(integer_value(file, line, str.c_str(), str.size(), -MAXTAGINT - 1,
+                                           MAXTAGINT, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -589,9 +548,11 @@ tagint utils::tnumeric(const char *file, int line, const std::string &str, bool
 tagint utils::tnumeric(const char *file, int line, const char *str, bool do_abort, LAMMPS *lmp)
 {
   if (str)
-    return tnumeric(file, line, std::string(str), do_abort, lmp);
+    return static_cast<tagint>(
+        integer_value(file, line, str, strlen(str), -MAXTAGINT - 1, MAXTAGINT, do_abort, lmp));
   else
-    return tnumeric(file, line, std::string(""), do_abort, lmp);
+    return static_cast<tagint>(
+        integer_value(file, line, "", 0, -MAXTAGINT - 1, MAXTAGINT, do_abort, lmp));
 }
 
 /* ----------------------------------------------------------------------
@@ -1403,9 +1364,8 @@ std::vector<std::string> utils::split_lines(const std::string &text)
 
 bool utils::is_integer(const std::string &str)
 {
-  if (str.empty()) return false;
-
-  return strmatch(str, "^[+-]?\\d+$");
+  int64_t value;
+  return parse_int64(str.c_str(), str.size(), value) != 1;
 }
 
 /* ----------------------------------------------------------------------
@@ -1414,11 +1374,130 @@ bool utils::is_integer(const std::string &str)
 
 bool utils::is_double(const std::string &str)
 {
-  if (str.empty()) return false;
+  double value;
+  return parse_double(str.c_str(), str.size(), value) != 1;
+}
 
-  return strmatch(str, "^[+-]?\\d+\\.?\\d*$") ||
-      strmatch(str, "^[+-]?\\d+\\.?\\d*[eE][+-]?\\d+$") || strmatch(str, "^[+-]?\\d*\\.?\\d+$") ||
-      strmatch(str, "^[+-]?\\d*\\.?\\d+[eE][+-]?\\d+$");
+/* ----------------------------------------------------------------------
+   convert character range to floating-point number, see utils.h
+   syntax is [+-]?digits[.digits][(e|E)[+-]?digits] with at least one
+     mantissa digit, same as accepted by is_double()
+   numbers with at most 53 bits of mantissa and a decimal exponent
+     of at most 22 are exactly representable as products or quotients
+     of two doubles, so they are converted directly with correct rounding,
+     all others are passed to strtod()
+------------------------------------------------------------------------- */
+
+int utils::parse_double(const char *str, std::size_t len, double &value)
+{
+  static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const uint64_t maxmantissa = (uint64_t) 1 << 53;
+
+  const char *ptr = str;
+  const char *end = str + len;
+  bool negative = false;
+  if ((ptr < end) && ((*ptr == '+') || (*ptr == '-'))) negative = (*ptr++ == '-');
+
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  int ndigits = 0;
+  bool exact = true;
+  while ((ptr < end) && (*ptr >= '0') && (*ptr <= '9')) {
+    if (mantissa < maxmantissa / 10)
+      mantissa = 10 * mantissa + (*ptr - '0');
+    else
+      exact = false;
+    ++ndigits;
+    ++ptr;
+  }
+  if ((ptr < end) && (*ptr == '.')) {
+    ++ptr;
+    while ((ptr < end) && (*ptr >= '0') && (*ptr <= '9')) {
+      if (mantissa < maxmantissa / 10) {
+        mantissa = 10 * mantissa + (*ptr - '0');
+        --exponent;
+      } else
+        exact = false;
+      ++ndigits;
+      ++ptr;
+    }
+  }
+  if (ndigits == 0) return 1;
+
+  if ((ptr < end) && ((*ptr == 'e') || (*ptr == 'E'))) {
+    ++ptr;
+    bool negexp = false;
+    if ((ptr < end) && ((*ptr == '+') || (*ptr == '-'))) negexp = (*ptr++ == '-');
+    if ((ptr == end) || (*ptr < '0') || (*ptr > '9')) return 1;
+    int expval = 0;
+    while ((ptr < end) && (*ptr >= '0') && (*ptr <= '9')) {
+      if (expval < 100000) expval = 10 * expval + (*ptr - '0');
+      ++ptr;
+    }
+    exponent += negexp ? -expval : expval;
+  }
+  if (ptr != end) return 1;
+
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+  if (exact && (exponent >= -22) && (exponent <= 22)) {
+    value = (double) mantissa;
+    if (exponent < 0)
+      value /= pow10[-exponent];
+    else
+      value *= pow10[exponent];
+    if (negative) value = -value;
+    return 0;
+  }
+#endif
+
+  // strtod() requires a terminated string, but str may be followed by other text
+
+  char tmp[64];
+  std::string buf;
+  const char *number = tmp;
+  if (len < sizeof(tmp)) {
+    memcpy(tmp, str, len);
+    tmp[len] = '\0';
+  } else {
+    buf.assign(str, len);
+    number = buf.c_str();
+  }
+  errno = 0;
+  value = strtod(number, nullptr);
+  return (errno == ERANGE) ? 2 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   convert character range to 64-bit integer, see utils.h
+   syntax is [+-]?digits, same as accepted by is_integer()
+------------------------------------------------------------------------- */
+
+int utils::parse_int64(const char *str, std::size_t len, int64_t &value)
+{
+  const char *ptr = str;
+  const char *end = str + len;
+  bool negative = false;
+  if ((ptr < end) && ((*ptr == '+') || (*ptr == '-'))) negative = (*ptr++ == '-');
+  if (ptr == end) return 1;
+
+  const uint64_t limit = negative ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+  uint64_t result = 0;
+  bool overflow = false;
+  for (; ptr < end; ++ptr) {
+    if ((*ptr < '0') || (*ptr > '9')) return 1;
+    uint64_t digit = *ptr - '0';
+    if (result > (limit - digit) / 10) overflow = true;
+    if (!overflow) result = 10 * result + digit;
+  }
+  if (overflow) return 2;
+
+  if (negative)
+    value = (result == (uint64_t) INT64_MAX + 1) ? INT64_MIN : -(int64_t) result;
+  else
+    value = (int64_t) result;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
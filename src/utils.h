@@ -513,6 +513,18 @@ or the *-suffix/-sf* command line flag and return correspondingly modified strin
     return false;
   }
 
+  /*! \overload
+   *
+   * \param line  NUL terminated C-string that should be checked
+   * \return true if string contains UTF-8 encoded characters (bool) */
+
+  inline bool has_utf8(const char *line)
+  {
+    for (; *line; ++line)
+      if (*line & 0x80U) return true;
+    return false;
+  }
+
   /*! Replace known UTF-8 characters with ASCII equivalents
    *
 \verbatim embed:rst
@@ -606,6 +618,32 @@ or the *-suffix/-sf* command line flag and return correspondingly modified strin
 
   bool is_double(const std::string &str);
 
+  /*! Convert a character range to a floating-point number without allocating memory
+   *
+   * The characters need not be NUL terminated. The range is accepted
+   * if it is a valid floating-point number as checked by is_double().
+   * If the number is outside the representable range, *value* is set
+   * to the value returned by strtod() and 2 is returned.
+   *
+   * \param str    pointer to first character
+   * \param len    number of characters
+   * \param value  converted number
+   * \return 0 on success, 1 if not a valid number, 2 if out of range */
+
+  int parse_double(const char *str, std::size_t len, double &value);
+
+  /*! Convert a character range to a 64-bit integer number without allocating memory
+   *
+   * The characters need not be NUL terminated. The range is accepted
+   * if it is a valid integer number as checked by is_integer().
+   *
+   * \param str    pointer to first character
+   * \param len    number of characters
+   * \param value  converted number
+   * \return 0 on success, 1 if not a valid number, 2 if out of range */
+
+  int parse_int64(const char *str, std::size_t len, int64_t &value);
+
   /*! Check if string is a valid ID
    * ID strings may contain only letters, numbers, and underscores.
    *
@@ -1523,7 +1523,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_SCALAR)) {
-              compute->compute_scalar();
+              compute->invoke_scalar();
               compute->invoked_flag |= Compute::INVOKED_SCALAR;
             }
 
@@ -1540,7 +1540,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
-              compute->compute_vector();
+              compute->invoke_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
 
@@ -1565,7 +1565,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
-              compute->compute_array();
+              compute->invoke_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
 
@@ -1590,7 +1590,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
-              compute->compute_peratom();
+              compute->invoke_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
 
@@ -1611,7 +1611,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
-              compute->compute_peratom();
+              compute->invoke_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
 
@@ -1641,7 +1641,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
-              compute->compute_vector();
+              compute->invoke_vector();
               compute->invoked_flag |= Compute::INVOKED_VECTOR;
             }
 
@@ -1670,7 +1670,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
             if (index1 > compute->size_array_cols)
               print_var_error(FLERR,"Variable formula compute array is accessed out-of-range",ivar,0);
             if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
-              compute->compute_array();
+              compute->invoke_array();
               compute->invoked_flag |= Compute::INVOKED_ARRAY;
             }
 
@@ -1707,7 +1707,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
-              compute->compute_peratom();
+              compute->invoke_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
 
@@ -1731,7 +1731,7 @@ double Variable::evaluate(char *str, Tree **tree, int ivar)
               print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                               "initialization by a run",ivar);
             if (!(compute->invoked_flag & Compute::INVOKED_PERATOM)) {
-              compute->compute_peratom();
+              compute->invoke_peratom();
               compute->invoked_flag |= Compute::INVOKED_PERATOM;
             }
 
@@ -4385,7 +4385,7 @@ int Variable::special_function(char *word, char *contents, Tree **tree, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_VECTOR)) {
-          compute->compute_vector();
+          compute->invoke_vector();
           compute->invoked_flag |= Compute::INVOKED_VECTOR;
         }
         nvec = compute->size_vector;
@@ -4397,7 +4397,7 @@ int Variable::special_function(char *word, char *contents, Tree **tree, Tree **t
           print_var_error(FLERR,"Variable formula compute cannot be invoked before "
                           "initialization by a run",ivar);
         if (!(compute->invoked_flag & Compute::INVOKED_ARRAY)) {
-          compute->compute_array();
+          compute->invoke_array();
           compute->invoked_flag |= Compute::INVOKED_ARRAY;
         }
         nvec = compute->size_array_rows;
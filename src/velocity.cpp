@@ -207,7 +207,7 @@ void Velocity::create(double t_desired, int seed)
   // for some temperature computes, must first calculate temp to do that
 
   if (bias_flag) {
-    temperature->compute_scalar();
+    temperature->invoke_scalar();
     temperature->remove_bias_all();
   }
 
@@ -363,8 +363,8 @@ void Velocity::create(double t_desired, int seed)
 
   double t;
   if ((bias_flag == 0) || (temperature_nobias == nullptr))
-    t = temperature->compute_scalar();
-  else t = temperature_nobias->compute_scalar();
+    t = temperature->invoke_scalar();
+  else t = temperature_nobias->invoke_scalar();
   rescale(t,t_desired);
 
   // if bias_flag set, restore bias velocity to all atoms
@@ -590,10 +590,10 @@ void Velocity::scale(int /*narg*/, char **arg)
   //   remove/restore bias velocities before/after rescale
 
   if (bias_flag == 0) {
-    double t = temperature->compute_scalar();
+    double t = temperature->invoke_scalar();
     rescale(t,t_desired);
   } else {
-    double t = temperature->compute_scalar();
+    double t = temperature->invoke_scalar();
     temperature->remove_bias_all();
     rescale(t,t_desired);
     temperature->restore_bias_all();
@@ -84,6 +84,17 @@ void Verlet::init()
   // orthogonal vs triclinic simulation box
 
   triclinic = domain->triclinic;
+
+  // overlap of forward/reverse comm with pair forces
+  // pair compute() must be splittable by rows of its neighbor list
+
+  overlapflag = 0;
+  if (comm->overlap) {
+    if (pair_compute_flag && force->pair->overlap_enable) overlapflag = 1;
+    else if (comm->me == 0)
+      error->warning(FLERR,"Comm_modify overlap is not supported by pair style {}",
+                     force->pair_style);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -229,7 +240,7 @@ void Verlet::setup_minimal(int flag)
 void Verlet::run(int n)
 {
   bigint ntimestep;
-  int nflag,sortflag;
+  int nflag,sortflag,overlap,overlap_reverse;
 
   int n_post_integrate = modify->n_post_integrate;
   int n_pre_exchange = modify->n_pre_exchange;
@@ -261,12 +272,23 @@ void Verlet::run(int n)
 
     // regular communication vs neighbor list rebuild
 
-    nflag = neighbor->decide();
+    nflag = neighbor->decide(1);
+
+    // overlap comm with pair forces of atoms with only owned neighbors
+    // not on steps that tally energy or virial or need ghosts before pair
+
+    overlap = overlapflag && (nflag == 0) && !neighbor->partial_pending &&
+      !eflag && !vflag && !n_pre_force;
 
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
-      timer->stamp(Timer::COMM);
+      if (overlap) comm->forward_comm_start();
+      else comm->forward_comm();
+      timer->stamp(Timer::COMM,"forward comm");
+      if (neighbor->partial_pending) {
+        neighbor->build_partial();
+        timer->stamp(Timer::NEIGH,"partial neighbor build");
+      }
     } else {
       if (n_pre_exchange) {
         timer->stamp();
@@ -282,16 +304,20 @@ void Verlet::run(int n)
       }
       timer->stamp();
       comm->exchange();
-      if (sortflag && ntimestep >= atom->nextsort) atom->sort();
+      timer->stamp(Timer::COMM,"exchange");
+      if (sortflag && ntimestep >= atom->nextsort) {
+        atom->sort();
+        timer->stamp(Timer::COMM,"sort");
+      }
       comm->borders();
       if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
-      timer->stamp(Timer::COMM);
+      timer->stamp(Timer::COMM,"borders");
       if (n_pre_neighbor) {
         modify->pre_neighbor();
         timer->stamp(Timer::MODIFY);
       }
       neighbor->build(1);
-      timer->stamp(Timer::NEIGH);
+      timer->stamp(Timer::NEIGH,"neighbor build");
       if (n_post_neighbor) {
         modify->post_neighbor();
         timer->stamp(Timer::MODIFY);
@@ -313,8 +339,17 @@ void Verlet::run(int n)
     }
 
     if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
-      timer->stamp(Timer::PAIR);
+      if (overlap) {
+        force->pair->compute_interior();
+        timer->stamp(Timer::PAIR,"pair interior");
+        comm->forward_comm_finish();
+        timer->stamp(Timer::COMM,"forward comm finish");
+        force->pair->compute_boundary();
+        timer->stamp(Timer::PAIR,"pair boundary");
+      } else {
+        force->pair->compute(eflag,vflag);
+        timer->stamp(Timer::PAIR);
+      }
     }
 
     if (atom->molecular != Atom::ATOMIC) {
@@ -325,6 +360,17 @@ void Verlet::run(int n)
       timer->stamp(Timer::BOND);
     }
 
+    // forces on ghost atoms are complete unless KSpace or a fix adds to them,
+    // so the reverse comm can overlap with KSpace
+
+    overlap_reverse = overlap && force->newton && !n_pre_reverse &&
+      !(kspace_compute_flag && force->kspace->tip4pflag);
+
+    if (overlap_reverse) {
+      comm->reverse_comm_start();
+      timer->stamp(Timer::COMM,"reverse comm start");
+    }
+
     if (kspace_compute_flag) {
       force->kspace->compute(eflag,vflag);
       timer->stamp(Timer::KSPACE);
@@ -338,8 +384,9 @@ void Verlet::run(int n)
     // reverse communication of forces
 
     if (force->newton) {
-      comm->reverse_comm();
-      timer->stamp(Timer::COMM);
+      if (overlap_reverse) comm->reverse_comm_finish();
+      else comm->reverse_comm();
+      timer->stamp(Timer::COMM,"reverse comm");
     }
 
     // force modifications, final time integration, diagnostics
@@ -37,6 +37,7 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+  int overlapflag;    // 1 if comm may overlap with pair forces
 };
 
 }    // namespace LAMMPS_NS
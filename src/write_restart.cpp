@@ -36,11 +36,28 @@
 #include "update.h"
 
 #include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
 
 #include "lmprestart.h"
 
 using namespace LAMMPS_NS;
 
+// max # of doubles in one MPI-IO call, so that counts fit into an int
+
+static constexpr int MAXCHUNK = 1 << 27;
+
+// per-atom data of all procs in my cluster, written by a background thread
+
+struct WriteRestart::AsyncWriter {
+  std::thread thread;
+  std::vector<double> data;
+  std::vector<int> sizes;
+  std::string file;
+  std::string errmesg;
+};
+
 /* ---------------------------------------------------------------------- */
 
 WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
@@ -48,8 +65,19 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
   multiproc = 0;
+  mpiioflag = 0;
+  asyncflag = 0;
   noinit = 0;
   fp = nullptr;
+  async = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  sync(0);
+  delete async;
 }
 
 /* ----------------------------------------------------------------------
@@ -69,17 +97,17 @@ void WriteRestart::command(int narg, char **arg)
   if (found != std::string::npos)
     file.replace(found,1,fmt::format("{}",update->ntimestep));
 
-  // check for multiproc output and an MPI-IO filename
+  // check for multiproc output
+  // an MPI-IO filename is detected by write()
 
   if (strchr(arg[0],'%')) multiproc = nprocs;
   else multiproc = 0;
-  if (utils::strmatch(arg[0],"\\.mpiio$"))
-    error->all(FLERR,"MPI-IO files are no longer supported by LAMMPS");
 
   // setup output style and process optional args
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,narg-1,&arg[1]);
+  if (asyncflag) error->all(FLERR,"Write_restart does not support async, use the restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -179,6 +207,11 @@ void WriteRestart::multiproc_options(int multiproc_caller, int narg, char **arg)
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "restart async", error);
+      asyncflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (asyncflag && !async) async = new AsyncWriter;
+      iarg += 2;
     } else error->all(FLERR,"Unknown write_restart keyword: {}", arg[iarg]);
   }
 }
@@ -190,6 +223,18 @@ void WriteRestart::multiproc_options(int multiproc_caller, int narg, char **arg)
 
 void WriteRestart::write(const std::string &file)
 {
+  // MPI-IO output to a single file is selected by the file name
+
+  mpiioflag = utils::strmatch(file,"\\.mpiio$") ? 1 : 0;
+  if (multiproc && mpiioflag)
+    error->all(FLERR,"Restart file name cannot use both % and .mpiio");
+  if (asyncflag && mpiioflag)
+    error->all(FLERR,"Restart async cannot be used with MPI-IO restart files");
+
+  // wait until the previous restart file is written completely
+
+  if (asyncflag) sync();
+
   // special case where reneighboring is not done in integrator
   //   on timestep restart file is written (due to build_once being set)
   // if box is changing, must be reset, else restart file will have
@@ -254,35 +299,6 @@ void WriteRestart::write(const std::string &file)
   memory->create(buf,max_size,"write_restart:buf");
   memset(buf,0,max_size*sizeof(double));
 
-  // all procs write file layout info which may include per-proc sizes
-
-  file_layout(send_size);
-
-  // header info is complete
-  // if multiproc output:
-  //   close header file, open multiname file on each writing proc,
-  //   write PROCSPERFILE into new file
-
-  int io_error = 0;
-  if (multiproc) {
-    if (me == 0 && fp) {
-      magic_string();
-      if (ferror(fp)) io_error = 1;
-      fclose(fp);
-      fp = nullptr;
-    }
-
-    std::string multiname = file;
-    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
-
-    if (filewriter) {
-      fp = fopen(multiname.c_str(),"wb");
-      if (fp == nullptr)
-        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
-      write_int(PROCSPERFILE,nclusterprocs);
-    }
-  }
-
   // pack my atom data into buf
 
   AtomVec *avec = atom->avec;
@@ -338,14 +354,86 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
-  // output of one or more native files
-  // filewriter = 1 = this proc writes to file
-  // ping each proc in my cluster, receive its data, write data to file
-  // else wait for ping from fileproc, send my data to fileproc
+  // all procs write file layout info which may include per-proc sizes
+
+  file_layout(send_size);
+
+  // header info is complete
+  // if multiproc output:
+  //   close header file, open multiname file on each writing proc,
+  //   write PROCSPERFILE into new file
+
+  int io_error = 0;
+  if (multiproc) {
+    if (me == 0 && fp) {
+      magic_string();
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+
+    std::string multiname = file;
+    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
+
+    if (filewriter) {
+      fp = fopen(multiname.c_str(),"wb");
+      if (fp == nullptr)
+        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
+      write_int(PROCSPERFILE,nclusterprocs);
+    }
+  }
+
+  // MPI-IO output to a single file:
+  //   proc 0 closes the file after the header, then all procs write their data
+  // output of one or more native files:
+  //   filewriter = 1 = this proc writes to file
+  //   ping each proc in my cluster, receive its data, write data to file
+  //   else wait for ping from fileproc, send my data to fileproc
 
   int tmp,recv_size;
 
-  if (filewriter) {
+  if (mpiioflag) {
+    bigint header_size = 0;
+    if (me == 0) {
+      header_size = platform::ftell(fp);
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+    MPI_Bcast(&header_size,1,MPI_LMP_BIGINT,0,world);
+    if (write_mpiio(file,header_size,send_size,buf)) io_error = 1;
+
+  } else if (filewriter && asyncflag) {
+
+    // collect data of my cluster into memory and write it in background
+    // received directly into the snapshot, the capacity is retained
+
+    auto &data = async->data;
+    data.clear();
+    async->sizes.clear();
+    async->file = file;
+
+    MPI_Status status;
+    MPI_Request request;
+    for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+      bigint start = data.size();
+      if (iproc) {
+        data.resize(start + max_size);
+        MPI_Irecv(data.data() + start,max_size,MPI_DOUBLE,me+iproc,0,world,&request);
+        MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+        MPI_Wait(&request,&status);
+        MPI_Get_count(&status,MPI_DOUBLE,&recv_size);
+      } else {
+        recv_size = send_size;
+        data.resize(start + recv_size);
+        if (recv_size) memcpy(data.data() + start,buf,recv_size*sizeof(double));
+      }
+      data.resize(start + recv_size);
+      async->sizes.push_back(recv_size);
+    }
+    async_write();
+
+  } else if (filewriter) {
     MPI_Status status;
     MPI_Request request;
     for (int iproc = 0; iproc < nclusterprocs; iproc++) {
@@ -385,6 +473,49 @@ void WriteRestart::write(const std::string &file)
       fix->write_restart_file(file.c_str());
 }
 
+/* ----------------------------------------------------------------------
+   start background thread which writes the per-atom data of the snapshot,
+   the final magic string and closes the file
+   only one restart file can be in flight, the next call to write()
+     waits for the thread via sync()
+------------------------------------------------------------------------- */
+
+void WriteRestart::async_write()
+{
+  async->thread = std::thread([this] {
+    try {
+      bigint offset = 0;
+      for (const auto &size : async->sizes) {
+        write_double_vec(PERPROC,size,async->data.data() + offset);
+        offset += size;
+      }
+      magic_string();
+      if (ferror(fp)) async->errmesg = utils::getsyserror();
+    } catch (std::exception &e) {
+      async->errmesg = e.what();
+    }
+    if (fclose(fp) && async->errmesg.empty()) async->errmesg = utils::getsyserror();
+    fp = nullptr;
+  });
+}
+
+/* ----------------------------------------------------------------------
+   wait until the background thread has written the previous restart file
+   report = 1 to stop with an error if the thread failed, 0 to ignore it
+------------------------------------------------------------------------- */
+
+void WriteRestart::sync(int report)
+{
+  if (!async || !async->thread.joinable()) return;
+
+  async->thread.join();
+  if (!async->errmesg.empty()) {
+    std::string mesg = async->errmesg;
+    async->errmesg.clear();
+    if (report) error->one(FLERR,"I/O error while writing restart file {}: {}", async->file, mesg);
+  }
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes out problem description
 ------------------------------------------------------------------------- */
@@ -462,6 +593,7 @@ void WriteRestart::header()
   write_int(ATOM_MAP_USER,atom->map_user);
   write_int(ATOM_SORTFREQ,atom->sortfreq);
   write_double(ATOM_SORTBIN,atom->userbinsize);
+  write_int(ATOM_SORTORDER,atom->sortorder);
 
   write_int(COMM_MODE,comm->mode);
   write_double(COMM_CUTOFF,comm->cutghostuser);
@@ -547,12 +679,25 @@ void WriteRestart::force_fields()
 /* ----------------------------------------------------------------------
    proc 0 writes out file layout info
    all procs call this method, only proc 0 writes to file
+   for MPI-IO, the per-proc sizes allow reading the file with any # of procs
 ------------------------------------------------------------------------- */
 
-void WriteRestart::file_layout(int /*send_size*/)
+void WriteRestart::file_layout(int send_size)
 {
   if (me == 0) write_int(MULTIPROC,multiproc);
 
+  if (mpiioflag) {
+    bigint mysize = send_size;
+    bigint *all_send_sizes = nullptr;
+    if (me == 0) memory->create(all_send_sizes,nprocs,"write_restart:all_send_sizes");
+    MPI_Gather(&mysize,1,MPI_LMP_BIGINT,all_send_sizes,1,MPI_LMP_BIGINT,0,world);
+    if (me == 0) {
+      write_int(MPIIO,mpiioflag);
+      write_bigint_vec(PROCSPERFILE,nprocs,all_send_sizes);
+    }
+    memory->destroy(all_send_sizes);
+  }
+
   // -1 flag signals end of file layout info
 
   if (me == 0) {
@@ -561,6 +706,60 @@ void WriteRestart::file_layout(int /*send_size*/)
   }
 }
 
+/* ----------------------------------------------------------------------
+   all procs write their per-atom data into a single file with MPI-IO
+   header_size = # of bytes of header info written before by proc 0
+   offset of my data follows from sizes of all lower procs
+   proc 0 appends the magic string after the data of the last proc
+   return 1 if an I/O error occurred on this proc, else 0
+------------------------------------------------------------------------- */
+
+int WriteRestart::write_mpiio(const std::string &file, bigint header_size,
+                              int send_size, double *buf)
+{
+  bigint mysize = send_size;
+  bigint myoffset = 0;
+  bigint total;
+  MPI_Exscan(&mysize,&myoffset,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (me == 0) myoffset = 0;
+  MPI_Allreduce(&mysize,&total,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  MPI_File fh;
+  int err = MPI_File_open(world,file.c_str(),MPI_MODE_WRONLY,MPI_INFO_NULL,&fh);
+  int err_any;
+  MPI_Allreduce(&err,&err_any,1,MPI_INT,MPI_MAX,world);
+  if (err_any != MPI_SUCCESS) {
+    if (err == MPI_SUCCESS) MPI_File_close(&fh);
+    error->all(FLERR,"Cannot open MPI-IO restart file {}",file);
+  }
+
+  // collective writes in pieces of at most MAXCHUNK doubles
+  // all procs must make the same # of calls
+
+  int io_error = 0;
+  bigint nchunk = (mysize + MAXCHUNK - 1) / MAXCHUNK;
+  bigint maxchunk;
+  MPI_Allreduce(&nchunk,&maxchunk,1,MPI_LMP_BIGINT,MPI_MAX,world);
+
+  for (bigint i = 0; i < maxchunk; i++) {
+    bigint first = MIN(i * MAXCHUNK,mysize);
+    int count = static_cast<int> (MIN(mysize - first,MAXCHUNK));
+    MPI_Offset where = header_size + (myoffset + first) * sizeof(double);
+    if (MPI_File_write_at_all(fh,where,&buf[first],count,MPI_DOUBLE,MPI_STATUS_IGNORE)
+        != MPI_SUCCESS) io_error = 1;
+  }
+
+  if (me == 0) {
+    const char magic[] = MAGIC_STRING;
+    MPI_Offset where = header_size + total * sizeof(double);
+    if (MPI_File_write_at(fh,where,magic,strlen(magic)+1,MPI_CHAR,MPI_STATUS_IGNORE)
+        != MPI_SUCCESS) io_error = 1;
+  }
+
+  if (MPI_File_close(&fh) != MPI_SUCCESS) io_error = 1;
+  return io_error;
+}
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // low-level fwrite methods
@@ -645,6 +844,17 @@ void WriteRestart::write_int_vec(int flag, int n, int *vec)
   fwrite(vec,sizeof(int),n,fp);
 }
 
+/* ----------------------------------------------------------------------
+   write a flag and vector of N bigints into the restart file
+------------------------------------------------------------------------- */
+
+void WriteRestart::write_bigint_vec(int flag, int n, bigint *vec)
+{
+  fwrite(&flag,sizeof(int),1,fp);
+  fwrite(&n,sizeof(int),1,fp);
+  fwrite(vec,sizeof(bigint),n,fp);
+}
+
 /* ----------------------------------------------------------------------
    write a flag and vector of N doubles into the restart file
 ------------------------------------------------------------------------- */
@@ -27,9 +27,11 @@ namespace LAMMPS_NS {
 class WriteRestart : public Command {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart() override;
   void command(int, char **) override;
   void multiproc_options(int, int, char **);
   void write(const std::string &);
+  void sync(int report = 1);
 
  private:
   int me, nprocs;
@@ -43,11 +45,18 @@ class WriteRestart : public Command {
   int filewriter;       // 1 if this proc writes a file, else 0
   int fileproc;         // ID of proc in my cluster who writes to file
   int icluster;         // which cluster I am in
+  int mpiioflag;        // 1 = all procs write one file with MPI-IO
+  int asyncflag;        // 1 = per-atom data is written by a background thread
+
+  struct AsyncWriter;    // data of background thread for asynchronous output
+  AsyncWriter *async;
 
   void header();
   void type_arrays();
   void force_fields();
   void file_layout(int);
+  int write_mpiio(const std::string &, bigint, int, double *);
+  void async_write();
 
   void magic_string();
   void endian();
@@ -58,6 +67,7 @@ class WriteRestart : public Command {
   void write_double(int, double);
   void write_string(int, const std::string &);
   void write_int_vec(int, int, int *);
+  void write_bigint_vec(int, int, bigint *);
   void write_double_vec(int, int, double *);
 };
 }    // namespace LAMMPS_NS
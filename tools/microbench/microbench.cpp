@@ -0,0 +1,514 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// Microbenchmarks for performance critical kernels of LAMMPS.
+// Synthetic systems are set up in-process and individual kernels
+// (neighbor list builds, pair styles, per-atom communication buffers,
+// distributed FFTs and remaps, text parsing) are called directly and timed.
+
+#include "atom.h"
+#include "atom_vec.h"
+#include "force.h"
+#include "input.h"
+#include "lammps.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "npair.h"
+#include "pair.h"
+#include "platform.h"
+#include "tokenizer.h"
+#include "utils.h"
+#include "version.h"
+
+#if defined(LMP_MICROBENCH_KSPACE)
+#include "fft3d.h"
+#include "remap.h"
+#endif
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+namespace {
+
+struct Settings {
+  int ncell = 16;           // lattice cells per dimension of the synthetic systems
+  int ngrid = 64;           // FFT grid points per dimension
+  double mintime = 0.5;     // minimum time for a measurement in seconds
+  std::string filter;       // run only benchmarks matching this regex
+  std::string yamlfile;     // write results to this file in YAML format
+};
+
+struct Result {
+  std::string name;
+  bigint items;        // atoms or grid points processed per call
+  double time;         // seconds per call
+  double bytes;        // bytes processed per call, 0.0 if not applicable
+};
+
+Settings settings;
+std::vector<Result> results;
+int me = 0;
+
+/* ----------------------------------------------------------------------
+   call kernel until it ran for at least mintime seconds on all procs
+   the number of calls is doubled (or extrapolated) until that is reached
+   return time per call, maximum over all procs
+------------------------------------------------------------------------- */
+
+double measure(const std::function<void()> &kernel)
+{
+  // warm-up call, e.g. to grow buffers and fill caches
+
+  kernel();
+
+  int ncall = 1;
+  while (true) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = platform::walltime();
+    for (int i = 0; i < ncall; ++i) kernel();
+    double mytime = platform::walltime() - start;
+    double time;
+    MPI_Allreduce(&mytime, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    if ((time >= settings.mintime) || (ncall >= (1 << 28))) return time / ncall;
+    double next = 2.0 * ncall;
+    if (time > 0.0) next = std::max(next, 1.2 * ncall * settings.mintime / time);
+    ncall = (int) std::min(next, (double) (1 << 28));
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool selected(const std::string &name)
+{
+  return settings.filter.empty() || utils::strmatch(name, settings.filter);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void report(const std::string &name, bigint items, double time, double bytes)
+{
+  results.push_back({name, items, time, bytes});
+  if (me) return;
+
+  std::string line = fmt::format("{:<36s} {:>10d} {:>12.3f} {:>14.3f}", name, items, time * 1.0e6,
+                                 items / time * 1.0e-6);
+  if (bytes > 0.0)
+    line += fmt::format(" {:>10.3f}\n", bytes / time * 1.0e-9);
+  else
+    line += fmt::format(" {:>10s}\n", "-");
+  fputs(line.c_str(), stdout);
+  fflush(stdout);
+}
+
+/* ----------------------------------------------------------------------
+   create a LAMMPS instance with an fcc lattice of 2 randomly mixed atom types
+   atoms are displaced randomly from their lattice sites
+   commands are executed afterwards, then a "run 0" sets up everything
+------------------------------------------------------------------------- */
+
+LAMMPS *create_system(const std::string &atom_style, bool triclinic, bool newton,
+                      const std::vector<std::string> &commands)
+{
+  LAMMPS::argv args = {"lammps-microbench", "-log", "none", "-echo", "none", "-screen", "none",
+                       "-nocite"};
+  auto *lmp = new LAMMPS(args, MPI_COMM_WORLD);
+
+  lmp->input->one("units lj");
+  lmp->input->one("atom_style " + atom_style);
+  lmp->input->one(newton ? "newton on" : "newton off");
+  lmp->input->one("lattice fcc 0.8442");
+  if (triclinic)
+    lmp->input->one(fmt::format("region box prism 0 {0} 0 {0} 0 {0} 1 0.5 0.5", settings.ncell));
+  else
+    lmp->input->one(fmt::format("region box block 0 {0} 0 {0} 0 {0}", settings.ncell));
+  lmp->input->one("create_box 2 box");
+  lmp->input->one("create_atoms 1 box");
+  lmp->input->one("set type 1 type/fraction 2 0.5 12345");
+  lmp->input->one("mass * 1.0");
+  lmp->input->one("displace_atoms all random 0.05 0.05 0.05 4928");
+  lmp->input->one("velocity all create 1.44 87287 loop geom");
+  if (lmp->atom->q_flag) {
+    lmp->input->one("set type 1 charge 1.0");
+    lmp->input->one("set type 2 charge -1.0");
+  }
+  lmp->input->one("neighbor 0.3 bin");
+  for (const auto &cmd : commands) lmp->input->one(cmd);
+  lmp->input->one("run 0 post no");
+  return lmp;
+}
+
+/* ----------------------------------------------------------------------
+   neighbor list builds: time the NPair instance of the first pair list
+   bins are not updated, so only the NPair::build() kernel is measured
+------------------------------------------------------------------------- */
+
+void bench_neighbor()
+{
+  struct Case {
+    std::string name;
+    bool triclinic;
+    bool newton;
+    std::vector<std::string> commands;
+  };
+  std::vector<Case> cases = {
+      {"neigh half/bin/newton", false, true, {"pair_style lj/cut 2.5", "pair_coeff * * 1.0 1.0"}},
+      {"neigh half/bin/newtoff", false, false, {"pair_style lj/cut 2.5", "pair_coeff * * 1.0 1.0"}},
+      {"neigh half/bin/newton/tri", true, true, {"pair_style lj/cut 2.5", "pair_coeff * * 1.0 1.0"}},
+      {"neigh full/bin", false, true, {"pair_style zero 2.5 full", "pair_coeff * *"}},
+  };
+
+  for (const auto &c : cases) {
+    if (!selected(c.name)) continue;
+    auto *lmp = create_system("atomic", c.triclinic, c.newton, c.commands);
+    NeighList *list = lmp->neighbor->lists[0];
+    double time = measure([&] { list->np->build(list); });
+    report(c.name, lmp->atom->natoms, time, 0.0);
+    delete lmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pair styles: time Pair::compute() without energy and virial tallies
+------------------------------------------------------------------------- */
+
+void bench_pair()
+{
+  struct Case {
+    std::string name;
+    std::string atom_style;
+    std::vector<std::string> commands;
+  };
+  std::vector<Case> cases = {
+      {"pair lj/cut", "atomic", {"pair_style lj/cut 2.5", "pair_coeff * * 1.0 1.0"}},
+      {"pair morse", "atomic", {"pair_style morse 2.5", "pair_coeff * * 1.0 5.0 1.12"}},
+      {"pair lj/cut/coul/cut",
+       "charge",
+       {"pair_style lj/cut/coul/cut 2.5", "pair_coeff * * 1.0 1.0"}},
+  };
+#if defined(LMP_MICROBENCH_KSPACE)
+  cases.push_back({"pair lj/cut/coul/long",
+                   "charge",
+                   {"pair_style lj/cut/coul/long 2.5", "pair_coeff * * 1.0 1.0",
+                    "kspace_style pppm 1.0e-4"}});
+#endif
+
+  for (const auto &c : cases) {
+    if (!selected(c.name)) continue;
+    auto *lmp = create_system(c.atom_style, false, true, c.commands);
+    Pair *pair = lmp->force->pair;
+    double time = measure([&] { pair->compute(0, 0); });
+    report(c.name, lmp->atom->natoms, time, 0.0);
+    delete lmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   per-atom communication buffers of atom styles
+   forward comm: pack_comm() and unpack_comm() of all local atoms
+     unpacked onto themselves, so the atom data does not change
+   exchange: pack_exchange() of all local atoms and unpack_exchange()
+     into the first unused slot, nlocal is reset after each atom
+------------------------------------------------------------------------- */
+
+void bench_comm()
+{
+  std::vector<std::string> styles = {"atomic", "charge"};
+  if (LAMMPS::is_installed_pkg("MOLECULE")) styles.emplace_back("full");
+
+  for (const auto &style : styles) {
+    std::string name_forward = "comm forward " + style;
+    std::string name_exchange = "comm exchange " + style;
+    if (!selected(name_forward) && !selected(name_exchange)) continue;
+
+    auto *lmp = create_system(style, false, true, {"pair_style lj/cut 2.5", "pair_coeff * * 1.0 1.0"});
+    Atom *atom = lmp->atom;
+    AtomVec *avec = atom->avec;
+    const int nlocal = atom->nlocal;
+
+    std::vector<int> list(nlocal);
+    for (int i = 0; i < nlocal; ++i) list[i] = i;
+    int pbc[6] = {0, 0, 0, 0, 0, 0};
+
+    // all local atoms pack to the same size, so probe it with the first one
+
+    std::vector<double> buf(1024);
+    int nexchange = (nlocal > 0) ? avec->pack_exchange(0, buf.data()) : 0;
+    buf.resize((bigint) nlocal * std::max(avec->size_forward, nexchange) + 1);
+
+    if (selected(name_forward)) {
+      int nbytes = 0;
+      double time = measure([&] {
+        int n = avec->pack_comm(nlocal, list.data(), buf.data(), 0, pbc);
+        avec->unpack_comm(nlocal, 0, buf.data());
+        nbytes = n * sizeof(double);
+      });
+      double bytes = nbytes, allbytes;
+      MPI_Allreduce(&bytes, &allbytes, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      report(name_forward, atom->natoms, time, allbytes);
+    }
+
+    // last benchmark for this instance, since it overwrites ghost atom data
+
+    if (selected(name_exchange)) {
+      int nbytes = 0;
+      double time = measure([&] {
+        int n = 0;
+        for (int i = 0; i < nlocal; ++i) n += avec->pack_exchange(i, &buf[n]);
+        for (int m = 0; m < n;) {
+          m += avec->unpack_exchange(&buf[m]);
+          atom->nlocal = nlocal;
+        }
+        nbytes = n * sizeof(double);
+      });
+      double bytes = nbytes, allbytes;
+      MPI_Allreduce(&bytes, &allbytes, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      report(name_exchange, atom->natoms, time, allbytes);
+    }
+    delete lmp;
+  }
+}
+
+#if defined(LMP_MICROBENCH_KSPACE)
+
+/* ----------------------------------------------------------------------
+   distributed 3d FFTs and remaps of a N^3 complex grid
+   each proc owns a slab of planes along the slow axis
+   fft_3d: one forward and one scaled backward FFT per call
+   fft_3d batch3: the same for 3 grids transformed together
+   remap_3d: from slabs along the slow axis to slabs along the mid axis
+   each benchmark is run with point-to-point (default), collective,
+     and non-blocking remaps
+------------------------------------------------------------------------- */
+
+void bench_fft()
+{
+  int nprocs;
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+  const int n = settings.ngrid;
+  const bigint npoints = (bigint) n * n * n;
+
+  const int klo = me * n / nprocs;
+  const int khi = (me + 1) * n / nprocs - 1;
+  const int jlo = klo;
+  const int jhi = khi;
+  const int nlocal = n * n * (khi - klo + 1);
+
+  std::vector<FFT_SCALAR> work(2 * nlocal);
+  std::vector<FFT_SCALAR> copy(2 * nlocal);
+  for (int i = 0; i < 2 * nlocal; ++i) work[i] = (FFT_SCALAR) ((i * 7 + me) % 13) - 6.0;
+  auto *data = reinterpret_cast<FFT_DATA *>(work.data());
+
+  const char *modes[] = {"", " collective", " nonblocking"};
+
+  for (int mode = REMAP_P2P; mode <= REMAP_NONBLOCKING; ++mode) {
+    std::string name = fmt::format("fft_3d {}^3{}", n, modes[mode]);
+    std::string name_batch = fmt::format("fft_3d batch3 {}^3{}", n, modes[mode]);
+    if (selected(name) || selected(name_batch)) {
+      int nbuf;
+      auto *plan = fft_3d_create_plan(MPI_COMM_WORLD, n, n, n, 0, n - 1, 0, n - 1, klo, khi, 0,
+                                      n - 1, 0, n - 1, klo, khi, 1, 0, &nbuf, mode);
+      if (selected(name)) {
+        double time = measure([&] {
+          fft_3d(data, data, 1, plan);
+          fft_3d(data, data, -1, plan);
+        });
+        report(name, npoints, time, 2.0 * npoints * sizeof(FFT_DATA));
+      }
+      if (selected(name_batch)) {
+        const int stride = plan->batch_stride;
+        std::vector<FFT_SCALAR> batch(3 * 2 * stride);
+        for (int m = 0; m < 3; ++m)
+          std::copy(work.begin(), work.end(), batch.begin() + m * 2 * stride);
+        auto *bdata = reinterpret_cast<FFT_DATA *>(batch.data());
+        double time = measure([&] {
+          fft_3d_batch(bdata, 3, 1, plan);
+          fft_3d_batch(bdata, 3, -1, plan);
+        });
+        report(name_batch, 3 * npoints, time, 6.0 * npoints * sizeof(FFT_DATA));
+      }
+      fft_3d_destroy_plan(plan);
+    }
+
+    name = fmt::format("remap_3d {}^3{}", n, modes[mode]);
+    if (selected(name)) {
+      auto *plan = remap_3d_create_plan(MPI_COMM_WORLD, 0, n - 1, 0, n - 1, klo, khi, 0, n - 1,
+                                        jlo, jhi, 0, n - 1, 2, 0, 1, FFT_PRECISION, mode);
+      double time = measure([&] { remap_3d(work.data(), copy.data(), nullptr, plan); });
+      report(name, npoints, time, (double) npoints * sizeof(FFT_DATA));
+      remap_3d_destroy_plan(plan);
+    }
+  }
+}
+
+#endif
+
+/* ----------------------------------------------------------------------
+   text parsing: convert lines as in the Atoms section of a data file
+   with the ValueTokenizer class as used by file readers and with
+   Tokenizer plus utils::numeric() and friends as used by read_data
+------------------------------------------------------------------------- */
+
+void bench_parse()
+{
+  auto *lmp = create_system("atomic", false, true, {"pair_style zero 2.5", "pair_coeff * *"});
+  Atom *atom = lmp->atom;
+  std::vector<std::string> lines;
+  double nbytes = 0.0;
+  for (int i = 0; i < atom->nlocal; ++i) {
+    lines.emplace_back(fmt::format("{} {} {:.16} {:.16} {:.16} 0 0 0", atom->tag[i],
+                                   atom->type[i], atom->x[i][0], atom->x[i][1], atom->x[i][2]));
+    nbytes += lines.back().size() + 1;
+  }
+  bigint nlines = lines.size();
+  volatile double sink = 0.0;    // keeps the conversions from being optimized away
+
+  if (selected("parse ValueTokenizer")) {
+    double time = measure([&] {
+      double sum = 0.0;
+      for (const auto &line : lines) {
+        ValueTokenizer values(line);
+        sum += values.next_tagint() + values.next_int();
+        for (int k = 0; k < 3; ++k) sum += values.next_double();
+        for (int k = 0; k < 3; ++k) sum += values.next_int();
+      }
+      sink = sum;
+    });
+    report("parse ValueTokenizer", nlines, time, nbytes);
+  }
+
+  if (selected("parse utils::numeric")) {
+    double time = measure([&] {
+      double sum = 0.0;
+      for (const auto &line : lines) {
+        auto values = Tokenizer(line).as_vector();
+        sum += utils::tnumeric(FLERR, values[0], false, lmp);
+        sum += utils::inumeric(FLERR, values[1], false, lmp);
+        for (int k = 2; k < 5; ++k) sum += utils::numeric(FLERR, values[k], false, lmp);
+        for (int k = 5; k < 8; ++k) sum += utils::inumeric(FLERR, values[k], false, lmp);
+      }
+      sink = sum;
+    });
+    report("parse utils::numeric", nlines, time, nbytes);
+  }
+
+  delete lmp;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void write_yaml(const std::string &file)
+{
+  FILE *fp = fopen(file.c_str(), "w");
+  if (!fp) {
+    fprintf(stderr, "Cannot open YAML file %s: %s\n", file.c_str(), utils::getsyserror().c_str());
+    return;
+  }
+
+  int nprocs;
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+  fmt::print(fp, "---\nlammps_version: {}\nnprocs: {}\nncell: {}\nngrid: {}\nresults:\n",
+             LAMMPS_VERSION, nprocs, settings.ncell, settings.ngrid);
+  for (const auto &r : results) {
+    fmt::print(fp, "  - name: {}\n    items: {}\n    time: {:.6g}\n    items_per_sec: {:.6g}\n",
+               r.name, r.items, r.time, r.items / r.time);
+    if (r.bytes > 0.0) fmt::print(fp, "    bytes_per_sec: {:.6g}\n", r.bytes / r.time);
+  }
+  fputs("...\n", fp);
+  fclose(fp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void usage()
+{
+  puts("Usage: lammps-microbench [-n <ncell>] [-g <ngrid>] [-t <seconds>] [-f <regex>] "
+       "[-y <file>]\n"
+       "  -n <ncell>    fcc lattice cells per dimension of the test systems (default: 16)\n"
+       "  -g <ngrid>    FFT grid points per dimension (default: 64)\n"
+       "  -t <seconds>  minimum time for each measurement (default: 0.5)\n"
+       "  -f <regex>    only run benchmarks whose name matches the regular expression\n"
+       "  -y <file>     also write the results to a file in YAML format\n"
+       "  -h            print this message");
+}
+
+}    // namespace
+
+/* ---------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &me);
+
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    bool hasarg = (iarg + 1 < argc);
+    if ((strcmp(argv[iarg], "-n") == 0) && hasarg) {
+      settings.ncell = atoi(argv[++iarg]);
+    } else if ((strcmp(argv[iarg], "-g") == 0) && hasarg) {
+      settings.ngrid = atoi(argv[++iarg]);
+    } else if ((strcmp(argv[iarg], "-t") == 0) && hasarg) {
+      settings.mintime = atof(argv[++iarg]);
+    } else if ((strcmp(argv[iarg], "-f") == 0) && hasarg) {
+      settings.filter = argv[++iarg];
+    } else if ((strcmp(argv[iarg], "-y") == 0) && hasarg) {
+      settings.yamlfile = argv[++iarg];
+    } else {
+      if (me == 0) usage();
+      MPI_Finalize();
+      return (strcmp(argv[iarg], "-h") == 0) ? 0 : 1;
+    }
+  }
+
+  if ((settings.ncell < 1) || (settings.ngrid < 2) || (settings.mintime < 0.0)) {
+    if (me == 0) usage();
+    MPI_Finalize();
+    return 1;
+  }
+
+  if (me == 0) {
+    int nprocs;
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    fmt::print("LAMMPS microbenchmarks ({}) on {} MPI task(s)\n", LAMMPS_VERSION, nprocs);
+    fmt::print("{:<36s} {:>10s} {:>12s} {:>14s} {:>10s}\n{:-<86s}\n", "Benchmark", "Atoms/Grid",
+               "usec/call", "M(atom)-steps/s", "GB/s", "");
+  }
+
+  try {
+    bench_neighbor();
+    bench_pair();
+    bench_comm();
+    bench_parse();
+#if defined(LMP_MICROBENCH_KSPACE)
+    bench_fft();
+#endif
+  } catch (std::exception &e) {
+    fprintf(stderr, "%s\n", e.what());
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+
+  if ((me == 0) && !settings.yamlfile.empty()) write_yaml(settings.yamlfile);
+
+  MPI_Finalize();
+  return 0;
+}
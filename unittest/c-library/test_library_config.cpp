@@ -194,6 +194,34 @@ TEST_F(LibraryConfig, force_timeout)
     EXPECT_EQ(timer->is_timeout(), true);
 }
 
+TEST_F(LibraryConfig, timer_counters)
+{
+    LAMMPS_NS::Timer *timer = ((LAMMPS_NS::LAMMPS *)lmp)->timer;
+    EXPECT_EQ(timer->has_counters(), false);
+
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "timer counters");
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+
+    // counters are turned off again where perf events cannot be used
+    if (timer->has_counters()) {
+        EXPECT_THAT(output, HasSubstr("counters=counters"));
+        EXPECT_TRUE(timer->has_counter(LAMMPS_NS::Timer::CYCLES) ||
+                    timer->has_counter(LAMMPS_NS::Timer::INSTRUCTIONS));
+    } else {
+        EXPECT_THAT(output, HasSubstr("counters are not available"));
+        EXPECT_THAT(output, HasSubstr("counters=nocounters"));
+    }
+
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "timer nocounters");
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    EXPECT_EQ(timer->has_counters(), false);
+    EXPECT_EQ(timer->has_counter(LAMMPS_NS::Timer::CYCLES), false);
+}
+
 TEST(LAMMPSConfig, exceptions)
 {
     EXPECT_EQ(lammps_config_has_exceptions(), 1);
@@ -4,6 +4,8 @@
 #include "library.h"
 #include "lmptype.h"
 #include "platform.h"
+#include <fstream>
+#include <sstream>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -165,6 +167,66 @@ TEST_F(LibraryProperties, thermo)
     EXPECT_DOUBLE_EQ(dval, 31.700964689115658);
 };
 
+TEST_F(LibraryProperties, thermo_timer_detail)
+{
+    if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
+    std::string input = path_join(INPUT_DIR, "in.fourmol");
+    ::testing::internal::CaptureStdout();
+    lammps_file(lmp, input.c_str());
+    lammps_command(lmp, "fix 1 all nve");
+    lammps_command(lmp, "compute ke all ke");
+    lammps_command(lmp, "thermo_style custom step c_ke time/fix/1 time/compute/ke");
+    lammps_command(lmp, "timer detail");
+    lammps_command(lmp, "run 10 post no");
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    EXPECT_GT(lammps_get_thermo(lmp, "time/fix/1"), 0.0);
+    EXPECT_GT(lammps_get_thermo(lmp, "time/compute/ke"), 0.0);
+    EXPECT_DOUBLE_EQ(*(double *)lammps_last_thermo(lmp, "data", 2),
+                     lammps_get_thermo(lmp, "time/fix/1"));
+
+    // timings are reset by the next run
+    ::testing::internal::CaptureStdout();
+    lammps_command(lmp, "run 0 post no");
+    output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    EXPECT_DOUBLE_EQ(lammps_get_thermo(lmp, "time/fix/1"), 0.0);
+};
+
+TEST_F(LibraryProperties, timer_trace)
+{
+    if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
+    std::string input = path_join(INPUT_DIR, "in.fourmol");
+    ::testing::internal::CaptureStdout();
+    lammps_file(lmp, input.c_str());
+    lammps_command(lmp, "timer trace test_timer_trace.json");
+    lammps_command(lmp, "run 4 post no");
+    lammps_command(lmp, "run 2 post no");
+    lammps_command(lmp, "timer notrace");
+    std::string output = ::testing::internal::GetCapturedStdout();
+    if (verbose) std::cout << output;
+    EXPECT_THAT(output, HasSubstr("trace=yes"));
+    EXPECT_THAT(output, HasSubstr("trace=no"));
+
+    std::ifstream in("test_timer_trace.json");
+    std::stringstream buf;
+    buf << in.rdbuf();
+    std::string trace = buf.str();
+    EXPECT_THAT(trace, StartsWith("[\n{\"name\":\"process_name\""));
+    EXPECT_THAT(trace, HasSubstr("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0"));
+    EXPECT_THAT(trace, HasSubstr("{\"name\":\"Pair\",\"cat\":\"Pair\",\"ph\":\"X\""));
+    EXPECT_THAT(trace, HasSubstr("{\"name\":\"neighbor build\",\"cat\":\"Neigh\""));
+    EXPECT_EQ(trace.substr(trace.size() - 3), "\n]\n");
+
+    // one Pair event per step of both runs
+    int npair = 0;
+    for (auto pos = trace.find("\"name\":\"Pair\""); pos != std::string::npos;
+         pos = trace.find("\"name\":\"Pair\"", pos + 1))
+        ++npair;
+    EXPECT_EQ(npair, 6);
+    LAMMPS_NS::platform::unlink("test_timer_trace.json");
+};
+
 TEST_F(LibraryProperties, box)
 {
     if (!lammps_has_style(lmp, "atom", "full")) GTEST_SKIP();
@@ -0,0 +1,189 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS Development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "lammps.h"
+
+#include "atom.h"
+#include "force.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "pair.h"
+
+#include "../testing/core.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstring>
+
+// whether to print verbose output (i.e. not capturing LAMMPS screen output).
+bool verbose = false;
+
+namespace LAMMPS_NS {
+
+class NeighborTest : public LAMMPSTest {
+protected:
+    void SetUp() override
+    {
+        testbinary = "NeighborTest";
+        args       = {"-log", "none", "-echo", "screen", "-nocite"};
+        LAMMPSTest::SetUp();
+    }
+
+    void lj_system(const std::string &pairstyle, const std::string &paircoeff,
+                   const std::string &newton = "on")
+    {
+        BEGIN_HIDE_OUTPUT();
+        command("units lj");
+        command("newton " + newton);
+        command("lattice fcc 0.8442");
+        command("region box block 0 5 0 5 0 5");
+        command("create_box 1 box");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 1.0 87287 loop geom");
+        command("group hot id <= 25");
+        command("velocity hot create 20.0 4928459 loop geom");
+        command("pair_style " + pairstyle);
+        command("pair_coeff * * " + paircoeff);
+        command("neighbor 0.3 bin");
+        command("fix 1 all nve");
+        END_HIDE_OUTPUT();
+    }
+
+    // number of stored pairs closer than the force cutoff
+
+    bigint count_pairs(double cut)
+    {
+        double **x    = lmp->atom->x;
+        NeighList *list = lmp->neighbor->lists[0];
+        bigint npair  = 0;
+        for (int ii = 0; ii < list->inum; ++ii) {
+            int i = list->ilist[ii];
+            for (int jj = 0; jj < list->numneigh[i]; ++jj) {
+                int j       = list->firstneigh[i][jj] & NEIGHMASK;
+                double delx = x[i][0] - x[j][0];
+                double dely = x[i][1] - x[j][1];
+                double delz = x[i][2] - x[j][2];
+                if (delx * delx + dely * dely + delz * delz < cut * cut) ++npair;
+            }
+        }
+        return npair;
+    }
+};
+
+TEST_F(NeighborTest, RebuildKeyword)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify rebuild partial");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->neighbor->partial_flag, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify rebuild full");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->neighbor->partial_flag, 0);
+
+    TEST_FAILURE(".*ERROR: Unknown neigh_modify rebuild argument: xxx.*",
+                 command("neigh_modify rebuild xxx"););
+    TEST_FAILURE(".*ERROR: Illegal neigh_modify rebuild command: missing argument.*",
+                 command("neigh_modify rebuild"););
+}
+
+TEST_F(NeighborTest, PartialHalfNewton)
+{
+    lj_system("lj/cut 2.5", "1.0 1.0");
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify every 1 delay 0 check yes rebuild partial");
+    command("comm_modify cutoff 3.6");
+    command("run 100 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_GT(lmp->neighbor->npartial, 0);
+
+    double epartial = lmp->force->pair->eng_vdwl;
+    bigint npartial = count_pairs(2.5);
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_NEAR(epartial, lmp->force->pair->eng_vdwl, 1.0e-10 * fabs(epartial));
+    EXPECT_EQ(npartial, count_pairs(2.5));
+}
+
+TEST_F(NeighborTest, PartialHalfNewtoff)
+{
+    lj_system("lj/cut 2.5", "1.0 1.0", "off");
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify every 1 delay 0 check yes rebuild partial");
+    command("comm_modify cutoff 3.6");
+    command("run 100 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_GT(lmp->neighbor->npartial, 0);
+
+    double epartial = lmp->force->pair->eng_vdwl;
+    bigint npartial = count_pairs(2.5);
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_NEAR(epartial, lmp->force->pair->eng_vdwl, 1.0e-10 * fabs(epartial));
+    EXPECT_EQ(npartial, count_pairs(2.5));
+}
+
+TEST_F(NeighborTest, PartialFull)
+{
+    lj_system("zero 2.5 full", "");
+    BEGIN_HIDE_OUTPUT();
+    command("neigh_modify every 1 delay 0 check yes rebuild partial");
+    command("comm_modify cutoff 3.6");
+    command("run 100 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_GT(lmp->neighbor->npartial, 0);
+
+    bigint npartial = count_pairs(2.5);
+    BEGIN_HIDE_OUTPUT();
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    EXPECT_EQ(npartial, count_pairs(2.5));
+}
+
+TEST_F(NeighborTest, PartialUnsupported)
+{
+    lj_system("lj/cut 2.5", "1.0 1.0");
+    BEGIN_CAPTURE_OUTPUT();
+    command("neigh_modify rebuild partial once yes");
+    command("run 0 post no");
+    auto output = END_CAPTURE_OUTPUT();
+    ASSERT_THAT(output, ContainsRegex(".*WARNING: Neighbor list settings do not support "
+                                      "partial rebuilds, using full rebuilds.*"));
+}
+} // namespace LAMMPS_NS
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleMock(&argc, argv);
+
+    // handle arguments passed via environment variable
+    if (const char *var = getenv("TEST_ARGS")) {
+        std::vector<std::string> env = LAMMPS_NS::utils::split_words(var);
+        for (auto arg : env) {
+            if (arg == "-v") {
+                verbose = true;
+            }
+        }
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "-v") == 0)) verbose = true;
+
+    int rv = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return rv;
+}
@@ -26,6 +26,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -693,6 +694,60 @@ TEST_F(AtomStyleTest, atomic)
     EXPECT_NEAR(x[GETIDX(16)][2], 7.9, EPSILON);
 }
 
+// largest distance between atoms that are adjacent in the local atom list
+static double max_step(Atom *atom)
+{
+    double maxdist = 0.0;
+    for (int i = 1; i < atom->nlocal; ++i) {
+        const double dx = atom->x[i][0] - atom->x[i - 1][0];
+        const double dy = atom->x[i][1] - atom->x[i - 1][1];
+        const double dz = atom->x[i][2] - atom->x[i - 1][2];
+        maxdist         = std::max(maxdist, sqrt(dx * dx + dy * dy + dz * dz));
+    }
+    return maxdist;
+}
+
+TEST_F(AtomStyleTest, sort_order)
+{
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_BIN);
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort 1 2.0");
+    command("create_box 1 box");
+    command("lattice sc 1.0");
+    command("create_atoms 1 box");
+    command("mass 1 1.0");
+    command("pair_coeff * *");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 512);
+    ASSERT_GT(max_step(lmp->atom), 6.0);
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort hilbert");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_HILBERT);
+    ASSERT_EQ(lmp->atom->sortfreq, 1);
+    ASSERT_EQ(lmp->atom->natoms, 512);
+    ASSERT_LT(max_step(lmp->atom), 4.0);
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort morton");
+    command("run 0 post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_MORTON);
+    ASSERT_EQ(lmp->atom->natoms, 512);
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_modify sort hilbert");
+    command("write_restart test_atom_styles.restart");
+    command("clear");
+    command("read_restart test_atom_styles.restart");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->sortorder, Atom::SORT_HILBERT);
+    ASSERT_NEAR(lmp->atom->userbinsize, 2.0, EPSILON);
+}
+
 TEST_F(AtomStyleTest, no_tags)
 {
     BEGIN_HIDE_OUTPUT();
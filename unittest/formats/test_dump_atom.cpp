@@ -521,6 +521,86 @@ TEST_F(DumpAtomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpAtomTest, mpiio_run2)
+{
+    auto dump_file  = dump_filename("run2");
+    auto mpiio_file = dump_filename("mpiio_run2");
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all atom 1 {}", dump_file));
+    command(fmt::format("dump id1 all atom 1 {}", mpiio_file));
+    command("dump_modify id1 mpiio yes");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(mpiio_file);
+    ASSERT_EQ(count_lines(mpiio_file), 123);
+    ASSERT_FILE_EQUAL(dump_file, mpiio_file);
+    delete_file(dump_file);
+    delete_file(mpiio_file);
+}
+
+TEST_F(DumpAtomTest, binary_mpiio_run2)
+{
+    if (!BINARY2TXT_EXECUTABLE) GTEST_SKIP();
+
+    auto text_file   = text_dump_filename("mpiio_run2");
+    auto binary_file = binary_dump_filename("mpiio_run2");
+
+    generate_text_and_binary_dump(text_file, binary_file, "mpiio yes", 2);
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(binary_file);
+
+    auto converted_file = convert_binary_to_text(binary_file);
+
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(binary_file);
+    delete_file(converted_file);
+}
+
+TEST_F(DumpAtomTest, async_run2)
+{
+    auto dump_file  = dump_filename("run2");
+    auto async_file = dump_filename("async_run2");
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all atom 1 {}", dump_file));
+    command(fmt::format("dump id1 all atom 1 {}", async_file));
+    command("dump_modify id1 async yes buffer no");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(async_file);
+    ASSERT_EQ(count_lines(async_file), 123);
+    ASSERT_FILE_EQUAL(dump_file, async_file);
+
+    BEGIN_HIDE_OUTPUT();
+    command("run 1 pre no post no");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(count_lines(async_file), 164);
+    ASSERT_FILE_EQUAL(dump_file, async_file);
+    delete_file(dump_file);
+    delete_file(async_file);
+}
+
+TEST_F(DumpAtomTest, async_multi_file_run1)
+{
+    auto base_name = "async_multi_file_run1_*.melt";
+    auto run1_0    = "async_multi_file_run1_0.melt";
+    auto run1_1    = "async_multi_file_run1_1.melt";
+    generate_dump(base_name, "async yes", 1);
+
+    ASSERT_FILE_EXISTS(run1_0);
+    ASSERT_FILE_EXISTS(run1_1);
+    ASSERT_EQ(count_lines(run1_0), 41);
+    ASSERT_EQ(count_lines(run1_1), 41);
+    delete_file(run1_0);
+    delete_file(run1_1);
+}
+
 TEST_F(DumpAtomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
@@ -647,6 +727,27 @@ TEST_F(DumpAtomTest, dump_modify_invalid)
     TEST_FAILURE(".*Unknown dump_modify keyword: true.*", command("dump_modify id true"););
 }
 
+TEST_F(DumpAtomTest, dump_modify_async_invalid)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 dump.txt");
+    command("dump_modify id async yes mpiio yes");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR: Cannot use dump_modify async and mpiio together.*",
+                 command("run 0 post no"););
+}
+
+TEST_F(DumpAtomTest, dump_modify_mpiio_invalid)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all atom 1 dump_%.txt");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR: Cannot use dump_modify mpiio with % in dump file name.*",
+                 command("dump_modify id mpiio yes"););
+}
+
 TEST_F(DumpAtomTest, write_dump)
 {
     auto reference = dump_filename("run0_ref");
@@ -324,6 +324,27 @@ TEST_F(DumpCustomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpCustomTest, mpiio_run2)
+{
+    auto dump_file  = dump_filename("run2");
+    auto mpiio_file = dump_filename("mpiio_run2");
+    auto fields     = "id type proc x y z ix iy iz xs ys zs";
+
+    BEGIN_HIDE_OUTPUT();
+    command(fmt::format("dump id0 all custom 1 {} {}", dump_file, fields));
+    command(fmt::format("dump id1 all custom 1 {} {}", mpiio_file, fields));
+    command("dump_modify id0 units yes time yes");
+    command("dump_modify id1 units yes time yes mpiio yes");
+    command("run 2 post no");
+    END_HIDE_OUTPUT();
+
+    ASSERT_FILE_EXISTS(mpiio_file);
+    ASSERT_EQ(count_lines(mpiio_file), 131);
+    ASSERT_FILE_EQUAL(dump_file, mpiio_file);
+    delete_file(dump_file);
+    delete_file(mpiio_file);
+}
+
 TEST_F(DumpCustomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
@@ -384,6 +405,118 @@ TEST_F(DumpCustomTest, rerun_bin)
     ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
     delete_file(dump_file);
 }
+
+TEST_F(DumpCustomTest, rerun_index)
+{
+    auto dump_file  = dump_filename("rerun_index");
+    auto index_file = dump_file + ".idx";
+    auto fields     = "id type xs ys zs";
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+    });
+    generate_dump(dump_file, fields, "format float %20.15g", 1);
+    double pe_1, pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+    continue_dump(1);
+    close_dump();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    ASSERT_FILE_EXISTS(dump_file);
+    delete_file(index_file);
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 every 1 post no dump x y z index yes",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_DOUBLE_EQ(pe_2, pe_rerun);
+    ASSERT_FILE_EXISTS(index_file);
+
+    // second pass uses the stored index
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 1 last 1 every 1 post no dump x y z index yes",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_DOUBLE_EQ(pe_1, pe_rerun);
+    delete_file(dump_file);
+    delete_file(index_file);
+}
+
+TEST_F(DumpCustomTest, rerun_bin_index)
+{
+    auto dump_file  = binary_dump_filename("rerun_index");
+    auto index_file = dump_file + ".idx";
+    auto fields     = "id type xs ys zs";
+
+    HIDE_OUTPUT([&] {
+        command("fix 1 all nve");
+    });
+    generate_dump(dump_file, fields, "", 1);
+    continue_dump(1);
+    close_dump();
+    double pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    ASSERT_FILE_EXISTS(dump_file);
+    delete_file(index_file);
+
+    // read all snapshots, so later ones are read without field info
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} post no dump x y z index yes", dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+    ASSERT_FILE_EXISTS(index_file);
+    delete_file(dump_file);
+    delete_file(index_file);
+}
+
+TEST_F(DumpCustomTest, rerun_columnar)
+{
+    auto dump_file = fmt::format("dump_columnar_rerun.melt.bin");
+    auto fields    = "id type xs ys zs vx vy vz";
+
+    BEGIN_HIDE_OUTPUT();
+    command("fix 1 all nve");
+    command(fmt::format("dump id all columnar 1 {} {}", dump_file, fields));
+    command("dump_modify id filter delta");
+    command("run 1 post no");
+    END_HIDE_OUTPUT();
+    double pe_1, pe_2, pe_rerun;
+    lmp->output->thermo->evaluate_keyword("pe", &pe_1);
+    continue_dump(1);
+    close_dump();
+    lmp->output->thermo->evaluate_keyword("pe", &pe_2);
+    ASSERT_FILE_EXISTS(dump_file);
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 1 last 1 every 1 post no dump x y z format columnar",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_1, pe_rerun, 1.0e-14);
+    HIDE_OUTPUT([&] {
+        command(fmt::format("rerun {} first 2 last 2 every 1 post yes dump x y z format columnar",
+                            dump_file));
+    });
+    lmp->output->thermo->evaluate_keyword("pe", &pe_rerun);
+    ASSERT_NEAR(pe_2, pe_rerun, 1.0e-14);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCustomTest, columnar_invalid)
+{
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all columnar 1 dump_columnar_invalid.bin id type x y z");
+    END_HIDE_OUTPUT();
+
+    TEST_FAILURE(".*ERROR: Unknown dump_modify filter setting: xor.*",
+                 command("dump_modify id filter xor"););
+    TEST_FAILURE(".*ERROR: Dump columnar does not support dump_modify append.*",
+                 command("dump_modify id append yes"); command("run 0 post no"););
+    BEGIN_HIDE_OUTPUT();
+    command("undump id");
+    END_HIDE_OUTPUT();
+    delete_file("dump_columnar_invalid.bin");
+}
 } // namespace LAMMPS_NS
 int main(int argc, char **argv)
 {
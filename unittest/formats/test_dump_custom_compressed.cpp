@@ -117,6 +117,33 @@ TEST_F(DumpCustomCompressTest, compressed_no_buffer_run1)
     delete_file(converted_file);
 }
 
+TEST_F(DumpCustomCompressTest, compressed_frames_run1)
+{
+    if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
+    if (compression_style != "custom/zstd") GTEST_SKIP();
+
+    auto base_name       = "frames_custom_run1.melt";
+    auto text_file       = text_dump_filename(base_name);
+    auto compressed_file = compressed_dump_filename(base_name);
+    auto fields = "id type proc x y z ix iy iz xs ys zs xu yu zu xsu ysu zsu vx vy vz fx fy fz";
+
+    generate_text_and_compressed_dump(text_file, compressed_file, fields, fields, "",
+                                      "compression_frames yes checksum yes", 1);
+
+    TearDown();
+
+    ASSERT_FILE_EXISTS(text_file);
+    ASSERT_FILE_EXISTS(compressed_file);
+
+    auto converted_file = convert_compressed_to_text(compressed_file);
+
+    ASSERT_FILE_EXISTS(converted_file);
+    ASSERT_FILE_EQUAL(text_file, converted_file);
+    delete_file(text_file);
+    delete_file(compressed_file);
+    delete_file(converted_file);
+}
+
 TEST_F(DumpCustomCompressTest, compressed_triclinic_run1)
 {
     if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
@@ -302,6 +329,19 @@ TEST_F(DumpCustomCompressTest, compressed_modify_multi_bad_param)
         command("dump_modify id1 pad 3 compression_level 12"););
 }
 
+TEST_F(DumpCustomCompressTest, compressed_modify_bad_threads)
+{
+    if (compression_style != "custom/zstd") GTEST_SKIP();
+
+    auto fields = "id type proc x y z ix iy iz xs ys zs xu yu zu xsu ysu zsu vx vy vz fx fy fz";
+    command(fmt::format("dump id1 all {} 1 {} {}", compression_style,
+                        compressed_dump_filename("modify_bad_threads_run0_*.melt.custom"), fields));
+
+    TEST_FAILURE(".*ERROR on proc 0: Illegal dump_modify command: Number of compression threads "
+                 "must be >= 0.*",
+                 command("dump_modify id1 compression_threads -1"););
+}
+
 TEST_F(DumpCustomCompressTest, compressed_modify_clevel_run0)
 {
     if (!COMPRESS_EXECUTABLE) GTEST_SKIP();
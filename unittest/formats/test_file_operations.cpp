@@ -324,6 +324,7 @@ TEST_F(FileOperationsTest, write_restart)
     command("write_restart multi-%.restart");
     command("write_restart multi2-%.restart fileper 2");
     command("write_restart multi3-%.restart nfile 1");
+    command("write_restart step*.mpiio");
     END_HIDE_OUTPUT();
 
     ASSERT_FILE_EXISTS("noinit.restart");
@@ -335,7 +336,10 @@ TEST_F(FileOperationsTest, write_restart)
     ASSERT_FILE_EXISTS("multi2-0.restart");
     ASSERT_FILE_EXISTS("multi3-base.restart");
     ASSERT_FILE_EXISTS("multi3-0.restart");
+    ASSERT_FILE_EXISTS("step333.mpiio");
     TEST_FAILURE(".*ERROR: Illegal write_restart command.*", command("write_restart"););
+    TEST_FAILURE(".*ERROR: Restart file name cannot use both % and .mpiio.*",
+                 command("write_restart multi-%.mpiio"););
     TEST_FAILURE(".*ERROR: Unknown write_restart keyword: xxxx.*",
                  command("write_restart test.restart xxxx"););
     TEST_FAILURE(".*ERROR on proc 0: Cannot open restart file some_crazy_dir/test.restart:"
@@ -376,6 +380,15 @@ TEST_F(FileOperationsTest, write_restart)
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->update->ntimestep, 333);
     ASSERT_EQ(lmp->domain->triclinic, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart step333.mpiio");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->restart_ver, lmp->num_ver);
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->update->ntimestep, 333);
+    ASSERT_EQ(lmp->domain->triclinic, 0);
+    ASSERT_DOUBLE_EQ(lmp->atom->x[0][0], 0.0);
 
     // clean up
     delete_file("noinit.restart");
@@ -388,6 +401,61 @@ TEST_F(FileOperationsTest, write_restart)
     delete_file("multi3-base.restart");
     delete_file("multi3-0.restart");
     delete_file("triclinic.restart");
+    delete_file("step333.mpiio");
+}
+
+TEST_F(FileOperationsTest, restart_async)
+{
+    auto setup = [&]() {
+        command("region box block -2 2 -2 2 -2 2");
+        command("create_box 1 box");
+        command("lattice sc 1.0");
+        command("create_atoms 1 box");
+        command("mass 1 1.0");
+        command("velocity all create 1.0 4928459");
+        command("fix 1 all nve");
+    };
+
+    BEGIN_HIDE_OUTPUT();
+    command("echo none");
+    setup();
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Write_restart does not support async, use the restart command.*",
+                 command("write_restart test.restart async yes"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("restart 2 sync.*.restart");
+    command("run 4 post no");
+    command("clear");
+    setup();
+    command("restart 2 async.*.restart async yes");
+    command("run 4 post no");
+    END_HIDE_OUTPUT();
+
+    // the end of the run completes pending output, so the files must be identical
+
+    ASSERT_FILE_EXISTS("async.2.restart");
+    ASSERT_FILE_EXISTS("async.4.restart");
+    ASSERT_FILE_EQUAL("sync.2.restart", "async.2.restart");
+    ASSERT_FILE_EQUAL("sync.4.restart", "async.4.restart");
+
+    BEGIN_HIDE_OUTPUT();
+    command("restart 2 async.*.mpiio async yes");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Restart async cannot be used with MPI-IO restart files.*",
+                 command("run 2 post no"););
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart async.4.restart");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 64);
+    ASSERT_EQ(lmp->update->ntimestep, 4);
+
+    delete_file("sync.2.restart");
+    delete_file("sync.4.restart");
+    delete_file("async.2.restart");
+    delete_file("async.4.restart");
 }
 
 TEST_F(FileOperationsTest, write_data)
@@ -603,6 +671,96 @@ TEST_F(FileOperationsTest, read_data_fix)
     delete_file("test_mol_id.data");
 }
 
+TEST_F(FileOperationsTest, read_data_parallel)
+{
+    if (!LAMMPS::is_installed_pkg("MOLECULE")) GTEST_SKIP();
+
+    // last line without newline, atoms and velocities in arbitrary order
+
+    FILE *fp = fopen("test_parallel.data", "w");
+    fputs("LAMMPS data file for parallel read_data\n\n"
+          "4 atoms\n2 atom types\n3 bonds\n1 bond types\n\n"
+          "0.0 4.0 xlo xhi\n0.0 4.0 ylo yhi\n0.0 4.0 zlo zhi\n\n"
+          "Masses\n\n1 1.0\n2 2.0\n\n"
+          "Atoms # bond\n\n"
+          "3 1 2 2.5 0.5 0.5 0 0 0\n"
+          "1 1 1 0.5 0.5 0.5 0 0 0\n"
+          "4 1 2 3.5 0.5 0.5 -1 0 0\n"
+          "2 1 1 1.5 0.5 0.5 0 0 0\n\n"
+          "Velocities\n\n"
+          "2 0.2 0.0 0.0\n1 0.1 0.0 0.0 # comment\n4 0.4 0.0 0.0\n3 0.3 0.0 0.0\n\n"
+          "Bonds\n\n"
+          "1 1 3 4\n2 1 1 2\n3 1 2 3",
+          fp);
+    fclose(fp);
+
+    BEGIN_HIDE_OUTPUT();
+    command("atom_style bond");
+    command("atom_modify map array");
+    command("bond_style zero");
+    command("read_data test_parallel.data parallel yes");
+    command("bond_coeff *");
+    command("write_data test_parallel_yes.data");
+    command("clear");
+    command("atom_style bond");
+    command("atom_modify map array");
+    command("bond_style zero");
+    command("read_data test_parallel.data parallel no");
+    command("bond_coeff *");
+    command("write_data test_parallel_no.data");
+    END_HIDE_OUTPUT();
+
+    ASSERT_EQ(lmp->atom->natoms, 4);
+    ASSERT_EQ(lmp->atom->nbonds, 3);
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_DOUBLE_EQ(lmp->atom->v[GETIDX(i)][0], 0.1 * i);
+        EXPECT_EQ(lmp->atom->type[GETIDX(i)], (i + 1) / 2);
+    }
+    EXPECT_EQ(lmp->atom->image[GETIDX(4)], lmp->atom->image[GETIDX(1)] - 1);
+
+    // except for the header line, both data files must be identical
+
+    auto yes = read_lines("test_parallel_yes.data");
+    auto no  = read_lines("test_parallel_no.data");
+    ASSERT_EQ(yes.size(), no.size());
+    for (std::size_t i = 1; i < yes.size(); ++i)
+        EXPECT_EQ(yes[i], no[i]);
+
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("atom_style bond");
+    command("atom_modify map array");
+    command("bond_style zero");
+    command("read_data test_parallel_yes.data parallel yes");
+    command("read_data test_parallel_yes.data add append shift 0.0 0.0 1.0 parallel yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 8);
+    ASSERT_EQ(lmp->atom->nbonds, 6);
+    EXPECT_DOUBLE_EQ(lmp->atom->v[GETIDX(7)][0], 0.3);
+    EXPECT_DOUBLE_EQ(lmp->atom->x[GETIDX(7)][2], 1.5);
+
+    fp = fopen("test_parallel.data", "w");
+    fputs("LAMMPS data file for parallel read_data\n\n"
+          "2 atoms\n1 atom types\n\n"
+          "0.0 4.0 xlo xhi\n0.0 4.0 ylo yhi\n0.0 4.0 zlo zhi\n\n"
+          "Atoms # bond\n\n"
+          "1 1 1 0.5 0.5 0.5\n",
+          fp);
+    fclose(fp);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("atom_style bond");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR: Unexpected end of data file.*",
+                 command("read_data test_parallel.data parallel yes"););
+    TEST_FAILURE(".*ERROR: Expected boolean parameter instead of 'xx'.*",
+                 command("read_data test_parallel.data parallel xx"););
+
+    delete_file("test_parallel.data");
+    delete_file("test_parallel_yes.data");
+    delete_file("test_parallel_no.data");
+}
+
 int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
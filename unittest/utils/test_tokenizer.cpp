@@ -204,6 +204,18 @@ TEST(Tokenizer, as_vector4)
     ASSERT_EQ(list.size(), 1);
 }
 
+TEST(Tokenizer, next_token)
+{
+    Tokenizer t(" test  word", " ");
+    size_t len;
+    const char *token = t.next_token(len);
+    ASSERT_EQ(std::string(token, len), "test");
+    token = t.next_token(len);
+    ASSERT_EQ(std::string(token, len), "word");
+    ASSERT_FALSE(t.has_next());
+    ASSERT_THROW(t.next_token(len), TokenizerException);
+}
+
 TEST(ValueTokenizer, empty_string)
 {
     ValueTokenizer values("");
@@ -303,6 +315,24 @@ TEST(ValueTokenizer, bad_double)
     ASSERT_THROW(values.next_double(), InvalidFloatException);
 }
 
+TEST(ValueTokenizer, out_of_range_integer)
+{
+    ValueTokenizer values("2147483648 -9223372036854775809 99999999999999999999");
+    ASSERT_THROW(values.next_int(), InvalidIntegerException);
+    ASSERT_THROW(values.next_bigint(), InvalidIntegerException);
+    ASSERT_THROW(values.next_bigint(), InvalidIntegerException);
+}
+
+TEST(ValueTokenizer, number_followed_by_separator)
+{
+    ValueTokenizer values("1e5,2.5e-3,-7", ",e");
+    ASSERT_DOUBLE_EQ(values.next_double(), 1.0);
+    ASSERT_EQ(values.next_int(), 5);
+    ASSERT_DOUBLE_EQ(values.next_double(), 2.5);
+    ASSERT_DOUBLE_EQ(values.next_double(), -3.0);
+    ASSERT_EQ(values.next_bigint(), -7);
+}
+
 TEST(ValueTokenizer, valid_int)
 {
     ValueTokenizer values("10");
@@ -19,6 +19,9 @@
 #include "gtest/gtest.h"
 
 #include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -450,6 +453,56 @@ TEST(Utils, signed_double_and_broken_exponential)
     ASSERT_FALSE(utils::is_double("-10e10-2"));
 }
 
+TEST(Utils, parse_double)
+{
+    // results must be identical to strtod(), including the direct conversion path
+    const char *numbers[] = {"0",           "-0.0",        "1",         "0.1",
+                             "3.14159265358979", "-2.718281828459045", "1e22", "1e23",
+                             "1.7976931348623157e308", "2.2250738585072014e-308", "123456789012345678901234567890",
+                             "0.000000000000000000000000000001", "9007199254740993", ".5e-3",
+                             "+12.e+2",     "6.02214076e23", "1.0000000000000002", "0.30000000000000004"};
+    for (const auto &number : numbers) {
+        double value = -1.0;
+        ASSERT_EQ(utils::parse_double(number, strlen(number), value), 0) << number;
+        ASSERT_EQ(value, strtod(number, nullptr)) << number;
+        ASSERT_EQ(std::signbit(value), std::signbit(strtod(number, nullptr))) << number;
+    }
+
+    // only the given number of characters is used
+    double value = 0.0;
+    ASSERT_EQ(utils::parse_double("2.5e3", 3, value), 0);
+    ASSERT_EQ(value, 2.5);
+    ASSERT_EQ(utils::parse_double("2.5 x", 3, value), 0);
+    ASSERT_EQ(value, 2.5);
+    ASSERT_EQ(utils::parse_double("2.5 x", 4, value), 1);
+    ASSERT_EQ(utils::parse_double("", 0, value), 1);
+    ASSERT_EQ(utils::parse_double(".", 1, value), 1);
+    ASSERT_EQ(utils::parse_double("1e", 2, value), 1);
+    ASSERT_EQ(utils::parse_double("0x10", 4, value), 1);
+    ASSERT_EQ(utils::parse_double("inf", 3, value), 1);
+    ASSERT_EQ(utils::parse_double("1e400", 5, value), 2);
+    ASSERT_EQ(utils::parse_double("4.9e-324", 8, value), 2);
+    ASSERT_EQ(value, strtod("4.9e-324", nullptr));
+}
+
+TEST(Utils, parse_int64)
+{
+    int64_t value = 0;
+    ASSERT_EQ(utils::parse_int64("-42", 3, value), 0);
+    ASSERT_EQ(value, -42);
+    ASSERT_EQ(utils::parse_int64("+42x", 3, value), 0);
+    ASSERT_EQ(value, 42);
+    ASSERT_EQ(utils::parse_int64("9223372036854775807", 19, value), 0);
+    ASSERT_EQ(value, INT64_MAX);
+    ASSERT_EQ(utils::parse_int64("-9223372036854775808", 20, value), 0);
+    ASSERT_EQ(value, INT64_MIN);
+    ASSERT_EQ(utils::parse_int64("9223372036854775808", 19, value), 2);
+    ASSERT_EQ(utils::parse_int64("-9223372036854775809", 20, value), 2);
+    ASSERT_EQ(utils::parse_int64("-", 1, value), 1);
+    ASSERT_EQ(utils::parse_int64("1.0", 3, value), 1);
+    ASSERT_EQ(utils::parse_int64("", 0, value), 1);
+}
+
 TEST(Utils, is_double_with_d_exponential)
 {
     ASSERT_FALSE(utils::is_double("10d22"));